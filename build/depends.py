@@ -867,6 +867,7 @@ class MixxxCore(Feature):
                    "src/engine/engineobject.cpp",
                    "src/engine/enginepregain.cpp",
                    "src/engine/enginemaster.cpp",
+                   "src/engine/engineofflinerenderer.cpp",
                    "src/engine/enginedelay.cpp",
                    "src/engine/enginevumeter.cpp",
                    "src/engine/enginesidechaincompressor.cpp",
@@ -888,16 +889,20 @@ class MixxxCore(Feature):
                    "src/engine/enginetalkoverducking.cpp",
                    "src/engine/cachingreader/cachingreader.cpp",
                    "src/engine/cachingreader/cachingreaderchunk.cpp",
+                   "src/engine/cachingreader/cachingreaderchunkstore.cpp",
                    "src/engine/cachingreader/cachingreaderworker.cpp",
 
                    "src/analyzer/trackanalysisscheduler.cpp",
                    "src/analyzer/analyzerthread.cpp",
+                   "src/analyzer/analysisfingerprint.cpp",
                    "src/analyzer/analyzerwaveform.cpp",
+                   "src/analyzer/waveformfilterbank.cpp",
                    "src/analyzer/analyzergain.cpp",
                    "src/analyzer/analyzerbeats.cpp",
                    "src/analyzer/analyzerkey.cpp",
                    "src/analyzer/analyzerebur128.cpp",
                    "src/analyzer/analyzersilence.cpp",
+                   "src/analyzer/plugins/analyzerfrontend.cpp",
                    "src/analyzer/plugins/analyzersoundtouchbeats.cpp",
                    "src/analyzer/plugins/analyzerqueenmarybeats.cpp",
                    "src/analyzer/plugins/analyzerqueenmarykey.cpp",
@@ -911,6 +916,7 @@ class MixxxCore(Feature):
                    "src/controllers/controllerdebug.cpp",
                    "src/controllers/controllerengine.cpp",
                    "src/controllers/controllerenumerator.cpp",
+                   "src/controllers/controllerinputreader.cpp",
                    "src/controllers/controllerlearningeventfilter.cpp",
                    "src/controllers/controllermanager.cpp",
                    "src/controllers/controllerpresetfilehandler.cpp",
@@ -932,6 +938,7 @@ class MixxxCore(Feature):
                    "src/controllers/midi/midicontrollerpreset.cpp",
                    "src/controllers/midi/midicontrollerpresetfilehandler.cpp",
                    "src/controllers/midi/midienumerator.cpp",
+                   "src/controllers/midi/midiinputmappingtable.cpp",
                    "src/controllers/midi/midioutputhandler.cpp",
                    "src/controllers/softtakeover.cpp",
                    "src/controllers/keyboard/keyboardeventfilter.cpp",
@@ -1081,11 +1088,13 @@ class MixxxCore(Feature):
                    "src/library/export/trackexportdlg.cpp",
                    "src/library/export/trackexportwizard.cpp",
                    "src/library/export/trackexportworker.cpp",
+                   "src/library/externallibraryimport.cpp",
 
                    "src/library/recording/recordingfeature.cpp",
                    "src/library/recording/dlgrecording.cpp",
                    "src/recording/recordingmanager.cpp",
                    "src/engine/sidechain/enginerecord.cpp",
+                   "src/engine/sidechain/recordingfilewriter.cpp",
 
                    # External Library Features
                    "src/library/baseexternallibraryfeature.cpp",
@@ -1121,6 +1130,7 @@ class MixxxCore(Feature):
                    "src/library/dao/libraryhashdao.cpp",
                    "src/library/dao/settingsdao.cpp",
                    "src/library/dao/analysisdao.cpp",
+                   "src/library/dao/analysiscachedao.cpp",
                    "src/library/dao/autodjcratesdao.cpp",
 
                    "src/library/librarycontrol.cpp",
@@ -1213,6 +1223,7 @@ class MixxxCore(Feature):
                    "src/skin/legacyskinparser.cpp",
                    "src/skin/colorschemeparser.cpp",
                    "src/skin/tooltips.cpp",
+                   "src/skin/skincache.cpp",
                    "src/skin/skincontext.cpp",
                    "src/skin/svgparser.cpp",
                    "src/skin/pixmapsource.cpp",
@@ -1264,6 +1275,7 @@ class MixxxCore(Feature):
                    "src/mixer/sampler.cpp",
                    "src/mixer/samplerbank.cpp",
 
+                   "src/soundio/driftresampler.cpp",
                    "src/soundio/sounddevice.cpp",
                    "src/soundio/sounddevicenetwork.cpp",
                    "src/engine/sidechain/enginenetworkstream.cpp",
@@ -1286,6 +1298,7 @@ class MixxxCore(Feature):
                    "src/util/sleepableqthread.cpp",
                    "src/util/statsmanager.cpp",
                    "src/util/stat.cpp",
+                   "src/util/startuptrace.cpp",
                    "src/util/statmodel.cpp",
                    "src/util/dnd.cpp",
                    "src/util/duration.cpp",
@@ -1319,6 +1332,7 @@ class MixxxCore(Feature):
                    "src/util/db/fwdsqlqueryselectresult.cpp",
                    "src/util/db/sqllikewildcardescaper.cpp",
                    "src/util/db/sqlqueryfinisher.cpp",
+                   "src/util/db/sqlsavepoint.cpp",
                    "src/util/db/sqlstringformatter.cpp",
                    "src/util/db/sqltransaction.cpp",
                    "src/util/sample.cpp",
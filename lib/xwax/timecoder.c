@@ -602,6 +602,58 @@ void timecoder_submit(struct timecoder *tc, signed short *pcm, size_t npcm)
     }
 }
 
+/*
+ * Submit and decode a block of interleaved float PCM data to the
+ * timecode decoder
+ *
+ * Samples are scaled by gain, clamped to the range of signed short and
+ * decoded like the data passed to timecoder_submit(), but without the
+ * need for the caller to convert them to a separate buffer first. The
+ * conversion is done in small blocks with a branch-free loop that the
+ * compiler can vectorise.
+ */
+
+void timecoder_submit_float(struct timecoder *tc, const float *pcm,
+                            size_t npcm, float gain)
+{
+    signed int block[TIMECODER_SUBMIT_BLOCK * TIMECODER_CHANNELS];
+
+    while (npcm) {
+        size_t n, i;
+
+        n = npcm < TIMECODER_SUBMIT_BLOCK ? npcm : TIMECODER_SUBMIT_BLOCK;
+
+        for (i = 0; i < n * TIMECODER_CHANNELS; i++) {
+            float sample = pcm[i] * gain * 32767.0f;
+            sample = sample > 32767.0f ? 32767.0f : sample;
+            sample = sample < -32768.0f ? -32768.0f : sample;
+            /* Same as converting to signed short and shifting left */
+            block[i] = (signed int)sample * 65536;
+        }
+
+        for (i = 0; i < n; i++) {
+            signed int left, right, primary, secondary;
+
+            left = block[i * TIMECODER_CHANNELS];
+            right = block[i * TIMECODER_CHANNELS + 1];
+
+            if (tc->def->flags & SWITCH_PRIMARY) {
+                primary = left;
+                secondary = right;
+            } else {
+                primary = right;
+                secondary = left;
+            }
+
+            process_sample(tc, primary, secondary);
+            update_monitor(tc, left, right);
+        }
+
+        pcm += n * TIMECODER_CHANNELS;
+        npcm -= n;
+    }
+}
+
 /*
  * Get the last-known position of the timecode
  *
@@ -0,0 +1,81 @@
+#include "analyzer/analysisfingerprint.h"
+
+#include <QCryptographicHash>
+#include <QtEndian>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "analyzer/constants.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "util/math.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+// Bump the version when changing how the fingerprint is computed
+const QString kVersionPrefix = QStringLiteral("1:");
+
+// 8 excerpts of 4096 frames each, i.e. less than a second of audio
+constexpr int kExcerptCount = 8;
+constexpr SINT kExcerptFrames = mixxx::kAnalysisFramesPerChunk;
+
+void addValue(QCryptographicHash* pHash, qint64 value) {
+    const qint64 littleEndian = qToLittleEndian(value);
+    pHash->addData(
+            reinterpret_cast<const char*>(&littleEndian),
+            sizeof(littleEndian));
+}
+
+} // anonymous namespace
+
+// static
+QString AnalysisFingerprint::compute(const mixxx::AudioSourcePointer& pAudioSource) {
+    VERIFY_OR_DEBUG_ASSERT(pAudioSource) {
+        return QString();
+    }
+    const mixxx::IndexRange frameIndexRange = pAudioSource->frameIndexRange();
+    if (frameIndexRange.empty()) {
+        return QString();
+    }
+
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            pAudioSource,
+            kExcerptFrames);
+    DEBUG_ASSERT(
+            audioSourceProxy.getSignalInfo().getChannelCount() ==
+            mixxx::kAnalysisChannels);
+    mixxx::SampleBuffer sampleBuffer(kExcerptFrames * mixxx::kAnalysisChannels);
+    std::vector<qint16> quantized(sampleBuffer.size());
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    addValue(&hash, pAudioSource->getSignalInfo().getSampleRate());
+    addValue(&hash, frameIndexRange.length());
+
+    // The excerpts are spread evenly and may overlap for short tracks
+    const SINT excerptFrames = math_min(kExcerptFrames, frameIndexRange.length());
+    const SINT maxExcerptStart = frameIndexRange.end() - excerptFrames;
+    for (int i = 0; i < kExcerptCount; ++i) {
+        const SINT excerptStart = frameIndexRange.start() +
+                (maxExcerptStart - frameIndexRange.start()) * i / (kExcerptCount - 1);
+        const auto readableSampleFrames =
+                audioSourceProxy.readSampleFrames(
+                        mixxx::WritableSampleFrames(
+                                mixxx::IndexRange::forward(excerptStart, excerptFrames),
+                                mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+        // Decoding errors result in a different fingerprint
+        addValue(&hash, readableSampleFrames.frameIndexRange().start());
+        addValue(&hash, readableSampleFrames.frameIndexRange().length());
+        const SINT sampleCount = readableSampleFrames.readableLength();
+        const CSAMPLE* pSamples = readableSampleFrames.readableData();
+        for (SINT j = 0; j < sampleCount; ++j) {
+            const CSAMPLE sample = math_clamp(pSamples[j], -CSAMPLE_PEAK, CSAMPLE_PEAK);
+            quantized[j] = qToLittleEndian(static_cast<qint16>(
+                    std::lround(sample * std::numeric_limits<qint16>::max())));
+        }
+        hash.addData(
+                reinterpret_cast<const char*>(quantized.data()),
+                static_cast<int>(sampleCount * sizeof(qint16)));
+    }
+    return kVersionPrefix + QString::fromLatin1(hash.result().toHex());
+}
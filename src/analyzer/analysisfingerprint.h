@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QString>
+
+#include "sources/audiosource.h"
+
+// A compact fingerprint of the decoded audio content of a track that
+// identifies identical audio independent of the file location and the
+// tags, e.g. duplicates or moved and re-tagged files.
+//
+// Only files that decode to the same samples match. The same recording
+// in different formats, e.g. FLAC and MP3 of one master, decodes to
+// different samples and gets a different fingerprint. This is intended,
+// the results of one encoding are not exact for the other.
+//
+// Only a few short excerpts spread over the whole track are decoded,
+// which takes a fraction of the time needed for analyzing the track.
+// The excerpts are quantized to 16-bit before hashing and the hash
+// also covers the sample rate and the length of the track.
+class AnalysisFingerprint {
+  public:
+    // Returns an empty string if the audio source is not readable
+    static QString compute(const mixxx::AudioSourcePointer& pAudioSource);
+};
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <QString>
+
+#include "analyzer/analyzerstatistics.h"
+#include "analyzer/constants.h"
 #include "util/assert.h"
+#include "util/performancetimer.h"
 #include "util/types.h"
 
 /*
@@ -47,11 +52,15 @@ class Analyzer {
 
 typedef std::unique_ptr<Analyzer> AnalyzerPtr;
 
+// Also measures the time that is spent in the analyzer. The timing
+// is accumulated over all tracks that have been analyzed.
 class AnalyzerWithState final {
   public:
-    explicit AnalyzerWithState(AnalyzerPtr analyzer)
+    explicit AnalyzerWithState(AnalyzerPtr analyzer, QString name = QString())
             : m_analyzer(std::move(analyzer)),
-              m_active(false) {
+              m_name(std::move(name)),
+              m_active(false),
+              m_sampleRate(0) {
         DEBUG_ASSERT(m_analyzer);
     }
     AnalyzerWithState(const AnalyzerWithState&) = delete;
@@ -66,14 +75,32 @@ class AnalyzerWithState final {
         return m_active;
     }
 
+    const QString& name() const {
+        return m_name;
+    }
+
+    const AnalyzerStatistics::Timing& timing() const {
+        return m_timing;
+    }
+
     bool initialize(TrackPointer tio, int sampleRate, int totalSamples) {
         DEBUG_ASSERT(!m_active);
-        return m_active = m_analyzer->initialize(tio, sampleRate, totalSamples);
+        m_sampleRate = sampleRate;
+        m_timer.start();
+        m_active = m_analyzer->initialize(tio, sampleRate, totalSamples);
+        m_timing.processingDuration += m_timer.elapsed();
+        return m_active;
     }
 
     void processSamples(const CSAMPLE* pIn, const int iLen) {
         if (m_active) {
+            m_timer.start();
             m_active = m_analyzer->processSamples(pIn, iLen);
+            m_timing.processingDuration += m_timer.elapsed();
+            if (m_sampleRate > 0) {
+                m_timing.audioSeconds +=
+                        double(iLen / mixxx::kAnalysisChannels) / m_sampleRate;
+            }
             if (!m_active) {
                 // Ensure that cleanup() is invoked after processing
                 // failed and the analyzer became inactive!
@@ -84,8 +111,10 @@ class AnalyzerWithState final {
 
     void finish(TrackPointer tio) {
         if (m_active) {
+            m_timer.start();
             m_analyzer->storeResults(tio);
             m_analyzer->cleanup();
+            m_timing.processingDuration += m_timer.elapsed();
             m_active = false;
         }
     }
@@ -99,5 +128,9 @@ class AnalyzerWithState final {
 
   private:
     AnalyzerPtr m_analyzer;
+    QString m_name;
     bool m_active;
+    int m_sampleRate;
+    PerformanceTimer m_timer;
+    AnalyzerStatistics::Timing m_timing;
 };
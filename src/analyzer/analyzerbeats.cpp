@@ -28,9 +28,17 @@ mixxx::AnalyzerPluginInfo AnalyzerBeats::defaultPlugin() {
     return availablePlugins().at(0);
 }
 
-AnalyzerBeats::AnalyzerBeats(UserSettingsPointer pConfig, bool enforceBpmDetection)
+AnalyzerBeats::AnalyzerBeats(
+        UserSettingsPointer pConfig,
+        bool enforceBpmDetection,
+        bool provisionalResults,
+        mixxx::AnalyzerFrontEnd* pFrontEnd)
         : m_bpmSettings(pConfig),
+          m_pFrontEnd(pFrontEnd),
           m_enforceBpmDetection(enforceBpmDetection),
+          m_provisionalResults(provisionalResults),
+          m_iProvisionalSamplesToProcess(0),
+          m_bTrackHadFinalBeats(false),
           m_bPreferencesReanalyzeOldBpm(false),
           m_bPreferencesFixedTempo(true),
           m_bPreferencesOffsetCorrection(false),
@@ -103,19 +111,14 @@ bool AnalyzerBeats::initialize(TrackPointer tio, int sampleRate, int totalSample
     // if we can load a stored track don't reanalyze it
     bool bShouldAnalyze = shouldAnalyze(tio);
 
+    const mixxx::BeatsPointer pBeats = tio->getBeats();
+    m_bTrackHadFinalBeats = pBeats && !BeatFactory::isProvisional(*pBeats);
+
 
     DEBUG_ASSERT(!m_pPlugin);
+    DEBUG_ASSERT(!m_pProvisionalPlugin);
     if (bShouldAnalyze) {
-        if (m_pluginId == mixxx::AnalyzerQueenMaryBeats::pluginInfo().id) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryBeats>();
-        } else if (m_pluginId == mixxx::AnalyzerSoundTouchBeats::pluginInfo().id) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerSoundTouchBeats>();
-        } else {
-            // This must not happen, because we have already verified above
-            // that the PlugInId is valid
-            DEBUG_ASSERT(false);
-        }
-
+        m_pPlugin = createPlugin();
         if (m_pPlugin) {
             if (m_pPlugin->initialize(sampleRate)) {
                 qDebug() << "Beat calculation started with plugin" << m_pluginId;
@@ -128,9 +131,38 @@ bool AnalyzerBeats::initialize(TrackPointer tio, int sampleRate, int totalSample
             bShouldAnalyze = false;
         }
     }
+
+    // Provide a beat grid for beat matching as soon as possible if the
+    // track has never been analyzed. The final beats replace it when
+    // the analysis of the whole track has finished.
+    m_iProvisionalSamplesToProcess =
+            mixxx::kProvisionalAnalysisSecondsToAnalyze * m_iSampleRate *
+            mixxx::kAnalysisChannels;
+    if (bShouldAnalyze && m_provisionalResults &&
+            m_pPlugin->supportsBeatTracking() && !tio->getBeats() &&
+            m_iProvisionalSamplesToProcess < m_iMaxSamplesToProcess) {
+        m_pProvisionalPlugin = createPlugin();
+        if (m_pProvisionalPlugin && m_pProvisionalPlugin->initialize(sampleRate)) {
+            m_pProvisionalTrack = tio;
+        } else {
+            m_pProvisionalPlugin.reset();
+        }
+    }
     return bShouldAnalyze;
 }
 
+std::unique_ptr<mixxx::AnalyzerBeatsPlugin> AnalyzerBeats::createPlugin() const {
+    if (m_pluginId == mixxx::AnalyzerQueenMaryBeats::pluginInfo().id) {
+        return std::make_unique<mixxx::AnalyzerQueenMaryBeats>(m_pFrontEnd);
+    } else if (m_pluginId == mixxx::AnalyzerSoundTouchBeats::pluginInfo().id) {
+        return std::make_unique<mixxx::AnalyzerSoundTouchBeats>();
+    }
+    // This must not happen, because we have already verified above
+    // that the PlugInId is valid
+    DEBUG_ASSERT(false);
+    return nullptr;
+}
+
 bool AnalyzerBeats::shouldAnalyze(TrackPointer tio) const {
     int iMinBpm = m_bpmSettings.getBpmRangeStart();
     int iMaxBpm = m_bpmSettings.getBpmRangeEnd();
@@ -152,6 +184,12 @@ bool AnalyzerBeats::shouldAnalyze(TrackPointer tio) const {
     if (!pBeats) {
         return true;
     }
+    if (BeatFactory::isProvisional(*pBeats)) {
+        // The analysis has been interrupted after publishing the
+        // provisional beats
+        qDebug() << "Re-analyzing track with provisional beats.";
+        return true;
+    }
     if (!mixxx::Bpm::isValidValue(pBeats->getBpm())) {
         // Tracks with an invalid bpm <= 0 should be re-analyzed,
         // independent of the preference settings. We expect that
@@ -206,11 +244,42 @@ bool AnalyzerBeats::processSamples(const CSAMPLE *pIn, const int iLen) {
         return true; // silently ignore all remaining samples
     }
 
+    if (m_pProvisionalPlugin) {
+        // Processed before m_pPlugin that reuses the shared downmix
+        if (!m_pProvisionalPlugin->processSamples(pIn, iLen)) {
+            m_pProvisionalPlugin.reset();
+            m_pProvisionalTrack.reset();
+        } else if (m_iCurrentSample >= m_iProvisionalSamplesToProcess) {
+            storeProvisionalResults();
+        }
+    }
+
     return m_pPlugin->processSamples(pIn, iLen);
 }
 
+void AnalyzerBeats::storeProvisionalResults() {
+    DEBUG_ASSERT(m_pProvisionalPlugin);
+    DEBUG_ASSERT(m_pProvisionalTrack);
+    if (m_pProvisionalPlugin->finalize()) {
+        mixxx::BeatsPointer pBeats = makeBeats(
+                *m_pProvisionalTrack, m_pProvisionalPlugin.get(), true);
+        // Don't override beats that have been set in the meantime,
+        // e.g. by tapping the tempo
+        if (pBeats && !m_pProvisionalTrack->getBeats() &&
+                !m_pProvisionalTrack->isBpmLocked()) {
+            qDebug() << "AnalyzerBeats publishes provisional beats. BPM:"
+                     << pBeats->getBpm();
+            m_pProvisionalTrack->setBeats(pBeats);
+        }
+    }
+    m_pProvisionalPlugin.reset();
+    m_pProvisionalTrack.reset();
+}
+
 void AnalyzerBeats::cleanup() {
     m_pPlugin.reset();
+    m_pProvisionalPlugin.reset();
+    m_pProvisionalTrack.reset();
 }
 
 void AnalyzerBeats::storeResults(TrackPointer tio) {
@@ -223,29 +292,7 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
         return;
     }
 
-    mixxx::BeatsPointer pBeats;
-    if (m_pPlugin->supportsBeatTracking()) {
-        QVector<double> beats = m_pPlugin->getBeats();
-        QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
-                m_pluginId, m_bPreferencesFastAnalysis);
-        pBeats = BeatFactory::makePreferredBeats(
-                *tio,
-                beats,
-                extraVersionInfo,
-                m_bPreferencesFixedTempo,
-                m_bPreferencesOffsetCorrection,
-                m_iSampleRate,
-                m_iTotalSamples,
-                m_iMinBpm,
-                m_iMaxBpm);
-        qDebug() << "AnalyzerBeats plugin detected" << beats.size()
-                 << "beats. Average BPM:" << (pBeats ? pBeats->getBpm() : 0.0);
-    } else {
-        float bpm = m_pPlugin->getBpm();
-        qDebug() << "AnalyzerBeats plugin detected constant BPM: " << bpm;
-        pBeats = BeatFactory::makeBeatGrid(*tio, bpm, 0.0f);
-    }
-
+    mixxx::BeatsPointer pBeats = makeBeats(*tio, m_pPlugin.get(), false);
     mixxx::BeatsPointer pCurrentBeats = tio->getBeats();
 
     // If the track has no beats object then set our newly generated one
@@ -262,6 +309,19 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
         return;
     }
 
+    // Provisional beats are always replaced by the final beats
+    if (BeatFactory::isProvisional(*pCurrentBeats)) {
+        tio->setBeats(pBeats);
+        return;
+    }
+
+    // The track had no beats or only provisional beats when the analysis
+    // started. Beats that have been set or edited in the meantime are kept.
+    if (!m_bTrackHadFinalBeats) {
+        qDebug() << "Track got beats as we were analyzing it. Keeping them.";
+        return;
+    }
+
     // If the user prefers to replace old beatgrids with newly generated ones or
     // the old beatgrid has 0-bpm then we replace it.
     bool zeroCurrentBpm = pCurrentBeats->getBpm() == 0.0;
@@ -283,13 +343,48 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
     }
 }
 
+mixxx::BeatsPointer AnalyzerBeats::makeBeats(
+        const Track& track,
+        mixxx::AnalyzerBeatsPlugin* pPlugin,
+        bool provisional) const {
+    mixxx::BeatsPointer pBeats;
+    if (pPlugin->supportsBeatTracking()) {
+        QVector<double> beats = pPlugin->getBeats();
+        QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
+                m_pluginId, m_bPreferencesFastAnalysis, provisional);
+        pBeats = BeatFactory::makePreferredBeats(
+                track,
+                beats,
+                extraVersionInfo,
+                m_bPreferencesFixedTempo,
+                m_bPreferencesOffsetCorrection,
+                m_iSampleRate,
+                m_iTotalSamples,
+                m_iMinBpm,
+                m_iMaxBpm);
+        qDebug() << "AnalyzerBeats plugin detected" << beats.size()
+                 << "beats. Average BPM:" << (pBeats ? pBeats->getBpm() : 0.0);
+    } else {
+        // Provisional beats are only supported by beat tracking plugins
+        // that store the sub-version
+        DEBUG_ASSERT(!provisional);
+        float bpm = pPlugin->getBpm();
+        qDebug() << "AnalyzerBeats plugin detected constant BPM: " << bpm;
+        pBeats = BeatFactory::makeBeatGrid(track, bpm, 0.0f);
+    }
+    return pBeats;
+}
+
 // static
 QHash<QString, QString> AnalyzerBeats::getExtraVersionInfo(
-        QString pluginId, bool bPreferencesFastAnalysis) {
+        QString pluginId, bool bPreferencesFastAnalysis, bool provisional) {
     QHash<QString, QString> extraVersionInfo;
     extraVersionInfo["vamp_plugin_id"] = pluginId;
     if (bPreferencesFastAnalysis) {
         extraVersionInfo["fast_analysis"] = "1";
     }
+    if (provisional) {
+        BeatFactory::markProvisional(&extraVersionInfo);
+    }
     return extraVersionInfo;
 }
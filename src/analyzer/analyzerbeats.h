@@ -17,11 +17,17 @@
 #include "preferences/usersettings.h"
 #include "util/memory.h"
 
+namespace mixxx {
+class AnalyzerFrontEnd;
+} // namespace mixxx
+
 class AnalyzerBeats : public Analyzer {
   public:
     explicit AnalyzerBeats(
             UserSettingsPointer pConfig,
-            bool enforceBpmDetection = false);
+            bool enforceBpmDetection = false,
+            bool provisionalResults = false,
+            mixxx::AnalyzerFrontEnd* pFrontEnd = nullptr);
     ~AnalyzerBeats() override = default;
 
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
@@ -35,11 +41,28 @@ class AnalyzerBeats : public Analyzer {
   private:
     bool shouldAnalyze(TrackPointer tio) const;
     static QHash<QString, QString> getExtraVersionInfo(
-            QString pluginId, bool bPreferencesFastAnalysis);
+            QString pluginId, bool bPreferencesFastAnalysis, bool provisional = false);
+
+    std::unique_ptr<mixxx::AnalyzerBeatsPlugin> createPlugin() const;
+    mixxx::BeatsPointer makeBeats(
+            const Track& track,
+            mixxx::AnalyzerBeatsPlugin* pPlugin,
+            bool provisional) const;
+    void storeProvisionalResults();
 
     BeatDetectionSettings m_bpmSettings;
+    mixxx::AnalyzerFrontEnd* const m_pFrontEnd;
     std::unique_ptr<mixxx::AnalyzerBeatsPlugin> m_pPlugin;
     const bool m_enforceBpmDetection;
+    const bool m_provisionalResults;
+
+    // Analyzes the first seconds of a track that has no beats yet in
+    // parallel to m_pPlugin, sharing the downmix of the front-end
+    std::unique_ptr<mixxx::AnalyzerBeatsPlugin> m_pProvisionalPlugin;
+    TrackPointer m_pProvisionalTrack;
+    int m_iProvisionalSamplesToProcess;
+    bool m_bTrackHadFinalBeats;
+
     QString m_pluginId;
     bool m_bPreferencesReanalyzeOldBpm;
     bool m_bPreferencesFixedTempo;
@@ -11,6 +11,14 @@
 #include "proto/keys.pb.h"
 #include "track/keyfactory.h"
 
+namespace {
+
+// Marks the sub-version of keys that have been detected by analyzing
+// only the first seconds of a track
+const QString kProvisionalVersionInfoKey = QStringLiteral("provisional");
+
+} // anonymous namespace
+
 // static
 QList<mixxx::AnalyzerPluginInfo> AnalyzerKey::availablePlugins() {
     QList<mixxx::AnalyzerPluginInfo> analyzers;
@@ -28,8 +36,15 @@ mixxx::AnalyzerPluginInfo AnalyzerKey::defaultPlugin() {
     return availablePlugins().at(0);
 }
 
-AnalyzerKey::AnalyzerKey(KeyDetectionSettings keySettings)
+AnalyzerKey::AnalyzerKey(
+        KeyDetectionSettings keySettings,
+        bool provisionalResults,
+        mixxx::AnalyzerFrontEnd* pFrontEnd)
         : m_keySettings(keySettings),
+          m_pFrontEnd(pFrontEnd),
+          m_provisionalResults(provisionalResults),
+          m_iProvisionalSamplesToProcess(0),
+          m_bTrackHadFinalKeys(false),
           m_iSampleRate(0),
           m_iTotalSamples(0),
           m_iMaxSamplesToProcess(0),
@@ -83,20 +98,13 @@ bool AnalyzerKey::initialize(TrackPointer tio, int sampleRate, int totalSamples)
     // if we can't load a stored track reanalyze it
     bool bShouldAnalyze = shouldAnalyze(tio);
 
+    const Keys keys = tio->getKeys();
+    m_bTrackHadFinalKeys = keys.isValid() && !isProvisional(keys);
+
     DEBUG_ASSERT(!m_pPlugin);
+    DEBUG_ASSERT(!m_pProvisionalPlugin);
     if (bShouldAnalyze) {
-        if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerQueenMaryKey>();
-#if defined __KEYFINDER__
-        } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id) {
-            m_pPlugin = std::make_unique<mixxx::AnalyzerKeyFinder>();
-#endif
-        } else {
-            // This must not happen, because we have already verified above
-            // that the PlugInId is valid
-            DEBUG_ASSERT(false);
-        }
-
+        m_pPlugin = createPlugin();
         if (m_pPlugin) {
             if (m_pPlugin->initialize(sampleRate)) {
                 qDebug() << "Key calculation started with plugin" << m_pluginId;
@@ -109,9 +117,39 @@ bool AnalyzerKey::initialize(TrackPointer tio, int sampleRate, int totalSamples)
             bShouldAnalyze = false;
         }
     }
+
+    // Provide a key for harmonic mixing as soon as possible if the
+    // track has never been analyzed. The final keys replace it when
+    // the analysis of the whole track has finished.
+    m_iProvisionalSamplesToProcess =
+            mixxx::kProvisionalAnalysisSecondsToAnalyze * m_iSampleRate *
+            mixxx::kAnalysisChannels;
+    if (bShouldAnalyze && m_provisionalResults && !tio->getKeys().isValid() &&
+            m_iProvisionalSamplesToProcess < m_iMaxSamplesToProcess) {
+        m_pProvisionalPlugin = createPlugin();
+        if (m_pProvisionalPlugin && m_pProvisionalPlugin->initialize(sampleRate)) {
+            m_pProvisionalTrack = tio;
+        } else {
+            m_pProvisionalPlugin.reset();
+        }
+    }
     return bShouldAnalyze;
 }
 
+std::unique_ptr<mixxx::AnalyzerKeyPlugin> AnalyzerKey::createPlugin() const {
+    if (m_pluginId == mixxx::AnalyzerQueenMaryKey::pluginInfo().id) {
+        return std::make_unique<mixxx::AnalyzerQueenMaryKey>(m_pFrontEnd);
+#if defined __KEYFINDER__
+    } else if (m_pluginId == mixxx::AnalyzerKeyFinder::pluginInfo().id) {
+        return std::make_unique<mixxx::AnalyzerKeyFinder>();
+#endif
+    }
+    // This must not happen, because we have already verified above
+    // that the PlugInId is valid
+    DEBUG_ASSERT(false);
+    return nullptr;
+}
+
 bool AnalyzerKey::shouldAnalyze(TrackPointer tio) const {
     bool bPreferencesFastAnalysisEnabled = m_keySettings.getFastAnalysis();
     QString pluginID = m_keySettings.getKeyPluginId();
@@ -120,6 +158,12 @@ bool AnalyzerKey::shouldAnalyze(TrackPointer tio) const {
     }
 
     const Keys keys(tio->getKeys());
+    if (keys.isValid() && isProvisional(keys)) {
+        // The analysis has been interrupted after publishing the
+        // provisional keys
+        qDebug() << "Re-analyzing track with provisional keys.";
+        return true;
+    }
     if (keys.isValid()) {
         QString version = keys.getVersion();
         QString subVersion = keys.getSubVersion();
@@ -155,11 +199,42 @@ bool AnalyzerKey::processSamples(const CSAMPLE *pIn, const int iLen) {
         return true; // silently ignore remaining samples
     }
 
+    if (m_pProvisionalPlugin) {
+        if (!m_pProvisionalPlugin->processSamples(pIn, iLen)) {
+            m_pProvisionalPlugin.reset();
+            m_pProvisionalTrack.reset();
+        } else if (m_iCurrentSample >= m_iProvisionalSamplesToProcess) {
+            storeProvisionalResults();
+        }
+    }
+
     return m_pPlugin->processSamples(pIn, iLen);
 }
 
+void AnalyzerKey::storeProvisionalResults() {
+    DEBUG_ASSERT(m_pProvisionalPlugin);
+    DEBUG_ASSERT(m_pProvisionalTrack);
+    if (m_pProvisionalPlugin->finalize()) {
+        KeyChangeList key_changes = m_pProvisionalPlugin->getKeyChanges();
+        QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
+                m_pluginId, m_bPreferencesFastAnalysisEnabled, true);
+        Keys track_keys = KeyFactory::makePreferredKeys(
+                key_changes, extraVersionInfo, m_iSampleRate, m_iTotalSamples);
+        // Don't override keys that have been set in the meantime
+        if (track_keys.isValid() && !m_pProvisionalTrack->getKeys().isValid()) {
+            qDebug() << "AnalyzerKey publishes provisional key"
+                     << track_keys.getGlobalKey();
+            m_pProvisionalTrack->setKeys(track_keys);
+        }
+    }
+    m_pProvisionalPlugin.reset();
+    m_pProvisionalTrack.reset();
+}
+
 void AnalyzerKey::cleanup() {
     m_pPlugin.reset();
+    m_pProvisionalPlugin.reset();
+    m_pProvisionalTrack.reset();
 }
 
 void AnalyzerKey::storeResults(TrackPointer tio) {
@@ -172,6 +247,16 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
         return;
     }
 
+    // The track had no keys or only provisional keys when the analysis
+    // started. Keys that have been set in the meantime, e.g. by the user
+    // editing the provisional key, are kept.
+    const Keys currentKeys = tio->getKeys();
+    if (!m_bTrackHadFinalKeys && currentKeys.isValid() &&
+            !isProvisional(currentKeys)) {
+        qDebug() << "Track got keys as we were analyzing it. Keeping them.";
+        return;
+    }
+
     KeyChangeList key_changes = m_pPlugin->getKeyChanges();
     QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
             m_pluginId, m_bPreferencesFastAnalysisEnabled);
@@ -182,11 +267,19 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
 
 // static
 QHash<QString, QString> AnalyzerKey::getExtraVersionInfo(
-        QString pluginId, bool bPreferencesFastAnalysis) {
+        QString pluginId, bool bPreferencesFastAnalysis, bool provisional) {
     QHash<QString, QString> extraVersionInfo;
     extraVersionInfo["vamp_plugin_id"] = pluginId;
     if (bPreferencesFastAnalysis) {
         extraVersionInfo["fast_analysis"] = "1";
     }
+    if (provisional) {
+        extraVersionInfo[kProvisionalVersionInfoKey] = "1";
+    }
     return extraVersionInfo;
 }
+
+// static
+bool AnalyzerKey::isProvisional(const Keys& keys) {
+    return keys.getSubVersion().contains(kProvisionalVersionInfoKey);
+}
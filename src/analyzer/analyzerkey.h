@@ -12,14 +12,24 @@
 #include "track/track.h"
 #include "util/memory.h"
 
+namespace mixxx {
+class AnalyzerFrontEnd;
+} // namespace mixxx
+
 class AnalyzerKey : public Analyzer {
   public:
-    explicit AnalyzerKey(KeyDetectionSettings keySettings);
+    explicit AnalyzerKey(
+            KeyDetectionSettings keySettings,
+            bool provisionalResults = false,
+            mixxx::AnalyzerFrontEnd* pFrontEnd = nullptr);
     ~AnalyzerKey() override = default;
 
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
     static mixxx::AnalyzerPluginInfo defaultPlugin();
 
+    // Keys that have been published before the analysis finished
+    static bool isProvisional(const Keys& keys);
+
     bool initialize(TrackPointer tio, int sampleRate, int totalSamples) override;
     bool processSamples(const CSAMPLE *pIn, const int iLen) override;
     void storeResults(TrackPointer tio) override;
@@ -27,12 +37,23 @@ class AnalyzerKey : public Analyzer {
 
   private:
     static QHash<QString, QString> getExtraVersionInfo(
-            QString pluginId, bool bPreferencesFastAnalysis);
+            QString pluginId, bool bPreferencesFastAnalysis, bool provisional = false);
 
     bool shouldAnalyze(TrackPointer tio) const;
+    std::unique_ptr<mixxx::AnalyzerKeyPlugin> createPlugin() const;
+    void storeProvisionalResults();
 
     KeyDetectionSettings m_keySettings;
+    mixxx::AnalyzerFrontEnd* const m_pFrontEnd;
     std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pPlugin;
+    const bool m_provisionalResults;
+
+    // Analyzes the first seconds of a track that has no key yet in
+    // parallel to m_pPlugin
+    std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pProvisionalPlugin;
+    TrackPointer m_pProvisionalTrack;
+    int m_iProvisionalSamplesToProcess;
+    bool m_bTrackHadFinalKeys;
     QString m_pluginId;
     int m_iSampleRate;
     int m_iTotalSamples;
@@ -9,7 +9,10 @@ constexpr float kSilenceThreshold = 0.001;
 // TODO: Change the above line to:
 //constexpr float kSilenceThreshold = db2ratio(-60.0f);
 
-bool shouldAnalyze(TrackPointer pTrack) {
+} // anonymous namespace
+
+// static
+bool AnalyzerSilence::shouldAnalyze(TrackPointer pTrack) {
     CuePointer pIntroCue = pTrack->findCueByType(mixxx::CueType::Intro);
     CuePointer pOutroCue = pTrack->findCueByType(mixxx::CueType::Outro);
     CuePointer pAudibleSound = pTrack->findCueByType(mixxx::CueType::AudibleSound);
@@ -20,8 +23,6 @@ bool shouldAnalyze(TrackPointer pTrack) {
     return false;
 }
 
-} // anonymous namespace
-
 AnalyzerSilence::AnalyzerSilence(UserSettingsPointer pConfig)
         : m_pConfig(pConfig),
           m_fThreshold(kSilenceThreshold),
@@ -91,7 +92,15 @@ void AnalyzerSilence::storeResults(TrackPointer pTrack) {
 
     double firstSound = mixxx::kAnalysisChannels * m_iSignalStart;
     double lastSound = mixxx::kAnalysisChannels * m_iSignalEnd;
+    storeAudibleSound(pTrack, m_pConfig, firstSound, lastSound);
+}
 
+// static
+void AnalyzerSilence::storeAudibleSound(
+        TrackPointer pTrack,
+        UserSettingsPointer pConfig,
+        double firstSound,
+        double lastSound) {
     CuePointer pAudibleSound = pTrack->findCueByType(mixxx::CueType::AudibleSound);
     if (pAudibleSound == nullptr) {
         pAudibleSound = pTrack->createAndAddCue();
@@ -119,7 +128,7 @@ void AnalyzerSilence::storeResults(TrackPointer pTrack) {
     if (mainCue == Cue::kNoPosition || upgradingWithMainCueAtDefault) {
         pTrack->setCuePoint(CuePosition(firstSound));
         // NOTE: the actual default for this ConfigValue is set in DlgPrefDeck.
-    } else if (m_pConfig->getValue(ConfigKey("[Controls]", "SetIntroStartAtMainCue"), false) &&
+    } else if (pConfig->getValue(ConfigKey("[Controls]", "SetIntroStartAtMainCue"), false) &&
             pIntroCue == nullptr) {
         introStart = mainCue;
     }
@@ -16,6 +16,16 @@ class AnalyzerSilence : public Analyzer {
     void storeResults(TrackPointer pTrack) override;
     void cleanup() override;
 
+    static bool shouldAnalyze(TrackPointer pTrack);
+
+    // Sets up the audible sound, intro and outro cues of a track from the
+    // positions of the first and last sound in samples
+    static void storeAudibleSound(
+            TrackPointer pTrack,
+            UserSettingsPointer pConfig,
+            double firstSound,
+            double lastSound);
+
   private:
     UserSettingsPointer m_pConfig;
     float m_fThreshold;
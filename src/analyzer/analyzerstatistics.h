@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+
+#include "util/duration.h"
+
+// Throughput of the track analysis, accumulated by the analyzer threads
+struct AnalyzerStatistics {
+    struct Timing {
+        Timing()
+                : audioSeconds(0.0) {
+        }
+
+        // The duration of the audio that has been processed
+        double audioSeconds;
+        // The time that has been spent on processing the audio
+        mixxx::Duration processingDuration;
+
+        // Seconds of audio that are processed per second, 0 if unknown
+        double realTimeFactor() const {
+            const double processingSeconds = processingDuration.toDoubleSeconds();
+            if (processingSeconds <= 0.0) {
+                return 0.0;
+            }
+            return audioSeconds / processingSeconds;
+        }
+
+        void add(const Timing& other) {
+            audioSeconds += other.audioSeconds;
+            processingDuration += other.processingDuration;
+        }
+    };
+
+    AnalyzerStatistics()
+            : analyzedTrackCount(0),
+              skippedTrackCount(0),
+              failedTrackCount(0) {
+    }
+
+    // Tracks that have been decoded and analyzed
+    int analyzedTrackCount;
+    // Tracks that didn't need to be analyzed, e.g. up-to-date tracks
+    // or tracks with cached results for the same audio content
+    int skippedTrackCount;
+    // Tracks that could not be opened or decoded
+    int failedTrackCount;
+
+    Timing decoding;
+    // Keyed by the name of the analyzer
+    QMap<QString, Timing> analyzers;
+
+    void add(const AnalyzerStatistics& other) {
+        analyzedTrackCount += other.analyzedTrackCount;
+        skippedTrackCount += other.skippedTrackCount;
+        failedTrackCount += other.failedTrackCount;
+        decoding.add(other.decoding);
+        for (auto i = other.analyzers.constBegin(); i != other.analyzers.constEnd(); ++i) {
+            analyzers[i.key()].add(i.value());
+        }
+    }
+};
@@ -2,6 +2,7 @@
 
 #include <mutex>
 
+#include "analyzer/analysisfingerprint.h"
 #include "analyzer/analyzerbeats.h"
 #include "analyzer/analyzerebur128.h"
 #include "analyzer/analyzergain.h"
@@ -10,13 +11,15 @@
 #include "analyzer/analyzerwaveform.h"
 #include "analyzer/constants.h"
 
-#include "library/dao/analysisdao.h"
-
 #include "engine/engine.h"
 
 #include "sources/audiosourcestereoproxy.h"
 #include "sources/soundsourceproxy.h"
 
+#include "track/beatfactory.h"
+#include "track/keyfactory.h"
+
+#include "util/counter.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
@@ -44,6 +47,25 @@ void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     }
 }
 
+// Cached results are only applied if the track is missing them,
+// see AnalyzerThread::restoreCachedResults(). Waveforms are not
+// considered, they are only copied along with the other results.
+bool isMissingCachedResults(const TrackPointer& pTrack, bool withReplayGain) {
+    const mixxx::BeatsPointer pBeats = pTrack->getBeats();
+    if (!pTrack->isBpmLocked() &&
+            (!pBeats || BeatFactory::isProvisional(*pBeats))) {
+        return true;
+    }
+    const Keys keys = pTrack->getKeys();
+    if (!keys.isValid() || AnalyzerKey::isProvisional(keys)) {
+        return true;
+    }
+    if (withReplayGain && !pTrack->getReplayGain().hasRatio()) {
+        return true;
+    }
+    return AnalyzerSilence::shouldAnalyze(pTrack);
+}
+
 std::once_flag registerMetaTypesOnceFlag;
 
 void registerMetaTypesOnce() {
@@ -90,33 +112,60 @@ AnalyzerThread::AnalyzerThread(
 }
 
 void AnalyzerThread::doRun() {
-    std::unique_ptr<AnalysisDao> pAnalysisDao;
     // The thread-local database connection  must not be closed
     // before returning from this function.
-    mixxx::DbConnectionPooler dbConnectionPooler;
+    const mixxx::DbConnectionPooler dbConnectionPooler(m_dbConnectionPool);
 
-    if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
-        dbConnectionPooler = mixxx::DbConnectionPooler(m_dbConnectionPool); // move assignment
-        if (!dbConnectionPooler.isPooling()) {
-            kLogger.warning()
-                    << "Failed to obtain database connection for analyzer thread";
-            return;
-        }
+    if (dbConnectionPooler.isPooling()) {
+        // All analyses use the cached results, not only those
+        // with waveforms
         QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
+        m_pAnalysisDao = std::make_unique<AnalysisDao>(m_pConfig);
+        m_pAnalysisDao->initialize(dbConnection);
+        m_pAnalysisCacheDao = std::make_unique<AnalysisCacheDao>();
+        m_pAnalysisCacheDao->initialize(dbConnection);
+        if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
+            m_analyzers.push_back(AnalyzerWithState(
+                    std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection),
+                    "Waveform"));
+        }
+    } else if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
+        kLogger.warning()
+                << "Failed to obtain database connection for analyzer thread";
+        return;
+    } else {
+        kLogger.warning()
+                << "Analyzing without database connection, cached results"
+                << "are not available";
     }
+    const bool withReplayGain =
+            AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig)) ||
+            AnalyzerEbur128::isEnabled(ReplayGainSettings(m_pConfig));
     if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig)));
+        m_analyzers.push_back(AnalyzerWithState(
+                std::make_unique<AnalyzerGain>(m_pConfig),
+                "ReplayGain"));
     }
     if (AnalyzerEbur128::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerEbur128>(m_pConfig)));
+        m_analyzers.push_back(AnalyzerWithState(
+                std::make_unique<AnalyzerEbur128>(m_pConfig),
+                "EBU R128"));
     }
     // BPM detection might be disabled in the config, but can be overridden
     // and enabled by explicitly setting the mode flag.
     const bool enforceBpmDetection = (m_modeFlags & AnalyzerModeFlags::WithBeats) != 0;
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
+    const bool provisionalResults = (m_modeFlags & AnalyzerModeFlags::WithProvisionalResults) != 0;
+    m_analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerBeats>(
+                    m_pConfig, enforceBpmDetection, provisionalResults, &m_frontEnd),
+            "Beats"));
+    m_analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerKey>(
+                    m_pConfig, provisionalResults, &m_frontEnd),
+            "Key"));
+    m_analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerSilence>(m_pConfig),
+            "Silence"));
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
 
@@ -136,10 +185,23 @@ void AnalyzerThread::doRun() {
             kLogger.warning()
                     << "Failed to open file for analyzing:"
                     << m_currentTrack->getFileInfo();
+            updateStatistics(TrackOutcome::Failed);
             emitDoneProgress(kAnalyzerProgressUnknown);
             continue;
         }
 
+        // Results of the same audio in a different file are reused
+        // before the analyzers decide if the track needs to be analyzed.
+        // The fingerprint is only computed if anything could be restored.
+        QString fingerprint;
+        bool restoredCachedResults = false;
+        if (m_pAnalysisCacheDao &&
+                isMissingCachedResults(m_currentTrack, withReplayGain)) {
+            fingerprint = AnalysisFingerprint::compute(audioSource);
+            restoredCachedResults = restoreCachedResults(fingerprint);
+        }
+
+        m_frontEnd.initialize(audioSource->getSignalInfo().getSampleRate());
         bool processTrack = false;
         for (auto&& analyzer : m_analyzers) {
             // Make sure not to short-circuit initialize(...)
@@ -166,6 +228,15 @@ void AnalyzerThread::doRun() {
                 for (auto&& analyzer : m_analyzers) {
                     analyzer.finish(m_currentTrack);
                 }
+                if (m_pAnalysisCacheDao) {
+                    if (fingerprint.isEmpty()) {
+                        fingerprint = AnalysisFingerprint::compute(audioSource);
+                    }
+                    if (!fingerprint.isEmpty()) {
+                        storeCachedResults(fingerprint);
+                    }
+                }
+                updateStatistics(TrackOutcome::Analyzed);
                 emitDoneProgress(kAnalyzerProgressDone);
             } else {
                 for (auto&& analyzer : m_analyzers) {
@@ -175,6 +246,11 @@ void AnalyzerThread::doRun() {
             }
         } else {
             kLogger.debug() << "Skipping track analysis because no analyzer initialized.";
+            if (!fingerprint.isEmpty() && !restoredCachedResults) {
+                // Results of a previous analysis
+                storeCachedResults(fingerprint);
+            }
+            updateStatistics(TrackOutcome::Skipped);
             emitDoneProgress(kAnalyzerProgressDone);
         }
     }
@@ -182,6 +258,8 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(isStopping());
 
     m_analyzers.clear();
+    m_pAnalysisCacheDao.reset();
+    m_pAnalysisDao.reset();
 
     kLogger.debug() << "Exiting worker thread";
     emitProgress(AnalyzerThreadState::Exit);
@@ -203,6 +281,30 @@ bool AnalyzerThread::submitNextTrack(TrackPointer nextTrack) {
     return false;
 }
 
+AnalyzerStatistics AnalyzerThread::statistics() const {
+    const QMutexLocker locked(&m_statisticsMutex);
+    return m_statistics;
+}
+
+void AnalyzerThread::updateStatistics(TrackOutcome outcome) {
+    const QMutexLocker locked(&m_statisticsMutex);
+    switch (outcome) {
+    case TrackOutcome::Analyzed:
+        ++m_statistics.analyzedTrackCount;
+        break;
+    case TrackOutcome::Skipped:
+        ++m_statistics.skippedTrackCount;
+        break;
+    case TrackOutcome::Failed:
+        ++m_statistics.failedTrackCount;
+        break;
+    }
+    m_statistics.decoding = m_decodingTiming;
+    for (const auto& analyzer : m_analyzers) {
+        m_statistics.analyzers[analyzer.name()] = analyzer.timing();
+    }
+}
+
 WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
     DEBUG_ASSERT(!m_currentTrack);
     TrackPointer* pFront = m_nextTrack.front();
@@ -233,6 +335,9 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
     // Analysis starts now
     emitBusyProgress(kAnalyzerProgressNone);
 
+    const double sampleRate = audioSource->getSignalInfo().getSampleRate();
+    PerformanceTimer decodingTimer;
+
     mixxx::IndexRange remainingFrameRange = audioSource->frameIndexRange();
     while (!remainingFrameRange.empty()) {
         sleepWhileSuspended();
@@ -249,11 +354,17 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
         DEBUG_ASSERT(!chunkFrameRange.empty());
 
         // Request the next chunk of audio data
+        decodingTimer.start();
         const auto readableSampleFrames =
                 audioSourceProxy.readSampleFrames(
                         mixxx::WritableSampleFrames(
                                 chunkFrameRange,
                                 mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+        m_decodingTiming.processingDuration += decodingTimer.elapsed();
+        if (sampleRate > 0) {
+            m_decodingTiming.audioSeconds +=
+                    readableSampleFrames.frameIndexRange().length() / sampleRate;
+        }
         // The returned range fits into the requested range
         DEBUG_ASSERT(readableSampleFrames.frameIndexRange() <= chunkFrameRange);
 
@@ -297,6 +408,11 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
         // 2nd: step: Analyze chunk of decoded audio data
         if (!readableSampleFrames.frameIndexRange().empty()) {
+            // The downmix is computed on demand and shared by
+            // the analyzers
+            m_frontEnd.setStereoSamples(
+                    readableSampleFrames.readableData(),
+                    readableSampleFrames.readableLength());
             for (auto&& analyzer : m_analyzers) {
                 analyzer.processSamples(
                         readableSampleFrames.readableData(),
@@ -328,6 +444,123 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
     return AnalysisResult::Finished;
 }
 
+bool AnalyzerThread::restoreCachedResults(const QString& fingerprint) {
+    DEBUG_ASSERT(m_currentTrack);
+    DEBUG_ASSERT(m_pAnalysisCacheDao);
+    AnalysisCacheDao::CachedResults results;
+    if (!m_pAnalysisCacheDao->getCachedResults(fingerprint, &results)) {
+        return false;
+    }
+    const TrackId trackId = m_currentTrack->getId();
+    if (results.trackId == trackId) {
+        // Cached results of the same track
+        return true;
+    }
+    Counter("AnalyzerThread analysis cache hit").increment();
+    kLogger.debug()
+            << "Reusing analysis results of track"
+            << results.trackId
+            << "for track"
+            << trackId;
+
+    applyCachedResults(m_currentTrack, results, m_pConfig);
+    // The analyzed track might have been deleted in the meantime,
+    // then the waveforms are analyzed again
+    if (m_pAnalysisDao && trackId.isValid() && results.trackId.isValid() &&
+            m_pAnalysisDao->getAnalysesForTrack(trackId).isEmpty()) {
+        for (auto analysis : m_pAnalysisDao->getAnalysesForTrack(results.trackId)) {
+            analysis.analysisId = -1;
+            analysis.trackId = trackId;
+            m_pAnalysisDao->saveAnalysis(&analysis);
+        }
+    }
+    return true;
+}
+
+void AnalyzerThread::storeCachedResults(const QString& fingerprint) {
+    DEBUG_ASSERT(m_currentTrack);
+    DEBUG_ASSERT(m_pAnalysisCacheDao);
+    const AnalysisCacheDao::CachedResults results =
+            cachedResultsOfTrack(m_currentTrack);
+    if (results.beatsVersion.isEmpty() &&
+            results.keysVersion.isEmpty() &&
+            !results.replayGain.hasRatio() &&
+            results.audibleSoundStart < 0.0) {
+        return;
+    }
+    m_pAnalysisCacheDao->saveCachedResults(fingerprint, results);
+}
+
+//static
+AnalysisCacheDao::CachedResults AnalyzerThread::cachedResultsOfTrack(
+        const TrackPointer& pTrack) {
+    AnalysisCacheDao::CachedResults results;
+    results.trackId = pTrack->getId();
+    const mixxx::BeatsPointer pBeats = pTrack->getBeats();
+    if (pBeats && !BeatFactory::isProvisional(*pBeats)) {
+        results.beatsVersion = pBeats->getVersion();
+        results.beatsSubVersion = pBeats->getSubVersion();
+        results.beats = pBeats->toByteArray();
+    }
+    const Keys keys = pTrack->getKeys();
+    if (keys.isValid() && !AnalyzerKey::isProvisional(keys)) {
+        results.keysVersion = keys.getVersion();
+        results.keysSubVersion = keys.getSubVersion();
+        results.keys = keys.toByteArray();
+    }
+    results.replayGain = pTrack->getReplayGain();
+    const CuePointer pAudibleSound =
+            pTrack->findCueByType(mixxx::CueType::AudibleSound);
+    if (pAudibleSound && pAudibleSound->getLength() > 0) {
+        results.audibleSoundStart = pAudibleSound->getPosition();
+        results.audibleSoundEnd = pAudibleSound->getEndPosition();
+    }
+    return results;
+}
+
+//static
+void AnalyzerThread::applyCachedResults(
+        const TrackPointer& pTrack,
+        const AnalysisCacheDao::CachedResults& results,
+        const UserSettingsPointer& pConfig) {
+    const mixxx::BeatsPointer pCurrentBeats = pTrack->getBeats();
+    if (!results.beatsVersion.isEmpty() && !pTrack->isBpmLocked() &&
+            (!pCurrentBeats || BeatFactory::isProvisional(*pCurrentBeats))) {
+        const mixxx::BeatsPointer pBeats = BeatFactory::loadBeatsFromByteArray(
+                *pTrack,
+                results.beatsVersion,
+                results.beatsSubVersion,
+                results.beats);
+        if (pBeats) {
+            pTrack->setBeats(pBeats);
+        }
+    }
+    const Keys currentKeys = pTrack->getKeys();
+    if (!results.keysVersion.isEmpty() &&
+            (!currentKeys.isValid() || AnalyzerKey::isProvisional(currentKeys))) {
+        QByteArray keysData = results.keys;
+        const Keys keys = KeyFactory::loadKeysFromByteArray(
+                results.keysVersion,
+                results.keysSubVersion,
+                &keysData);
+        if (keys.isValid()) {
+            pTrack->setKeys(keys);
+        }
+    }
+    if (results.replayGain.hasRatio() &&
+            !pTrack->getReplayGain().hasRatio()) {
+        pTrack->setReplayGain(results.replayGain);
+    }
+    if (results.audibleSoundStart >= 0.0 &&
+            AnalyzerSilence::shouldAnalyze(pTrack)) {
+        AnalyzerSilence::storeAudibleSound(
+                pTrack,
+                pConfig,
+                results.audibleSoundStart,
+                results.audibleSoundEnd);
+    }
+}
+
 void AnalyzerThread::emitBusyProgress(AnalyzerProgress busyProgress) {
     DEBUG_ASSERT(m_currentTrack);
     if ((m_emittedState == AnalyzerThreadState::Busy) &&
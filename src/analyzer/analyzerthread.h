@@ -1,11 +1,17 @@
 #pragma once
 
+#include <QMutex>
+
 #include <vector>
 
 #include "rigtorp/SPSCQueue.h"
 
 #include "analyzer/analyzer.h"
 #include "analyzer/analyzerprogress.h"
+#include "analyzer/analyzerstatistics.h"
+#include "analyzer/plugins/analyzerfrontend.h"
+#include "library/dao/analysiscachedao.h"
+#include "library/dao/analysisdao.h"
 #include "preferences/usersettings.h"
 #include "sources/audiosource.h"
 #include "track/track.h"
@@ -19,6 +25,8 @@ enum AnalyzerModeFlags {
     None = 0x00,
     WithBeats = 0x01,
     WithWaveform = 0x02,
+    // Publish provisional beats and keys early, e.g. for loaded tracks
+    WithProvisionalResults = 0x04,
     All = WithBeats | WithWaveform,
 };
 
@@ -76,6 +84,22 @@ class AnalyzerThread : public WorkerThread {
     // worker thread, yet.
     bool submitNextTrack(TrackPointer nextTrack);
 
+    // The throughput of all tracks that have been analyzed by this
+    // thread so far. Might be invoked from any thread.
+    AnalyzerStatistics statistics() const;
+
+    // The results of the given track that are stored in the analysis
+    // cache, excluding any provisional results
+    static AnalysisCacheDao::CachedResults cachedResultsOfTrack(
+            const TrackPointer& pTrack);
+
+    // Applies the cached results that are missing for the given track.
+    // Beats are never applied to a track with a locked BPM.
+    static void applyCachedResults(
+            const TrackPointer& pTrack,
+            const AnalysisCacheDao::CachedResults& results,
+            const UserSettingsPointer& pConfig);
+
   signals:
     // Use a single signal for progress updates to ensure that all signals
     // are queued and received in the same order as emitted from the internal
@@ -109,6 +133,10 @@ class AnalyzerThread : public WorkerThread {
     // for this purpose, which will become available in C++20.
     rigtorp::SPSCQueue<TrackPointer> m_nextTrack;
 
+    // Updated by the worker thread after each track
+    mutable QMutex m_statisticsMutex;
+    AnalyzerStatistics m_statistics;
+
     /////////////////////////////////////////////////////////////////////////
     // Thread local: Only used in the constructor/destructor and within
     // run() by the worker thread.
@@ -117,8 +145,16 @@ class AnalyzerThread : public WorkerThread {
 
     mixxx::SampleBuffer m_sampleBuffer;
 
+    mixxx::AnalyzerFrontEnd m_frontEnd;
+
+    // Only available if the thread has a database connection
+    std::unique_ptr<AnalysisDao> m_pAnalysisDao;
+    std::unique_ptr<AnalysisCacheDao> m_pAnalysisCacheDao;
+
     TrackPointer m_currentTrack;
 
+    AnalyzerStatistics::Timing m_decodingTiming;
+
     AnalyzerThreadState m_emittedState;
 
     PerformanceTimer m_lastBusyProgressEmittedTimer;
@@ -131,6 +167,21 @@ class AnalyzerThread : public WorkerThread {
     AnalysisResult analyzeAudioSource(
             const mixxx::AudioSourcePointer& audioSource);
 
+    // Applies the cached results of a previous analysis of the same audio
+    // content that are missing for the current track. Returns true if
+    // cached results have been found.
+    bool restoreCachedResults(const QString& fingerprint);
+    // Stores the analysis results of the current track for reuse
+    void storeCachedResults(const QString& fingerprint);
+
+    enum class TrackOutcome {
+        Analyzed,
+        Skipped,
+        Failed,
+    };
+    // Publishes the statistics after the current track has been finished
+    void updateStatistics(TrackOutcome outcome);
+
     // Blocks the worker thread until a next track becomes available
     TrackPointer receiveNextTrack();
 
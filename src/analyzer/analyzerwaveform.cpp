@@ -1,8 +1,5 @@
 #include "analyzer/analyzerwaveform.h"
 
-#include "engine/engineobject.h"
-#include "engine/filters/enginefilterbessel4.h"
-#include "engine/filters/enginefilterbutterworth8.h"
 #include "library/trackcollection.h"
 #include "track/track.h"
 #include "util/logger.h"
@@ -22,16 +19,14 @@ AnalyzerWaveform::AnalyzerWaveform(
           m_waveformSummaryData(nullptr),
           m_stride(0, 0),
           m_currentStride(0),
-          m_currentSummaryStride(0) {
-    m_filter[0] = 0;
-    m_filter[1] = 0;
-    m_filter[2] = 0;
+          m_currentSummaryStride(0),
+          m_nextStridePosition(0),
+          m_nextSummaryStridePosition(0) {
     m_analysisDao.initialize(dbConnection);
 }
 
 AnalyzerWaveform::~AnalyzerWaveform() {
     kLogger.debug() << "~AnalyzerWaveform():";
-    destroyFilters();
 }
 
 bool AnalyzerWaveform::initialize(TrackPointer tio, int sampleRate, int totalSamples) {
@@ -48,8 +43,9 @@ bool AnalyzerWaveform::initialize(TrackPointer tio, int sampleRate, int totalSam
     m_timer.start();
 
     // Now actually initialize the AnalyzerWaveform:
-    destroyFilters();
-    createFilters(sampleRate);
+    // The filters are settled for silence in preroll to avoid ramping
+    // (Bug #1406389)
+    m_filterBank.initialize(sampleRate);
 
     //TODO (vrince) Do we want to expose this as settings or whatever ?
     const int mainWaveformSampleRate = 441;
@@ -75,6 +71,8 @@ bool AnalyzerWaveform::initialize(TrackPointer tio, int sampleRate, int totalSam
 
     m_currentStride = 0;
     m_currentSummaryStride = 0;
+    m_nextStridePosition = nextStridePosition(m_stride.m_length, 0);
+    m_nextSummaryStridePosition = nextStridePosition(m_stride.m_averageLength, 0);
 
     //debug
     //m_waveform->dump();
@@ -145,26 +143,24 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer tio) const {
     return true;
 }
 
-void AnalyzerWaveform::createFilters(int sampleRate) {
-    // m_filter[Low] = new EngineFilterButterworth8(FILTER_LOWPASS, sampleRate, 200);
-    // m_filter[Mid] = new EngineFilterButterworth8(FILTER_BANDPASS, sampleRate, 200, 2000);
-    // m_filter[High] = new EngineFilterButterworth8(FILTER_HIGHPASS, sampleRate, 2000);
-    m_filter[Low] = new EngineFilterBessel4Low(sampleRate, 600);
-    m_filter[Mid] = new EngineFilterBessel4Band(sampleRate, 600, 4000);
-    m_filter[High] = new EngineFilterBessel4High(sampleRate, 4000);
-    // settle filters for silence in preroll to avoids ramping (Bug #1406389)
-    for (int i = 0; i < FilterCount; ++i) {
-        m_filter[i]->assumeSettled();
+// static
+int AnalyzerWaveform::nextStridePosition(double length, int position) {
+    // A stride is stored at the first position at or behind each multiple
+    // of the length, i.e. if fmod(position, length) < 1. The estimate is
+    // corrected with the same condition to store exactly the strides of a
+    // sample by sample check.
+    int next = position + 1;
+    const double remainder = fmod(next, length);
+    if (remainder >= 1) {
+        next += static_cast<int>(ceil(length - remainder));
     }
-}
-
-void AnalyzerWaveform::destroyFilters() {
-    for (int i = 0; i < FilterCount; ++i) {
-        if (m_filter[i]) {
-            delete m_filter[i];
-            m_filter[i] = 0;
-        }
+    while (next > position + 1 && fmod(next - 1, length) < 1) {
+        --next;
+    }
+    while (fmod(next, length) >= 1) {
+        ++next;
     }
+    return next;
 }
 
 bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLength) {
@@ -175,51 +171,47 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLen
         return false;
     }
 
-    //this should only append once if bufferLength is constant
-    if (bufferLength > (int)m_buffers[0].size()) {
-        m_buffers[Low].resize(bufferLength);
-        m_buffers[Mid].resize(bufferLength);
-        m_buffers[High].resize(bufferLength);
-    }
-
-    m_filter[Low]->process(buffer, &m_buffers[Low][0], bufferLength);
-    m_filter[Mid]->process(buffer, &m_buffers[Mid][0], bufferLength);
-    m_filter[High]->process(buffer, &m_buffers[High][0], bufferLength);
-
     m_waveform->setSaveState(Waveform::SaveState::NotSaved);
     m_waveformSummary->setSaveState(Waveform::SaveState::NotSaved);
 
-    for (int i = 0; i < bufferLength; i += 2) {
-        // Take max value, not average of data
-        CSAMPLE cover[2] = {fabs(buffer[i]), fabs(buffer[i + 1])};
-        CSAMPLE clow[2] = {fabs(m_buffers[Low][i]), fabs(m_buffers[Low][i + 1])};
-        CSAMPLE cmid[2] = {fabs(m_buffers[Mid][i]), fabs(m_buffers[Mid][i + 1])};
-        CSAMPLE chigh[2] = {fabs(m_buffers[High][i]), fabs(m_buffers[High][i + 1])};
-
-        // This is for if you want to experiment with averaging instead of
-        // maxing.
-        // m_stride.m_overallData[Right] += buffer[i]*buffer[i];
-        // m_stride.m_overallData[Left] += buffer[i + 1]*buffer[i + 1];
-        // m_stride.m_filteredData[Right][Low] += m_buffers[Low][i]*m_buffers[Low][i];
-        // m_stride.m_filteredData[Left][Low] += m_buffers[Low][i + 1]*m_buffers[Low][i + 1];
-        // m_stride.m_filteredData[Right][Mid] += m_buffers[Mid][i]*m_buffers[Mid][i];
-        // m_stride.m_filteredData[Left][Mid] += m_buffers[Mid][i + 1]*m_buffers[Mid][i + 1];
-        // m_stride.m_filteredData[Right][High] += m_buffers[High][i]*m_buffers[High][i];
-        // m_stride.m_filteredData[Left][High] += m_buffers[High][i + 1]*m_buffers[High][i + 1];
-
-        // Record the max across this stride.
-        storeIfGreater(&m_stride.m_overallData[Left], cover[Left]);
-        storeIfGreater(&m_stride.m_overallData[Right], cover[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][Low], clow[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][Low], clow[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][Mid], cmid[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][Mid], cmid[Right]);
-        storeIfGreater(&m_stride.m_filteredData[Left][High], chigh[Left]);
-        storeIfGreater(&m_stride.m_filteredData[Right][High], chigh[Right]);
-
-        m_stride.m_position++;
-
-        if (fmod(m_stride.m_position, m_stride.m_length) < 1) {
+    const int frameCount = bufferLength / 2;
+    int frame = 0;
+    while (frame < frameCount) {
+        // Filter all frames until the next stride needs to be stored
+        const int nextPosition = math_min(
+                m_nextStridePosition, m_nextSummaryStridePosition);
+        DEBUG_ASSERT(nextPosition > m_stride.m_position);
+        const int frames = math_min(
+                frameCount - frame, nextPosition - m_stride.m_position);
+
+        // Record the max across this stride, not the average.
+        float maxima[WaveformFilterBank::kLanes];
+        for (int i = 0; i < ChannelCount; ++i) {
+            const auto channel = static_cast<ChannelIndex>(i);
+            maxima[WaveformFilterBank::overallLane(channel)] =
+                    m_stride.m_overallData[channel];
+            for (int f = 0; f < FilterCount; ++f) {
+                const auto filter = static_cast<FilterIndex>(f);
+                maxima[WaveformFilterBank::lane(filter, channel)] =
+                        m_stride.m_filteredData[channel][filter];
+            }
+        }
+        m_filterBank.process(&buffer[2 * frame], frames, maxima);
+        for (int i = 0; i < ChannelCount; ++i) {
+            const auto channel = static_cast<ChannelIndex>(i);
+            m_stride.m_overallData[channel] =
+                    maxima[WaveformFilterBank::overallLane(channel)];
+            for (int f = 0; f < FilterCount; ++f) {
+                const auto filter = static_cast<FilterIndex>(f);
+                m_stride.m_filteredData[channel][filter] =
+                        maxima[WaveformFilterBank::lane(filter, channel)];
+            }
+        }
+
+        frame += frames;
+        m_stride.m_position += frames;
+
+        if (m_stride.m_position == m_nextStridePosition) {
             VERIFY_OR_DEBUG_ASSERT(m_currentStride + ChannelCount <= m_waveform->getDataSize()) {
                 qWarning() << "AnalyzerWaveform::process - currentStride > waveform size";
                 return false;
@@ -227,9 +219,11 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLen
             m_stride.store(m_waveformData + m_currentStride);
             m_currentStride += ChannelCount;
             m_waveform->setCompletion(m_currentStride);
+            m_nextStridePosition = nextStridePosition(
+                    m_stride.m_length, m_stride.m_position);
         }
 
-        if (fmod(m_stride.m_position, m_stride.m_averageLength) < 1) {
+        if (m_stride.m_position == m_nextSummaryStridePosition) {
             VERIFY_OR_DEBUG_ASSERT(m_currentSummaryStride + ChannelCount <= m_waveformSummary->getDataSize()) {
                 qWarning() << "AnalyzerWaveform::process - current summary stride > waveform summary size";
                 return false;
@@ -237,6 +231,8 @@ bool AnalyzerWaveform::processSamples(const CSAMPLE* buffer, const int bufferLen
             m_stride.averageStore(m_waveformSummaryData + m_currentSummaryStride);
             m_currentSummaryStride += ChannelCount;
             m_waveformSummary->setCompletion(m_currentSummaryStride);
+            m_nextSummaryStridePosition = nextStridePosition(
+                    m_stride.m_averageLength, m_stride.m_position);
 
 #ifdef TEST_HEAT_MAP
             QPointF point(m_stride.m_filteredData[Right][High],
@@ -298,9 +294,3 @@ void AnalyzerWaveform::storeResults(TrackPointer tio) {
     kLogger.debug() << "Waveform generation for track" << tio->getId() << "done"
                     << m_timer.elapsed().debugSecondsWithUnit();
 }
-
-void AnalyzerWaveform::storeIfGreater(float* pDest, float source) {
-    if (*pDest < source) {
-        *pDest = source;
-    }
-}
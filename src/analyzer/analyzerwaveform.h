@@ -7,6 +7,7 @@
 #include <limits>
 
 #include "analyzer/analyzer.h"
+#include "analyzer/waveformfilterbank.h"
 #include "library/dao/analysisdao.h"
 #include "util/math.h"
 #include "util/performancetimer.h"
@@ -15,8 +16,6 @@
 //NOTS vrince some test to segment sound, to apply color in the waveform
 //#define TEST_HEAT_MAP
 
-class EngineFilterIIRBase;
-
 inline CSAMPLE scaleSignal(CSAMPLE invalue, FilterIndex index = FilterCount) {
     if (invalue == 0.0) {
         return 0;
@@ -153,9 +152,9 @@ class AnalyzerWaveform : public Analyzer {
     void storeCurrentStridePower();
     void resetCurrentStride();
 
-    void createFilters(int sampleRate);
-    void destroyFilters();
-    void storeIfGreater(float* pDest, float source);
+    // The first position after position at which a stride of the length
+    // is stored, see processSamples()
+    static int nextStridePosition(double length, int position);
 
     mutable AnalysisDao m_analysisDao;
 
@@ -168,9 +167,10 @@ class AnalyzerWaveform : public Analyzer {
 
     int m_currentStride;
     int m_currentSummaryStride;
+    int m_nextStridePosition;
+    int m_nextSummaryStridePosition;
 
-    EngineFilterIIRBase* m_filter[FilterCount];
-    std::vector<float> m_buffers[FilterCount];
+    WaveformFilterBank m_filterBank;
 
     PerformanceTimer m_timer;
 
@@ -16,4 +16,9 @@ constexpr SINT kAnalysisSamplesPerChunk =
 // Only analyze the first minute in fast-analysis mode.
 constexpr int kFastAnalysisSecondsToAnalyze = 60;
 
+// Provisional results for tracks that have just been loaded into a deck
+// are published after analyzing the first seconds, before the analysis
+// of the whole track has finished.
+constexpr int kProvisionalAnalysisSecondsToAnalyze = 15;
+
 }  // namespace mixxx
@@ -0,0 +1,49 @@
+#include "analyzer/plugins/analyzerfrontend.h"
+
+#include "analyzer/constants.h"
+#include "util/assert.h"
+
+static_assert(mixxx::kAnalysisChannels == 2,
+        "The front-end only supports stereo input");
+
+namespace mixxx {
+
+AnalyzerFrontEnd::AnalyzerFrontEnd()
+        : m_sampleRate(0),
+          m_pChunk(nullptr),
+          m_chunkFrames(0),
+          m_monoSamplesValid(false),
+          m_computedDownmixCount(0) {
+}
+
+void AnalyzerFrontEnd::initialize(int sampleRate) {
+    m_sampleRate = sampleRate;
+    m_pChunk = nullptr;
+    m_chunkFrames = 0;
+    m_monoSamplesValid = false;
+}
+
+void AnalyzerFrontEnd::setStereoSamples(const CSAMPLE* pIn, int iLen) {
+    DEBUG_ASSERT(iLen % kChannels == 0);
+    m_pChunk = pIn;
+    m_chunkFrames = iLen / kChannels;
+    m_monoSamplesValid = false;
+}
+
+const double* AnalyzerFrontEnd::monoSamples() {
+    if (!m_monoSamplesValid) {
+        if (m_monoSamples.size() < static_cast<size_t>(m_chunkFrames)) {
+            m_monoSamples.resize(m_chunkFrames);
+        }
+        for (SINT i = 0; i < m_chunkFrames; ++i) {
+            // We analyze a mono downmix of the signal since we don't think
+            // stereo does us any good.
+            m_monoSamples[i] = (m_pChunk[i * 2] + m_pChunk[i * 2 + 1]) * 0.5;
+        }
+        m_monoSamplesValid = true;
+        ++m_computedDownmixCount;
+    }
+    return m_monoSamples.data();
+}
+
+} // namespace mixxx
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+
+#include "util/types.h"
+
+namespace mixxx {
+
+// Shared front-end of all analyzer plugins of an analyzer thread.
+//
+// The analyzer thread passes each chunk of stereo samples to the front-end
+// before passing it to the analyzers. The mono downmix of the chunk is
+// computed lazily on demand and only once, regardless of how many plugins
+// consume it. Plugins that stop early, e.g. for a fast analysis, don't
+// cause any work for the remaining chunks.
+//
+// Only the downmix is shared. The Queen Mary key detector decimates the
+// signal before its constant-Q transform, so the spectra of the beat
+// tracker could not be reused by any other plugin.
+class AnalyzerFrontEnd {
+  public:
+    AnalyzerFrontEnd();
+
+    // Starts the analysis of the next track
+    void initialize(int sampleRate);
+
+    // Replaces the current chunk. The samples must stay valid until the
+    // chunk has been processed by all analyzers.
+    void setStereoSamples(const CSAMPLE* pIn, int iLen);
+
+    int getSampleRate() const {
+        return m_sampleRate;
+    }
+
+    // Checks if the samples passed to a plugin are the current chunk
+    bool isCurrentChunk(const CSAMPLE* pIn, int iLen) const {
+        return pIn == m_pChunk && iLen == m_chunkFrames * kChannels;
+    }
+
+    // The mono downmix of the current chunk
+    const double* monoSamples();
+    SINT monoFrameCount() const {
+        return m_chunkFrames;
+    }
+
+    // The number of downmixes that have been computed, for tests
+    int getComputedDownmixCount() const {
+        return m_computedDownmixCount;
+    }
+
+  private:
+    static constexpr SINT kChannels = 2;
+
+    int m_sampleRate;
+
+    const CSAMPLE* m_pChunk;
+    SINT m_chunkFrames;
+    bool m_monoSamplesValid;
+    std::vector<double> m_monoSamples;
+
+    int m_computedDownmixCount;
+};
+
+} // namespace mixxx
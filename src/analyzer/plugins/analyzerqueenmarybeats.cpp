@@ -6,6 +6,7 @@
 #include "analyzer/plugins/analyzerqueenmarybeats.h"
 
 #include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerfrontend.h"
 
 namespace mixxx {
 namespace {
@@ -29,8 +30,9 @@ DFConfig makeDetectionFunctionConfig(int stepSize, int windowSize) {
 
 } // namespace
 
-AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats()
-        : m_iSampleRate(0) {
+AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats(AnalyzerFrontEnd* pFrontEnd)
+        : m_pFrontEnd(pFrontEnd),
+          m_iSampleRate(0) {
 }
 
 AnalyzerQueenMaryBeats::~AnalyzerQueenMaryBeats() {
@@ -62,6 +64,10 @@ bool AnalyzerQueenMaryBeats::processSamples(const CSAMPLE* pIn, const int iLen)
         return false;
     }
 
+    if (m_pFrontEnd && m_pFrontEnd->isCurrentChunk(pIn, iLen)) {
+        return m_helper.processMonoSamples(
+                m_pFrontEnd->monoSamples(), m_pFrontEnd->monoFrameCount());
+    }
     return m_helper.processStereoSamples(pIn, iLen);
 }
 
@@ -14,6 +14,8 @@ class DetectionFunction;
 
 namespace mixxx {
 
+class AnalyzerFrontEnd;
+
 class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
   public:
     static AnalyzerPluginInfo pluginInfo() {
@@ -26,7 +28,8 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
                 true);
     }
 
-    AnalyzerQueenMaryBeats();
+    // The front-end is optional and shared with other plugins
+    explicit AnalyzerQueenMaryBeats(AnalyzerFrontEnd* pFrontEnd = nullptr);
     ~AnalyzerQueenMaryBeats() override;
 
     AnalyzerPluginInfo info() const override {
@@ -46,6 +49,7 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
     }
 
   private:
+    AnalyzerFrontEnd* const m_pFrontEnd;
     std::unique_ptr<DetectionFunction> m_pDetectionFunction;
     DownmixAndOverlapHelper m_helper;
     int m_iSampleRate;
@@ -5,6 +5,7 @@
 #include "analyzer/plugins/analyzerqueenmarykey.h"
 
 #include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerfrontend.h"
 #include "util/assert.h"
 #include "util/math.h"
 
@@ -19,8 +20,9 @@ constexpr int kTuningFrequencyHertz = 440;
 
 } // namespace
 
-AnalyzerQueenMaryKey::AnalyzerQueenMaryKey()
-        : m_currentFrame(0),
+AnalyzerQueenMaryKey::AnalyzerQueenMaryKey(AnalyzerFrontEnd* pFrontEnd)
+        : m_pFrontEnd(pFrontEnd),
+          m_currentFrame(0),
           m_prevKey(mixxx::track::io::key::INVALID) {
 }
 
@@ -84,6 +86,12 @@ bool AnalyzerQueenMaryKey::processSamples(const CSAMPLE* pIn, const int iLen) {
 
     const size_t numInputFrames = iLen / kAnalysisChannels;
     m_currentFrame += numInputFrames;
+    if (m_pFrontEnd && m_pFrontEnd->isCurrentChunk(pIn, iLen)) {
+        // The key detection needs the time domain signal for decimation,
+        // only the downmix is shared
+        return m_helper.processMonoSamples(
+                m_pFrontEnd->monoSamples(), numInputFrames);
+    }
     return m_helper.processStereoSamples(pIn, iLen);
 }
 
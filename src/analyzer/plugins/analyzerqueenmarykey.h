@@ -14,6 +14,8 @@ class GetKeyMode;
 
 namespace mixxx {
 
+class AnalyzerFrontEnd;
+
 class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
   public:
     static AnalyzerPluginInfo pluginInfo() {
@@ -26,7 +28,8 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
                 false);
     }
 
-    AnalyzerQueenMaryKey();
+    // The front-end is optional and shared with other plugins
+    explicit AnalyzerQueenMaryKey(AnalyzerFrontEnd* pFrontEnd = nullptr);
     ~AnalyzerQueenMaryKey() override;
 
     AnalyzerPluginInfo info() const override {
@@ -42,6 +45,7 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
     }
 
   private:
+    AnalyzerFrontEnd* const m_pFrontEnd;
     std::unique_ptr<GetKeyMode> m_pKeyMode;
     DownmixAndOverlapHelper m_helper;
     size_t m_currentFrame;
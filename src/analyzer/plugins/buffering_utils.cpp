@@ -3,6 +3,7 @@
 #include "util/math.h"
 #include "util/sample.h"
 
+#include <algorithm>
 #include <string.h>
 
 namespace mixxx {
@@ -21,7 +22,11 @@ bool DownmixAndOverlapHelper::initialize(size_t windowSize, size_t stepSize, Win
 
 bool DownmixAndOverlapHelper::processStereoSamples(const CSAMPLE* pInput, size_t inputStereoSamples) {
     const size_t numInputFrames = inputStereoSamples / 2;
-    return processInner(pInput, numInputFrames);
+    return processInner(pInput, nullptr, numInputFrames);
+}
+
+bool DownmixAndOverlapHelper::processMonoSamples(const double* pInput, size_t numInputFrames) {
+    return processInner(nullptr, pInput, numInputFrames);
 }
 
 bool DownmixAndOverlapHelper::finalize() {
@@ -32,11 +37,13 @@ bool DownmixAndOverlapHelper::finalize() {
     // instead of "m_windowSize / 2 - m_stepSize"
     size_t framesToFillWindow = m_windowSize - m_bufferWritePosition;
     size_t numInputFrames = math_max(framesToFillWindow, m_windowSize / 2 - 1);
-    return processInner(nullptr, numInputFrames);
+    return processInner(nullptr, nullptr, numInputFrames);
 }
 
 bool DownmixAndOverlapHelper::processInner(
-        const CSAMPLE* pInput, size_t numInputFrames) {
+        const CSAMPLE* pStereoInput,
+        const double* pMonoInput,
+        size_t numInputFrames) {
     size_t inRead = 0;
     double* pDownmix = m_buffer.data();
 
@@ -45,14 +52,18 @@ bool DownmixAndOverlapHelper::processInner(
         DEBUG_ASSERT(m_bufferWritePosition <= m_windowSize);
         size_t writeAvailable = m_windowSize - m_bufferWritePosition;
         size_t numFrames = math_min(readAvailable, writeAvailable);
-        if (pInput) {
+        if (pStereoInput) {
             for (size_t i = 0; i < numFrames; ++i) {
                 // We analyze a mono downmix of the signal since we don't think
                 // stereo does us any good.
-                pDownmix[m_bufferWritePosition + i] = (pInput[(inRead + i) * 2] +
-                                                              pInput[(inRead + i) * 2 + 1]) *
+                pDownmix[m_bufferWritePosition + i] = (pStereoInput[(inRead + i) * 2] +
+                                                              pStereoInput[(inRead + i) * 2 + 1]) *
                         0.5;
             }
+        } else if (pMonoInput) {
+            std::copy(pMonoInput + inRead,
+                    pMonoInput + inRead + numFrames,
+                    pDownmix + m_bufferWritePosition);
         } else {
             // we are in the finalize call. Add silence to
             // complete samples left in th buffer.
@@ -25,10 +25,19 @@ class DownmixAndOverlapHelper {
             const CSAMPLE* pInput,
             size_t inputStereoSamples);
 
+    // For input that has already been downmixed, e.g. by the
+    // AnalyzerFrontEnd
+    bool processMonoSamples(
+            const double* pInput,
+            size_t numInputFrames);
+
     bool finalize();
 
   private:
-    bool processInner(const CSAMPLE* pInput, size_t numInputFrames);
+    bool processInner(
+            const CSAMPLE* pStereoInput,
+            const double* pMonoInput,
+            size_t numInputFrames);
 
     std::vector<double> m_buffer;
     // The window size in frames.
@@ -36,8 +36,24 @@ TrackAnalysisScheduler::Pointer TrackAnalysisScheduler::createInstance(
         int numWorkerThreads,
         const UserSettingsPointer& pConfig,
         AnalyzerModeFlags modeFlags) {
+    return createInstance(
+            &library->trackCollection(),
+            library->dbConnectionPool(),
+            numWorkerThreads,
+            pConfig,
+            modeFlags);
+}
+
+//static
+TrackAnalysisScheduler::Pointer TrackAnalysisScheduler::createInstance(
+        TrackCollection* trackCollection,
+        mixxx::DbConnectionPoolPtr dbConnectionPool,
+        int numWorkerThreads,
+        const UserSettingsPointer& pConfig,
+        AnalyzerModeFlags modeFlags) {
     return Pointer(new TrackAnalysisScheduler(
-            library,
+            trackCollection,
+            std::move(dbConnectionPool),
             numWorkerThreads,
             pConfig,
             modeFlags),
@@ -45,11 +61,12 @@ TrackAnalysisScheduler::Pointer TrackAnalysisScheduler::createInstance(
 }
 
 TrackAnalysisScheduler::TrackAnalysisScheduler(
-        Library* library,
+        TrackCollection* trackCollection,
+        mixxx::DbConnectionPoolPtr dbConnectionPool,
         int numWorkerThreads,
         const UserSettingsPointer& pConfig,
         AnalyzerModeFlags modeFlags)
-        : m_library(library),
+        : m_trackCollection(trackCollection),
           m_currentTrackProgress(kAnalyzerProgressUnknown),
           m_currentTrackNumber(0),
           m_dequeuedTracksCount(0),
@@ -70,7 +87,7 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
     for (int threadId = 0; threadId < numWorkerThreads; ++threadId) {
         m_workers.emplace_back(AnalyzerThread::createInstance(
                 threadId,
-                library->dbConnectionPool(),
+                dbConnectionPool,
                 pConfig,
                 modeFlags));
         connect(m_workers.back().thread(), &AnalyzerThread::progress,
@@ -105,10 +122,10 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
     }
     m_lastProgressEmittedAt = now;
 
-    DEBUG_ASSERT(m_pendingTrackIds.size() <=
+    DEBUG_ASSERT(m_pendingTracks.size() <=
             static_cast<size_t>(m_dequeuedTracksCount));
     const int finishedTracksCount =
-            m_dequeuedTracksCount - m_pendingTrackIds.size();
+            m_dequeuedTracksCount - m_pendingTracks.size();
 
     AnalyzerProgress workerProgressSum = 0;
     int workerProgressCount = 0;
@@ -199,24 +216,28 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     case AnalyzerThreadState::Busy:
         DEBUG_ASSERT(trackId.isValid());
         // Ignore delayed signals for tracks that are no longer pending
-        if (m_pendingTrackIds.find(trackId) != m_pendingTrackIds.end()) {
+        if (m_pendingTracks.find(trackId) != m_pendingTracks.end()) {
             DEBUG_ASSERT(analyzerProgress != kAnalyzerProgressUnknown);
             DEBUG_ASSERT(analyzerProgress < kAnalyzerProgressDone);
             worker.onAnalyzerProgress(analyzerProgress);
             emit trackProgress(trackId, analyzerProgress);
         }
         break;
-    case AnalyzerThreadState::Done:
+    case AnalyzerThreadState::Done: {
         DEBUG_ASSERT(trackId.isValid());
         // Ignore delayed signals for tracks that are no longer pending
-        if (m_pendingTrackIds.find(trackId) != m_pendingTrackIds.end()) {
+        const auto pendingTrack = m_pendingTracks.find(trackId);
+        if (pendingTrack != m_pendingTracks.end()) {
             DEBUG_ASSERT((analyzerProgress == kAnalyzerProgressDone) // success
                     || (analyzerProgress == kAnalyzerProgressUnknown)); // failure
-            m_pendingTrackIds.erase(trackId);
+            const TrackPointer track = std::move(pendingTrack->second);
+            m_pendingTracks.erase(pendingTrack);
             worker.onAnalyzerProgress(analyzerProgress);
             emit trackProgress(trackId, analyzerProgress);
+            emit trackFinished(track, analyzerProgress);
         }
         break;
+    }
     case AnalyzerThreadState::Exit:
         DEBUG_ASSERT(!trackId.isValid());
         DEBUG_ASSERT(analyzerProgress == kAnalyzerProgressUnknown);
@@ -275,9 +296,9 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
         DEBUG_ASSERT(nextTrackId.isValid());
         if (nextTrackId.isValid()) {
             TrackPointer nextTrack =
-                    m_library->trackCollection().getTrackById(nextTrackId);
+                    m_trackCollection->getTrackById(nextTrackId);
             if (nextTrack) {
-                if (m_pendingTrackIds.insert(nextTrackId).second) {
+                if (m_pendingTracks.emplace(nextTrackId, nextTrack).second) {
                     if (worker->submitNextTrack(std::move(nextTrack))) {
                         m_queuedTrackIds.pop_front();
                         ++m_dequeuedTracksCount;
@@ -285,7 +306,7 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     } else {
                         // The worker may already have been assigned new tasks
                         // in the mean time, nothing to worry about.
-                        m_pendingTrackIds.erase(nextTrackId);
+                        m_pendingTracks.erase(nextTrackId);
                         kLogger.debug()
                                 << "Failed to submit next track - worker thread"
                                 << worker->thread()->id()
@@ -324,21 +345,31 @@ void TrackAnalysisScheduler::stop() {
     // The worker threads are still running at this point
     // and m_workers must not be modified!
     m_queuedTrackIds.clear();
-    m_pendingTrackIds.clear();
+    m_pendingTracks.clear();
     DEBUG_ASSERT((allTracksFinished()));
 }
 
 QList<TrackId> TrackAnalysisScheduler::stopAndCollectScheduledTrackIds() {
     QList<TrackId> scheduledTrackIds;
-    scheduledTrackIds.reserve(m_queuedTrackIds.size() + m_pendingTrackIds.size());
+    scheduledTrackIds.reserve(m_queuedTrackIds.size() + m_pendingTracks.size());
     for (auto queuedTrackId: m_queuedTrackIds) {
         scheduledTrackIds.append(std::move(queuedTrackId));
     }
-    for (auto pendingTrackId: m_pendingTrackIds) {
-        scheduledTrackIds.append(std::move(pendingTrackId));
+    for (const auto& pendingTrack: m_pendingTracks) {
+        scheduledTrackIds.append(pendingTrack.first);
     }
     // Stopping the scheduler will clear all queued and pending tracks,
     // so we need to do this after we have collected all scheduled tracks!
     stop();
     return scheduledTrackIds;
 }
+
+AnalyzerStatistics TrackAnalysisScheduler::statistics() const {
+    AnalyzerStatistics statistics;
+    for (const auto& worker: m_workers) {
+        if (worker) {
+            statistics.add(worker.thread()->statistics());
+        }
+    }
+    return statistics;
+}
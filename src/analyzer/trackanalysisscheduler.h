@@ -3,9 +3,10 @@
 #include <QList>
 
 #include <deque>
-#include <set>
+#include <map>
 #include <vector>
 
+#include "analyzer/analyzerstatistics.h"
 #include "analyzer/analyzerthread.h"
 
 #include "util/memory.h"
@@ -13,6 +14,7 @@
 
 // forward declaration(s)
 class Library;
+class TrackCollection;
 
 class TrackAnalysisScheduler : public QObject {
     Q_OBJECT
@@ -30,9 +32,17 @@ class TrackAnalysisScheduler : public QObject {
             int numWorkerThreads,
             const UserSettingsPointer& pConfig,
             AnalyzerModeFlags modeFlags);
+    // Without a library, e.g. for batch analysis from the command line
+    static Pointer createInstance(
+            TrackCollection* trackCollection,
+            mixxx::DbConnectionPoolPtr dbConnectionPool,
+            int numWorkerThreads,
+            const UserSettingsPointer& pConfig,
+            AnalyzerModeFlags modeFlags);
 
     /*private*/ TrackAnalysisScheduler(
-            Library* library,
+            TrackCollection* trackCollection,
+            mixxx::DbConnectionPoolPtr dbConnectionPool,
             int numWorkerThreads,
             const UserSettingsPointer& pConfig,
             AnalyzerModeFlags modeFlags);
@@ -51,6 +61,9 @@ class TrackAnalysisScheduler : public QObject {
     // https://bugs.launchpad.net/mixxx/+bug/1443181
     QList<TrackId> stopAndCollectScheduledTrackIds();
 
+    // The accumulated throughput of all worker threads
+    AnalyzerStatistics statistics() const;
+
   public slots:
     void suspend();
 
@@ -64,6 +77,10 @@ class TrackAnalysisScheduler : public QObject {
   signals:
     // Progress for individual tracks is passed-through from the workers
     void trackProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
+    // Emitted after trackProgress() when a track is done. The scheduler
+    // releases its reference afterwards, receivers may keep the track
+    // to save multiple tracks at once.
+    void trackFinished(TrackPointer track, AnalyzerProgress analyzerProgress);
     // Current average progress for all scheduled tracks and from all workers
     void progress(AnalyzerProgress currentTrackProgress, int currentTrackNumber, int totalTracksCount);
     void finished();
@@ -143,18 +160,20 @@ class TrackAnalysisScheduler : public QObject {
 
     bool allTracksFinished() const {
         return m_queuedTrackIds.empty() &&
-                m_pendingTrackIds.empty();
+                m_pendingTracks.empty();
     }
 
-    Library* m_library;
+    TrackCollection* m_trackCollection;
 
     std::vector<Worker> m_workers;
 
     std::deque<TrackId> m_queuedTrackIds;
 
     // Tracks that have already been submitted to workers
-    // and not yet reported back as finished.
-    std::set<TrackId> m_pendingTrackIds;
+    // and not yet reported back as finished. The references
+    // are kept until then to ensure that the tracks are not
+    // released by the worker threads, see AnalyzerThread.
+    std::map<TrackId, TrackPointer> m_pendingTracks;
 
     AnalyzerProgress m_currentTrackProgress;
 
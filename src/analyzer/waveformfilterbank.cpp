@@ -0,0 +1,154 @@
+#include "analyzer/waveformfilterbank.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fidlib.h>
+
+namespace {
+
+// The corner frequencies of the waveform bands in Hz
+constexpr double kLowMidCorner = 600;
+constexpr double kMidHighCorner = 4000;
+
+// The numerators of the low and high pass sections, the band pass is a
+// high pass followed by a low pass, see EngineFilterIIR::processSample()
+constexpr double kLowPassB1 = 2.0;
+constexpr double kHighPassB1 = -2.0;
+
+} // anonymous namespace
+
+WaveformFilterBank::WaveformFilterBank() {
+    memset(m_sections, 0, sizeof(m_sections));
+    memset(m_bandPassSections, 0, sizeof(m_bandPassSections));
+}
+
+// static
+template<int LANES>
+void WaveformFilterBank::setSection(Section<LANES>* pSection, int lane,
+        double gain, double a1, double a2, double b1, double b2) {
+    pSection->gain[lane] = gain;
+    pSection->a1[lane] = a1;
+    pSection->a2[lane] = a2;
+    pSection->b1[lane] = b1;
+    pSection->b2[lane] = b2;
+    pSection->z1[lane] = 0.0;
+    pSection->z2[lane] = 0.0;
+}
+
+void WaveformFilterBank::initialize(int sampleRate) {
+    // The same designs as EngineFilterBessel4Low/Band/High, the overall
+    // gain is in front of the coefficients of the sections
+    double lowCoef[4 + 1];
+    lowCoef[0] = fid_design_coef(lowCoef + 1, 4,
+            "LpBe4", sampleRate, kLowMidCorner, 0, 0);
+    double midCoef[8 + 1];
+    midCoef[0] = fid_design_coef(midCoef + 1, 8,
+            "BpBe4", sampleRate, kLowMidCorner, kMidHighCorner, 0);
+    double highCoef[4 + 1];
+    highCoef[0] = fid_design_coef(highCoef + 1, 4,
+            "HpBe4", sampleRate, kMidHighCorner, 0, 0);
+
+    for (int channel = 0; channel < ChannelCount; ++channel) {
+        const auto channelIndex = static_cast<ChannelIndex>(channel);
+        for (int i = 0; i < 2; ++i) {
+            // The overall gain is applied by the first section
+            setSection(&m_sections[i], lane(Low, channelIndex),
+                    i == 0 ? lowCoef[0] : 1.0,
+                    lowCoef[1 + 2 * i], lowCoef[2 + 2 * i],
+                    kLowPassB1, 1.0);
+            setSection(&m_sections[i], lane(Mid, channelIndex),
+                    i == 0 ? midCoef[0] : 1.0,
+                    midCoef[1 + 2 * i], midCoef[2 + 2 * i],
+                    kHighPassB1, 1.0);
+            setSection(&m_sections[i], lane(High, channelIndex),
+                    i == 0 ? highCoef[0] : 1.0,
+                    highCoef[1 + 2 * i], highCoef[2 + 2 * i],
+                    kHighPassB1, 1.0);
+            setSection(&m_sections[i], overallLane(channelIndex),
+                    1.0, 0.0, 0.0, 0.0, 0.0);
+            setSection(&m_bandPassSections[i], channel,
+                    1.0, midCoef[5 + 2 * i], midCoef[6 + 2 * i],
+                    kLowPassB1, 1.0);
+        }
+    }
+}
+
+void WaveformFilterBank::process(
+        const CSAMPLE* pIn, int frameCount, float pMaxima[kLanes]) {
+    constexpr int kBandPassOffset = 2 * Mid;
+    const Section<kLanes>& s0 = m_sections[0];
+    const Section<kLanes>& s1 = m_sections[1];
+    const Section<kBandPassLanes>& bp0 = m_bandPassSections[0];
+    const Section<kBandPassLanes>& bp1 = m_bandPassSections[1];
+
+    // Working on local copies of the state allows the compiler to keep
+    // it in registers
+    alignas(32) double z1[2][kLanes];
+    alignas(32) double z2[2][kLanes];
+    alignas(32) double bandPassZ1[2][kBandPassLanes];
+    alignas(32) double bandPassZ2[2][kBandPassLanes];
+    for (int i = 0; i < 2; ++i) {
+        memcpy(z1[i], m_sections[i].z1, sizeof(z1[i]));
+        memcpy(z2[i], m_sections[i].z2, sizeof(z2[i]));
+        memcpy(bandPassZ1[i], m_bandPassSections[i].z1, sizeof(bandPassZ1[i]));
+        memcpy(bandPassZ2[i], m_bandPassSections[i].z2, sizeof(bandPassZ2[i]));
+    }
+    alignas(32) float maxima[kLanes];
+    memcpy(maxima, pMaxima, sizeof(maxima));
+
+    for (int frame = 0; frame < frameCount; ++frame) {
+        alignas(32) double values[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane) {
+            values[lane] = pIn[2 * frame + (lane & 1)];
+        }
+        // note: LOOP VECTORIZED.
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const double w0 = s0.gain[lane] * values[lane] -
+                    s0.a1[lane] * z2[0][lane] - s0.a2[lane] * z1[0][lane];
+            const double y0 = s0.b2[lane] * z2[0][lane] +
+                    s0.b1[lane] * z1[0][lane] + w0;
+            z2[0][lane] = z1[0][lane];
+            z1[0][lane] = w0;
+            const double w1 = s1.gain[lane] * y0 -
+                    s1.a1[lane] * z2[1][lane] - s1.a2[lane] * z1[1][lane];
+            values[lane] = s1.b2[lane] * z2[1][lane] +
+                    s1.b1[lane] * z1[1][lane] + w1;
+            z2[1][lane] = z1[1][lane];
+            z1[1][lane] = w1;
+        }
+        // note: LOOP VECTORIZED.
+        for (int lane = 0; lane < kBandPassLanes; ++lane) {
+            const double x = values[kBandPassOffset + lane];
+            const double w0 = bp0.gain[lane] * x -
+                    bp0.a1[lane] * bandPassZ2[0][lane] -
+                    bp0.a2[lane] * bandPassZ1[0][lane];
+            const double y0 = bp0.b2[lane] * bandPassZ2[0][lane] +
+                    bp0.b1[lane] * bandPassZ1[0][lane] + w0;
+            bandPassZ2[0][lane] = bandPassZ1[0][lane];
+            bandPassZ1[0][lane] = w0;
+            const double w1 = bp1.gain[lane] * y0 -
+                    bp1.a1[lane] * bandPassZ2[1][lane] -
+                    bp1.a2[lane] * bandPassZ1[1][lane];
+            values[kBandPassOffset + lane] = bp1.b2[lane] * bandPassZ2[1][lane] +
+                    bp1.b1[lane] * bandPassZ1[1][lane] + w1;
+            bandPassZ2[1][lane] = bandPassZ1[1][lane];
+            bandPassZ1[1][lane] = w1;
+        }
+        // Take the max value of the samples, rounded to CSAMPLE like the
+        // output of the EngineFilterIIR filters
+        // note: LOOP VECTORIZED.
+        for (int lane = 0; lane < kLanes; ++lane) {
+            const float magnitude = std::fabs(static_cast<float>(values[lane]));
+            maxima[lane] = magnitude > maxima[lane] ? magnitude : maxima[lane];
+        }
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        memcpy(m_sections[i].z1, z1[i], sizeof(z1[i]));
+        memcpy(m_sections[i].z2, z2[i], sizeof(z2[i]));
+        memcpy(m_bandPassSections[i].z1, bandPassZ1[i], sizeof(bandPassZ1[i]));
+        memcpy(m_bandPassSections[i].z2, bandPassZ2[i], sizeof(bandPassZ2[i]));
+    }
+    memcpy(pMaxima, maxima, sizeof(maxima));
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "util/types.h"
+#include "waveform/waveform.h"
+
+// The low, band and high pass filters of the waveform analysis, evaluated
+// for both channels at once.
+//
+// The Bessel filters of EngineFilterBessel4Low/Band/High are cascades of
+// second order sections with the same structure: Two sections for the
+// low and high pass and four for the band pass. Every combination of
+// filter and channel is a lane of a small vector and the first two
+// sections are evaluated for all lanes in one loop. The unfiltered signal
+// is passed through the remaining two lanes. The last two sections of the
+// band pass only run for its own lanes. The compiler vectorizes these
+// loops, and the filtered samples are reduced to the maxima of a stride
+// without storing them.
+class WaveformFilterBank {
+  public:
+    // The lanes of process(), the channels are interleaved
+    static constexpr int kLanes = 2 * (FilterCount + 1);
+
+    static constexpr int lane(FilterIndex filter, ChannelIndex channel) {
+        return 2 * filter + channel;
+    }
+    static constexpr int overallLane(ChannelIndex channel) {
+        return 2 * FilterCount + channel;
+    }
+
+    WaveformFilterBank();
+
+    // Designs the filters for the sample rate and clears their state,
+    // like freshly settled EngineFilterBessel4 filters
+    void initialize(int sampleRate);
+
+    // Filters frameCount interleaved stereo frames and raises pMaxima
+    // to the absolute values of all lanes, if greater.
+    void process(const CSAMPLE* pIn, int frameCount, float pMaxima[kLanes]);
+
+  private:
+    static constexpr int kBandPassLanes = ChannelCount;
+
+    // The coefficients of a second order section in the form of
+    // EngineFilterIIR::processSample()
+    //   w = gain * x - a1 * z2 - a2 * z1
+    //   y = b2 * z2 + b1 * z1 + w
+    // with z1 and z2 the previous and second previous w.
+    template<int LANES>
+    struct Section {
+        alignas(32) double gain[LANES];
+        alignas(32) double a1[LANES];
+        alignas(32) double a2[LANES];
+        alignas(32) double b1[LANES];
+        alignas(32) double b2[LANES];
+        alignas(32) double z1[LANES];
+        alignas(32) double z2[LANES];
+    };
+
+    template<int LANES>
+    static void setSection(Section<LANES>* pSection, int lane,
+            double gain, double a1, double a2, double b1, double b2);
+
+    // The first two sections of all lanes
+    Section<kLanes> m_sections[2];
+    // The last two sections of the band pass
+    Section<kBandPassLanes> m_bandPassSections[2];
+};
@@ -10,6 +10,7 @@
 
 #include "controllers/controller.h"
 #include "controllers/controllerdebug.h"
+#include "controllers/controllerinputreader.h"
 #include "controllers/defs_controllers.h"
 #include "util/screensaver.h"
 
@@ -107,8 +108,34 @@ void Controller::triggerActivity()
         m_userActivityInhibitTimer.start();
     }
 }
+
+namespace {
+
+void debugPacket(const QString& deviceName,
+        const QByteArray& data,
+        mixxx::Duration timestamp) {
+    // Formatted packet display
+    const int length = data.size();
+    QString message = QString("%1: t:%2, %3 bytes:\n")
+            .arg(deviceName).arg(timestamp.formatMillisWithUnit()).arg(length);
+    for(int i=0; i<length; i++) {
+        QString spacer=" ";
+        if ((i+1) % 4 == 0) spacer="  ";
+        if ((i+1) % 16 == 0) spacer="\n";
+        message += QString("%1%2")
+                    .arg((unsigned char)(data.at(i)), 2, 16, QChar('0')).toUpper()
+                    .arg(spacer);
+    }
+    controllerDebug(message);
+}
+
+} // anonymous namespace
+
 void Controller::receive(const QByteArray data, mixxx::Duration timestamp) {
+    receiveBatch(QVector<ControllerInputReport>{ControllerInputReport{data, timestamp}});
+}
 
+void Controller::receiveBatch(const QVector<ControllerInputReport>& reports) {
     if (m_pEngine == NULL) {
         //qWarning() << "Controller::receive called with no active engine!";
         // Don't complain, since this will always show after closing a device as
@@ -117,30 +144,11 @@ void Controller::receive(const QByteArray data, mixxx::Duration timestamp) {
     }
     triggerActivity();
 
-    int length = data.size();
     if (ControllerDebug::enabled()) {
-        // Formatted packet display
-        QString message = QString("%1: t:%2, %3 bytes:\n")
-                .arg(m_sDeviceName).arg(timestamp.formatMillisWithUnit()).arg(length);
-        for(int i=0; i<length; i++) {
-            QString spacer=" ";
-            if ((i+1) % 4 == 0) spacer="  ";
-            if ((i+1) % 16 == 0) spacer="\n";
-            message += QString("%1%2")
-                        .arg((unsigned char)(data.at(i)), 2, 16, QChar('0')).toUpper()
-                        .arg(spacer);
+        for (const auto& report : reports) {
+            debugPacket(m_sDeviceName, report.data, report.timestamp);
         }
-        controllerDebug(message);
     }
 
-    foreach (QString function, m_pEngine->getScriptFunctionPrefixes()) {
-        if (function == "") {
-            continue;
-        }
-        function.append(".incomingData");
-        QScriptValue incomingData = m_pEngine->wrapFunctionCode(function, 2);
-        if (!m_pEngine->execute(incomingData, data, timestamp)) {
-            qWarning() << "Controller: Invalid script function" << function;
-        }
-    }
+    m_pEngine->receiveIncomingData(reports);
 }
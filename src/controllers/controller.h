@@ -96,6 +96,10 @@ class Controller : public QObject, ConstControllerPresetVisitor {
     void stopLearning();
 
   protected:
+    // Handles a burst of packets like receive() but passes them to the
+    // scripts at once, see ControllerEngine::receiveIncomingData().
+    void receiveBatch(const QVector<ControllerInputReport>& reports);
+
     // The length parameter is here for backwards compatibility for when scripts
     // were required to specify it.
     Q_INVOKABLE void send(QList<int> data, unsigned int length = 0);
@@ -10,6 +10,7 @@
 #include "controllers/controllerengine.h"
 #include "controllers/controller.h"
 #include "controllers/controllerdebug.h"
+#include "controllers/controllerinputreader.h"
 #include "control/controlobject.h"
 #include "control/controlobjectscript.h"
 #include "errordialoghandler.h"
@@ -22,6 +23,8 @@
 // (closure compatible version of connectControl)
 #include <QUuid>
 
+#include <QRegularExpression>
+
 const int kDecks = 16;
 
 // Use 1ms for the Alpha-Beta dt. We're assuming the OS actually gives us a 1ms
@@ -29,13 +32,45 @@ const int kDecks = 16;
 const int kScratchTimerMs = 1;
 const double kAlphaBetaDt = kScratchTimerMs / 1000.0;
 
+// Matches a reference to a function like "MyController.deck1.wheelTurn"
+const QRegularExpression kFunctionReferenceRegex(
+        "^[A-Za-z_$][\\w$]*(\\.[A-Za-z_$][\\w$]*)*$");
+
+// Handler generations are unique across all engines, so handlers of
+// a deleted engine are never mistaken for handlers of a new engine.
+// All engines live in the controller thread.
+static int s_lastHandlerGeneration = 0;
+
+QScriptValue ControllerScriptHandler::thisObject() const {
+    QScriptValue thisObject;
+    resolve(&thisObject);
+    return thisObject;
+}
+
+QScriptValue ControllerScriptHandler::resolve(QScriptValue* pThisObject) const {
+    *pThisObject = m_globalObject;
+    if (!m_functionName.isValid()) {
+        return m_wrappedFunction;
+    }
+    for (const QScriptString& name : m_path) {
+        *pThisObject = pThisObject->property(name);
+        if (!pThisObject->isObject()) {
+            return QScriptValue();
+        }
+    }
+    return pThisObject->property(m_functionName);
+}
+
 ControllerEngine::ControllerEngine(
         Controller* controller, UserSettingsPointer pConfig)
         : m_pEngine(nullptr),
           m_pController(controller),
           m_pConfig(pConfig),
           m_bPopups(true),
-          m_pBaClass(nullptr) {
+          m_pBaClass(nullptr),
+          m_incomingDataHandlersResolved(false),
+          m_handlerGeneration(++s_lastHandlerGeneration),
+          m_executionDepth(0) {
     // Handle error dialog buttons
     qRegisterMetaType<QMessageBox::StandardButton>("QMessageBox::StandardButton");
 
@@ -137,6 +172,94 @@ QScriptValue ControllerEngine::wrapFunctionCode(const QString& codeSnippet,
     return wrappedFunction;
 }
 
+ControllerScriptHandler ControllerEngine::resolveHandler(
+        const QString& codeSnippet, int numberOfArgs) {
+    if (m_pEngine == nullptr) {
+        return ControllerScriptHandler();
+    }
+
+    auto it = m_scriptHandlerCache.constFind(codeSnippet);
+    if (it != m_scriptHandlerCache.constEnd()) {
+        return it.value();
+    }
+
+    ControllerScriptHandler handler;
+    handler.m_globalObject = m_pEngine->globalObject();
+    const QString reference = codeSnippet.trimmed();
+    if (kFunctionReferenceRegex.match(reference).hasMatch()) {
+        // Only the names are cached, the objects may be replaced or
+        // not exist yet.
+        QStringList path = reference.split('.');
+        handler.m_functionName = m_pEngine->toStringHandle(path.takeLast());
+        handler.m_path.reserve(path.size());
+        for (const QString& name : path) {
+            handler.m_path.append(m_pEngine->toStringHandle(name));
+        }
+    } else {
+        // Evaluating the snippet may have side effects or depend on
+        // state that changes between calls.
+        handler.m_wrappedFunction = wrapFunctionCode(codeSnippet, numberOfArgs);
+    }
+    m_scriptHandlerCache.insert(codeSnippet, handler);
+    return handler;
+}
+
+void ControllerEngine::clearHandlerCache() {
+    m_handlerGeneration = ++s_lastHandlerGeneration;
+    m_scriptWrappedFunctionCache.clear();
+    m_scriptHandlerCache.clear();
+    m_incomingDataHandlers.clear();
+    m_incomingDataHandlersResolved = false;
+}
+
+void ControllerEngine::receiveIncomingData(
+        const QVector<ControllerInputReport>& reports) {
+    if (m_pEngine == nullptr || reports.isEmpty()) {
+        return;
+    }
+
+    if (!m_incomingDataHandlersResolved) {
+        for (const QString& prefix : m_scriptFunctionPrefixes) {
+            if (prefix.isEmpty()) {
+                continue;
+            }
+            IncomingDataHandler handler;
+            handler.prefix = prefix;
+            handler.single = resolveHandler(prefix + ".incomingData", 2);
+            handler.batch = resolveHandler(prefix + ".incomingDataBatch", 1);
+            m_incomingDataHandlers.append(handler);
+        }
+        m_incomingDataHandlersResolved = true;
+    }
+
+    beginExecution();
+    for (const auto& handler : m_incomingDataHandlers) {
+        if (handler.batch.function().isFunction()) {
+            QScriptValue batch = m_pEngine->newArray(reports.size());
+            for (int i = 0; i < reports.size(); ++i) {
+                QScriptValue report = m_pEngine->newObject();
+                report.setProperty("data", m_pBaClass->newInstance(reports[i].data));
+                report.setProperty("length", reports[i].data.size());
+                report.setProperty("timestamp", reports[i].timestamp.toDoubleMillis());
+                batch.setProperty(i, report);
+            }
+            if (!internalExecute(handler.batch, QScriptValueList{batch})) {
+                qWarning() << "ControllerEngine: Invalid script function"
+                           << handler.prefix + ".incomingDataBatch";
+            }
+            continue;
+        }
+        for (const auto& report : reports) {
+            if (!execute(handler.single, report.data, report.timestamp)) {
+                qWarning() << "ControllerEngine: Invalid script function"
+                           << handler.prefix + ".incomingData";
+                break;
+            }
+        }
+    }
+    endExecution();
+}
+
 QScriptValue ControllerEngine::getThisObjectInFunctionCall() {
     VERIFY_OR_DEBUG_ASSERT(m_pEngine != nullptr) {
         return QScriptValue();
@@ -186,7 +309,9 @@ void ControllerEngine::gracefulShutdown() {
     }
 
     qDebug() << "Clearing function wrapper cache";
-    m_scriptWrappedFunctionCache.clear();
+    clearHandlerCache();
+    m_coalescedValues.clear();
+    m_coalescedValueIndices.clear();
 
     // Free all the ControlObjectScripts
     {
@@ -309,6 +434,8 @@ void ControllerEngine::scriptHasChanged(const QString& scriptFilename) {
    Output:  -
    -------- ------------------------------------------------------ */
 void ControllerEngine::initializeScripts(const QList<ControllerPreset::ScriptFileInfo>& scripts) {
+    // The init functions may replace the objects handlers belong to
+    clearHandlerCache();
 
     m_scriptFunctionPrefixes.clear();
     for (const ControllerPreset::ScriptFileInfo& script : scripts) {
@@ -456,7 +583,9 @@ bool ControllerEngine::internalExecute(QScriptValue thisObject,
     }
 
     // If it does happen to be a function, call it.
+    beginExecution();
     QScriptValue rc = functionObject.call(thisObject, args);
+    endExecution();
     if (!rc.isValid()) {
         qDebug() << "QScriptValue is not a function or ...";
         return false;
@@ -498,6 +627,61 @@ bool ControllerEngine::execute(QScriptValue function,
     return internalExecute(m_pEngine->globalObject(), function, args);
 }
 
+bool ControllerEngine::execute(const ControllerScriptHandler& handler,
+        unsigned char channel,
+        unsigned char control,
+        unsigned char value,
+        unsigned char status,
+        const QString& group,
+        mixxx::Duration timestamp) {
+    Q_UNUSED(timestamp);
+    if (m_pEngine == nullptr) {
+        return false;
+    }
+    QScriptValueList args;
+    args << QScriptValue(channel);
+    args << QScriptValue(control);
+    args << QScriptValue(value);
+    args << QScriptValue(status);
+    args << QScriptValue(group);
+    return internalExecute(handler, args);
+}
+
+bool ControllerEngine::execute(const ControllerScriptHandler& handler,
+        const QByteArray data,
+        mixxx::Duration timestamp) {
+    Q_UNUSED(timestamp);
+    if (m_pEngine == nullptr) {
+        return false;
+    }
+    QScriptValueList args;
+    args << m_pBaClass->newInstance(data);
+    args << QScriptValue(data.size());
+    return internalExecute(handler, args);
+}
+
+bool ControllerEngine::internalExecute(const ControllerScriptHandler& handler,
+        QScriptValueList args) {
+    QScriptValue thisObject;
+    QScriptValue function = handler.resolve(&thisObject);
+    return internalExecute(thisObject, function, args);
+}
+
+void ControllerEngine::endExecution() {
+    DEBUG_ASSERT(m_executionDepth > 0);
+    if (--m_executionDepth > 0 || m_coalescedValues.isEmpty()) {
+        return;
+    }
+    // Setting a control may trigger connected script callbacks that
+    // coalesce values again, so take the pending values first.
+    QVector<QPair<ControlObjectScript*, double>> values;
+    values.swap(m_coalescedValues);
+    m_coalescedValueIndices.clear();
+    for (const auto& value : values) {
+        setControlValue(value.first, value.second);
+    }
+}
+
 /* -------- ------------------------------------------------------
    Purpose: Check to see if a script threw an exception
    Input:   QScriptValue returned from call(scriptFunctionName)
@@ -676,10 +860,41 @@ void ControllerEngine::setValue(QString group, QString name, double newValue) {
     ControlObjectScript* coScript = getControlObjectScript(group, name);
 
     if (coScript != nullptr) {
-        ControlObject* pControl = ControlObject::getControl(coScript->getKey());
-        if (pControl && !m_st.ignore(pControl, coScript->getParameterForValue(newValue))) {
-            coScript->slotSet(newValue);
-        }
+        setControlValue(coScript, newValue);
+    }
+}
+
+void ControllerEngine::setValueCoalesced(QString group, QString name, double newValue) {
+    if (isnan(newValue)) {
+        qWarning() << "ControllerEngine: script setting [" << group << "," << name
+                 << "] to NotANumber, ignoring.";
+        return;
+    }
+
+    ControlObjectScript* coScript = getControlObjectScript(group, name);
+    if (coScript == nullptr) {
+        return;
+    }
+
+    if (m_executionDepth == 0) {
+        // Not called from a handler, e.g. from a connection callback
+        setControlValue(coScript, newValue);
+        return;
+    }
+
+    const auto it = m_coalescedValueIndices.constFind(coScript);
+    if (it != m_coalescedValueIndices.constEnd()) {
+        m_coalescedValues[it.value()].second = newValue;
+        return;
+    }
+    m_coalescedValueIndices.insert(coScript, m_coalescedValues.size());
+    m_coalescedValues.append(qMakePair(coScript, newValue));
+}
+
+void ControllerEngine::setControlValue(ControlObjectScript* coScript, double newValue) {
+    ControlObject* pControl = ControlObject::getControl(coScript->getKey());
+    if (pControl && !m_st.ignore(pControl, coScript->getParameterForValue(newValue))) {
+        coScript->slotSet(newValue);
     }
 }
 
@@ -25,6 +25,40 @@
 class Controller;
 class ControlObjectScript;
 class ControllerEngine;
+struct ControllerInputReport;
+
+// ControllerScriptHandler is a script function referenced by a mapping,
+// e.g. "MyController.deck1.wheelTurn", that has been parsed into the
+// names of the objects on its path and the name of the function. Calling
+// it doesn't need to evaluate the reference again, but the objects and
+// the function are still looked up for each call, so scripts may replace
+// any of them. Snippets that are not a plain reference are wrapped in an
+// anonymous function instead.
+class ControllerScriptHandler {
+  public:
+    ControllerScriptHandler() = default;
+
+    // The function that would be called now, if any.
+    QScriptValue function() const {
+        QScriptValue thisObject;
+        return resolve(&thisObject);
+    }
+    QScriptValue thisObject() const;
+
+    // Looks up both the object and the function with a single walk
+    // along the path.
+    QScriptValue resolve(QScriptValue* pThisObject) const;
+
+  private:
+    QScriptValue m_globalObject;
+    // The objects between the global object and the function
+    QVector<QScriptString> m_path;
+    QScriptString m_functionName;
+    // Only if the function isn't looked up by name
+    QScriptValue m_wrappedFunction;
+
+    friend class ControllerEngine;
+};
 
 // ScriptConnection represents a connection between
 // a ControlObject and a script callback function that gets executed when
@@ -95,6 +129,21 @@ class ControllerEngine : public QObject {
     QScriptValue wrapFunctionCode(const QString& codeSnippet, int numberOfArgs);
     QScriptValue getThisObjectInFunctionCall();
 
+    // Resolve a snippet of JS code from a mapping once into a handler
+    // that can be executed for every message
+    ControllerScriptHandler resolveHandler(const QString& codeSnippet, int numberOfArgs);
+
+    // Changes whenever previously resolved handlers become invalid,
+    // i.e. when the scripts are (re-)loaded or the engine is shut down.
+    int getHandlerGeneration() const {
+        return m_handlerGeneration;
+    }
+
+    // Pass data received from the device to the incomingData function of
+    // all scripts. Scripts that define an incomingDataBatch function get
+    // all reports in a single call instead.
+    void receiveIncomingData(const QVector<ControllerInputReport>& reports);
+
     // Look up registered script function prefixes
     const QList<QString>& getScriptFunctionPrefixes() { return m_scriptFunctionPrefixes; };
 
@@ -105,6 +154,10 @@ class ControllerEngine : public QObject {
   protected:
     Q_INVOKABLE double getValue(QString group, QString name);
     Q_INVOKABLE void setValue(QString group, QString name, double newValue);
+    // Like setValue, but if the same control is set multiple times while
+    // handling incoming data or a timer only the last value is applied
+    // after the script function has returned.
+    Q_INVOKABLE void setValueCoalesced(QString group, QString name, double newValue);
     Q_INVOKABLE double getParameter(QString group, QString name);
     Q_INVOKABLE void setParameter(QString group, QString name, double newValue);
     Q_INVOKABLE double getParameterForValue(QString group, QString name, double value);
@@ -153,6 +206,17 @@ class ControllerEngine : public QObject {
     bool execute(QScriptValue function, const QByteArray data,
                  mixxx::Duration timestamp);
 
+    // Same as above, for handlers from resolveHandler()
+    bool execute(const ControllerScriptHandler& handler,
+                 unsigned char channel,
+                 unsigned char control,
+                 unsigned char value,
+                 unsigned char status,
+                 const QString& group,
+                 mixxx::Duration timestamp);
+    bool execute(const ControllerScriptHandler& handler, const QByteArray data,
+                 mixxx::Duration timestamp);
+
     // Evaluates all provided script files and returns true if no script errors
     // occurred while evaluating them.
     bool loadScriptFiles(const QList<ControllerPreset::ScriptFileInfo>& scripts);
@@ -172,6 +236,9 @@ class ControllerEngine : public QObject {
     bool internalExecute(QScriptValue thisObject, const QString& scriptCode);
     bool internalExecute(QScriptValue thisObject, QScriptValue functionObject,
                          QScriptValueList arguments);
+    bool internalExecute(const ControllerScriptHandler& handler,
+                         QScriptValueList arguments);
+    void clearHandlerCache();
     void initializeScriptEngine();
     void uninitializeScriptEngine();
 
@@ -185,6 +252,14 @@ class ControllerEngine : public QObject {
     QScriptEngine *m_pEngine;
 
     ControlObjectScript* getControlObjectScript(const QString& group, const QString& name);
+    void setControlValue(ControlObjectScript* coScript, double newValue);
+
+    // Values from setValueCoalesced are applied when the outermost
+    // script execution ends.
+    void beginExecution() {
+        ++m_executionDepth;
+    }
+    void endExecution();
 
     // Scratching functions & variables
     void scratchProcess(int timerId);
@@ -215,6 +290,20 @@ class ControllerEngine : public QObject {
     QVarLengthArray<AlphaBetaFilter*> m_scratchFilters;
     QHash<int, int> m_scratchTimers;
     QHash<QString, QScriptValue> m_scriptWrappedFunctionCache;
+    QHash<QString, ControllerScriptHandler> m_scriptHandlerCache;
+    struct IncomingDataHandler {
+        QString prefix;
+        ControllerScriptHandler single;
+        ControllerScriptHandler batch;
+    };
+    QVector<IncomingDataHandler> m_incomingDataHandlers;
+    bool m_incomingDataHandlersResolved;
+    int m_handlerGeneration;
+    int m_executionDepth;
+    // In the order the controls have been set first
+    QVector<QPair<ControlObjectScript*, double>> m_coalescedValues;
+    // The index of each control in m_coalescedValues
+    QHash<ControlObjectScript*, int> m_coalescedValueIndices;
     // Filesystem watcher for script auto-reload
     QFileSystemWatcher m_scriptWatcher;
     QList<ControllerPreset::ScriptFileInfo> m_lastScriptFiles;
@@ -0,0 +1,81 @@
+#include "controllers/controllerinputreader.h"
+
+#include "util/compatibility.h"
+#include "util/logger.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ControllerInputReader");
+
+// Blocking reads are interrupted periodically to check if the reader
+// has been stopped. This only affects the time needed to close the
+// device, not the latency of input reports.
+const int kReadTimeoutMillis = 50;
+
+// Input reports of all supported HID and bulk controllers fit
+const int kMaxReportLength = 255;
+
+} // anonymous namespace
+
+ControllerInputReader::ControllerInputReader(const QString& name)
+        : m_stop(0) {
+    setObjectName(name);
+}
+
+ControllerInputReader::~ControllerInputReader() {
+    stop();
+}
+
+void ControllerInputReader::start(QThread::Priority priority) {
+    // Reset before starting the thread, a stop() that arrives before
+    // the thread is running must not be lost
+    m_stop = 0;
+    QThread::start(priority);
+}
+
+void ControllerInputReader::stop() {
+    m_stop = 1;
+    wait();
+}
+
+QVector<ControllerInputReport> ControllerInputReader::takeReports() {
+    QMutexLocker locker(&m_reportsMutex);
+    QVector<ControllerInputReport> reports;
+    reports.swap(m_reports);
+    return reports;
+}
+
+void ControllerInputReader::run() {
+    unsigned char data[kMaxReportLength];
+
+    while (atomicLoadAcquire(m_stop) == 0) {
+        const int result = readReport(data, kMaxReportLength, kReadTimeoutMillis);
+        if (result < 0) {
+            kLogger.warning()
+                    << "Stopped reading from"
+                    << objectName()
+                    << "after an error";
+            break;
+        }
+        if (result == 0) {
+            continue;
+        }
+        Trace process("ControllerInputReader queue report");
+        ControllerInputReport report{
+                QByteArray(reinterpret_cast<char*>(data), result),
+                mixxx::Time::elapsed()};
+        bool notify;
+        {
+            QMutexLocker locker(&m_reportsMutex);
+            notify = m_reports.isEmpty();
+            m_reports.append(std::move(report));
+        }
+        // Reports that arrive before the controller thread has taken
+        // the previous ones are added to the pending batch.
+        if (notify) {
+            emit reportsAvailable();
+        }
+    }
+}
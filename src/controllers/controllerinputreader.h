@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+
+#include "util/duration.h"
+
+struct ControllerInputReport {
+    QByteArray data;
+    mixxx::Duration timestamp;
+};
+
+// Reads input reports from a controller on a dedicated thread that blocks
+// until the device delivers data instead of polling it periodically.
+//
+// Reports are timestamped on arrival and queued. The owning controller is
+// notified once with reportsAvailable() and then takes all reports that
+// have been queued in the meantime at once, i.e. a burst of reports is
+// delivered to the controller thread as a single batch.
+class ControllerInputReader : public QThread {
+    Q_OBJECT
+  public:
+    explicit ControllerInputReader(const QString& name);
+    ~ControllerInputReader() override;
+
+    // Starts reading, also after the reader has been stopped.
+    void start(QThread::Priority priority = QThread::InheritPriority);
+    // Stops reading and waits until the thread has finished.
+    void stop();
+
+    // Returns all reports in the order they have been received.
+    QVector<ControllerInputReport> takeReports();
+
+  signals:
+    // Emitted when a report has been queued after the last
+    // invocation of takeReports().
+    void reportsAvailable();
+
+  protected:
+    void run() override;
+
+    // Blocks until a report is available or the timeout expires.
+    // Returns the number of bytes read, 0 on timeout or -1 if reading
+    // failed permanently, e.g. because the device has been disconnected.
+    virtual int readReport(
+            unsigned char* pData,
+            int maxLength,
+            int timeoutMillis) = 0;
+
+  private:
+    QAtomicInt m_stop;
+
+    QMutex m_reportsMutex;
+    QVector<ControllerInputReport> m_reports;
+};
@@ -16,9 +16,24 @@
 #include "controllers/controllerdebug.h"
 #include "util/time.h"
 
+HidReader::HidReader(
+        hid_device* pHidDevice,
+        const QString& name)
+        : ControllerInputReader(name),
+          m_pHidDevice(pHidDevice) {
+}
+
+int HidReader::readReport(unsigned char* pData, int maxLength, int timeoutMillis) {
+    // Blocks in poll() (hidraw), on a condition variable (IOKit, libusb)
+    // or on an overlapped read (Windows) until a report arrives. The
+    // timeout only bounds the time until a stopped reader finishes.
+    return hid_read_timeout(m_pHidDevice, pData, maxLength, timeoutMillis);
+}
+
 HidController::HidController(const hid_device_info& deviceInfo, UserSettingsPointer pConfig)
         : Controller(pConfig),
-          m_pHidDevice(NULL) {
+          m_pHidDevice(NULL),
+          m_pReader(NULL) {
     // Copy required variables from deviceInfo, which will be freed after
     // this class is initialized by caller.
     hid_vendor_id = deviceInfo.vendor_id;
@@ -218,6 +233,22 @@ int HidController::open() {
     setOpen(true);
     startEngine();
 
+    if (m_pReader != NULL) {
+        qWarning() << "HidReader already present for" << getName();
+    } else {
+        m_pReader = new HidReader(m_pHidDevice,
+                QString("HidReader %1").arg(getName()));
+        connect(m_pReader,
+                &HidReader::reportsAvailable,
+                this,
+                &HidController::receiveReports,
+                Qt::QueuedConnection);
+
+        // Controller input needs to be prioritized since it can affect the
+        // audio directly, like when scratching
+        m_pReader->start(QThread::HighPriority);
+    }
+
     return 0;
 }
 
@@ -229,6 +260,14 @@ int HidController::close() {
 
     qDebug() << "Shutting down HID device" << getName();
 
+    // Stop the reader before closing the device it reads from
+    if (m_pReader != NULL) {
+        m_pReader->stop();
+        controllerDebug("  Waiting on reader to finish");
+        delete m_pReader;
+        m_pReader = NULL;
+    }
+
     // Stop controller engine here to ensure it's done before the device is closed
     //  in case it has any final parting messages
     stopEngine();
@@ -240,23 +279,13 @@ int HidController::close() {
     return 0;
 }
 
-bool HidController::poll() {
-    Trace hidRead("HidController poll");
-
-    int result = hid_read(m_pHidDevice, m_pPollData, sizeof(m_pPollData) / sizeof(m_pPollData[0]));
-    if (result == -1) {
-        return false;
-    } else if (result > 0) {
-        Trace process("HidController process packet");
-        QByteArray outData(reinterpret_cast<char*>(m_pPollData), result);
-        receive(outData, mixxx::Time::elapsed());
+void HidController::receiveReports() {
+    if (m_pReader == NULL) {
+        // Queued notification after closing the device
+        return;
     }
-
-    return true;
-}
-
-bool HidController::isPolling() const {
-    return isOpen();
+    Trace process("HidController process reports");
+    receiveBatch(m_pReader->takeReports());
 }
 
 void HidController::send(QList<int> data, unsigned int length, unsigned int reportID) {
@@ -13,10 +13,29 @@
 #include <QAtomicInt>
 
 #include "controllers/controller.h"
+#include "controllers/controllerinputreader.h"
 #include "controllers/hid/hidcontrollerpreset.h"
 #include "controllers/hid/hidcontrollerpresetfilehandler.h"
 #include "util/duration.h"
 
+// Reads from the device while the controller thread writes to it.
+// All hidapi backends support a single reader and a single writer
+// thread per device: hidraw reads and writes the same file descriptor,
+// Windows uses separate overlapped operations for reads and writes,
+// and the IOKit and libusb backends synchronize internally. The device
+// must only be closed after the reader has been stopped.
+class HidReader : public ControllerInputReader {
+    Q_OBJECT
+  public:
+    HidReader(hid_device* pHidDevice, const QString& name);
+
+  protected:
+    int readReport(unsigned char* pData, int maxLength, int timeoutMillis) override;
+
+  private:
+    hid_device* const m_pHidDevice;
+};
+
 class HidController final : public Controller {
     Q_OBJECT
   public:
@@ -55,8 +74,9 @@ class HidController final : public Controller {
     int open() override;
     int close() override;
 
-    bool poll() override;
-    bool isPolling() const override;
+    // Passes all input reports that have been queued by the reader
+    // to the controller engine.
+    void receiveReports();
 
   private:
     // For devices which only support a single report, reportID must be set to
@@ -87,9 +107,8 @@ class HidController final : public Controller {
 
     QString m_sUID;
     hid_device* m_pHidDevice;
+    HidReader* m_pReader;
     HidControllerPreset m_preset;
-
-    unsigned char m_pPollData[255];
 };
 
 #endif
@@ -34,6 +34,7 @@ QString MidiController::presetExtension() {
 
 void MidiController::visit(const MidiControllerPreset* preset) {
     m_preset = *preset;
+    rebuildInputMappingTable();
     emit presetLoaded(getPreset());
 }
 
@@ -58,6 +59,9 @@ bool MidiController::applyPreset(bool initializeScripts) {
     // Handles the engine
     bool result = Controller::applyPreset(initializeScripts);
 
+    // Resolve the script handlers of the scripts that have just been loaded
+    rebuildInputMappingTable();
+
     // Only execute this code if this is an output device
     if (isOutputDevice()) {
         if (m_outputs.count() > 0) {
@@ -194,6 +198,15 @@ void MidiController::commitTemporaryInputMappings() {
         m_preset.addInputMapping(it.key(), it.value());
     }
     m_temporaryInputMappings.clear();
+    rebuildInputMappingTable();
+}
+
+void MidiController::rebuildInputMappingTable() {
+    m_inputMappingTable.rebuild(m_preset.getInputMappings());
+    ControllerEngine* pEngine = getEngine();
+    if (pEngine) {
+        m_inputMappingTable.resolveScriptHandlers(pEngine);
+    }
 }
 
 void MidiController::receive(unsigned char status, unsigned char control,
@@ -228,9 +241,13 @@ void MidiController::receive(unsigned char status, unsigned char control,
         }
     }
 
-    auto it = m_preset.getInputMappings().constFind(mappingKey.key);
-    for (; it != m_preset.getInputMappings().constEnd() && it.key() == mappingKey.key; ++it) {
-        processInputMapping(it.value(), status, control, value, timestamp);
+    MidiInputMappingTable::Entries* pEntries =
+            m_inputMappingTable.find(mappingKey.key);
+    if (pEntries == nullptr) {
+        return;
+    }
+    for (auto& entry : *pEntries) {
+        processInputMapping(&entry, status, control, value, timestamp);
     }
 }
 
@@ -239,7 +256,18 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
                                          unsigned char control,
                                          unsigned char value,
                                          mixxx::Duration timestamp) {
+    // Temporary mappings while learning are not part of the mapping table
+    MidiInputMappingTable::Entry entry(mapping);
+    processInputMapping(&entry, status, control, value, timestamp);
+}
+
+void MidiController::processInputMapping(MidiInputMappingTable::Entry* pEntry,
+                                         unsigned char status,
+                                         unsigned char control,
+                                         unsigned char value,
+                                         mixxx::Duration timestamp) {
     Q_UNUSED(timestamp);
+    const MidiInputMapping& mapping = pEntry->mapping;
     unsigned char channel = MidiUtils::channelFromStatus(status);
     unsigned char opCode = MidiUtils::opCodeFromStatus(status);
 
@@ -249,8 +277,8 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
             return;
         }
 
-        QScriptValue function = pEngine->wrapFunctionCode(mapping.control.item, 5);
-        if (!pEngine->execute(function, channel, control, value, status,
+        const ControllerScriptHandler& handler = pEntry->scriptHandler(pEngine);
+        if (!pEngine->execute(handler, channel, control, value, status,
                               mapping.control.group, timestamp)) {
             qDebug() << "MidiController: Invalid script function"
                      << mapping.control.item;
@@ -259,8 +287,8 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
     }
 
     // Only pass values on to valid ControlObjects.
-    ControlObject* pCO = ControlObject::getControl(mapping.control);
-    if (pCO == NULL) {
+    ControlDoublePrivate* pControl = pEntry->control();
+    if (pControl == nullptr) {
         return;
     }
 
@@ -340,24 +368,21 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
         newValue = static_cast<double>(iValue) / 128.0;
         newValue = math_min(newValue, 127.0);
     } else {
-        double currControlValue = pCO->getMidiParameter();
+        double currControlValue = pControl->getMidiParameter();
         newValue = computeValue(mapping.options, currControlValue, value);
     }
 
-    // ControlPushButton ControlObjects only accept NOTE_ON, so if the midi
-    // mapping is <button> we override the Midi 'status' appropriately.
-    if (mapping.options.button || mapping.options.sw) {
-        opCode = MIDI_NOTE_ON;
-    }
-
     if (mapping.options.soft_takeover) {
-        // This is the only place to enable it if it isn't already.
-        m_st.enable(pCO);
-        if (m_st.ignore(pCO, pCO->getParameterForMidi(newValue))) {
-            return;
+        ControlObject* pCO = pControl->getCreatorCO();
+        if (pCO != nullptr) {
+            // This is the only place to enable it if it isn't already.
+            m_st.enable(pCO);
+            if (m_st.ignore(pCO, pControl->getParameterForMidi(newValue))) {
+                return;
+            }
         }
     }
-    pCO->setValueFromMidi(static_cast<MidiOpCode>(opCode), newValue);
+    pControl->setValueFromMidi(pEntry->opCode, newValue);
 }
 
 double MidiController::computeValue(
@@ -473,29 +498,37 @@ void MidiController::receive(QByteArray data, mixxx::Duration timestamp) {
         auto it = m_temporaryInputMappings.constFind(mappingKey.key);
         if (it != m_temporaryInputMappings.constEnd()) {
             for (; it != m_temporaryInputMappings.constEnd() && it.key() == mappingKey.key; ++it) {
-                processInputMapping(it.value(), data, timestamp);
+                // Temporary mappings while learning are not part of the
+                // mapping table
+                MidiInputMappingTable::Entry entry(it.value());
+                processInputMapping(&entry, data, timestamp);
             }
             return;
         }
     }
 
-    auto it = m_preset.getInputMappings().constFind(mappingKey.key);
-    for (; it != m_preset.getInputMappings().constEnd() && it.key() == mappingKey.key; ++it) {
-        processInputMapping(it.value(), data, timestamp);
+    MidiInputMappingTable::Entries* pEntries =
+            m_inputMappingTable.find(mappingKey.key);
+    if (pEntries == nullptr) {
+        return;
+    }
+    for (auto& entry : *pEntries) {
+        processInputMapping(&entry, data, timestamp);
     }
 }
 
-void MidiController::processInputMapping(const MidiInputMapping& mapping,
+void MidiController::processInputMapping(MidiInputMappingTable::Entry* pEntry,
                                          const QByteArray& data,
                                          mixxx::Duration timestamp) {
+    const MidiInputMapping& mapping = pEntry->mapping;
     // Custom script handler
     if (mapping.options.script) {
         ControllerEngine* pEngine = getEngine();
         if (pEngine == NULL) {
             return;
         }
-        QScriptValue function = pEngine->wrapFunctionCode(mapping.control.item, 2);
-        if (!pEngine->execute(function, data, timestamp)) {
+        const ControllerScriptHandler& handler = pEntry->scriptHandler(pEngine);
+        if (!pEngine->execute(handler, data, timestamp)) {
             qDebug() << "MidiController: Invalid script function"
                      << mapping.control.item;
         }
@@ -16,6 +16,7 @@
 #include "controllers/controller.h"
 #include "controllers/midi/midicontrollerpreset.h"
 #include "controllers/midi/midicontrollerpresetfilehandler.h"
+#include "controllers/midi/midiinputmappingtable.h"
 #include "controllers/midi/midimessage.h"
 #include "controllers/midi/midioutputhandler.h"
 #include "controllers/softtakeover.h"
@@ -91,10 +92,18 @@ class MidiController : public Controller {
                              unsigned char control,
                              unsigned char value,
                              mixxx::Duration timestamp);
-    void processInputMapping(const MidiInputMapping& mapping,
+    void processInputMapping(MidiInputMappingTable::Entry* pEntry,
+                             unsigned char status,
+                             unsigned char control,
+                             unsigned char value,
+                             mixxx::Duration timestamp);
+    void processInputMapping(MidiInputMappingTable::Entry* pEntry,
                              const QByteArray& data,
                              mixxx::Duration timestamp);
 
+    /// Rebuilds m_inputMappingTable from the input mappings of m_preset
+    void rebuildInputMappingTable();
+
     double computeValue(MidiOptions options, double _prevmidivalue, double _newmidivalue);
     void createOutputHandlers();
     void updateAllOutputs();
@@ -109,6 +118,8 @@ class MidiController : public Controller {
     QHash<uint16_t, MidiInputMapping> m_temporaryInputMappings;
     QList<MidiOutputHandler*> m_outputs;
     MidiControllerPreset m_preset;
+    // Built from the input mappings of m_preset
+    MidiInputMappingTable m_inputMappingTable;
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char> > m_fourteen_bit_queued_mappings;
 
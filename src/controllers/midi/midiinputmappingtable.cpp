@@ -0,0 +1,65 @@
+#include "controllers/midi/midiinputmappingtable.h"
+
+#include "controllers/midi/midiutils.h"
+#include "util/assert.h"
+
+MidiInputMappingTable::Entry::Entry(const MidiInputMapping& mapping)
+        : mapping(mapping),
+          opCode(MidiUtils::opCodeFromStatus(mapping.key.status)),
+          m_scriptHandlerGeneration(0) {
+    // ControlPushButton ControlObjects only accept NOTE_ON, so if the midi
+    // mapping is <button> we override the Midi 'status' appropriately.
+    if (mapping.options.button || mapping.options.sw) {
+        opCode = MIDI_NOTE_ON;
+    }
+    if (!mapping.options.script) {
+        m_pControl = ControlDoublePrivate::getControl(mapping.control, false);
+    }
+}
+
+ControlDoublePrivate* MidiInputMappingTable::Entry::control() {
+    if (mapping.options.script) {
+        return nullptr;
+    }
+    // The ControlObject might have been created after the mapping was
+    // loaded, or it has been deleted and maybe re-created since.
+    if (!m_pControl || m_pControl->getCreatorCO() == nullptr) {
+        m_pControl = ControlDoublePrivate::getControl(mapping.control);
+    }
+    return m_pControl.data();
+}
+
+const ControllerScriptHandler& MidiInputMappingTable::Entry::scriptHandler(
+        ControllerEngine* pEngine) {
+    DEBUG_ASSERT(mapping.options.script);
+    DEBUG_ASSERT(pEngine);
+    if (m_scriptHandlerGeneration != pEngine->getHandlerGeneration()) {
+        // System exclusive messages are passed to the script as data
+        // and length, all other messages as channel, control, value,
+        // status and group.
+        const int numberOfArgs = mapping.key.status == MIDI_SYSEX ? 2 : 5;
+        m_scriptHandler = pEngine->resolveHandler(mapping.control.item, numberOfArgs);
+        m_scriptHandlerGeneration = pEngine->getHandlerGeneration();
+    }
+    return m_scriptHandler;
+}
+
+void MidiInputMappingTable::rebuild(
+        const QHash<uint16_t, MidiInputMapping>& mappings) {
+    m_entries.clear();
+    // Multiple mappings for the same key are kept in the iteration order of
+    // the preset, i.e. they are processed in the same order as before.
+    for (auto it = mappings.constBegin(); it != mappings.constEnd(); ++it) {
+        m_entries[it.key()].append(Entry(it.value()));
+    }
+}
+
+void MidiInputMappingTable::resolveScriptHandlers(ControllerEngine* pEngine) {
+    for (auto& entries : m_entries) {
+        for (auto& entry : entries) {
+            if (entry.mapping.options.script) {
+                entry.scriptHandler(pEngine);
+            }
+        }
+    }
+}
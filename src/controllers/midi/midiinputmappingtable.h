@@ -0,0 +1,58 @@
+#pragma once
+/// @file midiinputmappingtable.h
+/// @brief Input mappings of a MIDI controller prepared for dispatching
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "control/control.h"
+#include "controllers/controllerengine.h"
+#include "controllers/midi/midimessage.h"
+
+/// The input mappings of a MIDI controller grouped by MidiKey. Mappings that
+/// set a control directly keep a reference to the control, so incoming
+/// messages are handled without looking up controls by ConfigKey and without
+/// involving the script engine. Script bindings keep the handler that has
+/// been resolved when the mapping or the scripts were loaded.
+class MidiInputMappingTable {
+  public:
+    struct Entry {
+        explicit Entry(const MidiInputMapping& mapping);
+
+        /// Returns the control this mapping sets or nullptr for script
+        /// bindings and controls that don't exist (yet).
+        ControlDoublePrivate* control();
+
+        /// Returns the handler of a script binding. It is only resolved
+        /// again after the scripts of the engine have been reloaded.
+        const ControllerScriptHandler& scriptHandler(ControllerEngine* pEngine);
+
+        MidiInputMapping mapping;
+        /// The opcode that is passed on to the control
+        MidiOpCode opCode;
+
+      private:
+        QSharedPointer<ControlDoublePrivate> m_pControl;
+        ControllerScriptHandler m_scriptHandler;
+        /// The generation of the engine's handlers m_scriptHandler
+        /// belongs to, 0 if not resolved yet.
+        int m_scriptHandlerGeneration;
+    };
+    typedef QVector<Entry> Entries;
+
+    void rebuild(const QHash<uint16_t, MidiInputMapping>& mappings);
+
+    /// Resolves the handlers of all script bindings in advance, so they
+    /// are not resolved while handling the first incoming messages.
+    void resolveScriptHandlers(ControllerEngine* pEngine);
+
+    /// Returns nullptr if there is no mapping for the key.
+    Entries* find(uint16_t key) {
+        auto it = m_entries.find(key);
+        return it != m_entries.end() ? &it.value() : nullptr;
+    }
+
+  private:
+    QHash<uint16_t, Entries> m_entries;
+};
@@ -11,7 +11,7 @@
 const QString MixxxDb::kDefaultSchemaFile(":/schema.xml");
 
 //static
-const int MixxxDb::kRequiredSchemaVersion = 32;
+const int MixxxDb::kRequiredSchemaVersion = 35;
 
 namespace {
 
@@ -32,7 +32,8 @@ const QString kPassword = QStringLiteral("mixxx");
 // The connection parameters for the main Mixxx DB
 mixxx::DbConnection::Params dbConnectionParams(
         const UserSettingsPointer& pConfig,
-        bool inMemoryConnection) {
+        bool inMemoryConnection,
+        bool readOnly = false) {
     mixxx::DbConnection::Params params;
     params.type = kType;
     params.connectOptions = kConnectOptions;
@@ -57,6 +58,7 @@ mixxx::DbConnection::Params dbConnectionParams(
     }
     params.userName = kUserName;
     params.password = kPassword;
+    params.readOnly = readOnly;
     return params;
 }
 
@@ -65,7 +67,8 @@ mixxx::DbConnection::Params dbConnectionParams(
 MixxxDb::MixxxDb(
         const UserSettingsPointer& pConfig,
         bool inMemoryConnection)
-    : m_pDbConnectionPool(std::make_shared<mixxx::DbConnectionPool>(dbConnectionParams(pConfig, inMemoryConnection), "MIXXX")) {
+    : m_pDbConnectionPool(std::make_shared<mixxx::DbConnectionPool>(dbConnectionParams(pConfig, inMemoryConnection), "MIXXX")),
+      m_pReadOnlyDbConnectionPool(std::make_shared<mixxx::DbConnectionPool>(dbConnectionParams(pConfig, inMemoryConnection, true), "MIXXX-RO")) {
 }
 
 bool MixxxDb::initDatabaseSchema(
@@ -30,8 +30,16 @@ class MixxxDb : public QObject {
         return m_pDbConnectionPool;
     }
 
+    // A separate pool of read-only connections for queries that
+    // are executed on worker threads, e.g. for populating library
+    // models and searching. Readers never block the writer.
+    mixxx::DbConnectionPoolPtr readOnlyConnectionPool() const {
+        return m_pReadOnlyDbConnectionPool;
+    }
+
   private:
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    mixxx::DbConnectionPoolPtr m_pReadOnlyDbConnectionPool;
 };
 
 
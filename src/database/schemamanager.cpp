@@ -1,5 +1,7 @@
 #include "database/schemamanager.h"
 
+#include <QRegularExpression>
+
 #include "util/db/fwdsqlquery.h"
 #include "util/db/sqltransaction.h"
 #include "util/xml.h"
@@ -29,6 +31,29 @@ namespace {
             return schemaVersion;
         }
     }
+
+    int countKeyword(const QString& statement, const QRegularExpression& keyword) {
+        int count = 0;
+        auto matches = keyword.globalMatch(statement);
+        while (matches.hasNext()) {
+            matches.next();
+            ++count;
+        }
+        return count;
+    }
+
+    // The semicolons within the body of a trigger don't terminate the
+    // statement. A statement is complete if every BEGIN and CASE has
+    // been closed by an END.
+    bool isCompleteStatement(const QString& statement) {
+        static const QRegularExpression kBeginOrCase(
+                QStringLiteral("\\b(BEGIN|CASE)\\b"),
+                QRegularExpression::CaseInsensitiveOption);
+        static const QRegularExpression kEnd(
+                QStringLiteral("\\bEND\\b"),
+                QRegularExpression::CaseInsensitiveOption);
+        return countKeyword(statement, kBeginOrCase) <= countKeyword(statement, kEnd);
+    }
 }
 
 SchemaManager::SchemaManager(const QSqlDatabase& database)
@@ -174,8 +199,8 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
 
         SqlTransaction transaction(m_database);
 
-        // TODO(XXX) We can't have semicolons in schema.xml for anything other
-        // than statement separators.
+        // Semicolons in schema.xml are statement separators, except
+        // within the body of a trigger.
         QStringList sqlStatements = sql.split(";");
 
         QStringListIterator it(sqlStatements);
@@ -183,6 +208,10 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
         bool result = true;
         while (result && it.hasNext()) {
             QString statement = it.next().trimmed();
+            while (!isCompleteStatement(statement) && it.hasNext()) {
+                statement += QChar(';') + it.next();
+            }
+            statement = statement.trimmed();
             if (statement.isEmpty()) {
                 // skip blank lines
                 continue;
@@ -11,8 +11,14 @@ class LV2Backend : public EffectsBackend {
     Q_OBJECT
   public:
     LV2Backend(QObject* pParent);
+    // Takes ownership of a world returned by loadWorld()
+    LV2Backend(QObject* pParent, LilvWorld* pWorld);
     virtual ~LV2Backend();
 
+    // Scans all LV2 bundles on disk, which may take a long time. This
+    // does not depend on any Qt object and can be done on a worker thread.
+    static LilvWorld* loadWorld();
+
     void enumeratePlugins();
     const QList<QString> getEffectIds() const;
     const QSet<QString> getDiscoveredPluginIds() const;
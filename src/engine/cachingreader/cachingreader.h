@@ -59,7 +59,9 @@ typedef QVarLengthArray<Hint, 512> HintVector;
 // CachingReader and CachingReaderWorker (a worker thread) work in concert to
 // read and decode relevant sections of a track in a background thread. The
 // decoded chunks are kept in a cache by CachingReader with a
-// least-recently-used (LRU) eviction policy. CachingReader exposes a method for
+// least-recently-used (LRU) eviction policy. The samples are owned by the
+// CachingReaderChunkStore and shared with the readers of other decks that
+// have loaded the same track. CachingReader exposes a method for
 // indicating which chunks should be kept fresh in the cache (see
 // hintAndMaybeWake). For example, the chunks around the playhead, the hotcue
 // positions, and loop points are all portions of the track that the user is
@@ -174,9 +176,6 @@ class CachingReader : public QObject {
     CachingReaderChunkForOwner* m_mruCachingReaderChunk;
     CachingReaderChunkForOwner* m_lruCachingReaderChunk;
 
-    // The raw memory buffer which is divided up into chunks.
-    mixxx::SampleBuffer m_sampleBuffer;
-
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
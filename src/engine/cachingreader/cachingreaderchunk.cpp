@@ -2,7 +2,6 @@
 
 #include <QtDebug>
 
-#include "sources/audiosourcestereoproxy.h"
 #include "engine/engine.h"
 #include "util/math.h"
 #include "util/sample.h"
@@ -30,53 +29,59 @@ const SINT CachingReaderChunk::kFrames = 8192; // ~ 170 ms at 48 kHz
 const SINT CachingReaderChunk::kSamples =
         CachingReaderChunk::frames2samples(CachingReaderChunk::kFrames);
 
-CachingReaderChunk::CachingReaderChunk(
-        mixxx::SampleBuffer::WritableSlice sampleBuffer)
+CachingReaderChunk::CachingReaderChunk()
         : m_index(kInvalidChunkIndex),
-          m_sampleBuffer(std::move(sampleBuffer)) {
-    DEBUG_ASSERT(m_sampleBuffer.length() == kSamples);
+          m_pSlot(nullptr) {
+}
+
+CachingReaderChunk::~CachingReaderChunk() {
+    if (m_pSlot) {
+        CachingReaderChunkStore::releaseChunk(m_pSlot);
+    }
 }
 
 void CachingReaderChunk::init(SINT index) {
     DEBUG_ASSERT(m_index == kInvalidChunkIndex || index == kInvalidChunkIndex);
     m_index = index;
-    m_bufferedSampleFrames.frameIndexRange() = mixxx::IndexRange();
+    if (m_pSlot) {
+        // Lock-free, the samples might still be used by other readers
+        CachingReaderChunkStore::releaseChunk(m_pSlot);
+        m_pSlot = nullptr;
+    }
+    m_bufferedSampleFrames = mixxx::ReadableSampleFrames();
 }
 
 // Frame index range of this chunk for the given audio source.
 mixxx::IndexRange CachingReaderChunk::frameIndexRange(
-        const mixxx::AudioSourcePointer& pAudioSource) const {
+        const mixxx::IndexRange& sourceFrameIndexRange) const {
     DEBUG_ASSERT(m_index != kInvalidChunkIndex);
-    if (!pAudioSource) {
+    if (sourceFrameIndexRange.empty()) {
         return mixxx::IndexRange();
     }
     const SINT minFrameIndex =
-            pAudioSource->frameIndexMin() +
+            sourceFrameIndexRange.start() +
             frameIndexOffset();
     return intersect(
             mixxx::IndexRange::forward(minFrameIndex, kFrames),
-            pAudioSource->frameIndexRange());
+            sourceFrameIndexRange);
 }
 
-mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
-        const mixxx::AudioSourcePointer& pAudioSource,
-        mixxx::SampleBuffer::WritableSlice tempOutputBuffer) {
+std::optional<mixxx::IndexRange> CachingReaderChunk::bufferSampleFrames(
+        const CachingReaderChunkStore::SourcePointer& pSource) {
     DEBUG_ASSERT(m_index != kInvalidChunkIndex);
-    const auto sourceFrameIndexRange = frameIndexRange(pAudioSource);
-    mixxx::AudioSourceStereoProxy audioSourceProxy(
-            pAudioSource,
-            tempOutputBuffer);
-    DEBUG_ASSERT(
-            audioSourceProxy.getSignalInfo().getChannelCount() ==
-            kChannels);
-    m_bufferedSampleFrames =
-            audioSourceProxy.readSampleFrames(
-                    mixxx::WritableSampleFrames(
-                            sourceFrameIndexRange,
-                            mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
-    DEBUG_ASSERT(m_bufferedSampleFrames.frameIndexRange().empty() ||
-            m_bufferedSampleFrames.frameIndexRange() <= sourceFrameIndexRange);
-    return m_bufferedSampleFrames.frameIndexRange();
+    DEBUG_ASSERT(!m_pSlot);
+    const auto sourceFrameIndexRange = frameIndexRange(pSource->frameIndexRange());
+    m_pSlot = CachingReaderChunkStore::instance().acquireChunk(
+            pSource, m_index, sourceFrameIndexRange);
+    if (!m_pSlot) {
+        return std::nullopt;
+    }
+    m_bufferedSampleFrames = m_pSlot->sampleFrames();
+    // The samples might have been decoded by another reader before
+    // the readable range of the shared source has been shrinked
+    return intersect(
+            m_bufferedSampleFrames.frameIndexRange(),
+            sourceFrameIndexRange);
 }
 
 mixxx::IndexRange CachingReaderChunk::readBufferedSampleFrames(
@@ -119,9 +124,8 @@ mixxx::IndexRange CachingReaderChunk::readBufferedSampleFramesReverse(
     return copyableFrameIndexRange;
 }
 
-CachingReaderChunkForOwner::CachingReaderChunkForOwner(
-        mixxx::SampleBuffer::WritableSlice sampleBuffer)
-        : CachingReaderChunk(std::move(sampleBuffer)),
+CachingReaderChunkForOwner::CachingReaderChunkForOwner()
+        : CachingReaderChunk(),
           m_state(FREE),
           m_pPrev(nullptr),
           m_pNext(nullptr) {
@@ -1,11 +1,14 @@
 #ifndef ENGINE_CACHINGREADERCHUNK_H
 #define ENGINE_CACHINGREADERCHUNK_H
 
+#include "engine/cachingreader/cachingreaderchunkstore.h"
 #include "sources/audiosource.h"
+#include "util/optional.h"
 
 // A Chunk is a memory-resident section of audio that has been cached.
 // Each chunk holds a fixed number kFrames of frames with samples for
-// kChannels.
+// kChannels. The samples are owned by the CachingReaderChunkStore and
+// might be shared with the chunks of other readers.
 //
 // The class is not thread-safe although it is shared between CachingReader
 // and CachingReaderWorker! A lock-free FIFO ensures that only a single
@@ -47,15 +50,17 @@ public:
         return m_index;
     }
 
-    // Frame index range of this chunk for the given audio source.
+    // Frame index range of this chunk for the given readable frame
+    // index range of the audio source.
     mixxx::IndexRange frameIndexRange(
-            const mixxx::AudioSourcePointer& pAudioSource) const;
+            const mixxx::IndexRange& sourceFrameIndexRange) const;
 
-    // Read sample frames from the audio source and return the
-    // range of frames that have been read.
-    mixxx::IndexRange bufferSampleFrames(
-            const mixxx::AudioSourcePointer& pAudioSource,
-            mixxx::SampleBuffer::WritableSlice tempOutputBuffer);
+    // Obtain the sample frames from the store, which reads them from
+    // the shared source unless another reader has done this before.
+    // Returns the range of frames that have been read or nothing if
+    // the store has no slot available.
+    std::optional<mixxx::IndexRange> bufferSampleFrames(
+            const CachingReaderChunkStore::SourcePointer& pSource);
 
     mixxx::IndexRange readBufferedSampleFrames(
             CSAMPLE* sampleBuffer,
@@ -65,9 +70,8 @@ public:
             const mixxx::IndexRange& frameIndexRange) const;
 
 protected:
-    explicit CachingReaderChunk(
-            mixxx::SampleBuffer::WritableSlice sampleBuffer);
-    virtual ~CachingReaderChunk() = default;
+    CachingReaderChunk();
+    virtual ~CachingReaderChunk();
 
     void init(SINT index);
 
@@ -78,9 +82,9 @@ private:
 
     SINT m_index;
 
-    // The worker thread will fill the sample buffer and
-    // set the corresponding frame index range.
-    mixxx::SampleBuffer::WritableSlice m_sampleBuffer;
+    // The worker thread will acquire the slot with the samples
+    // and set the corresponding frame index range.
+    CachingReaderChunkStore::Slot* m_pSlot;
     mixxx::ReadableSampleFrames m_bufferedSampleFrames;
 };
 
@@ -89,8 +93,7 @@ private:
 // the worker thread is in control.
 class CachingReaderChunkForOwner: public CachingReaderChunk {
 public:
-    explicit CachingReaderChunkForOwner(
-            mixxx::SampleBuffer::WritableSlice sampleBuffer);
+    CachingReaderChunkForOwner();
     ~CachingReaderChunkForOwner() override = default;
 
     void init(SINT index);
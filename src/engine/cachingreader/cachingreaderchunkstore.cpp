@@ -0,0 +1,219 @@
+#include "engine/cachingreader/cachingreaderchunkstore.h"
+
+#include <QMutexLocker>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "util/assert.h"
+#include "util/counter.h"
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("CachingReaderChunkStore");
+
+} // anonymous namespace
+
+CachingReaderChunkStore::Source::Source(
+        CachingReaderChunkStore* pStore,
+        QString location,
+        mixxx::AudioSourcePointer pAudioSource)
+        : m_pStore(pStore),
+          m_location(std::move(location)),
+          m_pAudioSource(std::move(pAudioSource)),
+          m_tempReadBuffer(
+                  m_pAudioSource->getSignalInfo().frames2samples(
+                          CachingReaderChunk::kFrames)) {
+}
+
+CachingReaderChunkStore::Source::~Source() {
+    m_pStore->sourceDestroyed(this);
+}
+
+mixxx::IndexRange CachingReaderChunkStore::Source::frameIndexRange() const {
+    QMutexLocker locker(&m_mutex);
+    return m_pAudioSource->frameIndexRange();
+}
+
+mixxx::ReadableSampleFrames CachingReaderChunkStore::Source::readSampleFrames(
+        mixxx::WritableSampleFrames sampleFrames) {
+    QMutexLocker locker(&m_mutex);
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            m_pAudioSource,
+            mixxx::SampleBuffer::WritableSlice(m_tempReadBuffer));
+    DEBUG_ASSERT(
+            audioSourceProxy.getSignalInfo().getChannelCount() ==
+            CachingReaderChunk::kChannels);
+    return audioSourceProxy.readSampleFrames(std::move(sampleFrames));
+}
+
+CachingReaderChunkStore::Slot::Slot()
+        : m_pSource(nullptr),
+          m_chunkIndex(0),
+          m_decoding(false),
+          m_lastUsed(0),
+          m_refCount(0) {
+}
+
+// static
+CachingReaderChunkStore& CachingReaderChunkStore::instance() {
+    // Shared by the readers of all decks and samplers
+    static CachingReaderChunkStore s_instance;
+    return s_instance;
+}
+
+CachingReaderChunkStore::CachingReaderChunkStore(int capacity)
+        : m_slots(capacity),
+          m_useCounter(0),
+          m_decodedChunkCount(0) {
+    DEBUG_ASSERT(capacity > 0);
+}
+
+CachingReaderChunkStore::SourcePointer CachingReaderChunkStore::openSource(
+        const QString& location,
+        const std::function<mixxx::AudioSourcePointer()>& openAudioSource) {
+    {
+        QMutexLocker locker(&m_mutex);
+        SourcePointer pSource = m_sources.value(location).lock();
+        if (pSource) {
+            Counter("CachingReaderChunkStore shared source").increment();
+            return pSource;
+        }
+    }
+
+    // Opening a file may take a while and must not block other readers
+    mixxx::AudioSourcePointer pAudioSource = openAudioSource();
+    if (!pAudioSource) {
+        return SourcePointer();
+    }
+    auto pNewSource = std::make_shared<Source>(
+            this, location, std::move(pAudioSource));
+
+    QMutexLocker locker(&m_mutex);
+    SourcePointer pSource = m_sources.value(location).lock();
+    if (pSource) {
+        // Another reader has opened the same file in the meantime.
+        // The new source must be destroyed without holding the lock.
+        locker.unlock();
+        pNewSource.reset();
+        return pSource;
+    }
+    m_sources.insert(location, pNewSource);
+    return pNewSource;
+}
+
+void CachingReaderChunkStore::sourceDestroyed(const Source* pSource) {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_sources.find(pSource->getLocation());
+    // The file might have been opened again already
+    if (it != m_sources.end() && it.value().expired()) {
+        m_sources.erase(it);
+    }
+    // Referenced slots are reused after they have been released
+    for (auto& slot : m_slots) {
+        if (slot.m_pSource == pSource) {
+            DEBUG_ASSERT(!slot.m_decoding);
+            slot.m_pSource = nullptr;
+            slot.m_lastUsed = 0;
+        }
+    }
+}
+
+CachingReaderChunkStore::Slot* CachingReaderChunkStore::findSlot(
+        const Source* pSource, SINT chunkIndex) {
+    for (auto& slot : m_slots) {
+        if (slot.m_pSource == pSource && slot.m_chunkIndex == chunkIndex) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+CachingReaderChunkStore::Slot* CachingReaderChunkStore::findUnreferencedSlot() {
+    // Free slots have never been used or belong to closed sources
+    Slot* pLeastRecentlyUsed = nullptr;
+    for (auto& slot : m_slots) {
+        if (slot.m_refCount.load(std::memory_order_acquire) > 0) {
+            continue;
+        }
+        DEBUG_ASSERT(!slot.m_decoding);
+        if (!pLeastRecentlyUsed || slot.m_lastUsed < pLeastRecentlyUsed->m_lastUsed) {
+            pLeastRecentlyUsed = &slot;
+        }
+    }
+    return pLeastRecentlyUsed;
+}
+
+CachingReaderChunkStore::Slot* CachingReaderChunkStore::acquireChunk(
+        const SourcePointer& pSource,
+        SINT chunkIndex,
+        mixxx::IndexRange frameIndexRange) {
+    VERIFY_OR_DEBUG_ASSERT(pSource) {
+        return nullptr;
+    }
+    QMutexLocker locker(&m_mutex);
+    Slot* pSlot = findSlot(pSource.get(), chunkIndex);
+    while (pSlot && pSlot->m_decoding) {
+        // Another reader is decoding the same chunk
+        m_chunkDecoded.wait(&m_mutex);
+        pSlot = findSlot(pSource.get(), chunkIndex);
+    }
+    if (pSlot) {
+        Counter("CachingReaderChunkStore hit").increment();
+        pSlot->m_refCount.fetch_add(1, std::memory_order_relaxed);
+        pSlot->m_lastUsed = ++m_useCounter;
+        return pSlot;
+    }
+
+    pSlot = findUnreferencedSlot();
+    if (!pSlot) {
+        kLogger.warning()
+                << "All" << m_slots.size()
+                << "chunks are in use, failed to read chunk"
+                << chunkIndex << "of" << pSource->getLocation();
+        return nullptr;
+    }
+    pSlot->m_pSource = pSource.get();
+    pSlot->m_chunkIndex = chunkIndex;
+    pSlot->m_decoding = true;
+    pSlot->m_lastUsed = ++m_useCounter;
+    pSlot->m_refCount.store(1, std::memory_order_relaxed);
+    pSlot->m_sampleFrames = mixxx::ReadableSampleFrames();
+    locker.unlock();
+
+    // The slot is exclusively owned while decoding
+    if (pSlot->m_sampleBuffer.size() != CachingReaderChunk::kSamples) {
+        mixxx::SampleBuffer(CachingReaderChunk::kSamples).swap(pSlot->m_sampleBuffer);
+    }
+    const mixxx::ReadableSampleFrames sampleFrames =
+            pSource->readSampleFrames(
+                    mixxx::WritableSampleFrames(
+                            frameIndexRange,
+                            mixxx::SampleBuffer::WritableSlice(pSlot->m_sampleBuffer)));
+
+    locker.relock();
+    pSlot->m_sampleFrames = sampleFrames;
+    pSlot->m_decoding = false;
+    if (sampleFrames.frameIndexRange().empty()) {
+        // Don't share failures, the next reader should try again
+        pSlot->m_pSource = nullptr;
+        pSlot->m_lastUsed = 0;
+    }
+    ++m_decodedChunkCount;
+    m_chunkDecoded.wakeAll();
+    return pSlot;
+}
+
+// static
+void CachingReaderChunkStore::releaseChunk(Slot* pSlot) {
+    DEBUG_ASSERT(pSlot);
+    // Publishes all reads of the samples before the slot might be reused
+    const int refCount = pSlot->m_refCount.fetch_sub(1, std::memory_order_release);
+    Q_UNUSED(refCount); // only used in DEBUG_ASSERT
+    DEBUG_ASSERT(refCount > 0);
+}
+
+int CachingReaderChunkStore::getDecodedChunkCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_decodedChunkCount;
+}
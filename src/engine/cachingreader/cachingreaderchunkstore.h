@@ -0,0 +1,148 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "sources/audiosource.h"
+#include "util/samplebuffer.h"
+
+// Process-wide store of decoded chunks that is shared by the CachingReaders
+// of all decks, samplers and the preview deck.
+//
+// When the same file is loaded into multiple decks only a single audio
+// source is opened and each chunk is decoded only once. All readers
+// reference the same decoded samples read-only.
+//
+// The memory for decoded samples is limited by a global budget instead of
+// a fixed number of chunks per reader. Slots that are not referenced by
+// any reader keep their samples until they are reused in least recently
+// used order.
+//
+// Chunks are acquired by the worker threads that may block while decoding.
+// Releasing a chunk is lock-free and may be done from the engine thread.
+class CachingReaderChunkStore {
+  public:
+    // 1024 chunks of 8192 stereo frames consume 64 MiB
+    static constexpr int kDefaultCapacity = 1024;
+
+    class Slot;
+
+    // A decoder that is shared by all readers of the same file
+    class Source {
+      public:
+        Source(CachingReaderChunkStore* pStore,
+                QString location,
+                mixxx::AudioSourcePointer pAudioSource);
+        ~Source();
+
+        const QString& getLocation() const {
+            return m_location;
+        }
+
+        const mixxx::audio::SignalInfo& getSignalInfo() const {
+            return m_pAudioSource->getSignalInfo();
+        }
+
+        // The readable range shrinks if decoding errors occur
+        mixxx::IndexRange frameIndexRange() const;
+
+      private:
+        friend class CachingReaderChunkStore;
+
+        mixxx::ReadableSampleFrames readSampleFrames(
+                mixxx::WritableSampleFrames sampleFrames);
+
+        CachingReaderChunkStore* const m_pStore;
+        const QString m_location;
+        const mixxx::AudioSourcePointer m_pAudioSource;
+
+        // Serializes decoding by the workers of all readers
+        mutable QMutex m_mutex;
+        // Temporary buffer for reading samples from all channels
+        // before conversion to a stereo signal.
+        mixxx::SampleBuffer m_tempReadBuffer;
+    };
+    typedef std::shared_ptr<Source> SourcePointer;
+
+    // Holds the decoded samples of a single chunk
+    class Slot {
+      public:
+        Slot();
+
+        // Valid while the slot is referenced
+        const mixxx::ReadableSampleFrames& sampleFrames() const {
+            return m_sampleFrames;
+        }
+
+      private:
+        friend class CachingReaderChunkStore;
+
+        // Identifies the chunk, nullptr if the slot is free
+        const Source* m_pSource;
+        SINT m_chunkIndex;
+        // Set while a worker is decoding the samples
+        bool m_decoding;
+        quint64 m_lastUsed;
+
+        // Incremented by the workers while the store is locked and
+        // decremented by the readers from any thread
+        std::atomic<int> m_refCount;
+
+        // Allocated when the slot is used for the first time
+        mixxx::SampleBuffer m_sampleBuffer;
+        mixxx::ReadableSampleFrames m_sampleFrames;
+    };
+
+    static CachingReaderChunkStore& instance();
+
+    explicit CachingReaderChunkStore(int capacity = kDefaultCapacity);
+
+    int getCapacity() const {
+        return static_cast<int>(m_slots.size());
+    }
+
+    // Returns the decoder of another reader that has opened the same file,
+    // or the audio source returned by openAudioSource. Returns nullptr if
+    // opening the audio source failed.
+    SourcePointer openSource(
+            const QString& location,
+            const std::function<mixxx::AudioSourcePointer()>& openAudioSource);
+
+    // Returns a referenced slot with the samples of the chunk in the given
+    // frame index range. The samples are decoded unless another reader has
+    // done this before, possibly waiting for a concurrent decoding of the
+    // same chunk to finish. Returns nullptr if all slots are referenced.
+    Slot* acquireChunk(
+            const SourcePointer& pSource,
+            SINT chunkIndex,
+            mixxx::IndexRange frameIndexRange);
+
+    // Drops the reference to a slot that has been acquired before
+    static void releaseChunk(Slot* pSlot);
+
+    // The number of chunks that have been decoded, for tests and stats
+    int getDecodedChunkCount() const;
+
+  private:
+    void sourceDestroyed(const Source* pSource);
+
+    Slot* findSlot(const Source* pSource, SINT chunkIndex);
+    Slot* findUnreferencedSlot();
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_chunkDecoded;
+
+    QHash<QString, std::weak_ptr<Source>> m_sources;
+
+    // About a thousand slots that are searched linearly, which is
+    // negligible compared to decoding a chunk
+    std::vector<Slot> m_slots;
+    quint64 m_useCounter;
+    int m_decodedChunkCount;
+};
@@ -7,6 +7,7 @@
 #include "engine/cachingreader/cachingreaderworker.h"
 #include "sources/soundsourceproxy.h"
 #include "util/compatibility.h"
+#include "util/counter.h"
 #include "util/event.h"
 #include "util/logger.h"
 
@@ -26,6 +27,7 @@ CachingReaderWorker::CachingReaderWorker(
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
           m_newTrackAvailable(false),
+          m_busy(false),
           m_stop(0) {
 }
 
@@ -37,23 +39,30 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
     // Before trying to read any data we need to check if the audio source
     // is available and if any audio data that is needed by the chunk is
     // actually available.
-    auto chunkFrameIndexRange = pChunk->frameIndexRange(m_pAudioSource);
-    DEBUG_ASSERT(!m_pAudioSource ||
-            chunkFrameIndexRange <= m_pAudioSource->frameIndexRange());
+    const auto sourceFrameIndexRange =
+            m_pSource ? m_pSource->frameIndexRange() : mixxx::IndexRange();
+    auto chunkFrameIndexRange = pChunk->frameIndexRange(sourceFrameIndexRange);
+    DEBUG_ASSERT(chunkFrameIndexRange <= sourceFrameIndexRange);
     if (chunkFrameIndexRange.empty()) {
         ReaderStatusUpdate result;
-        result.init(CHUNK_READ_INVALID, pChunk, m_pAudioSource ? m_pAudioSource->frameIndexRange() : mixxx::IndexRange());
+        result.init(CHUNK_READ_INVALID, pChunk, sourceFrameIndexRange);
         return result;
     }
 
-    // Try to read the data required for the chunk from the audio source
-    const mixxx::IndexRange bufferedFrameIndexRange = pChunk->bufferSampleFrames(
-            m_pAudioSource,
-            mixxx::SampleBuffer::WritableSlice(m_tempReadBuffer));
-    DEBUG_ASSERT(!m_pAudioSource ||
-            bufferedFrameIndexRange <= m_pAudioSource->frameIndexRange());
+    // Try to obtain the data required for the chunk from the store that
+    // reads it from the audio source if needed
+    const auto optBufferedFrameIndexRange = pChunk->bufferSampleFrames(m_pSource);
+    if (!optBufferedFrameIndexRange) {
+        // The decoded chunks of all decks exceed the memory budget.
+        // The chunk is freed and requested again later.
+        Counter("CachingReaderWorker: No chunk available in store")++;
+        return ReaderStatusUpdate::readDiscarded(pChunk);
+    }
+    const mixxx::IndexRange bufferedFrameIndexRange = *optBufferedFrameIndexRange;
     // The readable frame range might have changed
-    chunkFrameIndexRange = intersect(chunkFrameIndexRange, m_pAudioSource->frameIndexRange());
+    const auto readableFrameIndexRange = m_pSource->frameIndexRange();
+    DEBUG_ASSERT(bufferedFrameIndexRange <= sourceFrameIndexRange);
+    chunkFrameIndexRange = intersect(chunkFrameIndexRange, readableFrameIndexRange);
     DEBUG_ASSERT(bufferedFrameIndexRange.empty() ||
             bufferedFrameIndexRange <= chunkFrameIndexRange);
 
@@ -70,7 +79,7 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
     }
 
     ReaderStatusUpdate result;
-    result.init(status, pChunk, m_pAudioSource ? m_pAudioSource->frameIndexRange() : mixxx::IndexRange());
+    result.init(status, pChunk, readableFrameIndexRange);
     return result;
 }
 
@@ -90,6 +99,7 @@ void CachingReaderWorker::run() {
 
     Event::start(m_tag);
     while (!atomicLoadAcquire(m_stop)) {
+        m_busy = true;
         // Request is initialized by reading from FIFO
         CachingReaderChunkReadRequest request;
         if (m_newTrackAvailable) {
@@ -106,6 +116,9 @@ void CachingReaderWorker::run() {
             const ReaderStatusUpdate update(processReadRequest(request));
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
         } else {
+            // Requests that arrive in the meantime are pending in the FIFO
+            m_busy = false;
+            workFinished();
             Event::end(m_tag);
             m_semaRun.acquire();
             Event::start(m_tag);
@@ -113,6 +126,12 @@ void CachingReaderWorker::run() {
     }
 }
 
+bool CachingReaderWorker::hasPendingWork() const {
+    return m_busy ||
+            m_newTrackAvailable ||
+            m_pChunkReadRequestFIFO->readAvailable() > 0;
+}
+
 void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     // Discard all pending read requests
     CachingReaderChunkReadRequest request;
@@ -122,7 +141,7 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     }
 
     // Unload the track
-    m_pAudioSource.reset(); // Close open file handles
+    m_pSource.reset(); // Close open file handles unless shared
 
     if (!pTrack) {
         // If no new track is available then we are done
@@ -147,10 +166,15 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
-    mixxx::AudioSource::OpenParams config;
-    config.setChannelCount(CachingReaderChunk::kChannels);
-    m_pAudioSource = SoundSourceProxy(pTrack).openAudioSource(config);
-    if (!m_pAudioSource) {
+    // Decks that have loaded the same file share a single decoder
+    m_pSource = CachingReaderChunkStore::instance().openSource(
+            filename,
+            [&pTrack]() {
+                mixxx::AudioSource::OpenParams config;
+                config.setChannelCount(CachingReaderChunk::kChannels);
+                return SoundSourceProxy(pTrack).openAudioSource(config);
+            });
+    if (!m_pSource) {
         kLogger.warning()
                 << m_group
                 << "Failed to open file"
@@ -165,8 +189,9 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     // Initially assume that the complete content offered by audio source
     // is available for reading. Later if read errors occur this value will
     // be decreased to avoid repeated reading of corrupt audio data.
-    if (m_pAudioSource->frameIndexRange().empty()) {
-        m_pAudioSource.reset(); // Close open file handles
+    const auto frameIndexRange = m_pSource->frameIndexRange();
+    if (frameIndexRange.empty()) {
+        m_pSource.reset(); // Close open file handles
         kLogger.warning()
                 << m_group
                 << "Failed to open empty file"
@@ -178,26 +203,17 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
-    // Adjust the internal buffer
-    const SINT tempReadBufferSize =
-            m_pAudioSource->getSignalInfo().frames2samples(
-                    CachingReaderChunk::kFrames);
-    if (m_tempReadBuffer.size() != tempReadBufferSize) {
-        mixxx::SampleBuffer(tempReadBufferSize).swap(m_tempReadBuffer);
-    }
-
     const auto update =
-            ReaderStatusUpdate::trackLoaded(
-                    m_pAudioSource->frameIndexRange());
+            ReaderStatusUpdate::trackLoaded(frameIndexRange);
     m_pReaderStatusFIFO->writeBlocking(&update, 1);
 
     // Emit that the track is loaded.
     const SINT sampleCount =
             CachingReaderChunk::frames2samples(
-                    m_pAudioSource->frameLength());
+                    frameIndexRange.length());
     emit trackLoaded(
             pTrack,
-            m_pAudioSource->getSignalInfo().getSampleRate(),
+            m_pSource->getSignalInfo().getSampleRate(),
             sampleCount);
 }
 
@@ -1,6 +1,8 @@
 #ifndef ENGINE_CACHINGREADERWORKER_H
 #define ENGINE_CACHINGREADERWORKER_H
 
+#include <atomic>
+
 #include <QtDebug>
 #include <QMutex>
 #include <QSemaphore>
@@ -8,6 +10,7 @@
 #include <QString>
 
 #include "engine/cachingreader/cachingreaderchunk.h"
+#include "engine/cachingreader/cachingreaderchunkstore.h"
 #include "track/track.h"
 #include "engine/engineworker.h"
 #include "sources/audiosource.h"
@@ -110,6 +113,8 @@ class CachingReaderWorker : public EngineWorker {
     // thread pool via the EngineWorkerScheduler.
     void run() override;
 
+    bool hasPendingWork() const override;
+
     void quitWait();
 
   signals:
@@ -128,23 +133,24 @@ class CachingReaderWorker : public EngineWorker {
     FIFO<ReaderStatusUpdate>* m_pReaderStatusFIFO;
 
     // Queue of Tracks to load, and the corresponding lock. Must acquire the
-    // lock to touch.
+    // lock to touch m_pNewTrack. The flag is atomic, because it is polled
+    // without the lock, e.g. by hasPendingWork().
     QMutex m_newTrackMutex;
-    bool m_newTrackAvailable;
+    std::atomic<bool> m_newTrackAvailable;
     TrackPointer m_pNewTrack;
 
+    // Set while not waiting for requests
+    std::atomic<bool> m_busy;
+
     // Internal method to load a track. Emits trackLoaded when finished.
     void loadTrack(const TrackPointer& pTrack);
 
     ReaderStatusUpdate processReadRequest(
             const CachingReaderChunkReadRequest& request);
 
-    // The current audio source of the track loaded
-    mixxx::AudioSourcePointer m_pAudioSource;
-
-    // Temporary buffer for reading samples from all channels
-    // before conversion to a stereo signal.
-    mixxx::SampleBuffer m_tempReadBuffer;
+    // The current audio source of the track loaded, shared with
+    // the workers of other decks that have loaded the same file
+    CachingReaderChunkStore::SourcePointer m_pSource;
 
     QAtomicInt m_stop;
 };
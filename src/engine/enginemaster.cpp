@@ -744,6 +744,10 @@ void EngineMaster::process(const int iBufferSize) {
     m_pWorkerScheduler->runWorkers();
 }
 
+void EngineMaster::waitForWorkers() const {
+    m_pWorkerScheduler->waitForWorkers();
+}
+
 void EngineMaster::applyMasterEffects() {
     // Apply master effects
     if (m_pEngineEffectsManager) {
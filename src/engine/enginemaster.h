@@ -86,6 +86,11 @@ class EngineMaster : public QObject, public AudioSource {
 
     void process(const int iBufferSize);
 
+    // Blocks until the engine workers, e.g. the readers of the decks, have
+    // finished the work requested by the last call of process(). Only needed
+    // when rendering faster than real time, see EngineOfflineRenderer.
+    void waitForWorkers() const;
+
     // Add an EngineChannel to the mixing engine. This is not thread safe --
     // only call it before the engine has started mixing.
     void addChannel(EngineChannel* pChannel);
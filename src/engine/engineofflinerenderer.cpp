@@ -0,0 +1,145 @@
+#include "engine/engineofflinerenderer.h"
+
+#ifdef Q_OS_WIN
+//Enable unicode in libsndfile on Windows
+//(sf_open uses UTF-8 otherwise)
+#include <windows.h>
+#define ENABLE_SNDFILE_WINDOWS_PROTOTYPES 1
+#endif
+#include <sndfile.h>
+
+#include <QDir>
+#include <QFile>
+#include <algorithm>
+#include <cstring>
+
+#include "control/controlobject.h"
+#include "engine/engine.h"
+#include "engine/enginemaster.h"
+#include "soundio/soundmanagerutil.h"
+#include "util/defs.h"
+#include "util/logger.h"
+#include "util/trace.h"
+
+namespace {
+
+const mixxx::Logger kLogger("EngineOfflineRenderer");
+
+AudioOutput masterOutput() {
+    return AudioOutput(AudioOutput::MASTER, 0, mixxx::kEngineChannelCount);
+}
+
+} // anonymous namespace
+
+EngineOfflineRenderer::EngineOfflineRenderer(
+        EngineMaster* pEngineMaster,
+        SINT framesPerBuffer,
+        double sampleRate)
+        : m_pEngineMaster(pEngineMaster),
+          m_framesPerBuffer(math_min(framesPerBuffer,
+                  static_cast<SINT>(MAX_BUFFER_LEN / mixxx::kEngineChannelCount))),
+          m_sampleRate(sampleRate),
+          m_framePosition(0) {
+    DEBUG_ASSERT(m_framesPerBuffer == framesPerBuffer);
+    ControlObject::set(ConfigKey("[Master]", "samplerate"), m_sampleRate);
+    m_pEngineMaster->onOutputConnected(masterOutput());
+}
+
+EngineOfflineRenderer::~EngineOfflineRenderer() {
+    m_pEngineMaster->onOutputDisconnected(masterOutput());
+}
+
+void EngineOfflineRenderer::scheduleControlChange(
+        SINT framePosition,
+        const ConfigKey& key,
+        double value) {
+    const auto insertPosition = std::upper_bound(
+            m_controlChanges.begin(),
+            m_controlChanges.end(),
+            framePosition,
+            [](SINT position, const ControlChange& change) {
+                return position < change.framePosition;
+            });
+    m_controlChanges.insert(insertPosition, ControlChange{framePosition, key, value});
+}
+
+void EngineOfflineRenderer::applyControlChanges() {
+    int applied = 0;
+    for (const auto& change : m_controlChanges) {
+        if (change.framePosition > m_framePosition) {
+            break;
+        }
+        ControlObject::set(change.key, change.value);
+        ++applied;
+    }
+    m_controlChanges.remove(0, applied);
+}
+
+void EngineOfflineRenderer::render(
+        SINT frameCount,
+        const OutputCallback& outputCallback) {
+    while (frameCount > 0) {
+        Trace trace("EngineOfflineRenderer::render");
+        applyControlChanges();
+
+        // Stop at the next scheduled control change
+        SINT framesToRender = math_min(frameCount, m_framesPerBuffer);
+        if (!m_controlChanges.isEmpty()) {
+            framesToRender = math_min(framesToRender,
+                    m_controlChanges.first().framePosition - m_framePosition);
+        }
+
+        m_pEngineMaster->process(framesToRender * mixxx::kEngineChannelCount);
+        // Without a sound device pacing the engine the readers would fall
+        // behind, so they need to catch up before the next buffer.
+        m_pEngineMaster->waitForWorkers();
+
+        if (outputCallback) {
+            outputCallback(m_pEngineMaster->getMasterBuffer(), framesToRender);
+        }
+        m_framePosition += framesToRender;
+        frameCount -= framesToRender;
+    }
+}
+
+bool EngineOfflineRenderer::renderToFile(const QString& fileName, SINT frameCount) {
+    SF_INFO sfInfo;
+    memset(&sfInfo, 0, sizeof(sfInfo));
+    sfInfo.samplerate = static_cast<int>(m_sampleRate);
+    sfInfo.channels = mixxx::kEngineChannelCount;
+    sfInfo.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+#ifdef __WINDOWS__
+    const QString nativeFileName(QDir::toNativeSeparators(fileName));
+    const ushort* const fileNameUtf16 = nativeFileName.utf16();
+    static_assert(sizeof(wchar_t) == sizeof(ushort), "QString::utf16(): wchar_t and ushort have different sizes");
+    SNDFILE* pSndFile = sf_wchar_open(
+            reinterpret_cast<wchar_t*>(const_cast<ushort*>(fileNameUtf16)),
+            SFM_WRITE,
+            &sfInfo);
+#else
+    SNDFILE* pSndFile = sf_open(QFile::encodeName(fileName), SFM_WRITE, &sfInfo);
+#endif
+    if (!pSndFile) {
+        kLogger.warning()
+                << "Failed to open"
+                << fileName
+                << sf_strerror(nullptr);
+        return false;
+    }
+
+    bool success = true;
+    render(frameCount, [pSndFile, &success](const CSAMPLE* pBuffer, SINT frameCount) {
+        if (sf_writef_float(pSndFile, pBuffer, frameCount) != frameCount) {
+            success = false;
+        }
+    });
+    if (!success) {
+        kLogger.warning()
+                << "Failed to write"
+                << fileName
+                << sf_strerror(pSndFile);
+    }
+    sf_close(pSndFile);
+    return success;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+
+#include <QString>
+#include <QVector>
+
+#include "preferences/configobject.h"
+#include "util/types.h"
+
+class EngineMaster;
+
+// Drives the EngineMaster without a sound device and as fast as possible,
+// e.g. for rendering a mix to a file, for testing the complete engine or
+// for benchmarking it.
+//
+// Control changes can be scheduled at frame positions. The buffer that
+// contains such a position is split, so the changes take effect exactly
+// at the requested frame.
+class EngineOfflineRenderer {
+  public:
+    // Receives the interleaved stereo master output of each buffer
+    typedef std::function<void(const CSAMPLE* pBuffer, SINT frameCount)> OutputCallback;
+
+    // Enables the master output of pEngineMaster and sets the sample rate
+    EngineOfflineRenderer(
+            EngineMaster* pEngineMaster,
+            SINT framesPerBuffer,
+            double sampleRate);
+    ~EngineOfflineRenderer();
+
+    // The number of frames that have been rendered
+    SINT framePosition() const {
+        return m_framePosition;
+    }
+
+    // Sets the control before the frame at framePosition is rendered.
+    // Changes for the same position are applied in the order they have
+    // been scheduled. Changes for past positions are applied before the
+    // next buffer is rendered.
+    void scheduleControlChange(
+            SINT framePosition,
+            const ConfigKey& key,
+            double value);
+
+    // Renders frameCount frames and passes the master output on to
+    // outputCallback if set.
+    void render(
+            SINT frameCount,
+            const OutputCallback& outputCallback = OutputCallback());
+
+    // Renders frameCount frames of the master output into a WAV file with
+    // 32 bit float samples. Returns false if the file could not be written.
+    bool renderToFile(const QString& fileName, SINT frameCount);
+
+  private:
+    struct ControlChange {
+        SINT framePosition;
+        ConfigKey key;
+        double value;
+    };
+
+    void applyControlChanges();
+
+    EngineMaster* const m_pEngineMaster;
+    const SINT m_framesPerBuffer;
+    const double m_sampleRate;
+    SINT m_framePosition;
+
+    // Ordered by frame position
+    QVector<ControlChange> m_controlChanges;
+};
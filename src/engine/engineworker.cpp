@@ -29,6 +29,13 @@ void EngineWorker::workReady() {
     m_pScheduler->workerReady();
 }
 
+void EngineWorker::workFinished() {
+    VERIFY_OR_DEBUG_ASSERT(m_pScheduler) {
+        return;
+    }
+    m_pScheduler->workerFinished();
+}
+
 void EngineWorker::wakeIfReady() {
     if (!m_notReady.test_and_set()) {
         m_semaRun.release();
@@ -28,7 +28,18 @@ class EngineWorker : public QThread {
     void workReady();
     void wakeIfReady();
 
+    // Returns true while work that has been requested is not finished yet.
+    // Only needed when the engine is not driven in real time and has to
+    // wait for the workers, see EngineMaster::waitForWorkers().
+    virtual bool hasPendingWork() const {
+        return false;
+    }
+
   protected:
+    // Must be called after hasPendingWork() has become false to wake up
+    // EngineMaster::waitForWorkers().
+    void workFinished();
+
     QSemaphore m_semaRun;
 
   private:
@@ -39,6 +39,33 @@ void EngineWorkerScheduler::runWorkers() {
     }
 }
 
+void EngineWorkerScheduler::workerFinished() {
+    // Locking prevents that the wake-up gets lost between checking for
+    // pending work and waiting in waitForWorkers()
+    QMutexLocker locker(&m_workFinishedMutex);
+    m_workFinished.wakeAll();
+}
+
+void EngineWorkerScheduler::waitForWorkers() {
+    QMutexLocker finishedLocker(&m_workFinishedMutex);
+    while (true) {
+        bool pendingWork = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            for (const auto& pWorker: m_workers) {
+                if (pWorker->hasPendingWork()) {
+                    pendingWork = true;
+                    break;
+                }
+            }
+        }
+        if (!pendingWork) {
+            return;
+        }
+        m_workFinished.wait(&m_workFinishedMutex);
+    }
+}
+
 void EngineWorkerScheduler::run() {
     static const QString tag("EngineWorkerScheduler");
     while (!m_bQuit) {
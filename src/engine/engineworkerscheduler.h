@@ -22,6 +22,10 @@ class EngineWorkerScheduler : public QThread {
     void addWorker(EngineWorker* pWorker);
     void runWorkers();
     void workerReady();
+    // Called by a worker that has finished its pending work
+    void workerFinished();
+    // Blocks until none of the workers has pending work
+    void waitForWorkers();
 
   protected:
     void run();
@@ -36,6 +40,10 @@ class EngineWorkerScheduler : public QThread {
     QWaitCondition m_waitCondition;
     QMutex m_mutex;
     volatile bool m_bQuit;
+
+    // Signalled by the workers when they have finished their work
+    QWaitCondition m_workFinished;
+    QMutex m_workFinishedMutex;
 };
 
 #endif /* ENGINEWORKERSCHEDULER_H */
@@ -0,0 +1,112 @@
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STEREODOUBLE_SSE2
+#endif
+
+// The left and the right channel of a stereo frame in double precision.
+//
+// The IIR filters process both channels with the same coefficients. With
+// this type they run through the filter together, one channel per lane of
+// a 128 bit SSE2 register, instead of calling the scalar filter for each
+// channel. The results are the same as for two separate doubles.
+class StereoDouble {
+  public:
+    StereoDouble() = default;
+
+#ifdef STEREODOUBLE_SSE2
+    StereoDouble(double left, double right)
+            : m_value(_mm_set_pd(right, left)) {
+    }
+
+    // Loads and converts an interleaved stereo frame with a single
+    // 64 bit load
+    static StereoDouble fromFrame(const float* pFrame) {
+        return StereoDouble(_mm_cvtps_pd(_mm_castsi128_ps(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pFrame)))));
+    }
+    // Converts and stores an interleaved stereo frame
+    void toFrame(float* pFrame) const {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pFrame),
+                _mm_castps_si128(_mm_cvtpd_ps(m_value)));
+    }
+
+    double left() const {
+        return _mm_cvtsd_f64(m_value);
+    }
+    double right() const {
+        return _mm_cvtsd_f64(_mm_unpackhi_pd(m_value, m_value));
+    }
+
+    StereoDouble operator+(StereoDouble other) const {
+        return StereoDouble(_mm_add_pd(m_value, other.m_value));
+    }
+    StereoDouble operator-(StereoDouble other) const {
+        return StereoDouble(_mm_sub_pd(m_value, other.m_value));
+    }
+    StereoDouble operator-() const {
+        // Flip the sign bits like the scalar negation
+        return StereoDouble(_mm_xor_pd(m_value, _mm_set1_pd(-0.0)));
+    }
+    StereoDouble operator*(double factor) const {
+        return StereoDouble(_mm_mul_pd(m_value, _mm_set1_pd(factor)));
+    }
+
+  private:
+    explicit StereoDouble(__m128d value)
+            : m_value(value) {
+    }
+
+    __m128d m_value;
+#else
+    StereoDouble(double left, double right)
+            : m_left(left),
+              m_right(right) {
+    }
+
+    static StereoDouble fromFrame(const float* pFrame) {
+        return StereoDouble(pFrame[0], pFrame[1]);
+    }
+    void toFrame(float* pFrame) const {
+        pFrame[0] = static_cast<float>(m_left);
+        pFrame[1] = static_cast<float>(m_right);
+    }
+
+    double left() const {
+        return m_left;
+    }
+    double right() const {
+        return m_right;
+    }
+
+    StereoDouble operator+(StereoDouble other) const {
+        return StereoDouble(m_left + other.m_left, m_right + other.m_right);
+    }
+    StereoDouble operator-(StereoDouble other) const {
+        return StereoDouble(m_left - other.m_left, m_right - other.m_right);
+    }
+    StereoDouble operator-() const {
+        return StereoDouble(-m_left, -m_right);
+    }
+    StereoDouble operator*(double factor) const {
+        return StereoDouble(m_left * factor, m_right * factor);
+    }
+
+  private:
+    double m_left;
+    double m_right;
+#endif
+
+  public:
+    StereoDouble& operator+=(StereoDouble other) {
+        return *this = *this + other;
+    }
+    StereoDouble& operator-=(StereoDouble other) {
+        return *this = *this - other;
+    }
+};
+
+inline StereoDouble operator*(double factor, StereoDouble value) {
+    return value * factor;
+}
@@ -8,12 +8,12 @@
 #ifndef ENGINERECORD_H
 #define ENGINERECORD_H
 
-#include <QDataStream>
 #include <QFile>
 
 #include "preferences/usersettings.h"
 #include "encoder/encodercallback.h"
 #include "encoder/encoder.h"
+#include "engine/sidechain/recordingfilewriter.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "track/track.h"
 
@@ -75,9 +75,9 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
     QString m_baAuthor;
     QString m_baAlbum;
 
-    QFile m_file;
+    // Decouples the sidechain from the disk
+    RecordingFileWriter m_fileWriter;
     QFile m_cueFile;
-    QDataStream m_dataStream;
 
     ControlProxy* m_pRecReady;
     ControlProxy* m_pSamplerate;
@@ -0,0 +1,260 @@
+#include "engine/sidechain/recordingfilewriter.h"
+
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <limits>
+
+#include <QMutexLocker>
+
+#include "util/assert.h"
+#include "util/counter.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/time.h"
+#include "util/timer.h"
+#include "util/trace.h"
+
+namespace {
+
+const mixxx::Logger kLogger("RecordingFileWriter");
+
+// The data is written to disk in blocks of up to this size
+const int kBlockSize = 1024 * 1024;
+
+// Large writes of the encoder are split into chunks, so the writer can
+// free space in the ring buffer while the rest is still being copied.
+const int kMaxChunkLength = 64 * 1024;
+
+// Assuming the smallest chunks are a few bytes of an encoder header
+const int kChunksPerBuffer = 4096;
+
+// Wakes up the writer when a block is complete, or when data is waiting
+// for longer than this. Limits what is lost if Mixxx crashes while
+// recording at a low bitrate.
+const qint64 kMaxWriteDelayNanos = 1000 * 1000 * 1000;
+
+#ifdef __LINUX__
+// Preallocates the file ahead of the data in steps of this size
+const qint64 kPreallocationSize = 64 * 1024 * 1024;
+#endif
+
+const QString kBlockedStat = QStringLiteral("RecordingFileWriter blocked");
+const QString kBufferFillStat = QStringLiteral("RecordingFileWriter buffer fill");
+const QString kBlockWriteStat = QStringLiteral("RecordingFileWriter block write");
+
+} // anonymous namespace
+
+RecordingFileWriter::RecordingFileWriter(int bufferSize)
+        // Must hold at least one chunk
+        : m_bufferSize(math_max(bufferSize, kMaxChunkLength)),
+          m_stop(false),
+          m_position(0),
+          m_size(0),
+          m_unwrittenBytes(0),
+          m_lastWakeNanos(0),
+          m_blockOffset(0),
+          m_blockLength(0),
+          m_allocatedSize(0),
+          m_error(false) {
+}
+
+RecordingFileWriter::~RecordingFileWriter() {
+    close();
+}
+
+bool RecordingFileWriter::open(const QString& fileName) {
+    VERIFY_OR_DEBUG_ASSERT(!isOpen()) {
+        close();
+    }
+    if (!m_pData) {
+        // Allocated up front and not while recording
+        m_pData = std::make_unique<FIFO<char>>(m_bufferSize);
+        m_pChunks = std::make_unique<FIFO<Chunk>>(kChunksPerBuffer);
+        m_block.resize(kBlockSize);
+    }
+
+    m_file.setFileName(fileName);
+    // Blocks are collected by the writer thread
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        return false;
+    }
+    m_stop = false;
+    m_position = 0;
+    m_size = 0;
+    m_unwrittenBytes = 0;
+    m_lastWakeNanos = mixxx::Time::elapsed().toIntegerNanos();
+    m_blockLength = 0;
+    m_allocatedSize = 0;
+    m_error = false;
+
+    // Like the sidechain itself, so the disk keeps up with the encoder
+    start(QThread::HighPriority);
+    return true;
+}
+
+bool RecordingFileWriter::close() {
+    if (!isOpen()) {
+        return !m_error;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        m_chunksAvailable.wakeAll();
+    }
+    wait();
+#ifdef __LINUX__
+    // Release the space that has been preallocated beyond the end
+    // of the file
+    if (m_allocatedSize > m_size &&
+            m_allocatedSize != std::numeric_limits<qint64>::max() &&
+            ftruncate(m_file.handle(), m_size) != 0) {
+        kLogger.warning()
+                << "Failed to release preallocated space of"
+                << m_file.fileName();
+    }
+#endif
+    m_file.close();
+    return !m_error;
+}
+
+void RecordingFileWriter::write(const char* pData, int length) {
+    while (length > 0) {
+        const int chunkLength = math_min(length, kMaxChunkLength);
+        enqueue(pData, chunkLength);
+        pData += chunkLength;
+        length -= chunkLength;
+    }
+
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
+    if (m_unwrittenBytes >= kBlockSize ||
+            nowNanos - m_lastWakeNanos >= kMaxWriteDelayNanos) {
+        m_lastWakeNanos = nowNanos;
+        wakeWriter();
+    }
+}
+
+void RecordingFileWriter::enqueue(const char* pData, int length) {
+    if (m_pData->writeAvailable() < length || m_pChunks->writeAvailable() < 1) {
+        // Backpressure: the disk does not keep up
+        Trace trace("RecordingFileWriter::enqueue blocked");
+        const qint64 startNanos = mixxx::Time::elapsed().toIntegerNanos();
+        QMutexLocker locker(&m_mutex);
+        m_chunksAvailable.wakeAll();
+        while (m_pData->writeAvailable() < length || m_pChunks->writeAvailable() < 1) {
+            m_spaceAvailable.wait(&m_mutex);
+        }
+        locker.unlock();
+        Stat::track(kBlockedStat,
+                Stat::DURATION_NANOSEC,
+                Stat::experimentFlags(kDefaultComputeFlags),
+                mixxx::Time::elapsed().toIntegerNanos() - startNanos);
+    }
+
+    // The data must be complete before the writer sees the chunk
+    m_pData->write(pData, length);
+    const Chunk chunk{m_position, length};
+    m_pChunks->write(&chunk, 1);
+
+    m_position += length;
+    m_size = math_max(m_size, m_position);
+    m_unwrittenBytes = m_pData->readAvailable();
+    Stat::track(kBufferFillStat,
+            Stat::UNSPECIFIED,
+            Stat::experimentFlags(kDefaultComputeFlags),
+            m_unwrittenBytes);
+}
+
+void RecordingFileWriter::wakeWriter() {
+    QMutexLocker locker(&m_mutex);
+    m_chunksAvailable.wakeAll();
+}
+
+void RecordingFileWriter::run() {
+    QThread::currentThread()->setObjectName("RecordingFileWriter");
+    Chunk chunk;
+    while (true) {
+        if (m_pChunks->read(&chunk, 1) == 1) {
+            collectChunk(chunk);
+            continue;
+        }
+
+        // Nothing queued, write what has been collected so far
+        writeBlock();
+
+        QMutexLocker locker(&m_mutex);
+        if (m_pChunks->readAvailable() > 0) {
+            continue;
+        }
+        if (m_stop) {
+            break;
+        }
+        m_chunksAvailable.wait(&m_mutex);
+    }
+}
+
+void RecordingFileWriter::collectChunk(const Chunk& chunk) {
+    if (m_blockLength > 0 &&
+            (chunk.offset != m_blockOffset + m_blockLength ||
+                    m_blockLength + chunk.length > kBlockSize)) {
+        writeBlock();
+    }
+    if (m_blockLength == 0) {
+        m_blockOffset = chunk.offset;
+    }
+    m_pData->read(&m_block[m_blockLength], chunk.length);
+    m_blockLength += chunk.length;
+
+    QMutexLocker locker(&m_mutex);
+    m_spaceAvailable.wakeAll();
+}
+
+void RecordingFileWriter::writeBlock() {
+    if (m_blockLength == 0) {
+        return;
+    }
+    // After an error the data is still consumed, so the producer never
+    // blocks forever.
+    if (!m_error) {
+        Trace trace("RecordingFileWriter::writeBlock");
+        const qint64 startNanos = mixxx::Time::elapsed().toIntegerNanos();
+        preallocate(m_blockOffset + m_blockLength);
+        if ((m_file.pos() != m_blockOffset && !m_file.seek(m_blockOffset)) ||
+                m_file.write(m_block.data(), m_blockLength) != m_blockLength) {
+            kLogger.warning()
+                    << "Failed to write"
+                    << m_file.fileName()
+                    << m_file.errorString();
+            Counter("RecordingFileWriter write error").increment();
+            m_error = true;
+        }
+        Stat::track(kBlockWriteStat,
+                Stat::DURATION_NANOSEC,
+                Stat::experimentFlags(kDefaultComputeFlags),
+                mixxx::Time::elapsed().toIntegerNanos() - startNanos);
+    }
+    m_blockLength = 0;
+}
+
+void RecordingFileWriter::preallocate(qint64 end) {
+#ifdef __LINUX__
+    if (end <= m_allocatedSize) {
+        return;
+    }
+    const qint64 allocatedSize = end + kPreallocationSize;
+    // Unlike posix_fallocate() this keeps the file size, so a recording
+    // interrupted by a crash does not end in silence.
+    if (fallocate(m_file.handle(),
+                FALLOC_FL_KEEP_SIZE,
+                m_allocatedSize,
+                allocatedSize - m_allocatedSize) == 0) {
+        m_allocatedSize = allocatedSize;
+    } else {
+        // Not supported by the file system
+        m_allocatedSize = std::numeric_limits<qint64>::max();
+    }
+#else
+    Q_UNUSED(end);
+#endif
+}
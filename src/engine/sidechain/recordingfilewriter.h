@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "util/fifo.h"
+
+// Writes the encoded recording on its own thread, so a slow disk or a
+// stalled flush does not delay the sidechain and overflow its sample FIFO.
+//
+// The encoder output is copied into a large ring buffer. The writer thread
+// collects it into blocks and writes each block with a single call. On
+// Linux the file is preallocated in large steps to avoid fragmentation.
+// The encoders seek back to update their headers, so every piece of data
+// carries its file offset and the logical position and size of the file
+// are maintained on the producer side.
+//
+// Only if the ring buffer is full does write() block until the disk has
+// caught up. The time blocked, the fill level of the ring buffer and the
+// duration of each block write are tracked as stats.
+class RecordingFileWriter : public QThread {
+    Q_OBJECT
+  public:
+    // 32 MiB last for 3 minutes of 16 bit stereo WAV at 44.1 kHz
+    static constexpr int kDefaultBufferSize = 32 * 1024 * 1024;
+
+    explicit RecordingFileWriter(int bufferSize = kDefaultBufferSize);
+    ~RecordingFileWriter() override;
+
+    // Creates or truncates the file and starts the writer thread
+    bool open(const QString& fileName);
+    // Waits until all data has been written and closes the file.
+    // Returns false if any write failed.
+    bool close();
+    bool isOpen() const {
+        return m_file.isOpen();
+    }
+
+    // The following functions must only be called from a single thread
+    // while the file is open.
+
+    // Writes at the current position, blocks only if the buffer is full
+    void write(const char* pData, int length);
+    void seek(qint64 position) {
+        m_position = position;
+    }
+    qint64 pos() const {
+        return m_position;
+    }
+    qint64 size() const {
+        return m_size;
+    }
+
+  private:
+    struct Chunk {
+        qint64 offset;
+        int length;
+    };
+
+    void run() override;
+
+    void enqueue(const char* pData, int length);
+    void wakeWriter();
+    void collectChunk(const Chunk& chunk);
+    void writeBlock();
+    void preallocate(qint64 end);
+
+    const int m_bufferSize;
+    QFile m_file;
+
+    // Created when the first file is opened
+    std::unique_ptr<FIFO<char>> m_pData;
+    std::unique_ptr<FIFO<Chunk>> m_pChunks;
+
+    QMutex m_mutex;
+    QWaitCondition m_chunksAvailable;
+    QWaitCondition m_spaceAvailable;
+    bool m_stop;
+
+    // Producer side
+    qint64 m_position;
+    qint64 m_size;
+    int m_unwrittenBytes;
+    qint64 m_lastWakeNanos;
+
+    // Writer thread
+    std::vector<char> m_block;
+    qint64 m_blockOffset;
+    int m_blockLength;
+    qint64 m_allocatedSize;
+
+    std::atomic<bool> m_error;
+};
@@ -340,11 +340,9 @@ void DlgAutoDJ::updateSelectionInfo() {
 
     QModelIndexList indices = m_pTrackTableView->selectionModel()->selectedRows();
 
-    for (int i = 0; i < indices.size(); ++i) {
-        TrackPointer pTrack = m_pAutoDJTableModel->getTrack(indices.at(i));
-        if (pTrack) {
-            duration += pTrack->getDuration();
-        }
+    const TrackPointerList tracks = m_pAutoDJTableModel->getTracks(indices);
+    for (const auto& pTrack : tracks) {
+        duration += pTrack->getDuration();
     }
 
     QString label;
@@ -2,6 +2,10 @@
 
 #include "library/basesqltablemodel.h"
 
+#include <QDateTime>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 #include <QUrl>
 #include <QtDebug>
 #include <algorithm>
@@ -18,6 +22,7 @@
 #include "util/assert.h"
 #include "util/datetime.h"
 #include "util/db/dbconnection.h"
+#include "util/db/dbconnectionpooled.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
 #include "util/platform.h"
@@ -32,13 +37,91 @@ const bool sDebug = false;
 const int kIdColumn = 0;
 const int kMaxSortColumns = 3;
 
+// Asynchronous queries fetch the rows that are accessed in pages
+// of this size on demand, i.e. the visible rows are loaded first.
+const int kSelectPageSize = 100;
+// All remaining rows are read sequentially in chunks of this size.
+// Pending requests for pages are processed between two chunks.
+const int kSelectChunkSize = 1000;
+
+// Priorities of asynchronous queries in the read-only thread pool
+const int kSelectPagePriority = 1;
+const int kSelectChunkPriority = 0;
+
 // Constant for getModelSetting(name)
 const QString COLUMNS_SORTING = QStringLiteral("ColumnsSorting");
 
 const QString kEmptyString = QStringLiteral("");
 
+class SelectTask : public QRunnable {
+  public:
+    explicit SelectTask(std::function<void()> function)
+            : m_function(std::move(function)) {
+    }
+
+    void run() override {
+        m_function();
+    }
+
+  private:
+    const std::function<void()> m_function;
+};
+
+const qint64 kRandomOrderSeedModulus = 1000000007;
+
+// A pseudo-random permutation of the ids for sorting tracks randomly.
+// Unlike RANDOM() the order is stable for a given seed, i.e. pages
+// that are fetched separately are consistent.
+QString randomOrderForIdColumn(const QString& idColumn, int seed) {
+    return QString("((%1 + %2) * 2654435761 % 4294967291 * 1597334677 % 4294967279)")
+            .arg(idColumn, QString::number(seed));
+}
+
 } // anonymous namespace
 
+struct BaseSqlTableModel::SelectQuery {
+    // Statements for creating the temporary views on the read-only
+    // connection that are referenced by name in the following queries
+    QStringList temporaryViewDefinitions;
+    QString countQuery;
+    // Selects either all table columns or only the ids if the rows
+    // are sorted by track source columns
+    QString rowsQuery;
+    QString rowsIdColumn;
+    // Selects the table columns for the ids of rowsQuery if only the
+    // ids are selected by rowsQuery, empty otherwise
+    QString tableColumnsQuery;
+    QString tableIdColumn;
+    QString idColumn;
+    int columnCount = 0;
+};
+
+struct BaseSqlTableModel::SelectStream {
+    SelectStream(
+            mixxx::DbConnectionPoolPtr pDbConnectionPool,
+            QThreadPool* pThreadPool,
+            SelectQueryPointer pSelectQuery,
+            QFutureInterface<SelectResult> futureInterface)
+            : pDbConnectionPool(std::move(pDbConnectionPool)),
+              pThreadPool(pThreadPool),
+              pSelectQuery(std::move(pSelectQuery)),
+              futureInterface(std::move(futureInterface)),
+              pThread(nullptr),
+              nextRow(0) {
+    }
+
+    const mixxx::DbConnectionPoolPtr pDbConnectionPool;
+    QThreadPool* const pThreadPool;
+    const SelectQueryPointer pSelectQuery;
+    QFutureInterface<SelectResult> futureInterface;
+
+    // The open query is bound to the thread-local connection and
+    // must only be accessed and destroyed by the same thread
+    QThread* pThread;
+    std::unique_ptr<QSqlQuery> pRowsQuery;
+    int nextRow;
+};
+
 BaseSqlTableModel::BaseSqlTableModel(
         QObject* parent,
         TrackCollectionManager* pTrackCollectionManager,
@@ -47,10 +130,14 @@ BaseSqlTableModel::BaseSqlTableModel(
           m_pTrackCollectionManager(pTrackCollectionManager),
           m_database(pTrackCollectionManager->internalCollection()->database()),
           m_bInitialized(false),
+          m_bSelectAsync(false),
+          m_pSelectWatcher(nullptr),
           m_currentSearch(kEmptyString) {
 }
 
 BaseSqlTableModel::~BaseSqlTableModel() {
+    // Abort all pending asynchronous queries
+    cancelSelectAsync();
 }
 
 void BaseSqlTableModel::initHeaderProperties() {
@@ -102,7 +189,7 @@ void BaseSqlTableModel::initSortColumnMapping() {
 }
 
 void BaseSqlTableModel::clearRows() {
-    DEBUG_ASSERT(m_rowInfo.empty() == m_trackIdToRows.empty());
+    // Placeholder rows of asynchronous queries are not mapped
     DEBUG_ASSERT(m_rowInfo.size() >= m_trackIdToRows.size());
     if (!m_rowInfo.isEmpty()) {
         beginRemoveRows(QModelIndex(), 0, m_rowInfo.size() - 1);
@@ -136,6 +223,69 @@ void BaseSqlTableModel::replaceRows(
     }
 }
 
+void BaseSqlTableModel::setSelectAsync(bool selectAsync) {
+    m_bSelectAsync = selectAsync &&
+            m_pTrackCollectionManager->readOnlyDbConnectionPool();
+    // Sequential reading of rows in multiple tasks requires that all
+    // tasks are executed by the same thread and connection
+    DEBUG_ASSERT(!m_bSelectAsync ||
+            m_pTrackCollectionManager->readOnlyDbThreadPool()->maxThreadCount() == 1);
+}
+
+bool BaseSqlTableModel::createTemporaryView(const QString& createViewStatement) {
+    m_temporaryViewDefinition = createViewStatement;
+    QSqlQuery query(m_database);
+    if (!query.prepare(createViewStatement) || !query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
+
+//static
+bool BaseSqlTableModel::readRows(
+        QSqlQuery* pQuery,
+        const QString& idColumnName,
+        int columnCount,
+        QVector<RowInfo>* pRowInfos,
+        int maxRows) {
+    DEBUG_ASSERT(pQuery);
+    DEBUG_ASSERT(pRowInfos);
+    // The size of the result set is not known in advance for a
+    // forward-only query, so we cannot reserve memory for rows
+    // in advance.
+    int idColumn = -1;
+    int rowCount = 0;
+    while ((maxRows < 0 || rowCount < maxRows) && pQuery->next()) {
+        ++rowCount;
+        QSqlRecord sqlRecord = pQuery->record();
+
+        if (idColumn < 0) {
+            idColumn = sqlRecord.indexOf(idColumnName);
+        }
+        VERIFY_OR_DEBUG_ASSERT(idColumn >= 0) {
+            qCritical()
+                    << "ID column not available in database query results:"
+                    << idColumnName;
+            return false;
+        }
+        // TODO(XXX): Can we get rid of the hard-coded assumption that
+        // the the first column always contains the id?
+        DEBUG_ASSERT(idColumn == kIdColumn);
+
+        RowInfo rowInfo;
+        rowInfo.trackId = TrackId(sqlRecord.value(idColumn));
+        // current position defines the ordering
+        rowInfo.order = pRowInfos->size();
+        rowInfo.metadata.reserve(sqlRecord.count());
+        for (int i = 0; i < columnCount; ++i) {
+            rowInfo.metadata.push_back(sqlRecord.value(i));
+        }
+        pRowInfos->push_back(rowInfo);
+    }
+    return true;
+}
+
 void BaseSqlTableModel::select() {
     if (!m_bInitialized) {
         return;
@@ -155,6 +305,26 @@ void BaseSqlTableModel::select() {
         qDebug() << this << "select()";
     }
 
+    // Any pending asynchronous query has become stale
+    cancelSelectAsync();
+
+    if (m_bSelectAsync) {
+        if (m_trackSource) {
+            // Filtering and sorting is done by the database that
+            // must reflect all pending modifications of tracks.
+            const QList<TrackPointer> dirtyTracks = m_trackSource->dirtyTracks();
+            if (!dirtyTracks.isEmpty()) {
+                m_pTrackCollectionManager->saveTracks(dirtyTracks);
+            }
+        }
+        selectAsync(buildSelectQuery());
+        return;
+    }
+
+    selectSync();
+}
+
+void BaseSqlTableModel::selectSync() {
     PerformanceTimer time;
     time.start();
 
@@ -179,52 +349,506 @@ void BaseSqlTableModel::select() {
         return;
     }
 
+    QVector<RowInfo> rowInfos;
+    if (!readRows(&query, m_idColumn, m_tableColumns.size(), &rowInfos)) {
+        return;
+    }
+
     // Remove all the rows from the table after(!) the query has been
     // executed successfully. See Bug #1090888.
     // TODO(rryan) we could edit the table in place instead of clearing it?
     clearRows();
 
-    // The size of the result set is not known in advance for a
-    // forward-only query, so we cannot reserve memory for rows
-    // in advance.
-    QVector<RowInfo> rowInfos;
-    QSet<TrackId> trackIds;
-    int idColumn = -1;
-    while (query.next()) {
-        QSqlRecord sqlRecord = query.record();
+    finishSelect(std::move(rowInfos));
 
-        if (idColumn < 0) {
-            idColumn = sqlRecord.indexOf(m_idColumn);
+    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
+             << m_rowInfo.size();
+}
+
+BaseSqlTableModel::SelectQueryPointer BaseSqlTableModel::buildSelectQuery() const {
+    auto pSelectQuery = std::make_shared<SelectQuery>();
+    if (m_trackSource && !m_trackSource->temporaryViewDefinition().isEmpty()) {
+        pSelectQuery->temporaryViewDefinitions.append(
+                m_trackSource->temporaryViewDefinition());
+    }
+    if (!m_temporaryViewDefinition.isEmpty()) {
+        pSelectQuery->temporaryViewDefinitions.append(m_temporaryViewDefinition);
+    }
+    pSelectQuery->idColumn = m_idColumn;
+    pSelectQuery->columnCount = m_tableColumns.size();
+
+    // All queries are composed in a single pass to prevent placeholders
+    // in the search text from being replaced accidentally.
+    const QString tableColumns = m_tableColumns.join(",");
+    const QString tableIdColumn = QString("%1.%2").arg(m_tableName, m_idColumn);
+    QString tableFilter;
+    if (m_trackSource) {
+        QString trackSourceFilter = m_trackSource->filterCondition(
+                m_currentSearch, m_currentSearchFilter);
+        if (!trackSourceFilter.isEmpty()) {
+            trackSourceFilter.prepend(" WHERE ");
         }
-        VERIFY_OR_DEBUG_ASSERT(idColumn >= 0) {
-            qCritical()
-                    << "ID column not available in database query results:"
-                    << m_idColumn;
+        tableFilter = QString(" WHERE %1 IN (SELECT %2 FROM %3%4)")
+                              .arg(tableIdColumn,
+                                      m_trackSource->idColumn(),
+                                      m_trackSource->tableName(),
+                                      trackSourceFilter);
+    }
+    pSelectQuery->countQuery = QString("SELECT COUNT(*) FROM %1%2")
+                                       .arg(m_tableName, tableFilter);
+
+    if (m_trackSource && !m_trackSourceOrderBy.isEmpty()) {
+        // Sort the ids of the track source and fetch the table columns
+        // for these ids in a second step. Only a single table is involved
+        // in each query, i.e. the column names of the ORDER BY clause
+        // are unambiguous.
+        QString trackSourceFilter = m_trackSource->filterCondition(
+                m_currentSearch, m_currentSearchFilter);
+        if (!trackSourceFilter.isEmpty()) {
+            trackSourceFilter = QString("(%1) AND ").arg(trackSourceFilter);
+        }
+        pSelectQuery->rowsQuery =
+                QString("SELECT %1 FROM %2 WHERE %3%1 IN (SELECT %4 FROM %5) %6, %1")
+                        .arg(m_trackSource->idColumn(),
+                                m_trackSource->tableName(),
+                                trackSourceFilter,
+                                tableIdColumn,
+                                m_tableName,
+                                m_trackSourceOrderBy);
+        pSelectQuery->rowsIdColumn = m_trackSource->idColumn();
+        pSelectQuery->tableColumnsQuery =
+                QString("SELECT %1 FROM %2").arg(tableColumns, m_tableName);
+        pSelectQuery->tableIdColumn = tableIdColumn;
+    } else {
+        // The id is appended as the last sort criterion to obtain a
+        // total order that is required for paging
+        const QString orderBy = m_tableOrderBy.isEmpty()
+                ? QString("ORDER BY %1").arg(tableIdColumn)
+                : QString("%1, %2").arg(m_tableOrderBy, tableIdColumn);
+        pSelectQuery->rowsQuery = QString("SELECT %1 FROM %2%3 %4")
+                                          .arg(tableColumns,
+                                                  m_tableName,
+                                                  tableFilter,
+                                                  orderBy);
+        pSelectQuery->rowsIdColumn = m_idColumn;
+    }
+    return pSelectQuery;
+}
+
+void BaseSqlTableModel::selectAsync(
+        SelectQueryPointer pSelectQuery) {
+    DEBUG_ASSERT(!m_pSelectQuery);
+    DEBUG_ASSERT(!m_pSelectWatcher);
+    if (sDebug) {
+        qDebug() << this << "select() executing asynchronously:"
+                 << pSelectQuery->countQuery
+                 << pSelectQuery->rowsQuery;
+    }
+
+    m_selectTimer.start();
+    m_pSelectQuery = pSelectQuery;
+    m_selectFutureInterface = QFutureInterface<SelectResult>();
+    m_selectFutureInterface.reportStarted();
+
+    // Each query gets its own watcher. Watchers of superseded queries
+    // are disconnected to discard their results.
+    m_pSelectWatcher = new QFutureWatcher<SelectResult>(this);
+    connect(m_pSelectWatcher,
+            &QFutureWatcher<SelectResult>::resultsReadyAt,
+            this,
+            &BaseSqlTableModel::slotSelectResultsReadyAt);
+    m_pSelectWatcher->setFuture(m_selectFutureInterface.future());
+
+    QThreadPool* pThreadPool = m_pTrackCollectionManager->readOnlyDbThreadPool();
+    auto pSelectStream = std::make_shared<SelectStream>(
+            m_pTrackCollectionManager->readOnlyDbConnectionPool(),
+            pThreadPool,
+            std::move(pSelectQuery),
+            m_selectFutureInterface);
+    pThreadPool->start(
+            new SelectTask([pSelectStream]() {
+                selectNextChunk(pSelectStream);
+            }),
+            kSelectPagePriority);
+}
+
+void BaseSqlTableModel::cancelSelectAsync() {
+    if (m_pSelectWatcher) {
+        m_pSelectWatcher->disconnect(this);
+        m_pSelectWatcher->deleteLater();
+        m_pSelectWatcher = nullptr;
+    }
+    m_selectFutureInterface.cancel();
+    m_pSelectQuery.reset();
+    m_requestedPages.clear();
+}
+
+void BaseSqlTableModel::slotSelectResultsReadyAt(int beginIndex, int endIndex) {
+    for (int i = beginIndex; i < endIndex; ++i) {
+        // Results might cancel the query and delete the watcher
+        if (!m_pSelectWatcher) {
             return;
         }
-        // TODO(XXX): Can we get rid of the hard-coded assumption that
-        // the the first column always contains the id?
-        DEBUG_ASSERT(idColumn == kIdColumn);
+        receiveSelectResult(m_pSelectWatcher->resultAt(i));
+    }
+}
 
-        TrackId trackId(sqlRecord.value(idColumn));
-        trackIds.insert(trackId);
+void BaseSqlTableModel::receiveSelectResult(SelectResult&& result) {
+    switch (result.type) {
+    case SelectResult::Type::RowCount:
+        if (!result.succeeded) {
+            qWarning() << this
+                       << "Falling back to a synchronous select()";
+            cancelSelectAsync();
+            selectSync();
+            return;
+        }
+        // Publish placeholders for all rows
+        clearRows();
+        if (result.rowCount > 0) {
+            beginInsertRows(QModelIndex(), 0, result.rowCount - 1);
+            m_rowInfo.resize(result.rowCount);
+            endInsertRows();
+        }
+        qDebug() << this << "select() found" << result.rowCount
+                 << "rows after" << m_selectTimer.elapsed().debugMillisWithUnit();
+        return;
+    case SelectResult::Type::Page:
+        if (result.succeeded) {
+            placeRows(result.firstRow, result.rowInfos, false);
+        }
+        return;
+    case SelectResult::Type::Chunk:
+        if (!result.succeeded) {
+            return;
+        }
+        // The sequentially read rows supersede the pages that have
+        // been fetched on demand from a different snapshot
+        placeRows(result.firstRow, result.rowInfos, true);
+        if (result.complete) {
+            truncateRows(result.firstRow + result.rowInfos.size());
+            m_pSelectQuery.reset();
+            qDebug() << this << "select() took"
+                     << m_selectTimer.elapsed().debugMillisWithUnit()
+                     << "for" << m_rowInfo.size() << "rows";
+        }
+        return;
+    }
+}
 
-        RowInfo rowInfo;
-        rowInfo.trackId = trackId;
-        // current position defines the ordering
-        rowInfo.order = rowInfos.size();
-        rowInfo.metadata.reserve(sqlRecord.count());
-        for (int i = 0; i < m_tableColumns.size(); ++i) {
-            rowInfo.metadata.push_back(sqlRecord.value(i));
+void BaseSqlTableModel::requestRows(int row) const {
+    if (!m_pSelectQuery) {
+        return;
+    }
+    const int page = row / kSelectPageSize;
+    if (m_requestedPages.contains(page)) {
+        return;
+    }
+    m_requestedPages.insert(page);
+    const mixxx::DbConnectionPoolPtr pDbConnectionPool =
+            m_pTrackCollectionManager->readOnlyDbConnectionPool();
+    const SelectQueryPointer pSelectQuery = m_pSelectQuery;
+    QFutureInterface<SelectResult> futureInterface = m_selectFutureInterface;
+    m_pTrackCollectionManager->readOnlyDbThreadPool()->start(
+            new SelectTask([pDbConnectionPool,
+                                   pSelectQuery,
+                                   futureInterface,
+                                   page]() mutable {
+                if (futureInterface.isCanceled()) {
+                    return;
+                }
+                futureInterface.reportResult(selectPage(
+                        pDbConnectionPool,
+                        *pSelectQuery,
+                        page * kSelectPageSize,
+                        kSelectPageSize));
+            }),
+            kSelectPagePriority);
+}
+
+void BaseSqlTableModel::placeRows(
+        int firstRow,
+        const QVector<RowInfo>& rowInfos,
+        bool overwrite) {
+    if (rowInfos.isEmpty()) {
+        return;
+    }
+    const int lastRow = firstRow + rowInfos.size() - 1;
+    if (lastRow >= m_rowInfo.size()) {
+        // Tracks have been added after counting the rows
+        beginInsertRows(QModelIndex(), m_rowInfo.size(), lastRow);
+        m_rowInfo.resize(lastRow + 1);
+        endInsertRows();
+    }
+    for (int i = 0; i < rowInfos.size(); ++i) {
+        const int row = firstRow + i;
+        RowInfo& rowInfo = m_rowInfo[row];
+        if (rowInfo.trackId.isValid()) {
+            if (!overwrite) {
+                continue;
+            }
+            if (rowInfo.trackId != rowInfos[i].trackId) {
+                auto rowsIter = m_trackIdToRows.find(rowInfo.trackId);
+                if (rowsIter != m_trackIdToRows.end()) {
+                    rowsIter.value().removeOne(row);
+                    if (rowsIter.value().isEmpty()) {
+                        m_trackIdToRows.erase(rowsIter);
+                    }
+                }
+                m_trackIdToRows[rowInfos[i].trackId].push_back(row);
+            }
+        } else {
+            m_trackIdToRows[rowInfos[i].trackId].push_back(row);
+        }
+        rowInfo = rowInfos[i];
+        rowInfo.order = row;
+    }
+    emit dataChanged(
+            index(firstRow, 0),
+            index(lastRow, columnCount() - 1));
+}
+
+void BaseSqlTableModel::truncateRows(int rowCount) {
+    if (rowCount >= m_rowInfo.size()) {
+        return;
+    }
+    // Tracks have been removed after counting the rows
+    beginRemoveRows(QModelIndex(), rowCount, m_rowInfo.size() - 1);
+    for (int row = rowCount; row < m_rowInfo.size(); ++row) {
+        const TrackId trackId = m_rowInfo[row].trackId;
+        if (!trackId.isValid()) {
+            continue;
+        }
+        auto rowsIter = m_trackIdToRows.find(trackId);
+        if (rowsIter != m_trackIdToRows.end()) {
+            rowsIter.value().removeOne(row);
+            if (rowsIter.value().isEmpty()) {
+                m_trackIdToRows.erase(rowsIter);
+            }
+        }
+    }
+    m_rowInfo.resize(rowCount);
+    endRemoveRows();
+}
+
+//static
+bool BaseSqlTableModel::prepareSelectConnection(
+        const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+        const SelectQuery& selectQuery) {
+    // The connection is opened only once per worker thread
+    // and reused for all subsequent queries. It is closed
+    // when the thread terminates.
+    if (!pDbConnectionPool->hasThreadLocalConnection() &&
+            !pDbConnectionPool->createThreadLocalConnection()) {
+        return false;
+    }
+    if (selectQuery.temporaryViewDefinitions.isEmpty()) {
+        return true;
+    }
+    // Temporary views only exist for the connection that created
+    // them. Creating them in the temporary schema of the read-only
+    // connection requires to lift the restriction temporarily.
+    QSqlQuery query(mixxx::DbConnectionPooled(pDbConnectionPool));
+    if (!query.exec(QStringLiteral("PRAGMA query_only=OFF"))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    bool succeeded = true;
+    for (const auto& temporaryViewDefinition : selectQuery.temporaryViewDefinitions) {
+        if (!query.exec(temporaryViewDefinition)) {
+            LOG_FAILED_QUERY(query);
+            succeeded = false;
+            break;
+        }
+    }
+    if (!query.exec(QStringLiteral("PRAGMA query_only=ON"))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return succeeded;
+}
+
+//static
+bool BaseSqlTableModel::fetchRows(
+        QSqlDatabase database,
+        const SelectQuery& selectQuery,
+        QSqlQuery* pQuery,
+        int maxRows,
+        QVector<RowInfo>* pRowInfos) {
+    if (selectQuery.tableColumnsQuery.isEmpty()) {
+        return readRows(
+                pQuery,
+                selectQuery.idColumn,
+                selectQuery.columnCount,
+                pRowInfos,
+                maxRows);
+    }
+    if (!readRows(pQuery, selectQuery.rowsIdColumn, 1, pRowInfos, maxRows)) {
+        return false;
+    }
+    if (pRowInfos->isEmpty()) {
+        return true;
+    }
+
+    QStringList idStrings;
+    idStrings.reserve(pRowInfos->size());
+    for (const auto& rowInfo : qAsConst(*pRowInfos)) {
+        idStrings.append(rowInfo.trackId.toString());
+    }
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    if (!query.prepare(QString("%1 WHERE %2 IN (%3)")
+                               .arg(selectQuery.tableColumnsQuery,
+                                       selectQuery.tableIdColumn,
+                                       idStrings.join(","))) ||
+            !query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    QVector<RowInfo> tableRows;
+    if (!readRows(&query, selectQuery.idColumn, selectQuery.columnCount, &tableRows)) {
+        return false;
+    }
+    QHash<TrackId, QVector<QVariant>> tableColumnsById;
+    tableColumnsById.reserve(tableRows.size());
+    for (const auto& tableRow : qAsConst(tableRows)) {
+        tableColumnsById.insert(tableRow.trackId, tableRow.metadata);
+    }
+    for (auto& rowInfo : *pRowInfos) {
+        rowInfo.metadata = tableColumnsById.value(rowInfo.trackId);
+        if (rowInfo.metadata.isEmpty()) {
+            // The track has been removed from the table in the meantime
+            rowInfo.metadata.resize(selectQuery.columnCount);
+            rowInfo.metadata[kIdColumn] = rowInfo.trackId.toVariant();
         }
-        rowInfos.push_back(rowInfo);
     }
+    return true;
+}
+
+//static
+BaseSqlTableModel::SelectResult BaseSqlTableModel::selectPage(
+        const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+        const SelectQuery& selectQuery,
+        int firstRow,
+        int rowCount) {
+    SelectResult result;
+    result.type = SelectResult::Type::Page;
+    result.firstRow = firstRow;
+    if (!prepareSelectConnection(pDbConnectionPool, selectQuery)) {
+        return result;
+    }
+    const QSqlDatabase database = mixxx::DbConnectionPooled(pDbConnectionPool);
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    if (!query.prepare(QString("%1 LIMIT %2 OFFSET %3")
+                               .arg(selectQuery.rowsQuery,
+                                       QString::number(rowCount),
+                                       QString::number(firstRow))) ||
+            !query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return result;
+    }
+    result.succeeded = fetchRows(
+            database,
+            selectQuery,
+            &query,
+            rowCount,
+            &result.rowInfos);
+    return result;
+}
+
+//static
+void BaseSqlTableModel::selectNextChunk(
+        const std::shared_ptr<SelectStream>& pSelectStream) {
+    SelectStream& selectStream = *pSelectStream;
+    const SelectQuery& selectQuery = *selectStream.pSelectQuery;
+    QFutureInterface<SelectResult>& futureInterface = selectStream.futureInterface;
+    if (futureInterface.isCanceled()) {
+        selectStream.pRowsQuery.reset();
+        futureInterface.reportFinished();
+        return;
+    }
+
+    if (!selectStream.pRowsQuery) {
+        // Count the rows first to publish placeholders
+        SelectResult result;
+        result.type = SelectResult::Type::RowCount;
+        result.succeeded = prepareSelectConnection(
+                selectStream.pDbConnectionPool, selectQuery);
+        if (result.succeeded) {
+            selectStream.pThread = QThread::currentThread();
+            const QSqlDatabase database =
+                    mixxx::DbConnectionPooled(selectStream.pDbConnectionPool);
+            selectStream.pRowsQuery = std::make_unique<QSqlQuery>(database);
+            QSqlQuery* pQuery = selectStream.pRowsQuery.get();
+            if (!pQuery->exec(selectQuery.countQuery) || !pQuery->next()) {
+                LOG_FAILED_QUERY(*pQuery);
+                result.succeeded = false;
+            } else {
+                result.rowCount = pQuery->value(0).toInt();
+                pQuery->finish();
+                pQuery->setForwardOnly(true);
+                if (!pQuery->prepare(selectQuery.rowsQuery) || !pQuery->exec()) {
+                    LOG_FAILED_QUERY(*pQuery);
+                    result.succeeded = false;
+                }
+            }
+        }
+        futureInterface.reportResult(result);
+        if (!result.succeeded) {
+            selectStream.pRowsQuery.reset();
+            futureInterface.reportFinished();
+            return;
+        }
+    } else {
+        VERIFY_OR_DEBUG_ASSERT(selectStream.pThread == QThread::currentThread()) {
+            // Abort, the query cannot be accessed from a different thread
+            selectStream.pRowsQuery.release();
+            futureInterface.reportFinished();
+            return;
+        }
+        SelectResult result;
+        result.type = SelectResult::Type::Chunk;
+        result.firstRow = selectStream.nextRow;
+        result.succeeded = fetchRows(
+                mixxx::DbConnectionPooled(selectStream.pDbConnectionPool),
+                selectQuery,
+                selectStream.pRowsQuery.get(),
+                kSelectChunkSize,
+                &result.rowInfos);
+        result.complete = !result.succeeded ||
+                result.rowInfos.size() < kSelectChunkSize;
+        selectStream.nextRow += result.rowInfos.size();
+        futureInterface.reportResult(result);
+        if (result.complete) {
+            selectStream.pRowsQuery.reset();
+            futureInterface.reportFinished();
+            return;
+        }
+    }
+
+    // Continue with the next chunk after all pending requests for pages
+    selectStream.pThreadPool->start(
+            new SelectTask([pSelectStream]() {
+                selectNextChunk(pSelectStream);
+            }),
+            kSelectChunkPriority);
+}
+
+void BaseSqlTableModel::finishSelect(
+        QVector<RowInfo>&& rowInfos) {
+    DEBUG_ASSERT(m_rowInfo.isEmpty());
 
     if (sDebug) {
         qDebug() << "Rows actually received:" << rowInfos.size();
     }
 
     if (m_trackSource) {
+        QSet<TrackId> trackIds;
+        trackIds.reserve(rowInfos.size());
+        for (const auto& rowInfo : qAsConst(rowInfos)) {
+            trackIds.insert(rowInfo.trackId);
+        }
         m_trackSource->filterAndSort(trackIds,
                 m_currentSearch,
                 m_currentSearchFilter,
@@ -278,9 +902,6 @@ void BaseSqlTableModel::select() {
             std::move(trackIdToRows));
     // Both rowInfo and trackIdToRows (might) have been moved and
     // must not be used afterwards!
-
-    qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
-             << m_rowInfo.size();
 }
 
 void BaseSqlTableModel::setTable(const QString& tableName,
@@ -453,12 +1074,17 @@ void BaseSqlTableModel::setSort(int column, Qt::SortOrder order) {
     // reset the old order by clauses
     m_trackSourceOrderBy.clear();
     m_tableOrderBy.clear();
+    const int randomOrderSeed = static_cast<int>(
+            QDateTime::currentMSecsSinceEpoch() % kRandomOrderSeedModulus);
 
     if (column > 0 && column < m_tableColumns.size()) {
         // Table sorting, no history
         if (column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_PREVIEW)) {
             // Random sort easter egg
-            m_tableOrderBy = "ORDER BY RANDOM()";
+            m_tableOrderBy = "ORDER BY " +
+                    randomOrderForIdColumn(
+                            QString("%1.%2").arg(m_tableName, m_idColumn),
+                            randomOrderSeed);
         } else {
             m_tableOrderBy = "ORDER BY ";
             QString field = m_tableColumns[column];
@@ -477,7 +1103,8 @@ void BaseSqlTableModel::setSort(int column, Qt::SortOrder order) {
                     sort_field = m_trackSource->columnSortForFieldIndex(kIdColumn);
                 } else if (sc.m_column ==
                         fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_PREVIEW)) {
-                    sort_field = "RANDOM()";
+                    sort_field = randomOrderForIdColumn(
+                            m_trackSource->idColumn(), randomOrderSeed);
                 } else {
                     // we can't sort by other table columns here since primary sort is a track
                     // column: skip
@@ -575,6 +1202,11 @@ QVariant BaseSqlTableModel::rawValue(
 
     const RowInfo& rowInfo = m_rowInfo[row];
     const TrackId trackId = rowInfo.trackId;
+    if (!trackId.isValid()) {
+        // Placeholder of an asynchronous select()
+        requestRows(row);
+        return QVariant();
+    }
 
     // If the row info has the row-specific column, return that.
     if (column < m_tableColumns.size()) {
@@ -701,6 +1333,15 @@ TrackPointer BaseSqlTableModel::getTrack(const QModelIndex& index) const {
     return m_pTrackCollectionManager->internalCollection()->getTrackById(getTrackId(index));
 }
 
+TrackPointerList BaseSqlTableModel::getInternalTracks(const QModelIndexList& indices) const {
+    QList<TrackId> trackIds;
+    trackIds.reserve(indices.size());
+    for (const auto& index : indices) {
+        trackIds.append(getTrackId(index));
+    }
+    return m_pTrackCollectionManager->internalCollection()->getTracksByIds(trackIds);
+}
+
 TrackId BaseSqlTableModel::getTrackId(const QModelIndex& index) const {
     if (index.isValid()) {
         return TrackId(index.sibling(index.row(), fieldIndex(m_idColumn)).data());
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <QFutureInterface>
+#include <QFutureWatcher>
 #include <QHash>
+#include <QSet>
 #include <QtSql>
+#include <functional>
+#include <memory>
 
 #include "library/basetrackcache.h"
 #include "library/dao/trackdao.h"
 #include "library/basetracktablemodel.h"
 #include "library/columncache.h"
 #include "util/class.h"
+#include "util/db/dbconnectionpool.h"
+#include "util/performancetimer.h"
 
 class TrackCollectionManager;
 
@@ -32,6 +39,18 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     void setSearch(const QString& searchText, const QString& extraFilter = QString());
     void setSort(int column, Qt::SortOrder order);
 
+    // Execute the queries of select() on a read-only database connection
+    // in a worker thread. The rows are replaced by placeholders as soon
+    // as the number of results is known. The contents of placeholder rows
+    // are fetched in pages on demand when they are accessed, i.e. the
+    // visible rows are loaded first. All remaining rows are read in the
+    // background with a lower priority.
+    // Only available if the TrackCollectionManager provides read-only
+    // connections and only for tables that contain each track at most
+    // once. Models that are accessed programmatically immediately after
+    // invoking select() must not enable this option!
+    void setSelectAsync(bool selectAsync);
+
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from QAbstractItemModel
     ///////////////////////////////////////////////////////////////////////////
@@ -89,6 +108,10 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     void setTable(const QString& tableName, const QString& trackIdColumn,
                   const QStringList& tableColumns,
                   QSharedPointer<BaseTrackCache> trackSource);
+    // Executes the CREATE TEMPORARY VIEW statement of the table and
+    // remembers it for creating the same view on the read-only
+    // connection of asynchronous queries.
+    bool createTemporaryView(const QString& createViewStatement);
     void initHeaderProperties() override;
     virtual void initSortColumnMapping();
 
@@ -96,6 +119,9 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
   protected:
     QList<TrackRef> getTrackRefs(const QModelIndexList& indices) const;
+    // Loads the tracks of the internal collection at once, for models
+    // that don't override getTrack()
+    TrackPointerList getInternalTracks(const QModelIndexList& indices) const;
 
     QSqlDatabase m_database;
 
@@ -122,7 +148,7 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     struct RowInfo {
         TrackId trackId;
-        int order;
+        int order = -1;
         QVector<QVariant> metadata;
 
         bool operator<(const RowInfo& other) const {
@@ -138,6 +164,74 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     typedef QHash<TrackId, QLinkedList<int>> TrackId2Rows;
 
+    // Reads all or at most maxRows rows from an executed query.
+    // Returns false if reading failed.
+    static bool readRows(
+            QSqlQuery* pQuery,
+            const QString& idColumnName,
+            int columnCount,
+            QVector<RowInfo>* pRowInfos,
+            int maxRows = -1);
+
+    // Filters, sorts, and finally publishes the selected rows
+    void finishSelect(
+            QVector<RowInfo>&& rowInfos);
+    void selectSync();
+
+    // The queries of an asynchronous select()
+    struct SelectQuery;
+    typedef std::shared_ptr<const SelectQuery> SelectQueryPointer;
+    // State for reading all rows sequentially in multiple tasks
+    struct SelectStream;
+
+    struct SelectResult {
+        enum class Type {
+            RowCount,
+            Page,
+            Chunk,
+        };
+        Type type = Type::RowCount;
+        bool succeeded = false;
+        int rowCount = 0;
+        int firstRow = 0;
+        QVector<RowInfo> rowInfos;
+        // The last chunk of the sequentially read rows
+        bool complete = false;
+    };
+
+    SelectQueryPointer buildSelectQuery() const;
+    void selectAsync(
+            SelectQueryPointer pSelectQuery);
+    void cancelSelectAsync();
+    void slotSelectResultsReadyAt(int beginIndex, int endIndex);
+    void receiveSelectResult(SelectResult&& result);
+    // Requests the page with this row if it has not been loaded yet
+    void requestRows(int row) const;
+    // Replaces placeholder rows or, if overwrite is true, any rows
+    void placeRows(
+            int firstRow,
+            const QVector<RowInfo>& rowInfos,
+            bool overwrite);
+    void truncateRows(int rowCount);
+
+    // Executed on the worker thread
+    static bool prepareSelectConnection(
+            const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+            const SelectQuery& selectQuery);
+    static bool fetchRows(
+            QSqlDatabase database,
+            const SelectQuery& selectQuery,
+            QSqlQuery* pQuery,
+            int maxRows,
+            QVector<RowInfo>* pRowInfos);
+    static SelectResult selectPage(
+            const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
+            const SelectQuery& selectQuery,
+            int firstRow,
+            int rowCount);
+    static void selectNextChunk(
+            const std::shared_ptr<SelectStream>& pSelectStream);
+
     void clearRows();
     void replaceRows(
             QVector<RowInfo>&& rows,
@@ -151,6 +245,15 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     QStringList m_tableColumns;
     QList<SortColumn> m_sortColumns;
     bool m_bInitialized;
+    bool m_bSelectAsync;
+    QString m_temporaryViewDefinition;
+    // The pending asynchronous select(), superseded queries are
+    // cancelled and their results are discarded
+    SelectQueryPointer m_pSelectQuery;
+    QFutureInterface<SelectResult> m_selectFutureInterface;
+    QFutureWatcher<SelectResult>* m_pSelectWatcher;
+    mutable QSet<int> m_requestedPages;
+    PerformanceTimer m_selectTimer;
     QHash<TrackId, int> m_trackSortOrder;
     TrackId2Rows m_trackIdToRows;
     QString m_currentSearch;
@@ -451,6 +451,33 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     return result;
 }
 
+QString BaseTrackCache::filterCondition(const QString& searchQuery,
+                                        const QString& extraFilter) const {
+    QString filter;
+    if (!extraFilter.isNull() && extraFilter != "") {
+        filter = QString("(%1)").arg(extraFilter);
+    }
+    return m_pQueryParser->parseQuery(
+            searchQuery,
+            m_searchColumns,
+            filter)->toSql();
+}
+
+QList<TrackPointer> BaseTrackCache::dirtyTracks() const {
+    QList<TrackPointer> tracks;
+    if (!m_bIsCaching || m_dirtyTracks.isEmpty()) {
+        return tracks;
+    }
+    GlobalTrackCacheLocker locker;
+    for (const auto& trackId : qAsConst(m_dirtyTracks)) {
+        TrackPointer pTrack = locker.lookupTrackById(trackId);
+        if (pTrack && pTrack->isDirty()) {
+            tracks.append(std::move(pTrack));
+        }
+    }
+    return tracks;
+}
+
 void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
                                    const QString& searchQuery,
                                    const QString& extraFilter,
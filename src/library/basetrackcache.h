@@ -59,6 +59,35 @@ class BaseTrackCache : public QObject {
     QString columnNameForFieldIndex(int index) const;
     QString columnSortForFieldIndex(int index) const;
     int fieldIndex(ColumnCache::Column column) const;
+
+    const QString& tableName() const {
+        return m_tableName;
+    }
+    const QString& idColumn() const {
+        return m_idColumn;
+    }
+
+    // The CREATE TEMPORARY VIEW statement of the table if it is a
+    // temporary view. Temporary views only exist for the connection
+    // that created them and need to be created again on other
+    // connections before they can be queried by name.
+    const QString& temporaryViewDefinition() const {
+        return m_temporaryViewDefinition;
+    }
+    void setTemporaryViewDefinition(const QString& createViewStatement) {
+        m_temporaryViewDefinition = createViewStatement;
+    }
+
+    // Returns the SQL condition for selecting the tracks that match
+    // the search query from the table or an empty string if all tracks
+    // match. Unlike filterAndSort() the result doesn't account for
+    // pending modifications of dirty tracks, see dirtyTracks().
+    QString filterCondition(const QString& searchQuery,
+                            const QString& extraFilter) const;
+    // Returns all cached tracks that have been modified, but whose
+    // changes have not been saved in the database yet.
+    QList<TrackPointer> dirtyTracks() const;
+
     virtual void filterAndSort(const QSet<TrackId>& trackIds,
                                const QString& query,
                                const QString& extraFilter,
@@ -114,6 +143,8 @@ class BaseTrackCache : public QObject {
     const int m_columnCount;
     const QString m_columnsJoined;
 
+    QString m_temporaryViewDefinition;
+
     const ColumnCache m_columnCache;
 
     const std::unique_ptr<SearchQueryParser> m_pQueryParser;
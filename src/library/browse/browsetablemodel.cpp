@@ -117,6 +117,12 @@ BrowseTableModel::BrowseTableModel(QObject* parent,
             &BrowseTableModel::slotInsert,
             Qt::QueuedConnection);
 
+    connect(m_pBrowseThread.data(),
+            &BrowseThread::rowsUpdated,
+            this,
+            &BrowseTableModel::slotUpdate,
+            Qt::QueuedConnection);
+
     connect(&PlayerInfo::instance(),
             &PlayerInfo::trackLoaded,
             this,
@@ -181,7 +187,8 @@ QString BrowseTableModel::getTrackLocation(const QModelIndex& index) const {
     int row = index.row();
 
     QModelIndex index2 = this->index(row, COLUMN_NATIVELOCATION);
-    QString nativeLocation = data(index2).toString();
+    // Bypass data() to avoid prioritizing the metadata of this row
+    QString nativeLocation = QStandardItemModel::data(index2).toString();
     QString location = QDir::fromNativeSeparators(nativeLocation);
     return location;
 }
@@ -266,6 +273,8 @@ QMimeData* BrowseTableModel::mimeData(const QModelIndexList &indexes) const {
 void BrowseTableModel::slotClear(BrowseTableModel* caller_object) {
     if (caller_object == this) {
         removeRows(0, rowCount());
+        m_rowsByLocation.clear();
+        m_pendingRows.clear();
     }
 }
 
@@ -277,7 +286,42 @@ void BrowseTableModel::slotInsert(const QList< QList<QStandardItem*> >& rows,
     if (caller_object == this) {
         //qDebug() << "BrowseTableModel::slotInsert";
         for (int i = 0; i < rows.size(); ++i) {
-            appendRow(rows.at(i));
+            const QList<QStandardItem*>& row_data = rows.at(i);
+            const QString location =
+                    row_data.at(COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString();
+            const int row = rowCount();
+            m_rowsByLocation.insert(location, row);
+            if (row_data.at(COLUMN_PREVIEW)->data(kPendingMetadataRole).toBool()) {
+                m_pendingRows.insert(row, location);
+            }
+            appendRow(row_data);
+        }
+    }
+}
+
+void BrowseTableModel::slotUpdate(const QList< QList<QStandardItem*> >& rows,
+                                  BrowseTableModel* caller_object) {
+    if (caller_object != this) {
+        return;
+    }
+    for (const auto& row_data : rows) {
+        const QString location =
+                row_data.at(COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString();
+        const int row = m_rowsByLocation.value(location, -1);
+        if (row < 0) {
+            // The model has been cleared in the meantime
+            qDeleteAll(row_data);
+            continue;
+        }
+        m_pendingRows.remove(row);
+        // Keep the current state of the preview column
+        delete row_data.at(COLUMN_PREVIEW);
+        QStandardItem* pPreviewItem = item(row, COLUMN_PREVIEW);
+        if (pPreviewItem) {
+            pPreviewItem->setData(QVariant(), kPendingMetadataRole);
+        }
+        for (int column = COLUMN_PREVIEW + 1; column < row_data.size(); ++column) {
+            setItem(row, column, row_data.at(column));
         }
     }
 }
@@ -318,6 +362,19 @@ Qt::ItemFlags BrowseTableModel::flags(const QModelIndex &index) const {
     }
 }
 
+QVariant BrowseTableModel::data(const QModelIndex& index, int role) const {
+    if (role == Qt::DisplayRole && !m_pendingRows.isEmpty()) {
+        // Only visible rows are displayed. Read their metadata
+        // before the metadata of all other rows.
+        const auto it = m_pendingRows.find(index.row());
+        if (it != m_pendingRows.end()) {
+            m_pBrowseThread->prioritizeMetadata(it.value());
+            m_pendingRows.erase(it);
+        }
+    }
+    return QStandardItemModel::data(index, role);
+}
+
 bool BrowseTableModel::setData(
         const QModelIndex& index,
         const QVariant& value,
@@ -3,6 +3,7 @@
 
 #include <QStandardItemModel>
 #include <QMimeData>
+#include <QHash>
 
 #include "library/trackmodel.h"
 #include "recording/recordingmanager.h"
@@ -45,6 +46,10 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
     Q_OBJECT
 
   public:
+    // Marks the preview item of rows for which the metadata
+    // has not been read yet.
+    static constexpr int kPendingMetadataRole = Qt::UserRole + 1;
+
     BrowseTableModel(QObject* parent, TrackCollectionManager* pTrackCollectionManager, RecordingManager* pRec);
     virtual ~BrowseTableModel();
 
@@ -67,6 +72,7 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
     bool isColumnHiddenByDefault(int column) override;
     const QList<int>& searchColumns() const override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex& index, const QVariant& value, int role=Qt::EditRole) override;
     QAbstractItemDelegate* delegateForColumn(const int i, QObject* pParent) override;
     bool isColumnSortable(int column) override;
@@ -76,6 +82,7 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
   public slots:
     void slotClear(BrowseTableModel*);
     void slotInsert(const QList< QList<QStandardItem*> >&, BrowseTableModel*);
+    void slotUpdate(const QList< QList<QStandardItem*> >&, BrowseTableModel*);
     void trackLoaded(QString group, TrackPointer pTrack);
 
   private:
@@ -91,6 +98,12 @@ class BrowseTableModel final : public QStandardItemModel, public virtual TrackMo
     int m_columnIndexBySortColumnId[TrackModel::SortColumnId::NUM_SORTCOLUMNIDS];
     QMap<int, TrackModel::SortColumnId> m_sortColumnIdByColumnIndex;
 
+    // Rows are only appended, i.e. the row of a location doesn't
+    // change until the model is cleared.
+    QHash<QString, int> m_rowsByLocation;
+    // Rows with pending metadata that have not been displayed yet
+    mutable QHash<int, QString> m_pendingRows;
+
 };
 
 #endif
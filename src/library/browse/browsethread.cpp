@@ -6,13 +6,84 @@
 #include <QStringList>
 #include <QDateTime>
 #include <QDirIterator>
+#include <QtConcurrentRun>
+#include <memory>
 
 #include "library/browse/browsetablemodel.h"
 
 #include "sources/soundsourceproxy.h"
 #include "util/datetime.h"
+#include "util/math.h"
 #include "util/trace.h"
 
+namespace {
+
+// Reading metadata is mostly I/O bound, especially on network
+// shares. Use a few more threads than cores, but not too many to
+// avoid flooding the file server with requests.
+const int kMaxMetadataThreads = 8;
+
+// Number of rows that are sent to the GUI at once
+const int kRowBatchSize = 100;
+
+// Upper bound for the number of rows in the metadata cache
+const int kMetadataCacheMaxRows = 20000;
+
+// Interval for checking if the current directory has changed
+// while waiting for metadata
+const unsigned long kMetadataWaitMillis = 100;
+
+} // anonymous namespace
+
+struct BrowseThread::CachedRow {
+    QDateTime fileLastModified;
+    qint64 fileSize;
+    // owned
+    QList<QStandardItem*> items;
+};
+
+struct BrowseThread::CachedDirectory {
+    CachedDirectory() = default;
+    CachedDirectory(const CachedDirectory&) = delete;
+    CachedDirectory& operator=(const CachedDirectory&) = delete;
+    ~CachedDirectory() {
+        for (const auto& row : rows) {
+            qDeleteAll(row.items);
+        }
+    }
+
+    // Stores a copy of the items of a completely populated row.
+    void insert(const QList<QStandardItem*>& items) {
+        const TrackFile trackFile(
+                items.at(COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString());
+        CachedRow& row = rows[trackFile.location()];
+        qDeleteAll(row.items);
+        row.items.clear();
+        row.fileLastModified = trackFile.fileLastModified();
+        row.fileSize = trackFile.fileSize();
+        for (const auto* pItem : items) {
+            row.items.append(pItem->clone());
+        }
+    }
+
+    // Returns a copy of the cached items or an empty list if the
+    // file has been modified after its row has been cached.
+    QList<QStandardItem*> lookup(const TrackFile& trackFile) const {
+        QList<QStandardItem*> items;
+        const auto it = rows.constFind(trackFile.location());
+        if (it == rows.constEnd() ||
+                it->fileLastModified != trackFile.fileLastModified() ||
+                it->fileSize != trackFile.fileSize()) {
+            return items;
+        }
+        for (const auto* pItem : it->items) {
+            items.append(pItem->clone());
+        }
+        return items;
+    }
+
+    QHash<QString, CachedRow> rows;
+};
 
 QWeakPointer<BrowseThread> BrowseThread::m_weakInstanceRef;
 static QMutex s_Mutex;
@@ -29,9 +100,13 @@ static QMutex s_Mutex;
  * make sense to use this class in non-GUI threads
  */
 BrowseThread::BrowseThread(QObject *parent)
-        : QThread(parent) {
+        : QThread(parent),
+          m_metadataCache(kMetadataCacheMaxRows) {
+    m_bPopulationRequested = false;
     m_bStopThread = false;
     m_model_observer = NULL;
+    m_metadataThreadPool.setMaxThreadCount(
+            math_min(QThread::idealThreadCount() * 2, kMaxMetadataThreads));
     //start Thread
     start(QThread::LowPriority);
 
@@ -41,7 +116,14 @@ BrowseThread::~BrowseThread() {
     qDebug() << "Wait to finish browser background thread";
     m_bStopThread = true;
     //wake up thread since it might wait for user input
+    m_mutex.lock();
     m_locationUpdated.wakeAll();
+    m_mutex.unlock();
+    //abort reading metadata
+    m_metadata_mutex.lock();
+    m_pendingLocations.clear();
+    m_metadataRead.wakeAll();
+    m_metadata_mutex.unlock();
     //Wait until thread terminated
     //terminate();
     wait();
@@ -68,16 +150,40 @@ void BrowseThread::executePopulation(const MDir& path, BrowseTableModel* client)
     m_path = path;
     m_model_observer = client;
     m_path_mutex.unlock();
+    // The request is remembered if the thread is still busy with
+    // populating the model and not waiting for it
+    m_mutex.lock();
+    m_bPopulationRequested = true;
     m_locationUpdated.wakeAll();
+    m_mutex.unlock();
+    // wake up the thread if it waits for metadata of the previous path
+    m_metadata_mutex.lock();
+    m_metadataRead.wakeAll();
+    m_metadata_mutex.unlock();
+}
+
+void BrowseThread::prioritizeMetadata(const QString& location) {
+    QMutexLocker locker(&m_metadata_mutex);
+    if (m_pendingLocations.removeOne(location)) {
+        m_pendingLocations.prepend(location);
+    }
+}
+
+bool BrowseThread::isPathChanged(const MDir& path) {
+    QMutexLocker locker(&m_path_mutex);
+    return m_bStopThread || path.dir() != m_path.dir();
 }
 
 void BrowseThread::run() {
     QThread::currentThread()->setObjectName("BrowseThread");
-    m_mutex.lock();
 
     while (!m_bStopThread) {
         //Wait until the user has selected a folder
-        m_locationUpdated.wait(&m_mutex);
+        m_mutex.lock();
+        while (!m_bPopulationRequested && !m_bStopThread) {
+            m_locationUpdated.wait(&m_mutex);
+        }
+        m_mutex.unlock();
         Trace trace("BrowseThread");
 
         //Terminate thread if Mixxx closes
@@ -87,7 +193,6 @@ void BrowseThread::run() {
         // Populate the model
         populateModel();
     }
-    m_mutex.unlock();
 }
 
 namespace {
@@ -98,7 +203,11 @@ public:
         QStandardItem(year) {
     }
 
-    QVariant data(int role) const {
+    QStandardItem* clone() const override {
+        return new YearItem(*this);
+    }
+
+    QVariant data(int role) const override {
         switch (role) {
         case Qt::DisplayRole:
         {
@@ -111,9 +220,179 @@ public:
     }
 };
 
+// Creates a row that only contains the file properties until the
+// metadata of the track has been read.
+QList<QStandardItem*> createPendingRow(const TrackFile& trackFile) {
+    QList<QStandardItem*> row_data;
+
+    QStandardItem* item = new QStandardItem("0");
+    item->setData("0", Qt::UserRole);
+    item->setData(true, BrowseTableModel::kPendingMetadataRole);
+    row_data.insert(COLUMN_PREVIEW, item);
+
+    for (int column = COLUMN_FILENAME; column <= COLUMN_REPLAYGAIN; ++column) {
+        row_data.append(new QStandardItem());
+    }
+
+    item = row_data.at(COLUMN_FILENAME);
+    item->setText(trackFile.fileName());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+
+    QString location = trackFile.location();
+    QString nativeLocation = QDir::toNativeSeparators(location);
+    item = row_data.at(COLUMN_NATIVELOCATION);
+    item->setText(nativeLocation);
+    item->setToolTip(nativeLocation);
+    item->setData(location, Qt::UserRole);
+
+    const auto fileLastModified = trackFile.fileLastModified();
+    item = row_data.at(COLUMN_FILE_MODIFIED_TIME);
+    item->setText(mixxx::displayLocalDateTime(fileLastModified));
+    item->setToolTip(item->text());
+    item->setData(fileLastModified, Qt::UserRole);
+
+    const auto fileCreated = trackFile.fileCreated();
+    item = row_data.at(COLUMN_FILE_CREATION_TIME);
+    item->setText(mixxx::displayLocalDateTime(fileCreated));
+    item->setToolTip(item->text());
+    item->setData(fileCreated, Qt::UserRole);
+
+    return row_data;
 }
 
+QList<QStandardItem*> createRow(const TrackPointer& pTrack) {
+    QList<QStandardItem*> row_data;
+
+    QStandardItem* item = new QStandardItem("0");
+    item->setData("0", Qt::UserRole);
+    row_data.insert(COLUMN_PREVIEW, item);
+
+    item = new QStandardItem(pTrack->getFileInfo().fileName());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_FILENAME, item);
+
+    item = new QStandardItem(pTrack->getArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ARTIST, item);
+
+    item = new QStandardItem(pTrack->getTitle());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TITLE, item);
+
+    item = new QStandardItem(pTrack->getAlbum());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUM, item);
+
+    item = new QStandardItem(pTrack->getAlbumArtist());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_ALBUMARTIST, item);
+
+    item = new QStandardItem(pTrack->getTrackNumber());
+    item->setToolTip(item->text());
+    item->setData(item->text().toInt(), Qt::UserRole);
+    row_data.insert(COLUMN_TRACK_NUMBER, item);
+
+    const QString year(pTrack->getYear());
+    item = new YearItem(year);
+    item->setToolTip(year);
+    // The year column is sorted according to the numeric calendar year
+    item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
+    row_data.insert(COLUMN_YEAR, item);
+
+    item = new QStandardItem(pTrack->getGenre());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GENRE, item);
+
+    item = new QStandardItem(pTrack->getComposer());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMPOSER, item);
+
+    item = new QStandardItem(pTrack->getGrouping());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_GROUPING, item);
+
+    item = new QStandardItem(pTrack->getComment());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_COMMENT, item);
+
+    QString duration = pTrack->getDurationText(mixxx::Duration::Precision::SECONDS);
+    item = new QStandardItem(duration);
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_DURATION, item);
+
+    item = new QStandardItem(pTrack->getBpmText());
+    item->setToolTip(item->text());
+    item->setData(pTrack->getBpm(), Qt::UserRole);
+    row_data.insert(COLUMN_BPM, item);
+
+    item = new QStandardItem(pTrack->getKeyText());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_KEY, item);
+
+    item = new QStandardItem(pTrack->getType());
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_TYPE, item);
+
+    item = new QStandardItem(pTrack->getBitrateText());
+    item->setToolTip(item->text());
+    item->setData(pTrack->getBitrate(), Qt::UserRole);
+    row_data.insert(COLUMN_BITRATE, item);
+
+    QString location = pTrack->getLocation();
+    QString nativeLocation = QDir::toNativeSeparators(location);
+    item = new QStandardItem(nativeLocation);
+    item->setToolTip(nativeLocation);
+    item->setData(location, Qt::UserRole);
+    row_data.insert(COLUMN_NATIVELOCATION, item);
+
+    const auto fileLastModified =
+            pTrack->getFileInfo().fileLastModified();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileLastModified));
+    item->setToolTip(item->text());
+    item->setData(fileLastModified, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
+
+    const auto fileCreated =
+            pTrack->getFileInfo().fileCreated();
+    item = new QStandardItem(
+            mixxx::displayLocalDateTime(fileCreated));
+    item->setToolTip(item->text());
+    item->setData(fileCreated, Qt::UserRole);
+    row_data.insert(COLUMN_FILE_CREATION_TIME, item);
+
+    const mixxx::ReplayGain replayGain(pTrack->getReplayGain());
+    item = new QStandardItem(
+            mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
+    item->setToolTip(item->text());
+    item->setData(item->text(), Qt::UserRole);
+    row_data.insert(COLUMN_REPLAYGAIN, item);
+
+    return row_data;
+}
+
+} // anonymous namespace
+
 void BrowseThread::populateModel() {
+    // Requests that arrive from now on refer to a path that
+    // might have been missed and need another population
+    m_mutex.lock();
+    m_bPopulationRequested = false;
+    m_mutex.unlock();
+
     m_path_mutex.lock();
     MDir thisPath = m_path;
     BrowseTableModel* thisModelObserver = m_model_observer;
@@ -122,7 +401,8 @@ void BrowseThread::populateModel() {
     // Refresh the name filters in case we loaded new SoundSource plugins.
     QStringList nameFilters(SoundSourceProxy::getSupportedFileNamePatterns());
 
-    QDirIterator fileIt(thisPath.dir().absolutePath(), nameFilters,
+    const QString dirPath = thisPath.dir().absolutePath();
+    QDirIterator fileIt(dirPath, nameFilters,
                         QDir::Files | QDir::NoDotAndDotDot);
 
     // remove all rows
@@ -130,162 +410,160 @@ void BrowseThread::populateModel() {
     // see signal/slot connection in BrowseTableModel
     emit clearModel(thisModelObserver);
 
+    // Take ownership while populating the model. The directory is
+    // re-inserted into the cache when done, even if aborted.
+    std::unique_ptr<CachedDirectory> pCachedDirectory(
+            m_metadataCache.take(dirPath));
+    if (!pCachedDirectory) {
+        pCachedDirectory = std::make_unique<CachedDirectory>();
+    }
+
+    // Rows of tracks that have been cached before are complete.
+    // All other rows are sent immediately with just the file
+    // properties and are updated when their metadata has been
+    // read in the background. Their locations are queued before
+    // sending the rows, so that the model is able to prioritize
+    // them as soon as they become visible.
+    QList<QString> pendingLocations;
+    int numPending = 0;
     QList< QList<QStandardItem*> > rows;
 
-    int row = 0;
     // Iterate over the files
+    bool aborted = false;
     while (fileIt.hasNext()) {
         // If a user quickly jumps through the folders
         // the current task becomes "dirty"
-        m_path_mutex.lock();
-        MDir newPath = m_path;
-        m_path_mutex.unlock();
+        if (isPathChanged(thisPath)) {
+            aborted = true;
+            break;
+        }
 
-        if (thisPath.dir() != newPath.dir()) {
-            qDebug() << "Abort populateModel()";
-            return populateModel();
+        fileIt.next();
+        const TrackFile trackFile(fileIt.fileInfo());
+        QList<QStandardItem*> row_data = pCachedDirectory->lookup(trackFile);
+        if (row_data.isEmpty()) {
+            row_data = createPendingRow(trackFile);
+            pendingLocations.append(trackFile.location());
         }
+        rows.append(row_data);
+        if (rows.size() >= kRowBatchSize) {
+            numPending += enqueuePendingLocations(&pendingLocations);
+            // this is a blocking operation
+            emit rowsAppended(rows, thisModelObserver);
+            rows.clear();
+        }
+    }
+    if (aborted) {
+        for (const auto& row : rows) {
+            qDeleteAll(row);
+        }
+        m_metadata_mutex.lock();
+        m_pendingLocations.clear();
+        m_metadata_mutex.unlock();
+    } else {
+        numPending += enqueuePendingLocations(&pendingLocations);
+        emit rowsAppended(rows, thisModelObserver);
+        qDebug() << "Pending metadata of" << numPending
+                 << "tracks in" << dirPath;
+
+        aborted = !readPendingMetadata(
+                thisPath, thisModelObserver, pCachedDirectory.get());
+    }
 
-        QList<QStandardItem*> row_data;
+    const int numCachedRows = pCachedDirectory->rows.size();
+    m_metadataCache.insert(dirPath, pCachedDirectory.release(), numCachedRows);
+
+    if (aborted && !m_bStopThread) {
+        qDebug() << "Abort populateModel()";
+        return populateModel();
+    }
+}
+
+int BrowseThread::enqueuePendingLocations(QList<QString>* pLocations) {
+    QMutexLocker locker(&m_metadata_mutex);
+    const int numLocations = pLocations->size();
+    m_pendingLocations.append(*pLocations);
+    pLocations->clear();
+    return numLocations;
+}
+
+bool BrowseThread::readPendingMetadata(
+        const MDir& path,
+        BrowseTableModel* pModelObserver,
+        CachedDirectory* pCachedDirectory) {
+    QMutexLocker locker(&m_metadata_mutex);
+    int numPending = m_pendingLocations.size();
+    const int numTasks = math_min(numPending, m_metadataThreadPool.maxThreadCount());
+    QList<QFuture<void>> tasks;
+    for (int i = 0; i < numTasks; ++i) {
+        tasks.append(QtConcurrent::run(
+                &m_metadataThreadPool,
+                this,
+                &BrowseThread::readMetadataTask,
+                MDir(path).token()));
+    }
 
-        QStandardItem* item = new QStandardItem("0");
-        item->setData("0", Qt::UserRole);
-        row_data.insert(COLUMN_PREVIEW, item);
+    bool aborted = false;
+    while (numPending > 0) {
+        if (m_readRows.isEmpty()) {
+            m_metadataRead.wait(&m_metadata_mutex, kMetadataWaitMillis);
+        }
+        QList< QList<QStandardItem*> > rows;
+        rows.swap(m_readRows);
+        locker.unlock();
+
+        numPending -= rows.size();
+        for (const auto& row : rows) {
+            pCachedDirectory->insert(row);
+        }
+        if (!rows.isEmpty()) {
+            // this is a blocking operation
+            emit rowsUpdated(rows, pModelObserver);
+        }
+
+        locker.relock();
+        if (isPathChanged(path)) {
+            aborted = true;
+            break;
+        }
+    }
+
+    // Stop all tasks and wait until they are finished
+    m_pendingLocations.clear();
+    locker.unlock();
+    for (auto& task : tasks) {
+        task.waitForFinished();
+    }
+    locker.relock();
 
-        const QString filepath = fileIt.next();
+    // Keep the metadata that has been read after aborting
+    for (const auto& row : m_readRows) {
+        pCachedDirectory->insert(row);
+        qDeleteAll(row);
+    }
+    m_readRows.clear();
+    return !aborted;
+}
+
+// This method is executed on the metadata thread pool
+void BrowseThread::readMetadataTask(SecurityTokenPointer pToken) {
+    QThread::currentThread()->setPriority(QThread::LowPriority);
+    QMutexLocker locker(&m_metadata_mutex);
+    while (!m_pendingLocations.isEmpty()) {
+        const QString location = m_pendingLocations.takeFirst();
+        locker.unlock();
+
+        QList<QStandardItem*> row_data;
         {
             const TrackPointer pTrack =
                     SoundSourceProxy::importTemporaryTrack(
-                            filepath,
-                            thisPath.token());
-
-            item = new QStandardItem(pTrack->getFileInfo().fileName());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_FILENAME, item);
-
-            item = new QStandardItem(pTrack->getArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ARTIST, item);
-
-            item = new QStandardItem(pTrack->getTitle());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TITLE, item);
-
-            item = new QStandardItem(pTrack->getAlbum());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUM, item);
-
-            item = new QStandardItem(pTrack->getAlbumArtist());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_ALBUMARTIST, item);
-
-            item = new QStandardItem(pTrack->getTrackNumber());
-            item->setToolTip(item->text());
-            item->setData(item->text().toInt(), Qt::UserRole);
-            row_data.insert(COLUMN_TRACK_NUMBER, item);
-
-            const QString year(pTrack->getYear());
-            item = new YearItem(year);
-            item->setToolTip(year);
-            // The year column is sorted according to the numeric calendar year
-            item->setData(mixxx::TrackMetadata::parseCalendarYear(year), Qt::UserRole);
-            row_data.insert(COLUMN_YEAR, item);
-
-            item = new QStandardItem(pTrack->getGenre());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GENRE, item);
-
-            item = new QStandardItem(pTrack->getComposer());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMPOSER, item);
-
-            item = new QStandardItem(pTrack->getGrouping());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_GROUPING, item);
-
-            item = new QStandardItem(pTrack->getComment());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_COMMENT, item);
-
-            QString duration = pTrack->getDurationText(mixxx::Duration::Precision::SECONDS);
-            item = new QStandardItem(duration);
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_DURATION, item);
-
-            item = new QStandardItem(pTrack->getBpmText());
-            item->setToolTip(item->text());
-            item->setData(pTrack->getBpm(), Qt::UserRole);
-            row_data.insert(COLUMN_BPM, item);
-
-            item = new QStandardItem(pTrack->getKeyText());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_KEY, item);
-
-            item = new QStandardItem(pTrack->getType());
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_TYPE, item);
-
-            item = new QStandardItem(pTrack->getBitrateText());
-            item->setToolTip(item->text());
-            item->setData(pTrack->getBitrate(), Qt::UserRole);
-            row_data.insert(COLUMN_BITRATE, item);
-
-            QString location = pTrack->getLocation();
-            QString nativeLocation = QDir::toNativeSeparators(location);
-            item = new QStandardItem(nativeLocation);
-            item->setToolTip(nativeLocation);
-            item->setData(location, Qt::UserRole);
-            row_data.insert(COLUMN_NATIVELOCATION, item);
-
-            const auto fileLastModified =
-                    pTrack->getFileInfo().fileLastModified();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileLastModified));
-            item->setToolTip(item->text());
-            item->setData(fileLastModified, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_MODIFIED_TIME, item);
-
-            const auto fileCreated =
-                    pTrack->getFileInfo().fileCreated();
-            item = new QStandardItem(
-                    mixxx::displayLocalDateTime(fileCreated));
-            item->setToolTip(item->text());
-            item->setData(fileCreated, Qt::UserRole);
-            row_data.insert(COLUMN_FILE_CREATION_TIME, item);
-
-            const mixxx::ReplayGain replayGain(pTrack->getReplayGain());
-            item = new QStandardItem(
-                    mixxx::ReplayGain::ratioToString(replayGain.getRatio()));
-            item->setToolTip(item->text());
-            item->setData(item->text(), Qt::UserRole);
-            row_data.insert(COLUMN_REPLAYGAIN, item);
+                            location,
+                            pToken);
+            row_data = createRow(pTrack);
         } // implicitly release track pointer and unlock cache
 
-        rows.append(row_data);
-        ++row;
-        // If 10 tracks have been analyzed, send it to GUI
-        // Will limit GUI freezing
-        if (row % 10 == 0) {
-            // this is a blocking operation
-            emit rowsAppended(rows, thisModelObserver);
-            qDebug() << "Append " << rows.count() << " from " << filepath;
-            rows.clear();
-        }
-        // Sleep additionally for 10ms which prevents us from GUI freezes
-        msleep(20);
+        locker.relock();
+        m_readRows.append(row_data);
+        m_metadataRead.wakeAll();
     }
-    emit rowsAppended(rows, thisModelObserver);
-    qDebug() << "Append last " << rows.count();
 }
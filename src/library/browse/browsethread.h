@@ -6,9 +6,11 @@
 #define BROWSETHREAD_H
 
 #include <QThread>
+#include <QThreadPool>
 #include <QMutex>
 #include <QWaitCondition>
 #include <QStandardItem>
+#include <QCache>
 #include <QList>
 #include <QSharedPointer>
 #include <QWeakPointer>
@@ -35,17 +37,45 @@ class BrowseThread : public QThread {
     void run();
     static BrowseThreadPointer getInstanceRef();
 
+    // Moves the given track to the front of the queue of
+    // tracks whose metadata still needs to be read, e.g.
+    // because it has become visible.
+    void prioritizeMetadata(const QString& location);
+
   signals:
+    // Rows of tracks with pending metadata only contain the
+    // file properties and are marked as pending.
     void rowsAppended(const QList< QList<QStandardItem*> >&, BrowseTableModel*);
+    // Complete rows for tracks with pending metadata.
+    void rowsUpdated(const QList< QList<QStandardItem*> >&, BrowseTableModel*);
     void clearModel(BrowseTableModel*);
 
   private:
+    friend class BrowseThreadTest;
+
+    struct CachedRow;
+    struct CachedDirectory;
+
     BrowseThread(QObject *parent = 0);
 
     void populateModel();
+    bool isPathChanged(const MDir& path);
+    // Moves the locations to the queue of tracks whose metadata
+    // needs to be read and returns their number.
+    int enqueuePendingLocations(QList<QString>* pLocations);
+    // Reads the metadata of all pending tracks on the metadata
+    // thread pool and sends the completed rows to the model.
+    // Returns false if aborted.
+    bool readPendingMetadata(
+            const MDir& path,
+            BrowseTableModel* pModelObserver,
+            CachedDirectory* pCachedDirectory);
+    void readMetadataTask(SecurityTokenPointer pToken);
 
+    // You must hold m_mutex to touch m_bPopulationRequested
     QMutex m_mutex;
     QWaitCondition m_locationUpdated;
+    bool m_bPopulationRequested;
     volatile bool m_bStopThread;
 
     // You must hold m_path_mutex to touch m_path or m_model_observer
@@ -53,6 +83,17 @@ class BrowseThread : public QThread {
     MDir m_path;
     BrowseTableModel* m_model_observer;
 
+    // You must hold m_metadata_mutex to touch m_pendingLocations
+    // or m_readRows
+    QMutex m_metadata_mutex;
+    QWaitCondition m_metadataRead;
+    QList<QString> m_pendingLocations;
+    QList< QList<QStandardItem*> > m_readRows;
+    QThreadPool m_metadataThreadPool;
+
+    // Only accessed by this thread
+    QCache<QString, CachedDirectory> m_metadataCache;
+
     static QWeakPointer<BrowseThread> m_weakInstanceRef;
 };
 
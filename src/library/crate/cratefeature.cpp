@@ -48,6 +48,8 @@ CrateFeature::CrateFeature(Library* pLibrary,
           m_lockedCrateIcon(":/images/library/ic_library_locked_tracklist.svg"),
           m_pTrackCollection(pLibrary->trackCollections()->internalCollection()),
           m_crateTableModel(this, pLibrary->trackCollections()) {
+    // Switching to a large crate must not block the UI
+    m_crateTableModel.setSelectAsync(true);
 
     initActions();
 
@@ -23,39 +23,30 @@ const QString CRATE_SUMMARY_VIEW = "crate_summary";
 const QString CRATESUMMARY_TRACK_COUNT = "track_count";
 const QString CRATESUMMARY_TRACK_DURATION = "track_duration";
 
-const QString kCrateTracksJoin = QString(
-        "LEFT JOIN %3 ON %3.%4=%1.%2").arg(
-                CRATE_TABLE,
-                CRATETABLE_ID,
-                CRATE_TRACKS_TABLE,
-                CRATETRACKSTABLE_CRATEID);
-
-const QString kLibraryTracksJoin = kCrateTracksJoin + QString(
-        " LEFT JOIN %3 ON %3.%4=%1.%2").arg(
-                CRATE_TRACKS_TABLE,
-                CRATETRACKSTABLE_TRACKID,
-                LIBRARY_TABLE,
-                LIBRARYTABLE_ID);
-
+const QString CRATE_SUMMARIES_TABLE = "crate_summaries";
+const QString CRATESUMMARIESTABLE_CRATEID = "crate_id";
+
+// The summaries are maintained by database triggers while adding,
+// removing, hiding or unhiding tracks, see schema.xml. Reading them
+// doesn't need to aggregate the tracks of all crates. The durations
+// are rounded to compensate for the accumulated rounding errors of
+// the incremental updates.
 const QString kCrateSummaryViewSelect = QString(
         "SELECT %1.*,"
-            "COUNT(CASE %2.%4 WHEN 0 THEN 1 ELSE NULL END) AS %5,"
-            "SUM(CASE %2.%4 WHEN 0 THEN %2.%3 ELSE 0 END) AS %6 "
-            "FROM %1").arg(
+            "IFNULL(%2.%4,0) AS %4,"
+            "IFNULL(ROUND(%2.%5,3),0) AS %5 "
+            "FROM %1 LEFT JOIN %2 ON %2.%3=%1.%6").arg(
                 CRATE_TABLE,
-                LIBRARY_TABLE,
-                LIBRARYTABLE_DURATION,
-                LIBRARYTABLE_MIXXXDELETED,
+                CRATE_SUMMARIES_TABLE,
+                CRATESUMMARIESTABLE_CRATEID,
                 CRATESUMMARY_TRACK_COUNT,
-                CRATESUMMARY_TRACK_DURATION);
+                CRATESUMMARY_TRACK_DURATION,
+                CRATETABLE_ID);
 
 const QString kCrateSummaryViewQuery = QString(
-            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS %2 %3 GROUP BY %4.%5").arg(
+            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS %2").arg(
                     CRATE_SUMMARY_VIEW,
-                    kCrateSummaryViewSelect,
-                    kLibraryTracksJoin,
-                    CRATE_TABLE,
-                    CRATETABLE_ID);
+                    kCrateSummaryViewSelect);
 
 
 class CrateQueryBinder {
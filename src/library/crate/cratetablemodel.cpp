@@ -4,7 +4,6 @@
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "mixer/playermanager.h"
-#include "util/db/fwdsqlquery.h"
 
 CrateTableModel::CrateTableModel(
         QObject* pParent,
@@ -41,7 +40,7 @@ void CrateTableModel::selectCrate(CrateId crateId) {
                                LIBRARYTABLE_ID,
                                CrateStorage::formatSubselectQueryForCrateTrackIds(crateId),
                                LIBRARYTABLE_MIXXXDELETED);
-    FwdSqlQuery(m_database, queryString).execPrepared();
+    createTemporaryView(queryString);
 
     columns[0] = LIBRARYTABLE_ID;
     columns[1] = LIBRARYTABLE_PREVIEW;
@@ -0,0 +1,128 @@
+#include "library/dao/analysiscachedao.h"
+
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QStringList>
+#include <QVariant>
+
+#include "library/queryutil.h"
+#include "util/assert.h"
+
+const QString AnalysisCacheDao::kTableName = "analysis_cache";
+
+bool AnalysisCacheDao::getCachedResults(
+        const QString& fingerprint,
+        CachedResults* pResults) const {
+    DEBUG_ASSERT(pResults);
+    if (fingerprint.isEmpty()) {
+        return false;
+    }
+
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+            "SELECT track_id, beats_version, beats_sub_version, beats, "
+            "keys_version, keys_sub_version, keys, "
+            "replaygain, replaygain_peak, "
+            "audible_sound_start, audible_sound_end "
+            "FROM %1 WHERE fingerprint=:fingerprint").arg(kTableName));
+    query.bindValue(":fingerprint", fingerprint);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    if (!query.next()) {
+        return false;
+    }
+
+    const QSqlRecord record = query.record();
+    pResults->trackId = TrackId(query.value(record.indexOf("track_id")));
+    pResults->beatsVersion = query.value(record.indexOf("beats_version")).toString();
+    pResults->beatsSubVersion = query.value(record.indexOf("beats_sub_version")).toString();
+    pResults->beats = query.value(record.indexOf("beats")).toByteArray();
+    pResults->keysVersion = query.value(record.indexOf("keys_version")).toString();
+    pResults->keysSubVersion = query.value(record.indexOf("keys_sub_version")).toString();
+    pResults->keys = query.value(record.indexOf("keys")).toByteArray();
+    pResults->replayGain = mixxx::ReplayGain(
+            query.value(record.indexOf("replaygain")).toDouble(),
+            query.value(record.indexOf("replaygain_peak")).toFloat());
+    const QVariant audibleSoundStart = query.value(record.indexOf("audible_sound_start"));
+    const QVariant audibleSoundEnd = query.value(record.indexOf("audible_sound_end"));
+    if (!audibleSoundStart.isNull() && !audibleSoundEnd.isNull()) {
+        pResults->audibleSoundStart = audibleSoundStart.toDouble();
+        pResults->audibleSoundEnd = audibleSoundEnd.toDouble();
+    }
+    return true;
+}
+
+bool AnalysisCacheDao::saveCachedResults(
+        const QString& fingerprint,
+        const CachedResults& results) {
+    VERIFY_OR_DEBUG_ASSERT(!fingerprint.isEmpty()) {
+        return false;
+    }
+
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+            "INSERT OR REPLACE INTO %1 "
+            "(fingerprint, track_id, beats_version, beats_sub_version, beats, "
+            "keys_version, keys_sub_version, keys, "
+            "replaygain, replaygain_peak, "
+            "audible_sound_start, audible_sound_end) "
+            "VALUES (:fingerprint, :track_id, :beats_version, :beats_sub_version, :beats, "
+            ":keys_version, :keys_sub_version, :keys, "
+            ":replaygain, :replaygain_peak, "
+            ":audible_sound_start, :audible_sound_end)").arg(kTableName));
+    query.bindValue(":fingerprint", fingerprint);
+    query.bindValue(":track_id", results.trackId.toVariant());
+    if (results.beatsVersion.isEmpty()) {
+        query.bindValue(":beats_version", QVariant(QVariant::String));
+        query.bindValue(":beats_sub_version", QVariant(QVariant::String));
+        query.bindValue(":beats", QVariant(QVariant::ByteArray));
+    } else {
+        query.bindValue(":beats_version", results.beatsVersion);
+        query.bindValue(":beats_sub_version", results.beatsSubVersion);
+        query.bindValue(":beats", results.beats);
+    }
+    if (results.keysVersion.isEmpty()) {
+        query.bindValue(":keys_version", QVariant(QVariant::String));
+        query.bindValue(":keys_sub_version", QVariant(QVariant::String));
+        query.bindValue(":keys", QVariant(QVariant::ByteArray));
+    } else {
+        query.bindValue(":keys_version", results.keysVersion);
+        query.bindValue(":keys_sub_version", results.keysSubVersion);
+        query.bindValue(":keys", results.keys);
+    }
+    query.bindValue(":replaygain", results.replayGain.getRatio());
+    query.bindValue(":replaygain_peak", results.replayGain.getPeak());
+    if (results.audibleSoundStart < 0.0 || results.audibleSoundEnd < 0.0) {
+        query.bindValue(":audible_sound_start", QVariant(QVariant::Double));
+        query.bindValue(":audible_sound_end", QVariant(QVariant::Double));
+    } else {
+        query.bindValue(":audible_sound_start", results.audibleSoundStart);
+        query.bindValue(":audible_sound_end", results.audibleSoundEnd);
+    }
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
+
+bool AnalysisCacheDao::deleteCachedResultsForTracks(const QList<TrackId>& trackIds) {
+    if (trackIds.isEmpty()) {
+        return true;
+    }
+    QStringList idList;
+    for (const auto& trackId : trackIds) {
+        idList << trackId.toString();
+    }
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+            "DELETE FROM %1 WHERE track_id IN (%2)")
+                    .arg(kTableName, idList.join(",")));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
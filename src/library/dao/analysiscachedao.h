@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+
+#include "library/dao/dao.h"
+#include "track/replaygain.h"
+#include "track/trackid.h"
+
+// Analysis results keyed by a fingerprint of the decoded audio content,
+// see AnalysisFingerprint. Tracks with identical decoded audio, e.g.
+// duplicates, moved or re-tagged files, reuse the results of a previous
+// analysis instead of decoding the whole file again.
+//
+// The beats, keys, ReplayGain and audible range are stored in serialized
+// form, independent of the track that has been analyzed. Waveforms are
+// large and copied from the analyses of that track if it still exists.
+class AnalysisCacheDao : public DAO {
+  public:
+    static const QString kTableName;
+
+    struct CachedResults {
+        CachedResults()
+                : audibleSoundStart(-1.0),
+                  audibleSoundEnd(-1.0) {
+        }
+
+        // The track that has been analyzed
+        TrackId trackId;
+
+        // Empty if not available
+        QString beatsVersion;
+        QString beatsSubVersion;
+        QByteArray beats;
+
+        QString keysVersion;
+        QString keysSubVersion;
+        QByteArray keys;
+
+        mixxx::ReplayGain replayGain;
+
+        // In samples, negative if not available
+        double audibleSoundStart;
+        double audibleSoundEnd;
+    };
+
+    ~AnalysisCacheDao() override = default;
+
+    void initialize(const QSqlDatabase& database) override {
+        m_database = database;
+    }
+
+    bool getCachedResults(
+            const QString& fingerprint,
+            CachedResults* pResults) const;
+
+    // Replaces any results that have been stored for the same fingerprint
+    bool saveCachedResults(
+            const QString& fingerprint,
+            const CachedResults& results);
+
+    // Deletes the results that have been stored for the given tracks,
+    // e.g. after they have been purged from the library
+    bool deleteCachedResultsForTracks(const QList<TrackId>& trackIds);
+
+  private:
+    QSqlDatabase m_database;
+};
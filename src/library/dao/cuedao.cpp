@@ -64,6 +64,29 @@ CuePointer cueFromRow(const QSqlRecord& row) {
     return pCue;
 }
 
+void appendCue(
+        QList<CuePointer>* pCues,
+        QMap<int, CuePointer>* pHotCuesByNumber,
+        CuePointer pCue) {
+    VERIFY_OR_DEBUG_ASSERT(pCue) {
+        return;
+    }
+    int hotCueNumber = pCue->getHotCue();
+    if (hotCueNumber != Cue::kNoHotCue) {
+        const auto pDuplicateCue = pHotCuesByNumber->take(hotCueNumber);
+        if (pDuplicateCue) {
+            kLogger.warning()
+                    << "Dropping hot cue"
+                    << pDuplicateCue->getId()
+                    << "with duplicate number"
+                    << hotCueNumber;
+            pCues->removeOne(pDuplicateCue);
+        }
+        pHotCuesByNumber->insert(hotCueNumber, pCue);
+    }
+    pCues->push_back(pCue);
+}
+
 } // namespace
 
 QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
@@ -85,28 +108,54 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
     }
     QMap<int, CuePointer> hotCuesByNumber;
     while (query.next()) {
-        CuePointer pCue = cueFromRow(query.record());
-        VERIFY_OR_DEBUG_ASSERT(pCue) {
-            continue;
-        }
-        int hotCueNumber = pCue->getHotCue();
-        if (hotCueNumber != Cue::kNoHotCue) {
-            const auto pDuplicateCue = hotCuesByNumber.take(hotCueNumber);
-            if (pDuplicateCue) {
-                kLogger.warning()
-                        << "Dropping hot cue"
-                        << pDuplicateCue->getId()
-                        << "with duplicate number"
-                        << hotCueNumber;
-                cues.removeOne(pDuplicateCue);
-            }
-            hotCuesByNumber.insert(hotCueNumber, pCue);
-        }
-        cues.push_back(pCue);
+        appendCue(&cues, &hotCuesByNumber, cueFromRow(query.record()));
     }
     return cues;
 }
 
+QHash<TrackId, QList<CuePointer>> CueDAO::getCuesForTracks(
+        const QList<TrackId>& trackIds) const {
+    QHash<TrackId, QList<CuePointer>> cuesByTrackId;
+    if (trackIds.isEmpty()) {
+        return cuesByTrackId;
+    }
+
+    QStringList idList;
+    for (const auto& trackId : trackIds) {
+        idList << trackId.toString();
+    }
+    // Ordered by track to collect the hot cues of one track at a time
+    FwdSqlQuery query(
+            m_database,
+            QStringLiteral("SELECT * FROM " CUE_TABLE
+                           " WHERE track_id IN (%1) ORDER BY track_id, id")
+                    .arg(idList.join(",")));
+    DEBUG_ASSERT(
+            query.isPrepared() &&
+            !query.hasError());
+    VERIFY_OR_DEBUG_ASSERT(query.execPrepared()) {
+        kLogger.warning()
+                << "Failed to load cues of"
+                << trackIds.size()
+                << "tracks";
+        return cuesByTrackId;
+    }
+    const DbFieldIndex trackIdIndex = query.fieldIndex("track_id");
+    TrackId currentTrackId;
+    QList<CuePointer>* pCues = nullptr;
+    QMap<int, CuePointer> hotCuesByNumber;
+    while (query.next()) {
+        const TrackId trackId(query.fieldValue(trackIdIndex));
+        if (!pCues || trackId != currentTrackId) {
+            currentTrackId = trackId;
+            pCues = &cuesByTrackId[trackId];
+            hotCuesByNumber.clear();
+        }
+        appendCue(pCues, &hotCuesByNumber, cueFromRow(query.record()));
+    }
+    return cuesByTrackId;
+}
+
 bool CueDAO::deleteCuesForTrack(TrackId trackId) const {
     qDebug() << "CueDAO::deleteCuesForTrack" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(m_database);
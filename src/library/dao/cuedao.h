@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QSqlDatabase>
 
 #include "track/track.h"
@@ -18,6 +19,9 @@ class CueDAO : public DAO {
     }
 
     QList<CuePointer> getCuesForTrack(TrackId trackId) const;
+    // Loads the cues of multiple tracks with a single query
+    QHash<TrackId, QList<CuePointer>> getCuesForTracks(
+            const QList<TrackId>& trackIds) const;
 
     void saveTrackCues(TrackId trackId, const QList<CuePointer>& cueList) const;
     bool deleteCuesForTrack(TrackId trackId) const;
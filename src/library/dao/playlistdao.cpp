@@ -1,6 +1,9 @@
 #include <QtDebug>
 #include <QtSql>
 
+#include <algorithm>
+#include <limits>
+
 #include "track/track.h"
 #include "library/dao/playlistdao.h"
 #include "library/queryutil.h"
@@ -9,6 +12,15 @@
 #include "util/compatibility.h"
 #include "util/math.h"
 
+namespace {
+
+// The distance between the positions of appended tracks. Tracks are
+// inserted or moved between two tracks by using the unused positions
+// in between, without renumbering the following tracks.
+constexpr int kPositionGap = 1024;
+
+} // anonymous namespace
+
 PlaylistDAO::PlaylistDAO()
         : m_pAutoDJProcessor(nullptr) {
 }
@@ -144,6 +156,25 @@ QList<TrackId> PlaylistDAO::getTrackIds(const int playlistId) const {
     return trackIds;
 }
 
+QVector<int> PlaylistDAO::getTrackPositions(const int playlistId) const {
+    QVector<int> positions;
+
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare("SELECT position FROM PlaylistTracks "
+                  "WHERE playlist_id = :id ORDER BY position");
+    query.bindValue(":id", playlistId);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return positions;
+    }
+
+    while (query.next()) {
+        positions.append(query.value(0).toInt());
+    }
+    return positions;
+}
+
 int PlaylistDAO::getPlaylistIdFromName(const QString& name) const {
     //qDebug() << "PlaylistDAO::getPlaylistIdFromName" << QThread::currentThread() << m_database.connectionName();
 
@@ -265,13 +296,19 @@ bool PlaylistDAO::appendTracksToPlaylist(const QList<TrackId>& trackIds, const i
     // qDebug() << "PlaylistDAO::appendTracksToPlaylist"
     //          << QThread::currentThread() << m_database.connectionName();
 
+    if (trackIds.isEmpty()) {
+        return true;
+    }
+
     // Start the transaction
     ScopedTransaction transaction(m_database);
 
-    int position = getMaxPosition(playlistId);
-
-    // Append after the last song. If no songs or a failed query then 0 becomes 1.
-    ++position;
+    // Append after the last song.
+    const QList<int> positions = allocatePositions(
+            playlistId, getMaxPosition(playlistId) + 1, trackIds.size());
+    if (positions.isEmpty()) {
+        return false;
+    }
 
     //Insert the song into the PlaylistTracks table
     QSqlQuery query(m_database);
@@ -279,11 +316,9 @@ bool PlaylistDAO::appendTracksToPlaylist(const QList<TrackId>& trackIds, const i
                   "VALUES (:playlist_id, :track_id, :position, CURRENT_TIMESTAMP)");
     query.bindValue(":playlist_id", playlistId);
 
-
-    int insertPosition = position;
-    for (const auto& trackId: trackIds) {
-        query.bindValue(":track_id", trackId.toVariant());
-        query.bindValue(":position", insertPosition++);
+    for (int i = 0; i < trackIds.size(); ++i) {
+        query.bindValue(":track_id", trackIds[i].toVariant());
+        query.bindValue(":position", positions[i]);
         if (!query.exec()) {
             LOG_FAILED_QUERY(query);
             return false;
@@ -293,11 +328,10 @@ bool PlaylistDAO::appendTracksToPlaylist(const QList<TrackId>& trackIds, const i
     // Commit the transaction
     transaction.commit();
 
-    insertPosition = position;
-    for (const auto& trackId: trackIds) {
-        m_playlistsTrackIsIn.insert(trackId, playlistId);
+    for (int i = 0; i < trackIds.size(); ++i) {
+        m_playlistsTrackIsIn.insert(trackIds[i], playlistId);
         // TODO(XXX) don't emit if the track didn't add successfully.
-        emit trackAdded(playlistId, trackId, insertPosition++);
+        emit trackAdded(playlistId, trackIds[i], positions[i]);
     }
     emit tracksChanged(QSet<int>{playlistId});
     return true;
@@ -406,10 +440,11 @@ void PlaylistDAO::removeHiddenTracks(const int playlistId) {
         return;
     }
 
+    QList<int> positions;
     while (query.next()) {
-        int position = query.value(query.record().indexOf("position")).toInt();
-        removeTracksFromPlaylistInner(playlistId, position);
+        positions.append(query.value(query.record().indexOf("position")).toInt());
     }
+    removeTracksFromPlaylistInner(playlistId, std::move(positions));
 
     transaction.commit();
     emit tracksChanged(QSet<int>{playlistId});
@@ -436,10 +471,11 @@ void PlaylistDAO::removeTracksFromPlaylistByIdInner(int playlistId, TrackId trac
         return;
     }
 
+    QList<int> positions;
     while (query.next()) {
-        int position = query.value(query.record().indexOf("position")).toInt();
-        removeTracksFromPlaylistInner(playlistId, position);
+        positions.append(query.value(query.record().indexOf("position")).toInt());
     }
+    removeTracksFromPlaylistInner(playlistId, std::move(positions));
 }
 
 
@@ -447,66 +483,64 @@ void PlaylistDAO::removeTrackFromPlaylist(int playlistId, int position) {
     // qDebug() << "PlaylistDAO::removeTrackFromPlaylist"
     //          << QThread::currentThread() << m_database.connectionName();
     ScopedTransaction transaction(m_database);
-    removeTracksFromPlaylistInner(playlistId, position);
+    removeTracksFromPlaylistInner(playlistId, QList<int>{position});
     transaction.commit();
     emit tracksChanged(QSet<int>{playlistId});
 }
 
 void PlaylistDAO::removeTracksFromPlaylist(int playlistId, QList<int> positions) {
-    // get positions in reversed order
-    std::sort(positions.begin(), positions.end(), std::greater<int>());
-
     //qDebug() << "PlaylistDAO::removeTrackFromPlaylist"
     //         << QThread::currentThread() << m_database.connectionName();
     ScopedTransaction transaction(m_database);
-    for (const auto position : qAsConst(positions)) {
-        removeTracksFromPlaylistInner(playlistId, position);
-    }
+    removeTracksFromPlaylistInner(playlistId, std::move(positions));
     transaction.commit();
     emit tracksChanged(QSet<int>{playlistId});
 }
 
-void PlaylistDAO::removeTracksFromPlaylistInner(int playlistId, int position) {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT track_id FROM PlaylistTracks WHERE playlist_id=:id "
-                  "AND position=:position");
-    query.bindValue(":id", playlistId);
-    query.bindValue(":position", position);
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-        return;
-    }
-
-    if (!query.next()) {
-        qDebug() << "removeTrackFromPlaylist no track exists at position:"
-                 << position << "in playlist:" << playlistId;
-        return;
-    }
-    TrackId trackId(query.value(query.record().indexOf("track_id")));
-
-    // Delete the track from the playlist.
-    query.prepare("DELETE FROM PlaylistTracks "
-                  "WHERE playlist_id=:id AND position= :position");
-    query.bindValue(":id", playlistId);
-    query.bindValue(":position", position);
+void PlaylistDAO::removeTracksFromPlaylistInner(int playlistId, QList<int> positions) {
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    QSqlQuery selectQuery(m_database);
+    selectQuery.prepare("SELECT track_id FROM PlaylistTracks WHERE playlist_id=:id "
+                        "AND position=:position");
+    selectQuery.bindValue(":id", playlistId);
+    QSqlQuery deleteQuery(m_database);
+    deleteQuery.prepare("DELETE FROM PlaylistTracks "
+                        "WHERE playlist_id=:id AND position=:position");
+    deleteQuery.bindValue(":id", playlistId);
+
+    QList<int> removedPositions;
+    QList<TrackId> removedTrackIds;
+    for (const auto position : qAsConst(positions)) {
+        selectQuery.bindValue(":position", position);
+        if (!selectQuery.exec()) {
+            LOG_FAILED_QUERY(selectQuery);
+            continue;
+        }
+        if (!selectQuery.next()) {
+            qDebug() << "removeTrackFromPlaylist no track exists at position:"
+                     << position << "in playlist:" << playlistId;
+            continue;
+        }
+        TrackId trackId(selectQuery.value(0));
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-        return;
+        // Delete the track from the playlist.
+        deleteQuery.bindValue(":position", position);
+        if (!deleteQuery.exec()) {
+            LOG_FAILED_QUERY(deleteQuery);
+            continue;
+        }
+        removedPositions.append(position);
+        removedTrackIds.append(trackId);
     }
 
-    QString queryString;
-    queryString = QString("UPDATE PlaylistTracks SET position=position-1 "
-                          "WHERE position>=%1 AND "
-                          "playlist_id=%2").arg(QString::number(position),
-                                                QString::number(playlistId));
-    if (!query.exec(queryString)) {
-        LOG_FAILED_QUERY(query);
+    // The positions of the following tracks are not changed, the unused
+    // positions are filled by subsequent inserts.
+    for (int i = 0; i < removedPositions.size(); ++i) {
+        m_playlistsTrackIsIn.remove(removedTrackIds[i], playlistId);
+        emit trackRemoved(playlistId, removedTrackIds[i], removedPositions[i]);
     }
-
-    m_playlistsTrackIsIn.remove(trackId, playlistId);
-    emit trackRemoved(playlistId, trackId, position);
 }
 
 
@@ -517,26 +551,14 @@ bool PlaylistDAO::insertTrackIntoPlaylist(TrackId trackId, const int playlistId,
 
     ScopedTransaction transaction(m_database);
 
-    int max_position = getMaxPosition(playlistId) + 1;
-
-    if (position > max_position) {
-        position = max_position;
-    }
-
-    // Move all the tracks in the playlist up by one
-    QString queryString =
-            QString("UPDATE PlaylistTracks SET position=position+1 "
-                    "WHERE position>=%1 AND "
-                    "playlist_id=%2").arg(QString::number(position),
-                                          QString::number(playlistId));
-
-    QSqlQuery query(m_database);
-    if (!query.exec(queryString)) {
-        LOG_FAILED_QUERY(query);
+    const QList<int> positions = allocatePositions(playlistId, position, 1);
+    if (positions.isEmpty()) {
         return false;
     }
+    position = positions.first();
 
     //Insert the song into the PlaylistTracks table
+    QSqlQuery query(m_database);
     query.prepare("INSERT INTO PlaylistTracks (playlist_id, track_id, position, pl_datetime_added)"
                   "VALUES (:playlist_id, :track_id, :position, CURRENT_TIMESTAMP)");
     query.bindValue(":playlist_id", playlistId);
@@ -561,59 +583,50 @@ int PlaylistDAO::insertTracksIntoPlaylist(const QList<TrackId>& trackIds,
         return 0;
     }
 
-    int tracksAdded = 0;
     ScopedTransaction transaction(m_database);
 
-    int max_position = getMaxPosition(playlistId) + 1;
+    QList<TrackId> validTrackIds;
+    validTrackIds.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        if (trackId.isValid()) {
+            validTrackIds.append(trackId);
+        }
+    }
+    if (validTrackIds.isEmpty()) {
+        return 0;
+    }
 
-    if (position > max_position) {
-        position = max_position;
+    // Only the following tracks that are nearest to the inserted
+    // tracks might need to make room for them
+    const QList<int> positions = allocatePositions(
+            playlistId, position, validTrackIds.size());
+    if (positions.isEmpty()) {
+        return 0;
     }
 
     QSqlQuery insertQuery(m_database);
     insertQuery.prepare("INSERT INTO PlaylistTracks (playlist_id, track_id, position)"
                         "VALUES (:playlist_id, :track_id, :position)");
-    QSqlQuery query(m_database);
-    int insertPositon = position;
-    for (const auto& trackId: trackIds) {
-        if (!trackId.isValid()) {
-            continue;
-        }
-        // Move all tracks in playlist up by 1.
-        // TODO(XXX) We could do this in one query before the for loop.
-        query.prepare(QString("UPDATE PlaylistTracks SET position=position+1 "
-                              "WHERE position>=%1 AND "
-                              "playlist_id=%2").arg(insertPositon).arg(playlistId));
-
-        if (!query.exec()) {
-            LOG_FAILED_QUERY(query);
-            continue;
-        }
-
+    insertQuery.bindValue(":playlist_id", playlistId);
+    for (int i = 0; i < validTrackIds.size(); ++i) {
         // Insert the track at the given position
-        insertQuery.bindValue(":playlist_id", playlistId);
-        insertQuery.bindValue(":track_id", trackId.toVariant());
-        insertQuery.bindValue(":position", insertPositon);
+        insertQuery.bindValue(":track_id", validTrackIds[i].toVariant());
+        insertQuery.bindValue(":position", positions[i]);
         if (!insertQuery.exec()) {
+            // Discard all changes instead of inserting only some tracks
             LOG_FAILED_QUERY(insertQuery);
-            continue;
+            return 0;
         }
-
-        // Increment the insert position for the track.
-        ++insertPositon;
-        ++tracksAdded;
     }
 
     transaction.commit();
 
-    insertPositon = position;
-    for (const auto& trackId: trackIds) {
-        m_playlistsTrackIsIn.insert(trackId, playlistId);
-        // TODO(XXX) The position is wrong if any track failed to insert.
-        emit trackAdded(playlistId, trackId, insertPositon++);
+    for (int i = 0; i < validTrackIds.size(); ++i) {
+        m_playlistsTrackIsIn.insert(validTrackIds[i], playlistId);
+        emit trackAdded(playlistId, validTrackIds[i], positions[i]);
     }
     emit tracksChanged(QSet<int>{playlistId});
-    return tracksAdded;
+    return validTrackIds.size();
 }
 
 void PlaylistDAO::addPlaylistToAutoDJQueue(const int playlistId, AutoDJSendLoc loc) {
@@ -736,6 +749,125 @@ int PlaylistDAO::getMaxPosition(const int playlistId) const {
     return position;
 }
 
+int PlaylistDAO::getMinPosition(const int playlistId) const {
+    QSqlQuery query(m_database);
+    query.prepare("SELECT min(position) as position FROM PlaylistTracks "
+                  "WHERE playlist_id = :id");
+    query.bindValue(":id", playlistId);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    int position = 0;
+    if (query.next()) {
+        position = query.value(query.record().indexOf("position")).toInt();
+    }
+    return position;
+}
+
+QList<int> PlaylistDAO::allocatePositions(
+        const int playlistId, int position, int count) {
+    DEBUG_ASSERT(count > 0);
+    // Leave room for appending after the last position
+    const int maxPosition = std::numeric_limits<int>::max() - 1;
+
+    // The nearest tracks in front of the new tracks in descending order and
+    // after them in ascending order. Tracks with a negative position are
+    // currently being moved.
+    QSqlQuery prevQuery(m_database);
+    prevQuery.prepare("SELECT id, position FROM PlaylistTracks "
+                      "WHERE playlist_id=:id AND position>=0 AND position<:position "
+                      "ORDER BY position DESC LIMIT :limit");
+    prevQuery.bindValue(":id", playlistId);
+    prevQuery.bindValue(":position", position);
+    QSqlQuery nextQuery(m_database);
+    nextQuery.prepare("SELECT id, position FROM PlaylistTracks "
+                      "WHERE playlist_id=:id AND position>=:position "
+                      "ORDER BY position LIMIT :limit");
+    nextQuery.bindValue(":id", playlistId);
+    nextQuery.bindValue(":position", position);
+
+    // Widen the range of respaced tracks around the new tracks until
+    // there are enough unused positions. The first range contains no
+    // tracks, so that the new tracks just fill the unused positions
+    // between their neighbors.
+    for (int rangeSize = 0;; rangeSize = 2 * rangeSize + 1) {
+        // Fetch one more track on each side, that bounds the range.
+        prevQuery.bindValue(":limit", rangeSize + 1);
+        nextQuery.bindValue(":limit", rangeSize + 1);
+        if (!prevQuery.exec()) {
+            LOG_FAILED_QUERY(prevQuery);
+            return QList<int>();
+        }
+        if (!nextQuery.exec()) {
+            LOG_FAILED_QUERY(nextQuery);
+            return QList<int>();
+        }
+        QList<int> rowIds;
+        QList<int> oldPositions;
+        while (prevQuery.next()) {
+            rowIds.prepend(prevQuery.value(0).toInt());
+            oldPositions.prepend(prevQuery.value(1).toInt());
+        }
+        int lowerBound = 0;
+        const bool lowerBounded = rowIds.size() > rangeSize;
+        if (lowerBounded) {
+            rowIds.removeFirst();
+            lowerBound = oldPositions.takeFirst();
+        }
+        const int prevCount = rowIds.size();
+        while (nextQuery.next()) {
+            rowIds.append(nextQuery.value(0).toInt());
+            oldPositions.append(nextQuery.value(1).toInt());
+        }
+        int upperBound = maxPosition;
+        const bool upperBounded = rowIds.size() - prevCount > rangeSize;
+        if (upperBounded) {
+            rowIds.removeLast();
+            upperBound = oldPositions.takeLast();
+        }
+
+        const int spacedCount = rowIds.size() + count;
+        int spacing = (upperBound - lowerBound) / (spacedCount + 1);
+        if (!upperBounded) {
+            spacing = math_min(spacing, kPositionGap);
+        }
+        // Respaced tracks should leave unused positions in between,
+        // otherwise the next insert would need to respace them again.
+        const int minSpacing = (rangeSize == 0 || (!lowerBounded && !upperBounded)) ? 1 : 2;
+        if (spacing < minSpacing) {
+            if (!lowerBounded && !upperBounded) {
+                qWarning() << "No positions left in playlist" << playlistId;
+                return QList<int>();
+            }
+            continue;
+        }
+
+        QSqlQuery updateQuery(m_database);
+        updateQuery.prepare("UPDATE PlaylistTracks SET position=:position WHERE id=:id");
+        QList<int> newPositions;
+        newPositions.reserve(count);
+        for (int i = 0; i < spacedCount; ++i) {
+            const int newPosition = lowerBound + (i + 1) * spacing;
+            if (i >= prevCount && i < prevCount + count) {
+                newPositions.append(newPosition);
+                continue;
+            }
+            const int rowIndex = i < prevCount ? i : i - count;
+            if (oldPositions[rowIndex] == newPosition) {
+                continue;
+            }
+            updateQuery.bindValue(":position", newPosition);
+            updateQuery.bindValue(":id", rowIds[rowIndex]);
+            if (!updateQuery.exec()) {
+                LOG_FAILED_QUERY(updateQuery);
+                return QList<int>();
+            }
+        }
+        return newPositions;
+    }
+}
+
 void PlaylistDAO::removeTracksFromPlaylists(const QList<TrackId>& trackIds) {
     // copy the hash, because there is no guarantee that "it" is valid after remove
     QMultiHash<TrackId, int> playlistsTrackIsInCopy = m_playlistsTrackIsIn;
@@ -775,58 +907,67 @@ int PlaylistDAO::tracksInPlaylist(const int playlistId) const {
     return count;
 }
 
-void PlaylistDAO::moveTrack(const int playlistId, const int oldPosition, const int newPosition) {
+void PlaylistDAO::moveTracks(const int playlistId,
+        QList<int> positions, int destPosition) {
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    if (positions.isEmpty()) {
+        return;
+    }
+
     ScopedTransaction transaction(m_database);
-    QSqlQuery query(m_database);
 
-    // Algorithm for code below
-    // Case 1: destination < source (newPositon < oldPosition)
-    //    1) Set position = -1 where pos=source -- Gives that track a dummy index to keep stuff simple.
-    //    2) Decrement position where pos >= dest AND pos < source
-    //    3) Set position = dest where pos=-1 -- Move track from dummy pos to final destination.
-
-     // Case 2: destination > source (newPos > oldPos)
-     //   1) Set position=-1 where pos=source -- Give track a dummy index again.
-     //   2) Decrement position where pos > source AND pos <= dest
-     //   3) Set position=dest where pos=-1 -- Move that track from dummy pos to final destination
-
-    QString queryString;
-
-    // Move moved track to dummy position -1
-    queryString = QString("UPDATE PlaylistTracks SET position=-1 "
-                          "WHERE position=%1 AND "
-                          "playlist_id=%2").arg(QString::number(oldPosition),
-                                                QString::number(playlistId));
-    query.exec(queryString);
-
-    if (newPosition < oldPosition) {
-        queryString = QString("UPDATE PlaylistTracks SET position=position+1 "
-                              "WHERE position >= %1 AND position < %2 AND "
-                              "playlist_id=%3").arg(QString::number(newPosition),
-                                                    QString::number(oldPosition),
-                                                    QString::number(playlistId));
-    } else {
-        queryString = QString("UPDATE PlaylistTracks SET position=position-1 "
-                              "WHERE position>%1 AND position<=%2 AND "
-                              "playlist_id=%3").arg(QString::number(oldPosition),
-                                                    QString::number(newPosition),
-                                                    QString::number(playlistId));
+    // The moved rows in their current order, identified by the primary key
+    QSqlQuery query(m_database);
+    query.prepare("SELECT id FROM PlaylistTracks "
+                  "WHERE playlist_id=:id AND position=:position");
+    query.bindValue(":id", playlistId);
+    QList<int> rowIds;
+    for (const auto position : qAsConst(positions)) {
+        query.bindValue(":position", position);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+            return;
+        }
+        while (query.next()) {
+            rowIds.append(query.value(0).toInt());
+        }
+    }
+    if (rowIds.isEmpty()) {
+        return;
     }
-    query.exec(queryString);
 
-    queryString = QString("UPDATE PlaylistTracks SET position = %1 "
-                          "WHERE position=-1 AND "
-                          "playlist_id=%2").arg(QString::number(newPosition),
-                                                QString::number(playlistId));
-    query.exec(queryString);
+    // Take the moved tracks out of the order, their positions can be
+    // reused for the moved tracks or for making room for them.
+    query.prepare("UPDATE PlaylistTracks SET position=-1 WHERE id=:id");
+    for (const auto rowId : qAsConst(rowIds)) {
+        query.bindValue(":id", rowId);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+            return;
+        }
+    }
 
-    transaction.commit();
+    if (destPosition < 1) {
+        destPosition = getMaxPosition(playlistId) + 1;
+    }
+    const QList<int> newPositions =
+            allocatePositions(playlistId, destPosition, rowIds.size());
+    if (newPositions.isEmpty()) {
+        return;
+    }
 
-    // Print out any SQL error, if there was one.
-    if (query.lastError().isValid()) {
-        qDebug() << query.lastError();
+    query.prepare("UPDATE PlaylistTracks SET position=:position WHERE id=:id");
+    for (int i = 0; i < rowIds.size(); ++i) {
+        query.bindValue(":position", newPositions[i]);
+        query.bindValue(":id", rowIds[i]);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+            return;
+        }
     }
 
+    transaction.commit();
     emit tracksChanged(QSet<int>{playlistId});
 }
 
@@ -849,13 +990,29 @@ void PlaylistDAO::searchForDuplicateTrack(const int fromPosition,
     }
 }
 
-void PlaylistDAO::shuffleTracks(const int playlistId, const QList<int>& positions, const QHash<int,TrackId>& allIds) {
+void PlaylistDAO::shuffleTracks(const int playlistId, const QList<int>& shufflePositions, const QHash<int,TrackId>& allIds) {
     ScopedTransaction transaction(m_database);
     QSqlQuery query(m_database);
 
+    // The shuffling below measures the distance between tracks by their
+    // number in the playlist, i.e. the rank of their sparse position.
+    QList<int> positionsInOrder = allIds.keys();
+    std::sort(positionsInOrder.begin(), positionsInOrder.end());
+    QHash<int,TrackId> trackPositionIds;
+    QHash<int,int> rankByPosition;
+    for (int i = 0; i < positionsInOrder.size(); ++i) {
+        trackPositionIds.insert(i + 1, allIds.value(positionsInOrder[i]));
+        rankByPosition.insert(positionsInOrder[i], i + 1);
+    }
+    QList<int> positions;
+    for (const auto position : shufflePositions) {
+        if (rankByPosition.contains(position)) {
+            positions.append(rankByPosition.value(position));
+        }
+    }
+
     int seed = QDateTime::currentDateTimeUtc().toTime_t();
     qsrand(seed);
-    QHash<int,TrackId> trackPositionIds = allIds;
     QList<int> newPositions = positions;
     const int searchDistance = math_max(trackPositionIds.count() / 4, 1);
 
@@ -988,13 +1145,15 @@ void PlaylistDAO::shuffleTracks(const int playlistId, const QList<int>& position
 
         QString swapQuery = "UPDATE PlaylistTracks SET position=%1 "
                 "WHERE position=%2 AND playlist_id=%3";
+        const int storedPositionA = positionsInOrder[trackAPosition - 1];
+        const int storedPositionB = positionsInOrder[trackBPosition - 1];
         query.exec(swapQuery.arg(QString::number(-1),
-                                 QString::number(trackAPosition),
+                                 QString::number(storedPositionA),
                                  QString::number(playlistId)));
-        query.exec(swapQuery.arg(QString::number(trackAPosition),
-                                 QString::number(trackBPosition),
+        query.exec(swapQuery.arg(QString::number(storedPositionA),
+                                 QString::number(storedPositionB),
                                  QString::number(playlistId)));
-        query.exec(swapQuery.arg(QString::number(trackBPosition),
+        query.exec(swapQuery.arg(QString::number(storedPositionB),
                                  QString::number(-1),
                                  QString::number(playlistId)));
 
@@ -1032,7 +1191,8 @@ void PlaylistDAO::addTracksToAutoDJQueue(const QList<TrackId>& trackIds, AutoDJS
     // If the first track is already loaded to the player,
     // alter the playlist only below the first track
     int position =
-        (m_pAutoDJProcessor && m_pAutoDJProcessor->nextTrackLoaded()) ? 2 : 1;
+        (m_pAutoDJProcessor && m_pAutoDJProcessor->nextTrackLoaded())
+            ? getMinPosition(iAutoDJPlaylistId) + 1 : 0;
 
     switch (loc) {
         case AutoDJSendLoc::TOP:
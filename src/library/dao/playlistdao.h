@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QSqlDatabase>
 #include <QSet>
+#include <QVector>
 
 #include "library/dao/dao.h"
 #include "track/trackid.h"
@@ -80,6 +81,10 @@ class PlaylistDAO : public QObject, public virtual DAO {
     // stored in the database.
     int getPlaylistId(const int index) const;
     QList<TrackId> getTrackIds(const int playlistId) const;
+    // Returns the positions of all tracks in the playlist in ascending order.
+    // The positions are sparse and only define the order of the tracks, the
+    // index of a position in this list is the number of the track.
+    QVector<int> getTrackPositions(const int playlistId) const;
     // Returns true if the playlist with playlistId is hidden
     bool isHidden(const int playlistId) const;
     // Returns the HiddenType of playlistId
@@ -94,9 +99,10 @@ class PlaylistDAO : public QObject, public virtual DAO {
     void removeTrackFromPlaylist(int playlistId, int position);
     void removeTracksFromPlaylist(int playlistId, QList<int> positions);
     void removeTracksFromPlaylistById(int playlistId, TrackId trackId);
-    // Insert a track into a specific position in a playlist
+    // Insert a track in front of the first track at or after position, or
+    // after the last track if there is no such track
     bool insertTrackIntoPlaylist(TrackId trackId, int playlistId, int position);
-    // Inserts a list of tracks into playlist
+    // Inserts a list of tracks into playlist like insertTrackIntoPlaylist()
     int insertTracksIntoPlaylist(const QList<TrackId>& trackIds, const int playlistId, int position);
     // Add a playlist to the Auto-DJ Queue
     void addPlaylistToAutoDJQueue(const int playlistId, AutoDJSendLoc loc);
@@ -109,9 +115,12 @@ class PlaylistDAO : public QObject, public virtual DAO {
     bool copyPlaylistTracks(const int sourcePlaylistID, const int targetPlaylistID);
     // Returns the number of tracks in the given playlist.
     int tracksInPlaylist(const int playlistId) const;
-    // moved Track to a new position
-    void moveTrack(const int playlistId,
-            const int oldPosition, const int newPosition);
+    // Moves the tracks at the given positions in their current order in
+    // front of the first other track at or after destPosition, or to the
+    // end of the playlist if there is no such track or destPosition is 0.
+    // Only the moved tracks get new positions.
+    void moveTracks(const int playlistId,
+            QList<int> positions, int destPosition);
     // shuffles all tracks in the position List
     void shuffleTracks(const int playlistId, const QList<int>& positions, const QHash<int,TrackId>& allIds);
     bool isTrackInPlaylist(TrackId trackId, const int playlistId) const;
@@ -131,8 +140,14 @@ class PlaylistDAO : public QObject, public virtual DAO {
 
   private:
     bool removeTracksFromPlaylist(int playlistId, int startIndex);
-    void removeTracksFromPlaylistInner(int playlistId, int position);
+    void removeTracksFromPlaylistInner(int playlistId, QList<int> positions);
     void removeTracksFromPlaylistByIdInner(int playlistId, TrackId trackId);
+    int getMinPosition(const int playlistId) const;
+    // Returns count ascending positions for tracks inserted in front of the
+    // first track at or after position, or after the last track if there
+    // is no such track. Respaces the positions of the nearest tracks if
+    // there are not enough unused positions in between.
+    QList<int> allocatePositions(const int playlistId, int position, int count);
     void searchForDuplicateTrack(const int fromPosition,
                                  const int toPosition,
                                  TrackId trackID,
@@ -15,6 +15,7 @@
 #include "util/db/sqlstringformatter.h"
 #include "util/db/sqllikewildcards.h"
 #include "util/db/sqllikewildcardescaper.h"
+#include "util/db/sqlsavepoint.h"
 #include "util/db/sqltransaction.h"
 #include "library/coverart.h"
 #include "library/coverartutils.h"
@@ -250,6 +251,23 @@ QSet<QString> TrackDAO::getAllTrackLocations() const {
     return locations;
 }
 
+QList<TrackId> TrackDAO::getAllTrackIds() const {
+    QList<TrackId> trackIds;
+    QSqlQuery query(m_database);
+    query.prepare("SELECT library.id FROM library "
+                  "INNER JOIN track_locations ON library.location = track_locations.id "
+                  "WHERE library.mixxx_deleted=0 AND track_locations.fs_deleted=0");
+    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    const int idColumn = query.record().indexOf("id");
+    while (query.next()) {
+        trackIds.append(TrackId(query.value(idColumn)));
+    }
+    return trackIds;
+}
+
 // Some code (eg. drag and drop) needs to just get a track's location, and it's
 // not worth retrieving a whole Track.
 QString TrackDAO::getTrackLocation(TrackId trackId) const {
@@ -331,14 +349,14 @@ void TrackDAO::slotDatabaseTracksRelocated(QList<RelocatedTrack> relocatedTracks
 void TrackDAO::addTracksPrepare() {
     if (m_pQueryLibraryInsert || m_pQueryTrackLocationInsert ||
             m_pQueryLibrarySelect || m_pQueryTrackLocationSelect ||
-            m_pTransaction) {
+            m_addTracksBatch.pSavepoint) {
         qDebug() << "TrackDAO::addTracksPrepare: PROGRAMMING ERROR"
              << "old queries have been left open, rolling back.";
         // true == do a db rollback
         addTracksFinish(true);
     }
     // Start the transaction
-    m_pTransaction = std::make_unique<SqlTransaction>(m_database);
+    beginBatch(&m_addTracksBatch, QStringLiteral("add_tracks"));
 
     m_pQueryTrackLocationInsert = std::make_unique<QSqlQuery>(m_database);
     m_pQueryTrackLocationSelect = std::make_unique<QSqlQuery>(m_database);
@@ -386,24 +404,68 @@ void TrackDAO::addTracksPrepare() {
 }
 
 void TrackDAO::addTracksFinish(bool rollback) {
-    if (m_pTransaction) {
-        if (rollback) {
-            m_pTransaction->rollback();
-            m_tracksAddedSet.clear();
-        } else {
-            m_pTransaction->commit();
-        }
+    if (m_addTracksBatch.pSavepoint && rollback) {
+        m_tracksAddedSet.clear();
     }
     m_pQueryTrackLocationInsert.reset();
     m_pQueryTrackLocationSelect.reset();
     m_pQueryLibraryInsert.reset();
     m_pQueryLibrarySelect.reset();
-    m_pTransaction.reset();
+    finishBatch(&m_addTracksBatch, rollback);
 
     emit tracksAdded(m_tracksAddedSet);
     m_tracksAddedSet.clear();
 }
 
+void TrackDAO::saveTracksPrepare() {
+    VERIFY_OR_DEBUG_ASSERT(!m_saveTracksBatch.pSavepoint) {
+        return;
+    }
+    beginBatch(&m_saveTracksBatch, QStringLiteral("save_tracks"));
+}
+
+void TrackDAO::saveTracksFinish(bool rollback) {
+    finishBatch(&m_saveTracksBatch, rollback);
+}
+
+void TrackDAO::beginBatch(Batch* pBatch, const QString& name) {
+    DEBUG_ASSERT(!pBatch->pSavepoint);
+    if (!m_pTransaction) {
+        m_pTransaction = std::make_unique<SqlTransaction>(m_database);
+    }
+    pBatch->pSavepoint = std::make_unique<SqlSavepoint>(m_database, name);
+    pBatch->nestedBatchReleased = false;
+}
+
+void TrackDAO::finishBatch(Batch* pBatch, bool rollback) {
+    DEBUG_ASSERT(pBatch == &m_addTracksBatch || pBatch == &m_saveTracksBatch);
+    // Batches are nested, i.e. the other batch encloses this batch
+    Batch* pOuterBatch = (pBatch == &m_addTracksBatch) ? &m_saveTracksBatch : &m_addTracksBatch;
+    if (pBatch->pSavepoint && *pBatch->pSavepoint) {
+        if (rollback && pBatch->nestedBatchReleased) {
+            // Failed tracks have already been rolled back individually
+            qWarning() << "TrackDAO: Keeping all modifications of a batch"
+                       << "that contains the released modifications of"
+                       << "a nested batch";
+            rollback = false;
+        }
+        if (rollback) {
+            pBatch->pSavepoint->rollback();
+        } else if (pBatch->pSavepoint->release() && pOuterBatch->pSavepoint) {
+            pOuterBatch->nestedBatchReleased = true;
+        }
+    }
+    pBatch->pSavepoint.reset();
+    pBatch->nestedBatchReleased = false;
+    if (m_pTransaction && !m_addTracksBatch.pSavepoint && !m_saveTracksBatch.pSavepoint) {
+        // The outermost batch has finished
+        if (*m_pTransaction) {
+            m_pTransaction->commit();
+        }
+        m_pTransaction.reset();
+    }
+}
+
 namespace {
 
 bool insertTrackLocation(
@@ -568,6 +630,10 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
     qDebug() << "TrackDAO: Adding track"
              << trackFile;
 
+    // Partial modifications of a failed track are discarded individually,
+    // even if the batch is not rolled back
+    SqlSavepoint savepoint(m_database, QStringLiteral("add_track"));
+
     TrackId trackId;
 
     // Insert the track location into the corresponding table. This will fail
@@ -683,6 +749,9 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
         m_tracksAddedSet.insert(trackId);
     }
 
+    if (savepoint) {
+        savepoint.release();
+    }
     return trackId;
 }
 
@@ -1154,10 +1223,90 @@ struct ColumnPopulator {
     TrackPopulatorFn populator;
 };
 
-}  // namespace
-
 #define ARRAYLENGTH(x) (sizeof(x) / sizeof(*x))
 
+const ColumnPopulator kTrackColumns[] = {
+    // Location and id must be first.
+    { "track_locations.location", nullptr },
+    { "library.id", nullptr },
+    { "artist", setTrackArtist },
+    { "title", setTrackTitle },
+    { "album", setTrackAlbum },
+    { "album_artist", setTrackAlbumArtist },
+    { "year", setTrackYear },
+    { "genre", setTrackGenre },
+    { "composer", setTrackComposer },
+    { "grouping", setTrackGrouping },
+    { "tracknumber", setTrackNumber },
+    { "tracktotal", setTrackTotal },
+    { "filetype", setTrackFiletype },
+    { "rating", setTrackRating },
+    { "color", setTrackColor },
+    { "comment", setTrackComment },
+    { "url", setTrackUrl },
+    { "cuepoint", setTrackCuePoint },
+    { "replaygain", setTrackReplayGainRatio },
+    { "replaygain_peak", setTrackReplayGainPeak },
+    { "timesplayed", setTrackTimesPlayed },
+    { "played", setTrackPlayed },
+    { "datetime_added", setTrackDateAdded },
+    { "header_parsed", setTrackMetadataSynchronized },
+
+    // Audio properties are set together at once. Do not change the
+    // ordering of these columns or put other columns in between them!
+    { "channels", setTrackAudioProperties },
+    { "samplerate", nullptr },
+    { "bitrate", nullptr },
+    { "duration", nullptr },
+
+    // Beat detection columns are handled by setTrackBeats. Do not change
+    // the ordering of these columns or put other columns in between them!
+    { "bpm", setTrackBeats },
+    { "beats_version", nullptr },
+    { "beats_sub_version", nullptr },
+    { "beats", nullptr },
+    { "bpm_lock", nullptr },
+
+    // Beat detection columns are handled by setTrackKey. Do not change the
+    // ordering of these columns or put other columns in between them!
+    { "key", setTrackKey },
+    { "keys_version", nullptr },
+    { "keys_sub_version", nullptr },
+    { "keys", nullptr },
+
+    // Cover art columns are handled by setTrackCoverInfo. Do not change the
+    // ordering of these columns or put other columns in between them!
+    { "coverart_source", setTrackCoverInfo },
+    { "coverart_type", nullptr },
+    { "coverart_location", nullptr },
+    { "coverart_hash", nullptr }
+};
+
+constexpr int kTrackColumnsCount = ARRAYLENGTH(kTrackColumns);
+constexpr int kTrackLocationColumn = 0;
+constexpr int kTrackIdColumn = 1;
+
+// The number of tracks that are loaded with a single query
+constexpr int kMaxTracksPerQuery = 500;
+
+QString trackColumnsString() {
+    QString columnsStr;
+    int columnsSize = 0;
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        columnsSize += qstrlen(kTrackColumns[i].name) + 1;
+    }
+    columnsStr.reserve(columnsSize);
+    for (int i = 0; i < kTrackColumnsCount; ++i) {
+        if (i > 0) {
+            columnsStr.append(QChar(','));
+        }
+        columnsStr.append(kTrackColumns[i].name);
+    }
+    return columnsStr;
+}
+
+}  // namespace
+
 TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     if (!trackId.isValid()) {
         return TrackPointer();
@@ -1176,80 +1325,10 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     ScopedTimer t("TrackDAO::getTrackById");
     QSqlQuery query(m_database);
 
-    ColumnPopulator columns[] = {
-        // Location must be first.
-        { "track_locations.location", nullptr },
-        { "artist", setTrackArtist },
-        { "title", setTrackTitle },
-        { "album", setTrackAlbum },
-        { "album_artist", setTrackAlbumArtist },
-        { "year", setTrackYear },
-        { "genre", setTrackGenre },
-        { "composer", setTrackComposer },
-        { "grouping", setTrackGrouping },
-        { "tracknumber", setTrackNumber },
-        { "tracktotal", setTrackTotal },
-        { "filetype", setTrackFiletype },
-        { "rating", setTrackRating },
-        { "color", setTrackColor },
-        { "comment", setTrackComment },
-        { "url", setTrackUrl },
-        { "cuepoint", setTrackCuePoint },
-        { "replaygain", setTrackReplayGainRatio },
-        { "replaygain_peak", setTrackReplayGainPeak },
-        { "timesplayed", setTrackTimesPlayed },
-        { "played", setTrackPlayed },
-        { "datetime_added", setTrackDateAdded },
-        { "header_parsed", setTrackMetadataSynchronized },
-
-        // Audio properties are set together at once. Do not change the
-        // ordering of these columns or put other columns in between them!
-        { "channels", setTrackAudioProperties },
-        { "samplerate", nullptr },
-        { "bitrate", nullptr },
-        { "duration", nullptr },
-
-        // Beat detection columns are handled by setTrackBeats. Do not change
-        // the ordering of these columns or put other columns in between them!
-        { "bpm", setTrackBeats },
-        { "beats_version", nullptr },
-        { "beats_sub_version", nullptr },
-        { "beats", nullptr },
-        { "bpm_lock", nullptr },
-
-        // Beat detection columns are handled by setTrackKey. Do not change the
-        // ordering of these columns or put other columns in between them!
-        { "key", setTrackKey },
-        { "keys_version", nullptr },
-        { "keys_sub_version", nullptr },
-        { "keys", nullptr },
-
-        // Cover art columns are handled by setTrackCoverInfo. Do not change the
-        // ordering of these columns or put other columns in between them!
-        { "coverart_source", setTrackCoverInfo },
-        { "coverart_type", nullptr },
-        { "coverart_location", nullptr },
-        { "coverart_hash", nullptr }
-    };
-
-    QString columnsStr;
-    int columnsSize = 0;
-    const int columnsCount = ARRAYLENGTH(columns);
-    for (int i = 0; i < columnsCount; ++i) {
-        columnsSize += qstrlen(columns[i].name) + 1;
-    }
-    columnsStr.reserve(columnsSize);
-    for (int i = 0; i < columnsCount; ++i) {
-        if (i > 0) {
-            columnsStr.append(QChar(','));
-        }
-        columnsStr.append(columns[i].name);
-    }
-
     query.prepare(QString(
             "SELECT %1 FROM Library "
             "INNER JOIN track_locations ON library.location = track_locations.id "
-            "WHERE library.id = %2").arg(columnsStr, trackId.toString()));
+            "WHERE library.id = %2").arg(trackColumnsString(), trackId.toString()));
 
     VERIFY_OR_DEBUG_ASSERT(query.exec()) {
         LOG_FAILED_QUERY(query)
@@ -1261,17 +1340,95 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return TrackPointer();
     }
 
-    QSqlRecord queryRecord = query.record();
+    return loadTrackFromRecord(
+            trackId,
+            query.record(),
+            m_cueDao.getCuesForTrack(trackId));
+}
+
+QList<TrackPointer> TrackDAO::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    // Cached tracks are returned as is, all others are loaded from
+    // the database.
+    QHash<TrackId, TrackPointer> tracksById;
+    QList<TrackId> uncachedTrackIds;
+    {
+        GlobalTrackCacheLocker cacheLocker;
+        for (const auto& trackId : trackIds) {
+            if (!trackId.isValid() || tracksById.contains(trackId)) {
+                continue;
+            }
+            auto pTrack = cacheLocker.lookupTrackById(trackId);
+            if (pTrack) {
+                tracksById.insert(trackId, std::move(pTrack));
+            } else {
+                uncachedTrackIds.append(trackId);
+            }
+        }
+    }
+
+    if (!uncachedTrackIds.isEmpty()) {
+        ScopedTimer t("TrackDAO::getTracksByIds");
+        const QString columnsStr = trackColumnsString();
+        // Instead of one query for the library and one for the cues per
+        // track both are loaded for many tracks at once
+        for (int offset = 0; offset < uncachedTrackIds.size(); offset += kMaxTracksPerQuery) {
+            const QList<TrackId> chunk = uncachedTrackIds.mid(offset, kMaxTracksPerQuery);
+            QStringList idList;
+            for (const auto& trackId : chunk) {
+                idList.append(trackId.toString());
+            }
+            QSqlQuery query(m_database);
+            query.prepare(QString(
+                    "SELECT %1 FROM Library "
+                    "INNER JOIN track_locations ON library.location = track_locations.id "
+                    "WHERE library.id IN (%2)").arg(columnsStr, idList.join(",")));
+            VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+                LOG_FAILED_QUERY(query);
+                continue;
+            }
+            QHash<TrackId, QList<CuePointer>> cuesByTrackId =
+                    m_cueDao.getCuesForTracks(chunk);
+            while (query.next()) {
+                const QSqlRecord queryRecord = query.record();
+                const TrackId trackId(queryRecord.value(kTrackIdColumn));
+                auto pTrack = loadTrackFromRecord(
+                        trackId,
+                        queryRecord,
+                        cuesByTrackId.take(trackId));
+                if (pTrack) {
+                    tracksById.insert(trackId, std::move(pTrack));
+                }
+            }
+        }
+    }
+
+    QList<TrackPointer> tracks;
+    tracks.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        auto pTrack = tracksById.value(trackId);
+        if (pTrack) {
+            tracks.append(std::move(pTrack));
+        } else if (trackId.isValid()) {
+            qDebug() << "Track with id =" << trackId << "not found";
+        }
+    }
+    return tracks;
+}
+
+TrackPointer TrackDAO::loadTrackFromRecord(
+        TrackId trackId,
+        const QSqlRecord& queryRecord,
+        QList<CuePointer> cuePoints) const {
     int recordCount = queryRecord.count();
-    VERIFY_OR_DEBUG_ASSERT(recordCount == columnsCount) {
-        recordCount = math_min(recordCount, columnsCount);
+    VERIFY_OR_DEBUG_ASSERT(recordCount == kTrackColumnsCount) {
+        recordCount = math_min(recordCount, kTrackColumnsCount);
     }
 
-    // Location is the first column.
-    const QString trackLocation(queryRecord.value(0).toString());
+    const QString trackLocation(queryRecord.value(kTrackLocationColumn).toString());
 
     GlobalTrackCacheResolver cacheResolver(TrackFile(trackLocation), trackId);
-    pTrack = cacheResolver.getTrack();
+    TrackPointer pTrack = cacheResolver.getTrack();
     VERIFY_OR_DEBUG_ASSERT(pTrack) {
         // Just to be safe, but this should never happen!!
         return pTrack;
@@ -1301,7 +1458,7 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     // For every column run its populator to fill the track in with the data.
     bool shouldDirty = false;
     for (int i = 0; i < recordCount; ++i) {
-        TrackPopulatorFn populator = columns[i].populator;
+        TrackPopulatorFn populator = kTrackColumns[i].populator;
         if (populator != nullptr) {
             // If any populator says the track should be dirty then we dirty it.
             if ((*populator)(queryRecord, i, pTrack)) {
@@ -1311,7 +1468,7 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     }
 
     // Populate track cues from the cues table.
-    pTrack->setCuePoints(m_cueDao.getCuesForTrack(trackId));
+    pTrack->setCuePoints(std::move(cuePoints));
 
     // Normally we will set the track as clean but sometimes when loading from
     // the database we need to perform upkeep that ought to be written back to
@@ -1413,7 +1570,16 @@ bool TrackDAO::updateTrack(Track* pTrack) const {
             << trackId
             << pTrack->getFileInfo();
 
-    SqlTransaction transaction(m_database);
+    // All modifications of a single track are either saved or discarded
+    // together, also within the enclosing transaction of a batch
+    std::unique_ptr<SqlTransaction> pTransaction;
+    std::unique_ptr<SqlSavepoint> pSavepoint;
+    if (m_pTransaction) {
+        pSavepoint = std::make_unique<SqlSavepoint>(
+                m_database, QStringLiteral("update_track"));
+    } else {
+        pTransaction = std::make_unique<SqlTransaction>(m_database);
+    }
     // PerformanceTimer time;
     // time.start();
 
@@ -1488,7 +1654,11 @@ bool TrackDAO::updateTrack(Track* pTrack) const {
             pTrack->getWaveformSummary());
     m_cueDao.saveTrackCues(
             trackId, pTrack->getCuePoints());
-    transaction.commit();
+    if (pTransaction) {
+        pTransaction->commit();
+    } else if (pSavepoint && *pSavepoint) {
+        pSavepoint->release();
+    }
 
     //qDebug() << "Update track in database took: " << time.elapsed().formatMillisWithUnit();
     //time.start();
@@ -15,6 +15,8 @@
 #include "util/class.h"
 #include "util/memory.h"
 
+class QSqlRecord;
+class SqlSavepoint;
 class SqlTransaction;
 class PlaylistDAO;
 class AnalysisDao;
@@ -60,6 +62,9 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     // Returns a set of all track locations in the library.
     QSet<QString> getAllTrackLocations() const;
+    // Returns the ids of all tracks in the library that have neither
+    // been hidden nor deleted from the file system.
+    QList<TrackId> getAllTrackIds() const;
     QString getTrackLocation(TrackId trackId) const;
 
     // Only used by friend class LibraryScanner, but public for testing!
@@ -96,11 +101,23 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
   private:
     friend class LibraryScanner;
     friend class TrackCollection;
+    friend class TrackDAOTest;
 
     TrackId getTrackIdByLocation(
             const QString& location) const;
     TrackPointer getTrackById(
             TrackId trackId) const;
+    // Loads multiple tracks with a few joined queries instead of
+    // separate queries for each track. The tracks are returned in
+    // the order of the ids, tracks that are not found are skipped.
+    QList<TrackPointer> getTracksByIds(
+            const QList<TrackId>& trackIds) const;
+    // Populates the track with the library columns of queryRecord, see
+    // getTrackById()
+    TrackPointer loadTrackFromRecord(
+            TrackId trackId,
+            const QSqlRecord& queryRecord,
+            QList<CuePointer> cuePoints) const;
 
     // Loads a track from the database (by id if available, otherwise by location)
     // or adds it if not found in case the location is known. The (optional) out
@@ -120,6 +137,11 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             bool unremove);
     void addTracksFinish(bool rollback = false);
 
+    // Tracks that are saved in between are updated within a single
+    // transaction instead of one transaction per track.
+    void saveTracksPrepare();
+    void saveTracksFinish(bool rollback = false);
+
     bool updateTrack(Track* pTrack) const;
 
     void hideAllTracks(const QDir& rootDir) const;
@@ -171,7 +193,22 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     std::unique_ptr<QSqlQuery> m_pQueryLibraryInsert;
     std::unique_ptr<QSqlQuery> m_pQueryLibraryUpdate;
     std::unique_ptr<QSqlQuery> m_pQueryLibrarySelect;
+    // Adding or saving multiple tracks is done in batches within a
+    // single transaction. Batches might be nested, e.g. when evicted
+    // tracks are saved while adding tracks. Each batch owns a savepoint
+    // and is released or rolled back independently. The transaction is
+    // committed after the outermost batch has finished.
+    struct Batch {
+        std::unique_ptr<SqlSavepoint> pSavepoint;
+        // The modifications of a nested batch that has been released
+        // must not be discarded by rolling back the enclosing batch
+        bool nestedBatchReleased = false;
+    };
+    void beginBatch(Batch* pBatch, const QString& name);
+    void finishBatch(Batch* pBatch, bool rollback);
     std::unique_ptr<SqlTransaction> m_pTransaction;
+    Batch m_addTracksBatch;
+    Batch m_saveTracksBatch;
     int m_trackLocationIdColumn;
     int m_queryLibraryIdColumn;
     int m_queryLibraryMixxxDeletedColumn;
@@ -0,0 +1,250 @@
+#include "library/externallibraryimport.h"
+
+#include <QDateTime>
+
+#include "library/dao/settingsdao.h"
+#include "library/queryutil.h"
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("ExternalLibraryImport");
+
+// Number of inserted, updated or deleted rows per transaction
+const int kTransactionBatchSize = 1000;
+
+const QString kIdColumn = QStringLiteral("id");
+
+QString placeholders(int count) {
+    QStringList placeholders;
+    for (int i = 0; i < count; ++i) {
+        placeholders << QStringLiteral("?");
+    }
+    return placeholders.join(QStringLiteral(","));
+}
+
+} // anonymous namespace
+
+ExternalLibraryFileStamp::ExternalLibraryFileStamp(
+        const QList<QFileInfo>& fileInfos) {
+    QStringList parts;
+    for (QFileInfo fileInfo : fileInfos) {
+        // Don't use cached file info that might have been
+        // obtained before the file has been modified.
+        fileInfo.refresh();
+        if (!fileInfo.exists()) {
+            return;
+        }
+        parts << QString("%1|%2|%3").arg(
+                fileInfo.absoluteFilePath(),
+                QString::number(fileInfo.lastModified().toMSecsSinceEpoch()),
+                QString::number(fileInfo.size()));
+    }
+    m_value = parts.join(QChar(';'));
+}
+
+bool ExternalLibraryFileStamp::isStored(
+        const QSqlDatabase& database, const QString& settingsKey) const {
+    if (!isValid()) {
+        return false;
+    }
+    SettingsDAO settings(database);
+    return settings.getValue(settingsKey) == m_value;
+}
+
+bool ExternalLibraryFileStamp::store(
+        const QSqlDatabase& database, const QString& settingsKey) const {
+    VERIFY_OR_DEBUG_ASSERT(isValid()) {
+        return false;
+    }
+    SettingsDAO settings(database);
+    return settings.setValue(settingsKey, m_value);
+}
+
+// static
+void ExternalLibraryFileStamp::clear(
+        const QSqlDatabase& database, const QString& settingsKey) {
+    SettingsDAO settings(database);
+    settings.setValue(settingsKey, QString());
+}
+
+ExternalTrackTableUpdater::ExternalTrackTableUpdater(
+        const QSqlDatabase& database,
+        ScopedTransaction* pTransaction,
+        const QString& tableName,
+        const QString& keyColumn,
+        const QStringList& valueColumns)
+        : m_database(database),
+          m_pTransaction(pTransaction),
+          m_tableName(tableName),
+          m_keyColumn(keyColumn),
+          m_valueColumns(valueColumns),
+          m_insertQuery(database),
+          m_updateQuery(database),
+          m_pendingWrites(0),
+          m_insertedCount(0),
+          m_updatedCount(0),
+          m_unchangedCount(0),
+          m_removedCount(0) {
+}
+
+bool ExternalTrackTableUpdater::keyIsId() const {
+    return m_keyColumn == kIdColumn;
+}
+
+bool ExternalTrackTableUpdater::prepare() {
+    m_rows.clear();
+
+    QStringList selectColumns;
+    selectColumns << kIdColumn;
+    if (!keyIsId()) {
+        selectColumns << m_keyColumn;
+    }
+    const int firstValueColumn = selectColumns.size();
+    selectColumns << m_valueColumns;
+
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    if (!query.exec(QString("SELECT %1 FROM %2").arg(
+                selectColumns.join(QChar(',')), m_tableName))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    while (query.next()) {
+        Row row;
+        row.id = query.value(0).toInt();
+        row.visited = false;
+        row.values.reserve(m_valueColumns.size());
+        for (int i = 0; i < m_valueColumns.size(); ++i) {
+            row.values.append(query.value(firstValueColumn + i));
+        }
+        m_rows.insert(query.value(keyIsId() ? 0 : 1).toString(), row);
+    }
+
+    QStringList insertColumns;
+    insertColumns << m_keyColumn << m_valueColumns;
+    if (!m_insertQuery.prepare(QString("INSERT INTO %1 (%2) VALUES (%3)").arg(
+                m_tableName,
+                insertColumns.join(QChar(',')),
+                placeholders(insertColumns.size())))) {
+        LOG_FAILED_QUERY(m_insertQuery);
+        return false;
+    }
+
+    QStringList assignments;
+    for (const auto& column : m_valueColumns) {
+        assignments << column + QStringLiteral("=?");
+    }
+    if (!m_updateQuery.prepare(QString("UPDATE %1 SET %2 WHERE %3=?").arg(
+                m_tableName,
+                assignments.join(QChar(',')),
+                kIdColumn))) {
+        LOG_FAILED_QUERY(m_updateQuery);
+        return false;
+    }
+
+    kLogger.debug()
+            << "Found"
+            << m_rows.size()
+            << "rows in"
+            << m_tableName;
+    return true;
+}
+
+int ExternalTrackTableUpdater::upsert(
+        const QVariant& key, const QVariantList& values) {
+    DEBUG_ASSERT(values.size() == m_valueColumns.size());
+    const QString keyString = key.toString();
+    auto it = m_rows.find(keyString);
+    if (it != m_rows.end()) {
+        it->visited = true;
+        if (it->values == values) {
+            ++m_unchangedCount;
+            return it->id;
+        }
+        for (int i = 0; i < values.size(); ++i) {
+            m_updateQuery.bindValue(i, values.at(i));
+        }
+        m_updateQuery.bindValue(values.size(), it->id);
+        if (!m_updateQuery.exec()) {
+            LOG_FAILED_QUERY(m_updateQuery) << "key:" << keyString;
+            return -1;
+        }
+        it->values = values;
+        ++m_updatedCount;
+        commitBatchIfNeeded();
+        return it->id;
+    }
+
+    m_insertQuery.bindValue(0, key);
+    for (int i = 0; i < values.size(); ++i) {
+        m_insertQuery.bindValue(i + 1, values.at(i));
+    }
+    if (!m_insertQuery.exec()) {
+        LOG_FAILED_QUERY(m_insertQuery) << "key:" << keyString;
+        return -1;
+    }
+    Row row;
+    row.id = keyIsId() ? key.toInt() : m_insertQuery.lastInsertId().toInt();
+    row.visited = true;
+    row.values = values;
+    m_rows.insert(keyString, row);
+    ++m_insertedCount;
+    commitBatchIfNeeded();
+    return row.id;
+}
+
+bool ExternalTrackTableUpdater::removeUnvisited() {
+    QSqlQuery query(m_database);
+    if (!query.prepare(QString("DELETE FROM %1 WHERE %2=:id").arg(
+                m_tableName, kIdColumn))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    bool success = true;
+    auto it = m_rows.begin();
+    while (it != m_rows.end()) {
+        if (it->visited) {
+            ++it;
+            continue;
+        }
+        query.bindValue(":id", it->id);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+            success = false;
+            ++it;
+            continue;
+        }
+        it = m_rows.erase(it);
+        ++m_removedCount;
+        commitBatchIfNeeded();
+    }
+    kLogger.info()
+            << m_tableName
+            << "inserted:" << m_insertedCount
+            << "updated:" << m_updatedCount
+            << "unchanged:" << m_unchangedCount
+            << "removed:" << m_removedCount;
+    return success;
+}
+
+int ExternalTrackTableUpdater::lookupId(const QVariant& key) const {
+    const auto it = m_rows.constFind(key.toString());
+    if (it == m_rows.constEnd()) {
+        return -1;
+    }
+    return it->id;
+}
+
+void ExternalTrackTableUpdater::commitBatchIfNeeded() {
+    if (!m_pTransaction) {
+        return;
+    }
+    if (++m_pendingWrites < kTransactionBatchSize) {
+        return;
+    }
+    m_pendingWrites = 0;
+    m_pTransaction->commit();
+    m_pTransaction->transaction();
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QFileInfo>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+class ScopedTransaction;
+
+// Identifies the state of the files an external library has been
+// imported from. The stamp is stored in the library settings table
+// after a successful import and compared before the next import to
+// detect if re-parsing the files is needed at all.
+class ExternalLibraryFileStamp final {
+  public:
+    explicit ExternalLibraryFileStamp(const QList<QFileInfo>& fileInfos);
+
+    bool isValid() const {
+        return !m_value.isEmpty();
+    }
+
+    // Returns true if the stamp matches the one stored under the
+    // given settings key.
+    bool isStored(const QSqlDatabase& database, const QString& settingsKey) const;
+    bool store(const QSqlDatabase& database, const QString& settingsKey) const;
+
+    static void clear(const QSqlDatabase& database, const QString& settingsKey);
+
+  private:
+    QString m_value;
+};
+
+// Applies the tracks parsed from an external library to one of the
+// external library tables. Instead of clearing the table and inserting
+// all tracks again only new or modified rows are written and rows that
+// are not visited again are deleted afterwards. Each row is identified
+// by a persistent key, i.e. either the id from the external library or
+// the unique track location.
+//
+// If a transaction is provided writes are committed in batches to avoid
+// holding the write lock of the database during the whole import. Without
+// a transaction the caller is responsible for committing all writes at
+// once, e.g. to roll them back if the import turns out to be incomplete.
+class ExternalTrackTableUpdater final {
+  public:
+    ExternalTrackTableUpdater(
+            const QSqlDatabase& database,
+            ScopedTransaction* pTransaction,
+            const QString& tableName,
+            const QString& keyColumn,
+            const QStringList& valueColumns);
+
+    // Loads the key, id and values of all rows that are currently
+    // stored in the table. Must be called before the first upsert().
+    bool prepare();
+
+    // Inserts a new row or updates an existing row if any of the
+    // values (ordered like valueColumns) have changed. Returns the
+    // id of the row or -1 on failure.
+    int upsert(const QVariant& key, const QVariantList& values);
+
+    // Deletes all rows that have not been visited by upsert().
+    bool removeUnvisited();
+
+    // Returns the id of the row with the given key or -1 if no
+    // such row exists.
+    int lookupId(const QVariant& key) const;
+
+    int insertedCount() const {
+        return m_insertedCount;
+    }
+    int updatedCount() const {
+        return m_updatedCount;
+    }
+    int unchangedCount() const {
+        return m_unchangedCount;
+    }
+    int removedCount() const {
+        return m_removedCount;
+    }
+
+  private:
+    struct Row {
+        int id;
+        bool visited;
+        QVariantList values;
+    };
+
+    bool keyIsId() const;
+    void commitBatchIfNeeded();
+
+    const QSqlDatabase m_database;
+    ScopedTransaction* const m_pTransaction;
+    const QString m_tableName;
+    const QString m_keyColumn;
+    const QStringList m_valueColumns;
+
+    QHash<QString, Row> m_rows;
+    QSqlQuery m_insertQuery;
+    QSqlQuery m_updateQuery;
+
+    int m_pendingWrites;
+    int m_insertedCount;
+    int m_updatedCount;
+    int m_unchangedCount;
+    int m_removedCount;
+};
@@ -12,6 +12,7 @@
 
 #include "library/basetrackcache.h"
 #include "library/dao/settingsdao.h"
+#include "library/externallibraryimport.h"
 #include "library/baseexternaltrackmodel.h"
 #include "library/baseexternalplaylistmodel.h"
 #include "library/queryutil.h"
@@ -30,6 +31,7 @@
 namespace {
 
 const QString ITDB_PATH_KEY = "mixxx.itunesfeature.itdbpath";
+const QString ITDB_IMPORT_STAMP_KEY = "mixxx.itunesfeature.itdbimportstamp";
 
 const QString kDict = "dict";
 const QString kKey = "key";
@@ -163,14 +165,6 @@ void ITunesFeature::activate() {
 void ITunesFeature::activate(bool forceReload) {
     //qDebug("ITunesFeature::activate()");
     if (!m_isActivated || forceReload) {
-
-        //Delete all table entries of iTunes feature
-        ScopedTransaction transaction(m_database);
-        clearTable("itunes_playlist_tracks");
-        clearTable("itunes_library");
-        clearTable("itunes_playlists");
-        transaction.commit();
-
         emit showTrackModel(m_pITunesTrackModel);
 
         SettingsDAO settings(m_pTrackCollection->database());
@@ -209,7 +203,7 @@ void ITunesFeature::activate(bool forceReload) {
         }
         m_isActivated =  true;
         // Let a worker thread do the XML parsing
-        m_future = QtConcurrent::run(this, &ITunesFeature::importLibrary);
+        m_future = QtConcurrent::run(this, &ITunesFeature::importLibrary, forceReload);
         m_future_watcher.setFuture(m_future);
         m_title = tr("(loading) iTunes");
         // calls a slot in the sidebar model such that 'iTunes (isLoading)' is displayed.
@@ -244,7 +238,7 @@ void ITunesFeature::onRightClick(const QPoint& globalPos) {
     if (chosen == &useDefault) {
         SettingsDAO settings(m_database);
         settings.setValue(ITDB_PATH_KEY, QString());
-        activate(true); // clears tables before parsing
+        activate(true); // re-imports even if the file is unchanged
     } else if (chosen == &chooseNew) {
         SettingsDAO settings(m_database);
         QString dbfile = QFileDialog::getOpenFileName(
@@ -262,7 +256,7 @@ void ITunesFeature::onRightClick(const QPoint& globalPos) {
         Sandbox::createSecurityToken(dbFileInfo);
 
         settings.setValue(ITDB_PATH_KEY, dbfile);
-        activate(true); // clears tables before parsing
+        activate(true); // re-imports even if the file is unchanged
     }
 }
 
@@ -365,7 +359,7 @@ void ITunesFeature::guessMusicLibraryMountpoint(QXmlStreamReader& xml) {
 
 // This method is executed in a separate thread
 // via QtConcurrent::run
-TreeItem* ITunesFeature::importLibrary() {
+TreeItem* ITunesFeature::importLibrary(bool forceReimport) {
     bool isTracksParsed=false;
     bool isMusicFolderLocatedAfterTracks=false;
 
@@ -375,7 +369,44 @@ TreeItem* ITunesFeature::importLibrary() {
 
     qDebug() << "ITunesFeature::importLibrary() ";
 
+    // The tables still contain the result of the last import. Skip
+    // parsing if the file has not been modified since then.
+    const ExternalLibraryFileStamp fileStamp({QFileInfo(m_dbfile)});
+    if (!forceReimport && fileStamp.isStored(m_database, ITDB_IMPORT_STAMP_KEY)) {
+        qDebug() << "iTunes music collection is unchanged since the last import";
+        return loadPlaylists();
+    }
+    // Invalidate the stored stamp until the import has finished
+    ExternalLibraryFileStamp::clear(m_database, ITDB_IMPORT_STAMP_KEY);
+
     ScopedTransaction transaction(m_database);
+    // Tracks are updated in place, but playlists are always rebuilt
+    clearTable("itunes_playlist_tracks");
+    clearTable("itunes_playlists");
+
+    ExternalTrackTableUpdater trackUpdater(
+            m_database,
+            &transaction,
+            "itunes_library",
+            "id",
+            QStringList{
+                    "artist",
+                    "title",
+                    "album",
+                    "album_artist",
+                    "year",
+                    "genre",
+                    "grouping",
+                    "comment",
+                    "tracknumber",
+                    "bpm",
+                    "bitrate",
+                    "duration",
+                    "location",
+                    "rating"});
+    if (!trackUpdater.prepare()) {
+        return nullptr;
+    }
 
     // By default set m_mixxxItunesRoot and m_dbItunesRoot to strip out
     // file://localhost/ from the URL. When we load the user's iTunes XML
@@ -405,7 +436,7 @@ TreeItem* ITunesFeature::importLibrary() {
                         guessMusicLibraryMountpoint(xml);
                     }
                 } else if (key == "Tracks") {
-                    parseTracks(xml);
+                    parseTracks(xml, &trackUpdater);
                     if (playlist_root != NULL)
                         delete playlist_root;
                     playlist_root = parsePlaylists(xml);
@@ -431,10 +462,21 @@ TreeItem* ITunesFeature::importLibrary() {
         }
     }
 
+    // Tracks that have not been found in a completely parsed file
+    // have been removed from the iTunes library.
+    const bool isComplete = isTracksParsed && !xml.hasError() && !m_cancelImport;
+    if (isComplete) {
+        trackUpdater.removeUnvisited();
+    }
+
     // Even if an error occurred, commit the transaction. The file may have been
     // half-parsed.
     transaction.commit();
 
+    if (isComplete && playlist_root) {
+        fileStamp.store(m_database, ITDB_IMPORT_STAMP_KEY);
+    }
+
     if (xml.hasError()) {
         // do error handling
         qDebug() << "Abort processing iTunes music collection";
@@ -449,17 +491,24 @@ TreeItem* ITunesFeature::importLibrary() {
     return playlist_root;
 }
 
-void ITunesFeature::parseTracks(QXmlStreamReader& xml) {
+TreeItem* ITunesFeature::loadPlaylists() {
+    std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT name FROM itunes_playlists ORDER BY id")) {
+        LOG_FAILED_QUERY(query);
+        return nullptr;
+    }
+    while (query.next()) {
+        pRootItem->appendChild(query.value(0).toString());
+    }
+    return pRootItem.release();
+}
+
+void ITunesFeature::parseTracks(QXmlStreamReader& xml,
+        ExternalTrackTableUpdater* pTrackUpdater) {
     bool in_container_dictionary = false;
     bool in_track_dictionary = false;
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO itunes_library (id, artist, title, album, album_artist, year, genre, grouping, comment, tracknumber,"
-                  "bpm, bitrate,"
-                  "duration, location,"
-                  "rating ) "
-                  "VALUES (:id, :artist, :title, :album, :album_artist, :year, :genre, :grouping, :comment, :tracknumber,"
-                  ":bpm, :bitrate,"
-                  ":duration, :location," ":rating )");
 
     qDebug() << "Parse iTunes music collection";
 
@@ -476,7 +525,7 @@ void ITunesFeature::parseTracks(QXmlStreamReader& xml) {
                     // We are in a <dict> tag that holds track information
                     in_track_dictionary = true;
                     // Parse track here
-                    parseTrack(xml, query);
+                    parseTrack(xml, pTrackUpdater);
                 }
             }
         }
@@ -494,7 +543,8 @@ void ITunesFeature::parseTracks(QXmlStreamReader& xml) {
     }
 }
 
-void ITunesFeature::parseTrack(QXmlStreamReader& xml, QSqlQuery& query) {
+void ITunesFeature::parseTrack(QXmlStreamReader& xml,
+        ExternalTrackTableUpdater* pTrackUpdater) {
     //qDebug() << "----------------TRACK-----------------";
     int id = -1;
     QString title;
@@ -616,29 +666,23 @@ void ITunesFeature::parseTrack(QXmlStreamReader& xml, QSqlQuery& query) {
     }
 
     // If we reach the end of <dict>
-    // Save parsed track to database
-    query.bindValue(":id", id);
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":album_artist", album_artist);
-    query.bindValue(":genre", genre);
-    query.bindValue(":grouping", grouping);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-
-    if (!success) {
-        LOG_FAILED_QUERY(query);
-        return;
-    }
+    // Save parsed track to database unless it is unchanged
+    pTrackUpdater->upsert(id,
+            QVariantList{
+                    artist,
+                    title,
+                    album,
+                    album_artist,
+                    year,
+                    genre,
+                    grouping,
+                    comment,
+                    tracknumber,
+                    bpm,
+                    bitrate,
+                    playtime,
+                    location,
+                    rating});
 }
 
 TreeItem* ITunesFeature::parsePlaylists(QXmlStreamReader& xml) {
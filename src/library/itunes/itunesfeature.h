@@ -18,6 +18,7 @@
 
 class BaseExternalTrackModel;
 class BaseExternalPlaylistModel;
+class ExternalTrackTableUpdater;
 class WLibrarySidebar;
 
 class ITunesFeature : public BaseExternalLibraryFeature {
@@ -44,10 +45,12 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     BaseSqlTableModel* getPlaylistModelForPlaylist(QString playlist) override;
     static QString getiTunesMusicPath();
     // returns the invisible rootItem for the sidebar model
-    TreeItem* importLibrary();
+    TreeItem* importLibrary(bool forceReimport);
+    // returns the invisible rootItem for the playlists imported previously
+    TreeItem* loadPlaylists();
     void guessMusicLibraryMountpoint(QXmlStreamReader& xml);
-    void parseTracks(QXmlStreamReader& xml);
-    void parseTrack(QXmlStreamReader& xml, QSqlQuery& query);
+    void parseTracks(QXmlStreamReader& xml, ExternalTrackTableUpdater* pTrackUpdater);
+    void parseTrack(QXmlStreamReader& xml, ExternalTrackTableUpdater* pTrackUpdater);
     TreeItem* parsePlaylists(QXmlStreamReader &xml);
     void parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query1,
                        QSqlQuery &query2, TreeItem*);
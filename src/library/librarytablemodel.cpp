@@ -3,7 +3,6 @@
 #include "library/dao/trackschema.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
-#include "library/queryutil.h"
 
 #include "mixer/playermanager.h"
 
@@ -35,16 +34,12 @@ void LibraryTableModel::setTableModel(int id) {
 
     const QString tableName = "library_view";
 
-    QSqlQuery query(m_database);
     QString queryString = "CREATE TEMPORARY VIEW IF NOT EXISTS " + tableName + " AS "
             "SELECT " + columns.join(", ") +
             " FROM library INNER JOIN track_locations "
             "ON library.location = track_locations.id "
             "WHERE (" + kDefaultLibraryFilter + ")";
-    query.prepare(queryString);
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
+    createTemporaryView(queryString);
 
     QStringList tableColumns;
     tableColumns << LIBRARYTABLE_ID;
@@ -91,6 +86,10 @@ bool LibraryTableModel::isColumnInternal(int column) {
             column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH);
 }
 
+TrackPointerList LibraryTableModel::getTracks(const QModelIndexList& indices) const {
+    return getInternalTracks(indices);
+}
+
 TrackModel::CapabilitiesFlags LibraryTableModel::getCapabilities() const {
     return TRACKMODELCAPS_NONE
             | TRACKMODELCAPS_RECEIVEDROPS
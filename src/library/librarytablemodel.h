@@ -13,6 +13,7 @@ class LibraryTableModel : public BaseSqlTableModel {
     void setTableModel(int id =-1);
 
     bool isColumnInternal(int column) final;
+    TrackPointerList getTracks(const QModelIndexList& indices) const final;
     // Takes a list of locations and add the tracks to the library. Returns the
     // number of successful additions.
     int addTracks(const QModelIndex& index, const QList<QString>& locations) final;
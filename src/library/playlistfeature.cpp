@@ -138,19 +138,19 @@ QList<BasePlaylistFeature::IdAndLabel> PlaylistFeature::createPlaylistLabels() {
     QSqlDatabase database = m_pLibrary->trackCollections()->internalCollection()->database();
 
     QList<BasePlaylistFeature::IdAndLabel> playlistLabels;
+    // The counts and durations are maintained by database triggers,
+    // see playlist_summaries in schema.xml
     QString queryString = QString(
             "CREATE TEMPORARY VIEW IF NOT EXISTS PlaylistsCountsDurations "
             "AS SELECT "
             "  Playlists.id AS id, "
             "  Playlists.name AS name, "
             "  LOWER(Playlists.name) AS sort_name, "
-            "  COUNT(case library.mixxx_deleted when 0 then 1 else null end) AS count, "
-            "  SUM(case library.mixxx_deleted when 0 then library.duration else 0 end) AS durationSeconds "
+            "  IFNULL(playlist_summaries.track_count, 0) AS count, "
+            "  IFNULL(ROUND(playlist_summaries.track_duration, 3), 0) AS durationSeconds "
             "FROM Playlists "
-            "LEFT JOIN PlaylistTracks ON PlaylistTracks.playlist_id = Playlists.id "
-            "LEFT JOIN library ON PlaylistTracks.track_id = library.id "
-            "WHERE Playlists.hidden = 0 "
-            "GROUP BY Playlists.id");
+            "LEFT JOIN playlist_summaries ON playlist_summaries.playlist_id = Playlists.id "
+            "WHERE Playlists.hidden = 0");
     queryString.append(mixxx::DbConnection::collateLexicographically(
             " ORDER BY sort_name"));
     QSqlQuery query(database);
@@ -1,5 +1,7 @@
 #include "library/playlisttablemodel.h"
 
+#include <algorithm>
+
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
@@ -99,6 +101,7 @@ void PlaylistTableModel::setTableModel(int playlistId) {
     // columns[2] = PLAYLISTTRACKSTABLE_DATETIMEADDED from above
     columns[3] = LIBRARYTABLE_PREVIEW;
     columns[4] = LIBRARYTABLE_COVERART;
+    updateTrackPositions();
     setTable(playlistTableName, LIBRARYTABLE_ID, columns,
             m_pTrackCollectionManager->internalCollection()->getTrackSource());
     setSearch("");
@@ -120,12 +123,11 @@ int PlaylistTableModel::addTracks(const QModelIndex& index,
     QList<TrackId> trackIds = m_pTrackCollectionManager->internalCollection()->resolveTrackIdsFromLocations(
             locations);
 
-    const int positionColumn = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
-    int position = index.sibling(index.row(), positionColumn).data().toInt();
+    int position = trackPosition(index);
 
     // Handle weird cases like a drag and drop to an invalid index
     if (position <= 0) {
-        position = rowCount() + 1;
+        position = m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().getMaxPosition(m_iPlaylistId) + 1;
     }
 
     int tracksAdded = m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().insertTracksIntoPlaylist(
@@ -151,8 +153,7 @@ void PlaylistTableModel::removeTrack(const QModelIndex& index) {
         return;
     }
 
-    const int positionColumnIndex = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
-    int position = index.sibling(index.row(), positionColumnIndex).data().toInt();
+    int position = trackPosition(index);
     m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().removeTrackFromPlaylist(m_iPlaylistId, position);
 }
 
@@ -161,12 +162,9 @@ void PlaylistTableModel::removeTracks(const QModelIndexList& indices) {
         return;
     }
 
-    const int positionColumnIndex = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
-
     QList<int> trackPositions;
     foreach (QModelIndex index, indices) {
-        int trackPosition = index.sibling(index.row(), positionColumnIndex).data().toInt();
-        trackPositions.append(trackPosition);
+        trackPositions.append(trackPosition(index));
     }
 
     m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().removeTracksFromPlaylist(
@@ -176,28 +174,23 @@ void PlaylistTableModel::removeTracks(const QModelIndexList& indices) {
 
 void PlaylistTableModel::moveTrack(const QModelIndex& sourceIndex,
                                    const QModelIndex& destIndex) {
+    moveTracks(QModelIndexList{sourceIndex}, destIndex);
+}
 
-    int playlistPositionColumn = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
-
-    int newPosition = destIndex.sibling(destIndex.row(), playlistPositionColumn).data().toInt();
-    int oldPosition = sourceIndex.sibling(sourceIndex.row(), playlistPositionColumn).data().toInt();
-
-    if (newPosition > oldPosition) {
-        // new position moves up due to closing the gap of the old position
-        --newPosition;
+void PlaylistTableModel::moveTracks(const QModelIndexList& sourceIndices,
+                                    const QModelIndex& destIndex) {
+    QList<int> positions;
+    for (const QModelIndex& index : sourceIndices) {
+        positions.append(trackPosition(index));
     }
-
-    //qDebug() << "old pos" << oldPosition << "new pos" << newPosition;
-    if (newPosition < 0 || newPosition == oldPosition) {
-        // Invalid for the position to be 0 or less.
-        // or no move at all
-        return;
-    } else if (newPosition == 0) {
-        // Dragged out of bounds, which is past the end of the rows...
-        newPosition = m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().getMaxPosition(m_iPlaylistId);
+    // An invalid position moves the tracks to the end
+    int destPosition = 0;
+    if (destIndex.isValid()) {
+        destPosition = trackPosition(destIndex);
     }
 
-    m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().moveTrack(m_iPlaylistId, oldPosition, newPosition);
+    m_pTrackCollectionManager->internalCollection()->getPlaylistDAO().moveTracks(
+            m_iPlaylistId, std::move(positions), destPosition);
 }
 
 bool PlaylistTableModel::isLocked() {
@@ -207,17 +200,16 @@ bool PlaylistTableModel::isLocked() {
 void PlaylistTableModel::shuffleTracks(const QModelIndexList& shuffle, const QModelIndex& exclude) {
     QList<int> positions;
     QHash<int,TrackId> allIds;
-    const int positionColumn = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
     const int idColumn = fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ID);
     int excludePos = -1;
     if (exclude.row() > -1) {
         // this is used to exclude the already loaded track at pos #1 if used from running Auto-DJ
-        excludePos = exclude.sibling(exclude.row(), positionColumn).data().toInt();
+        excludePos = trackPosition(exclude);
     }
     if (shuffle.count() > 1) {
         // if there is more then one track selected, shuffle selection only
         foreach(QModelIndex shuffleIndex, shuffle) {
-            int oldPosition = shuffleIndex.sibling(shuffleIndex.row(), positionColumn).data().toInt();
+            int oldPosition = trackPosition(shuffleIndex);
             if (oldPosition != excludePos) {
                 positions.append(oldPosition);
             }
@@ -226,7 +218,7 @@ void PlaylistTableModel::shuffleTracks(const QModelIndexList& shuffle, const QMo
         // if there is only one track selected, shuffle all tracks
         int numOfTracks = rowCount();
         for (int i = 0; i < numOfTracks; i++) {
-            int oldPosition = index(i, positionColumn).data().toInt();
+            int oldPosition = trackPosition(index(i, 0));
             if (oldPosition != excludePos) {
                 positions.append(oldPosition);
             }
@@ -235,7 +227,7 @@ void PlaylistTableModel::shuffleTracks(const QModelIndexList& shuffle, const QMo
     // Set up list of all IDs
     int numOfTracks = rowCount();
     for (int i = 0; i < numOfTracks; i++) {
-        int position = index(i, positionColumn).data().toInt();
+        int position = trackPosition(index(i, 0));
         TrackId trackId(index(i, idColumn).data());
         allIds.insert(position, trackId);
     }
@@ -288,6 +280,40 @@ TrackModel::CapabilitiesFlags PlaylistTableModel::getCapabilities() const {
 
 void PlaylistTableModel::playlistsChanged(QSet<int> playlistIds) {
     if (playlistIds.contains(m_iPlaylistId)) {
+        updateTrackPositions();
         select(); // Repopulate the data model.
     }
 }
+
+int PlaylistTableModel::trackPosition(const QModelIndex& index) const {
+    // The edit role provides the stored position instead of the number
+    // of the track that is displayed
+    return index.sibling(
+                        index.row(),
+                        fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION))
+            .data(Qt::EditRole)
+            .toInt();
+}
+
+void PlaylistTableModel::updateTrackPositions() {
+    m_trackPositions = m_pTrackCollectionManager->internalCollection()
+                               ->getPlaylistDAO()
+                               .getTrackPositions(m_iPlaylistId);
+}
+
+QVariant PlaylistTableModel::roleValue(
+        const QModelIndex& index,
+        QVariant&& rawValue,
+        int role) const {
+    if ((role == Qt::DisplayRole || role == Qt::ToolTipRole) &&
+            index.column() == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)) {
+        // The positions are sparse, display the number of the track
+        // in the whole playlist, independent of the current search.
+        const auto it = std::lower_bound(
+                m_trackPositions.constBegin(),
+                m_trackPositions.constEnd(),
+                rawValue.toInt());
+        return static_cast<int>(it - m_trackPositions.constBegin()) + 1;
+    }
+    return TrackSetTableModel::roleValue(index, std::move(rawValue), role);
+}
@@ -17,6 +17,7 @@ class PlaylistTableModel : public TrackSetTableModel {
 
     bool appendTrack(TrackId trackId);
     void moveTrack(const QModelIndex& sourceIndex, const QModelIndex& destIndex) override;
+    void moveTracks(const QModelIndexList& sourceIndices, const QModelIndex& destIndex) override;
     void removeTrack(const QModelIndex& index);
     void shuffleTracks(const QModelIndexList& shuffle, const QModelIndex& exclude);
 
@@ -30,12 +31,24 @@ class PlaylistTableModel : public TrackSetTableModel {
 
     CapabilitiesFlags getCapabilities() const final;
 
+  protected:
+    QVariant roleValue(
+            const QModelIndex& index,
+            QVariant&& rawValue,
+            int role) const override;
+
   private slots:
     void playlistsChanged(QSet<int> playlistIds);
 
   private:
     void initSortColumnMapping() override;
 
+    // The stored position of the track, which is passed to the PlaylistDAO
+    int trackPosition(const QModelIndex& index) const;
+    void updateTrackPositions();
+
     int m_iPlaylistId;
     bool m_keepDeletedTracks;
+    // The positions of all tracks in the playlist in ascending order
+    QVector<int> m_trackPositions;
 };
@@ -51,6 +51,18 @@ TrackPointer ProxyTrackModel::getTrackByRef(const TrackRef& trackRef) const {
     return m_pTrackModel ? m_pTrackModel->getTrackByRef(trackRef) : TrackPointer();
 }
 
+TrackPointerList ProxyTrackModel::getTracks(const QModelIndexList& indices) const {
+    if (!m_pTrackModel) {
+        return TrackPointerList();
+    }
+    QModelIndexList indicesSource;
+    indicesSource.reserve(indices.size());
+    for (const auto& index : indices) {
+        indicesSource.append(mapToSource(index));
+    }
+    return m_pTrackModel->getTracks(indicesSource);
+}
+
 QString ProxyTrackModel::getTrackLocation(const QModelIndex& index) const {
     QModelIndex indexSource = mapToSource(index);
     return m_pTrackModel ? m_pTrackModel->getTrackLocation(indexSource) : QString();
@@ -101,6 +113,17 @@ void ProxyTrackModel::moveTrack(const QModelIndex& sourceIndex,
     }
 }
 
+void ProxyTrackModel::moveTracks(const QModelIndexList& sourceIndices,
+                                 const QModelIndex& destIndex) {
+    QModelIndexList translatedList;
+    for (const QModelIndex& index : sourceIndices) {
+        translatedList.append(mapToSource(index));
+    }
+    if (m_pTrackModel) {
+        m_pTrackModel->moveTracks(translatedList, mapToSource(destIndex));
+    }
+}
+
 QAbstractItemDelegate* ProxyTrackModel::delegateForColumn(const int i, QObject* pParent) {
     return m_pTrackModel ? m_pTrackModel->delegateForColumn(i, pParent) : NULL;
 }
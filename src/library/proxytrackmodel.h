@@ -26,6 +26,7 @@ class ProxyTrackModel : public QSortFilterProxyModel, public TrackModel {
     CapabilitiesFlags getCapabilities() const final;
     TrackPointer getTrack(const QModelIndex& index) const final;
     TrackPointer getTrackByRef(const TrackRef& trackRef) const final;
+    TrackPointerList getTracks(const QModelIndexList& indices) const final;
     QString getTrackLocation(const QModelIndex& index) const final;
     TrackId getTrackId(const QModelIndex& index) const final;
     const QLinkedList<int> getTrackRows(TrackId trackId) const final;
@@ -35,6 +36,7 @@ class ProxyTrackModel : public QSortFilterProxyModel, public TrackModel {
     bool isColumnHiddenByDefault(int column) final;
     void removeTracks(const QModelIndexList& indices) final;
     void moveTrack(const QModelIndex& sourceIndex, const QModelIndex& destIndex) final;
+    void moveTracks(const QModelIndexList& sourceIndices, const QModelIndex& destIndex) final;
     QAbstractItemDelegate* delegateForColumn(const int i, QObject* pParent) final;
     QString getModelSetting(QString name) final;
     bool setModelSetting(QString name, QVariant value) final;
@@ -1,11 +1,15 @@
 // rekordboxfeature.cpp
 // Created 05/24/2019 by Evan Dekker
 
+#include <QDataStream>
 #include <QMap>
 #include <QMessageBox>
 #include <QSettings>
 #include <QStandardPaths>
+#include <QtConcurrent>
 #include <QtDebug>
+#include <algorithm>
+#include <exception>
 
 #include "library/rekordbox/rekordbox_anlz.h"
 #include "library/rekordbox/rekordbox_pdb.h"
@@ -44,6 +48,8 @@ const QString kRekordboxLibraryTable = QStringLiteral("rekordbox_library");
 const QString kRekordboxPlaylistsTable = QStringLiteral("rekordbox_playlists");
 const QString kRekordboxPlaylistTracksTable = QStringLiteral("rekordbox_playlist_tracks");
 
+const QString kRekordboxAnalyzeCacheColumn = QStringLiteral("analyze_cache");
+
 const QString kPdbPath = QStringLiteral("PIONEER/rekordbox/export.pdb");
 const QString kPLaylistPathDelimiter = QStringLiteral("-->");
 
@@ -68,6 +74,12 @@ constexpr mixxx::RgbColor kColorForIDBlue(0x0150F8);
 constexpr mixxx::RgbColor kColorForIDPurple(0x9808F8);
 constexpr mixxx::RgbColor kColorForIDNoColor(0x0);
 
+// Tracks are inserted in batches with one transaction per batch
+const int kTrackInsertBatchSize = 1000;
+
+// Version of the serialized anlz_data_t in the analyze_cache column
+const qint32 kAnalyzeCacheVersion = 1;
+
 struct memory_cue_loop_t {
     double startPosition;
     double endPosition;
@@ -75,6 +87,82 @@ struct memory_cue_loop_t {
     mixxx::RgbColor::optional_t color;
 };
 
+enum class AnlzCueType : qint32 {
+    MemoryCue = 0,
+    Loop,
+    HotCue,
+};
+
+// A cue as read from an ANLZ file. All times are in milliseconds as
+// stored in the file, i.e. independent of the sample rate and the
+// decoder-specific timing offset that are applied when loading the
+// track.
+struct anlz_cue_t {
+    AnlzCueType type;
+    int hotCueIndex;
+    int time;
+    int loopTime;
+    QString comment;
+    mixxx::RgbColor::optional_t color;
+};
+
+// Everything that is needed from the ANLZ files of a track. It is
+// parsed once while importing a device and cached in the library
+// table, such that loading a track doesn't need to access the
+// ANLZ files on the device again.
+struct anlz_data_t {
+    QVector<int> beatTimes;
+    QList<anlz_cue_t> cues;
+};
+
+QDataStream& operator<<(QDataStream& out, const anlz_cue_t& cue) {
+    out << static_cast<qint32>(cue.type)
+        << static_cast<qint32>(cue.hotCueIndex)
+        << static_cast<qint32>(cue.time)
+        << static_cast<qint32>(cue.loopTime)
+        << cue.comment
+        << static_cast<bool>(cue.color)
+        << static_cast<quint32>(cue.color ? static_cast<QRgb>(*cue.color) : 0);
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, anlz_cue_t& cue) {
+    qint32 type;
+    qint32 hotCueIndex;
+    qint32 time;
+    qint32 loopTime;
+    bool hasColor;
+    quint32 color;
+    in >> type >> hotCueIndex >> time >> loopTime >> cue.comment >> hasColor >> color;
+    cue.type = static_cast<AnlzCueType>(type);
+    cue.hotCueIndex = hotCueIndex;
+    cue.time = time;
+    cue.loopTime = loopTime;
+    cue.color = hasColor ? mixxx::RgbColor::optional(color) : mixxx::RgbColor::nullopt();
+    return in;
+}
+
+QByteArray serializeAnlzData(const anlz_data_t& data) {
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out << kAnalyzeCacheVersion << data.beatTimes << data.cues;
+    return bytes;
+}
+
+bool deserializeAnlzData(const QByteArray& bytes, anlz_data_t* pData) {
+    if (bytes.isEmpty()) {
+        return false;
+    }
+    QDataStream in(bytes);
+    qint32 version;
+    in >> version;
+    if (version != kAnalyzeCacheVersion) {
+        return false;
+    }
+    in >> pData->beatTimes >> pData->cues;
+    return in.status() == QDataStream::Ok;
+}
+
 bool createLibraryTable(QSqlDatabase& database, const QString& tableName) {
     qDebug() << "Creating Rekordbox library table: " << tableName;
 
@@ -99,7 +187,8 @@ bool createLibraryTable(QSqlDatabase& database, const QString& tableName) {
             "    rating INTEGER,"
             "    analyze_path TEXT UNIQUE,"
             "    device TEXT,"
-            "    color INTEGER"
+            "    color INTEGER,"
+            "    analyze_cache BLOB"
             ");");
 
     if (!query.exec()) {
@@ -344,8 +433,139 @@ mixxx::RgbColor colorFromID(int colorID) {
     return kColorForIDNoColor;
 }
 
-void insertTrack(
-        QSqlDatabase& database,
+// Ensure no offset times are less than 1
+int applyTimingOffset(int time, int timingOffset) {
+    return std::max(time - timingOffset, 1);
+}
+
+void parseAnalyze(anlz_data_t* pData, bool ignoreCues, QString anlzPath) {
+    if (!QFile(anlzPath).exists()) {
+        return;
+    }
+
+    std::ifstream ifs(anlzPath.toStdString(), std::ifstream::binary);
+    kaitai::kstream ks(&ifs);
+
+    rekordbox_anlz_t anlz = rekordbox_anlz_t(&ks);
+
+    for (std::vector<rekordbox_anlz_t::tagged_section_t*>::iterator section = anlz.sections()->begin(); section != anlz.sections()->end(); ++section) {
+        switch ((*section)->fourcc()) {
+        case rekordbox_anlz_t::SECTION_TAGS_BEAT_GRID: {
+            if (!ignoreCues) {
+                break;
+            }
+
+            rekordbox_anlz_t::beat_grid_tag_t* beatGridTag = static_cast<rekordbox_anlz_t::beat_grid_tag_t*>((*section)->body());
+
+            pData->beatTimes.clear();
+            pData->beatTimes.reserve(static_cast<int>(beatGridTag->beats()->size()));
+            for (std::vector<rekordbox_anlz_t::beat_grid_beat_t*>::iterator beat = beatGridTag->beats()->begin(); beat != beatGridTag->beats()->end(); ++beat) {
+                pData->beatTimes << static_cast<int>((*beat)->time());
+            }
+        } break;
+        case rekordbox_anlz_t::SECTION_TAGS_CUES: {
+            if (ignoreCues) {
+                break;
+            }
+
+            rekordbox_anlz_t::cue_tag_t* cuesTag = static_cast<rekordbox_anlz_t::cue_tag_t*>((*section)->body());
+
+            for (std::vector<rekordbox_anlz_t::cue_entry_t*>::iterator cueEntry = cuesTag->cues()->begin(); cueEntry != cuesTag->cues()->end(); ++cueEntry) {
+                anlz_cue_t cue;
+                cue.hotCueIndex = -1;
+                cue.time = static_cast<int>((*cueEntry)->time());
+                cue.loopTime = 0;
+                cue.color = mixxx::RgbColor::nullopt();
+
+                switch (cuesTag->type()) {
+                case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
+                    switch ((*cueEntry)->type()) {
+                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
+                        cue.type = AnlzCueType::MemoryCue;
+                        pData->cues << cue;
+                    } break;
+                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
+                        cue.type = AnlzCueType::Loop;
+                        cue.loopTime = static_cast<int>((*cueEntry)->loop_time());
+                        pData->cues << cue;
+                    } break;
+                    }
+                } break;
+                case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
+                    cue.type = AnlzCueType::HotCue;
+                    cue.hotCueIndex = static_cast<int>((*cueEntry)->hot_cue() - 1);
+                    pData->cues << cue;
+                } break;
+                }
+            }
+        } break;
+        case rekordbox_anlz_t::SECTION_TAGS_CUES_2: {
+            if (ignoreCues) {
+                break;
+            }
+
+            rekordbox_anlz_t::cue_extended_tag_t* cuesExtendedTag = static_cast<rekordbox_anlz_t::cue_extended_tag_t*>((*section)->body());
+
+            for (std::vector<rekordbox_anlz_t::cue_extended_entry_t*>::iterator cueExtendedEntry = cuesExtendedTag->cues()->begin(); cueExtendedEntry != cuesExtendedTag->cues()->end(); ++cueExtendedEntry) {
+                anlz_cue_t cue;
+                cue.hotCueIndex = -1;
+                cue.time = static_cast<int>((*cueExtendedEntry)->time());
+                cue.loopTime = 0;
+                cue.comment = toUnicode((*cueExtendedEntry)->comment());
+
+                switch (cuesExtendedTag->type()) {
+                case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
+                    cue.color = colorFromID(static_cast<int>((*cueExtendedEntry)->color_id()));
+                    switch ((*cueExtendedEntry)->type()) {
+                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
+                        cue.type = AnlzCueType::MemoryCue;
+                        pData->cues << cue;
+                    } break;
+                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
+                        cue.type = AnlzCueType::Loop;
+                        cue.loopTime = static_cast<int>((*cueExtendedEntry)->loop_time());
+                        pData->cues << cue;
+                    } break;
+                    }
+                } break;
+                case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
+                    cue.type = AnlzCueType::HotCue;
+                    cue.hotCueIndex = static_cast<int>((*cueExtendedEntry)->hot_cue() - 1);
+                    cue.color = mixxx::RgbColor(qRgb(
+                            static_cast<int>(
+                                    (*cueExtendedEntry)->color_red()),
+                            static_cast<int>(
+                                    (*cueExtendedEntry)->color_green()),
+                            static_cast<int>((*cueExtendedEntry)
+                                                     ->color_blue())));
+                    pData->cues << cue;
+                } break;
+                }
+            }
+        } break;
+        default:
+            break;
+        }
+    }
+}
+
+// Parses all ANLZ files of a track. Might be invoked concurrently
+// for different tracks.
+anlz_data_t parseAnalyzeFiles(const QString& anlzPath) {
+    anlz_data_t data;
+    QString anlzPathExt = anlzPath.left(anlzPath.length() - 3) + "EXT";
+    if (QFile(anlzPathExt).exists()) {
+        // Beatgrids appear to be only correct in legacy ANLZ file
+        parseAnalyze(&data, true, anlzPath);
+        parseAnalyze(&data, false, anlzPathExt);
+    } else {
+        parseAnalyze(&data, false, anlzPath);
+    }
+    return data;
+}
+
+// Returns the id of the inserted track or -1 on failure
+int insertTrack(
         rekordbox_pdb_t::track_row_t* track,
         QSqlQuery& query,
         QSqlQuery& queryInsertIntoDevicePlaylistTracks,
@@ -390,25 +610,14 @@ void insertTrack(
     query.bindValue(":device", device);
     query.bindValue(":color", mixxx::RgbColor::toQVariant(colorFromID(static_cast<int>(track->color_id()))));
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
-
     int trackID = -1;
-    QSqlQuery finderQuery(database);
-    finderQuery.prepare("select id from " + kRekordboxLibraryTable + " where rb_id=:rb_id and device=:device");
-    finderQuery.bindValue(":rb_id", rbID);
-    finderQuery.bindValue(":device", device);
-
-    if (!finderQuery.exec()) {
-        LOG_FAILED_QUERY(finderQuery)
+    if (query.exec()) {
+        trackID = query.lastInsertId().toInt();
+    } else {
+        LOG_FAILED_QUERY(query)
                 << "rbID:" << rbID;
     }
 
-    if (finderQuery.next()) {
-        trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
-    }
-
     // Insert into device all tracks playlist
     queryInsertIntoDevicePlaylistTracks.bindValue(":track_id", trackID);
     queryInsertIntoDevicePlaylistTracks.bindValue(":position", audioFilesCount);
@@ -418,6 +627,82 @@ void insertTrack(
                 << "trackID:" << trackID
                 << "position:" << audioFilesCount;
     }
+
+    return trackID;
+}
+
+// Visits all present rows of a table page by page. Navigating through
+// rekordbox_pdb_t::page_ref_t::body() would keep all parsed pages and
+// rows of the whole database in memory until the end. Instead each page
+// is parsed from its own buffer and released after its rows have been
+// visited.
+template<typename RowVisitor>
+void visitTableRows(
+        rekordbox_pdb_t* pdb,
+        rekordbox_pdb_t::table_t* table,
+        RowVisitor visitRow) {
+    kaitai::kstream* io = pdb->_io();
+    const uint32_t lastIndex = table->last_page()->index();
+    uint32_t pageIndex = table->first_page()->index();
+    while (true) {
+        io->seek(static_cast<uint64_t>(pdb->len_page()) * pageIndex);
+        std::string rawPage = io->read_bytes(pdb->len_page());
+        kaitai::kstream pageStream(rawPage);
+        rekordbox_pdb_t::page_t page(&pageStream, table->first_page(), pdb);
+
+        if (page.is_data_page()) {
+            for (rekordbox_pdb_t::row_group_t* rowGroup : *page.row_groups()) {
+                for (rekordbox_pdb_t::row_ref_t* rowRef : *rowGroup->rows()) {
+                    if (rowRef->present()) {
+                        visitRow(rowRef->body());
+                    }
+                }
+            }
+        }
+
+        if (pageIndex == lastIndex) {
+            break;
+        }
+        pageIndex = page.next_page()->index();
+    }
+}
+
+struct analyze_path_t {
+    int trackID;
+    QString anlzPath;
+};
+
+QByteArray parseAndSerializeAnalyzeFiles(const analyze_path_t& analyzePath) {
+    return RekordboxFeature::parseAnalyzeFilesForCache(analyzePath.anlzPath);
+}
+
+// Parses the ANLZ files of all imported tracks concurrently and caches
+// the results in the library table.
+void cacheAnalyzeFiles(
+        QSqlDatabase& database,
+        const QList<analyze_path_t>& analyzePaths) {
+    const QList<QByteArray> cachedData =
+            QtConcurrent::blockingMapped<QList<QByteArray>>(
+                    analyzePaths,
+                    parseAndSerializeAnalyzeFiles);
+    DEBUG_ASSERT(cachedData.size() == analyzePaths.size());
+
+    QSqlQuery query(database);
+    query.prepare("UPDATE " + kRekordboxLibraryTable + " SET " +
+            kRekordboxAnalyzeCacheColumn + "=:analyze_cache WHERE id=:id");
+    ScopedTransaction transaction(database);
+    for (int i = 0; i < analyzePaths.size(); ++i) {
+        query.bindValue(":analyze_cache", cachedData[i]);
+        query.bindValue(":id", analyzePaths[i].trackID);
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+        }
+        if ((i + 1) % kTrackInsertBatchSize == 0) {
+            transaction.commit();
+            transaction.transaction();
+        }
+    }
+    transaction.commit();
 }
 
 void buildPlaylistTree(
@@ -515,96 +800,85 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     QMap<uint32_t, bool> playlistIsFolderMap;
     QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTreeMap;
     QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTrackMap;
+    QList<analyze_path_t> analyzePaths;
 
     bool folderOrPlaylistFound = false;
 
     for (int tableOrderIndex = 0; tableOrderIndex < totalTables; tableOrderIndex++) {
-        for (
-                std::vector<rekordbox_pdb_t::table_t*>::iterator table = reckordboxDB.tables()->begin();
-                table != reckordboxDB.tables()->end();
-                ++table) {
-            if ((*table)->type() == tableOrder[tableOrderIndex]) {
-                uint16_t lastIndex = (*table)->last_page()->index();
-                rekordbox_pdb_t::page_ref_t* currentRef = (*table)->first_page();
-
-                while (true) {
-                    rekordbox_pdb_t::page_t* page = currentRef->body();
-
-                    if (page->is_data_page()) {
-                        for (
-                                std::vector<rekordbox_pdb_t::row_group_t*>::iterator rowGroup = page->row_groups()->begin();
-                                rowGroup != page->row_groups()->end();
-                                ++rowGroup) {
-                            for (
-                                    std::vector<rekordbox_pdb_t::row_ref_t*>::iterator rowRef = (*rowGroup)->rows()->begin();
-                                    rowRef != (*rowGroup)->rows()->end();
-                                    ++rowRef) {
-                                if ((*rowRef)->present()) {
-                                    switch (tableOrder[tableOrderIndex]) {
-                                    case rekordbox_pdb_t::PAGE_TYPE_KEYS: {
-                                        // Key found, update map
-                                        rekordbox_pdb_t::key_row_t* key =
-                                                static_cast<rekordbox_pdb_t::key_row_t*>((*rowRef)->body());
-                                        keysMap[key->id()] = getText(key->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_GENRES: {
-                                        // Genre found, update map
-                                        rekordbox_pdb_t::genre_row_t* genre =
-                                                static_cast<rekordbox_pdb_t::genre_row_t*>((*rowRef)->body());
-                                        genresMap[genre->id()] = getText(genre->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_ARTISTS: {
-                                        // Artist found, update map
-                                        rekordbox_pdb_t::artist_row_t* artist =
-                                                static_cast<rekordbox_pdb_t::artist_row_t*>((*rowRef)->body());
-                                        artistsMap[artist->id()] = getText(artist->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_ALBUMS: {
-                                        // Album found, update map
-                                        rekordbox_pdb_t::album_row_t* album =
-                                                static_cast<rekordbox_pdb_t::album_row_t*>((*rowRef)->body());
-                                        albumsMap[album->id()] = getText(album->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES: {
-                                        // Playlist to track mapping found, update map
-                                        rekordbox_pdb_t::playlist_entry_row_t* playlistEntry =
-                                                static_cast<rekordbox_pdb_t::playlist_entry_row_t*>((*rowRef)->body());
-                                        playlistTrackMap[playlistEntry->playlist_id()][playlistEntry->entry_index()] =
-                                                playlistEntry->track_id();
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_TRACKS: {
-                                        // Track found, insert into database
-                                        insertTrack(
-                                                database, static_cast<rekordbox_pdb_t::track_row_t*>((*rowRef)->body()), query, queryInsertIntoDevicePlaylistTracks, artistsMap, albumsMap, genresMap, keysMap, devicePath, device, audioFilesCount);
-
-                                        audioFilesCount++;
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE: {
-                                        // Playlist tree node found, update map
-                                        rekordbox_pdb_t::playlist_tree_row_t* playlistTree =
-                                                static_cast<rekordbox_pdb_t::playlist_tree_row_t*>((*rowRef)->body());
-
-                                        playlistNameMap[playlistTree->id()] = getText(playlistTree->name());
-                                        playlistIsFolderMap[playlistTree->id()] = playlistTree->is_folder();
-                                        playlistTreeMap[playlistTree->parent_id()][playlistTree->sort_order()] = playlistTree->id();
-
-                                        folderOrPlaylistFound = true;
-                                    } break;
-                                    default:
-                                        break;
-                                    }
-                                }
-                            }
-                        }
+        const rekordbox_pdb_t::page_type_t tableType = tableOrder[tableOrderIndex];
+        for (rekordbox_pdb_t::table_t* table : *reckordboxDB.tables()) {
+            if (table->type() != tableType) {
+                continue;
+            }
+            visitTableRows(&reckordboxDB, table, [&](kaitai::kstruct* row) {
+                switch (tableType) {
+                case rekordbox_pdb_t::PAGE_TYPE_KEYS: {
+                    // Key found, update map
+                    rekordbox_pdb_t::key_row_t* key =
+                            static_cast<rekordbox_pdb_t::key_row_t*>(row);
+                    keysMap[key->id()] = getText(key->name());
+                } break;
+                case rekordbox_pdb_t::PAGE_TYPE_GENRES: {
+                    // Genre found, update map
+                    rekordbox_pdb_t::genre_row_t* genre =
+                            static_cast<rekordbox_pdb_t::genre_row_t*>(row);
+                    genresMap[genre->id()] = getText(genre->name());
+                } break;
+                case rekordbox_pdb_t::PAGE_TYPE_ARTISTS: {
+                    // Artist found, update map
+                    rekordbox_pdb_t::artist_row_t* artist =
+                            static_cast<rekordbox_pdb_t::artist_row_t*>(row);
+                    artistsMap[artist->id()] = getText(artist->name());
+                } break;
+                case rekordbox_pdb_t::PAGE_TYPE_ALBUMS: {
+                    // Album found, update map
+                    rekordbox_pdb_t::album_row_t* album =
+                            static_cast<rekordbox_pdb_t::album_row_t*>(row);
+                    albumsMap[album->id()] = getText(album->name());
+                } break;
+                case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES: {
+                    // Playlist to track mapping found, update map
+                    rekordbox_pdb_t::playlist_entry_row_t* playlistEntry =
+                            static_cast<rekordbox_pdb_t::playlist_entry_row_t*>(row);
+                    playlistTrackMap[playlistEntry->playlist_id()][playlistEntry->entry_index()] =
+                            playlistEntry->track_id();
+                } break;
+                case rekordbox_pdb_t::PAGE_TYPE_TRACKS: {
+                    // Track found, insert into database
+                    rekordbox_pdb_t::track_row_t* track =
+                            static_cast<rekordbox_pdb_t::track_row_t*>(row);
+                    int trackID = insertTrack(
+                            track, query, queryInsertIntoDevicePlaylistTracks, artistsMap, albumsMap, genresMap, keysMap, devicePath, device, audioFilesCount);
+                    if (trackID >= 0) {
+                        analyze_path_t analyzePath;
+                        analyzePath.trackID = trackID;
+                        analyzePath.anlzPath = devicePath + getText(track->analyze_path());
+                        analyzePaths << analyzePath;
                     }
 
-                    if (currentRef->index() == lastIndex) {
-                        break;
-                    } else {
-                        currentRef = page->next_page();
+                    audioFilesCount++;
+
+                    // Commit in batches to keep the journal small
+                    if (audioFilesCount % kTrackInsertBatchSize == 0) {
+                        transaction.commit();
+                        transaction.transaction();
                     }
+                } break;
+                case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE: {
+                    // Playlist tree node found, update map
+                    rekordbox_pdb_t::playlist_tree_row_t* playlistTree =
+                            static_cast<rekordbox_pdb_t::playlist_tree_row_t*>(row);
+
+                    playlistNameMap[playlistTree->id()] = getText(playlistTree->name());
+                    playlistIsFolderMap[playlistTree->id()] = playlistTree->is_folder();
+                    playlistTreeMap[playlistTree->parent_id()][playlistTree->sort_order()] = playlistTree->id();
+
+                    folderOrPlaylistFound = true;
+                } break;
+                default:
+                    break;
                 }
-            }
+            });
         }
     }
 
@@ -618,6 +892,8 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
 
     transaction.commit();
 
+    cacheAnalyzeFiles(database, analyzePaths);
+
     return devicePath;
 }
 
@@ -817,172 +1093,63 @@ void setHotCue(TrackPointer track, double startPosition, double endPosition, int
     }
 }
 
-void readAnalyze(TrackPointer track, double sampleRate, int timingOffset, bool ignoreCues, QString anlzPath) {
-    if (!QFile(anlzPath).exists()) {
-        return;
-    }
-
-    qDebug() << "Rekordbox ANLZ path:" << anlzPath << " for: " << track->getTitle();
-
-    std::ifstream ifs(anlzPath.toStdString(), std::ifstream::binary);
-    kaitai::kstream ks(&ifs);
-
-    rekordbox_anlz_t anlz = rekordbox_anlz_t(&ks);
-
+void applyAnalyze(TrackPointer track, double sampleRate, int timingOffset, const anlz_data_t& data) {
     double sampleRateKhz = sampleRate / 1000.0;
     double samples = sampleRateKhz * mixxx::kEngineChannelCount;
 
-    QList<memory_cue_loop_t> memoryCuesAndLoops;
-    int lastHotCueIndex = 0;
-
-    for (std::vector<rekordbox_anlz_t::tagged_section_t*>::iterator section = anlz.sections()->begin(); section != anlz.sections()->end(); ++section) {
-        switch ((*section)->fourcc()) {
-        case rekordbox_anlz_t::SECTION_TAGS_BEAT_GRID: {
-            if (!ignoreCues) {
-                break;
-            }
-
-            rekordbox_anlz_t::beat_grid_tag_t* beatGridTag = static_cast<rekordbox_anlz_t::beat_grid_tag_t*>((*section)->body());
+    if (!data.beatTimes.isEmpty()) {
+        QVector<double> beats;
+        beats.reserve(data.beatTimes.size());
+        for (int beatTime : data.beatTimes) {
+            int time = applyTimingOffset(beatTime, timingOffset);
+            beats << (sampleRateKhz * static_cast<double>(time));
+        }
 
-            QVector<double> beats;
+        QHash<QString, QString> extraVersionInfo;
 
-            for (std::vector<rekordbox_anlz_t::beat_grid_beat_t*>::iterator beat = beatGridTag->beats()->begin(); beat != beatGridTag->beats()->end(); ++beat) {
-                int time = static_cast<int>((*beat)->time()) - timingOffset;
-                // Ensure no offset times are less than 1
-                if (time < 1) {
-                    time = 1;
-                }
-                beats << (sampleRateKhz * static_cast<double>(time));
-            }
+        mixxx::BeatsPointer pBeats = BeatFactory::makePreferredBeats(
+                *track, beats, extraVersionInfo, false, false, sampleRate, 0, 0, 0);
 
-            QHash<QString, QString> extraVersionInfo;
+        track->setBeats(pBeats);
+    }
 
-            mixxx::BeatsPointer pBeats = BeatFactory::makePreferredBeats(
-                    *track, beats, extraVersionInfo, false, false, sampleRate, 0, 0, 0);
+    QList<memory_cue_loop_t> memoryCuesAndLoops;
+    int lastHotCueIndex = 0;
 
-            track->setBeats(pBeats);
+    for (const anlz_cue_t& cue : data.cues) {
+        int time = applyTimingOffset(cue.time, timingOffset);
+        double position = samples * static_cast<double>(time);
+
+        switch (cue.type) {
+        case AnlzCueType::MemoryCue: {
+            memory_cue_loop_t memoryCue;
+            memoryCue.startPosition = position;
+            memoryCue.endPosition = Cue::kNoPosition;
+            memoryCue.comment = cue.comment;
+            memoryCue.color = cue.color;
+            memoryCuesAndLoops << memoryCue;
         } break;
-        case rekordbox_anlz_t::SECTION_TAGS_CUES: {
-            if (ignoreCues) {
-                break;
-            }
-
-            rekordbox_anlz_t::cue_tag_t* cuesTag = static_cast<rekordbox_anlz_t::cue_tag_t*>((*section)->body());
-
-            for (std::vector<rekordbox_anlz_t::cue_entry_t*>::iterator cueEntry = cuesTag->cues()->begin(); cueEntry != cuesTag->cues()->end(); ++cueEntry) {
-                int time = static_cast<int>((*cueEntry)->time()) - timingOffset;
-                // Ensure no offset times are less than 1
-                if (time < 1) {
-                    time = 1;
-                }
-                double position = samples * static_cast<double>(time);
-
-                switch (cuesTag->type()) {
-                case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
-                    switch ((*cueEntry)->type()) {
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
-                        memory_cue_loop_t memoryCue;
-                        memoryCue.startPosition = position;
-                        memoryCue.endPosition = Cue::kNoPosition;
-                        memoryCue.color = mixxx::RgbColor::nullopt();
-                        memoryCuesAndLoops << memoryCue;
-                    } break;
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
-                        int endTime = static_cast<int>((*cueEntry)->loop_time()) - timingOffset;
-                        // Ensure no offset times are less than 1
-                        if (endTime < 1) {
-                            endTime = 1;
-                        }
-
-                        memory_cue_loop_t loop;
-                        loop.startPosition = position;
-                        loop.endPosition = samples * static_cast<double>(endTime);
-                        loop.color = mixxx::RgbColor::nullopt();
-                        memoryCuesAndLoops << loop;
-                    } break;
-                    }
-                } break;
-                case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
-                    int hotCueIndex = static_cast<int>((*cueEntry)->hot_cue() - 1);
-                    if (hotCueIndex > lastHotCueIndex) {
-                        lastHotCueIndex = hotCueIndex;
-                    }
-                    setHotCue(
-                            track,
-                            position,
-                            Cue::kNoPosition,
-                            hotCueIndex,
-                            QString(),
-                            mixxx::RgbColor::nullopt());
-                } break;
-                }
-            }
+        case AnlzCueType::Loop: {
+            int endTime = applyTimingOffset(cue.loopTime, timingOffset);
+            memory_cue_loop_t loop;
+            loop.startPosition = position;
+            loop.endPosition = samples * static_cast<double>(endTime);
+            loop.comment = cue.comment;
+            loop.color = cue.color;
+            memoryCuesAndLoops << loop;
         } break;
-        case rekordbox_anlz_t::SECTION_TAGS_CUES_2: {
-            if (ignoreCues) {
-                break;
-            }
-
-            rekordbox_anlz_t::cue_extended_tag_t* cuesExtendedTag = static_cast<rekordbox_anlz_t::cue_extended_tag_t*>((*section)->body());
-
-            for (std::vector<rekordbox_anlz_t::cue_extended_entry_t*>::iterator cueExtendedEntry = cuesExtendedTag->cues()->begin(); cueExtendedEntry != cuesExtendedTag->cues()->end(); ++cueExtendedEntry) {
-                int time = static_cast<int>((*cueExtendedEntry)->time()) - timingOffset;
-                // Ensure no offset times are less than 1
-                if (time < 1) {
-                    time = 1;
-                }
-                double position = samples * static_cast<double>(time);
-
-                switch (cuesExtendedTag->type()) {
-                case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
-                    switch ((*cueExtendedEntry)->type()) {
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
-                        memory_cue_loop_t memoryCue;
-                        memoryCue.startPosition = position;
-                        memoryCue.endPosition = Cue::kNoPosition;
-                        memoryCue.comment = toUnicode((*cueExtendedEntry)->comment());
-                        memoryCue.color = colorFromID(static_cast<int>((*cueExtendedEntry)->color_id()));
-                        memoryCuesAndLoops << memoryCue;
-                    } break;
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
-                        int endTime = static_cast<int>((*cueExtendedEntry)->loop_time()) - timingOffset;
-                        // Ensure no offset times are less than 1
-                        if (endTime < 1) {
-                            endTime = 1;
-                        }
-
-                        memory_cue_loop_t loop;
-                        loop.startPosition = position;
-                        loop.endPosition = samples * static_cast<double>(endTime);
-                        loop.comment = toUnicode((*cueExtendedEntry)->comment());
-                        loop.color = colorFromID(static_cast<int>((*cueExtendedEntry)->color_id()));
-                        memoryCuesAndLoops << loop;
-                    } break;
-                    }
-                } break;
-                case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
-                    int hotCueIndex = static_cast<int>((*cueExtendedEntry)->hot_cue() - 1);
-                    if (hotCueIndex > lastHotCueIndex) {
-                        lastHotCueIndex = hotCueIndex;
-                    }
-                    setHotCue(track,
-                            position,
-                            Cue::kNoPosition,
-                            hotCueIndex,
-                            toUnicode((*cueExtendedEntry)->comment()),
-                            mixxx::RgbColor(qRgb(
-                                    static_cast<int>(
-                                            (*cueExtendedEntry)->color_red()),
-                                    static_cast<int>(
-                                            (*cueExtendedEntry)->color_green()),
-                                    static_cast<int>((*cueExtendedEntry)
-                                                             ->color_blue()))));
-                } break;
-                }
+        case AnlzCueType::HotCue: {
+            if (cue.hotCueIndex > lastHotCueIndex) {
+                lastHotCueIndex = cue.hotCueIndex;
             }
+            setHotCue(
+                    track,
+                    position,
+                    Cue::kNoPosition,
+                    cue.hotCueIndex,
+                    cue.comment,
+                    cue.color);
         } break;
-        default:
-            break;
         }
     }
 
@@ -1022,6 +1189,20 @@ void readAnalyze(TrackPointer track, double sampleRate, int timingOffset, bool i
 
 } // anonymous namespace
 
+//static
+QByteArray RekordboxFeature::parseAnalyzeFilesForCache(const QString& anlzPath) {
+    // The Kaitai parser throws on malformed or truncated files. A single
+    // corrupt file must neither abort the import of the whole device nor
+    // be parsed again when loading the track.
+    try {
+        return serializeAnlzData(parseAnalyzeFiles(anlzPath));
+    } catch (const std::exception& e) {
+        qWarning() << "Failed to parse Rekordbox ANLZ file"
+                   << anlzPath << ":" << e.what();
+    }
+    return serializeAnlzData(anlz_data_t());
+}
+
 RekordboxPlaylistModel::RekordboxPlaylistModel(QObject* parent,
         TrackCollectionManager* trackCollectionManager,
         QSharedPointer<BaseTrackCache> trackSource)
@@ -1127,16 +1308,21 @@ TrackPointer RekordboxPlaylistModel::getTrack(const QModelIndex& index) const {
 
     double sampleRate = static_cast<double>(track->getSampleRate());
 
-    QString anlzPath = index.sibling(index.row(), fieldIndex("analyze_path")).data().toString();
-    QString anlzPathExt = anlzPath.left(anlzPath.length() - 3) + "EXT";
-
-    if (QFile(anlzPathExt).exists()) {
-        // Beatgrids appear to be only correct in legacy ANLZ file
-        readAnalyze(track, sampleRate, timingOffset, true, anlzPath);
-        readAnalyze(track, sampleRate, timingOffset, false, anlzPathExt);
-    } else {
-        readAnalyze(track, sampleRate, timingOffset, false, anlzPath);
+    // The ANLZ files have already been parsed while importing the
+    // device. Only parse them again if the cached data is missing.
+    anlz_data_t anlzData;
+    QSqlQuery query(m_database);
+    query.prepare("SELECT " + kRekordboxAnalyzeCacheColumn +
+            " FROM " + kRekordboxLibraryTable + " WHERE id=:id");
+    query.bindValue(":id", index.sibling(index.row(), fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_ID)).data());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+    if (!query.next() || !deserializeAnlzData(query.value(0).toByteArray(), &anlzData)) {
+        QString anlzPath = index.sibling(index.row(), fieldIndex("analyze_path")).data().toString();
+        deserializeAnlzData(RekordboxFeature::parseAnalyzeFilesForCache(anlzPath), &anlzData);
     }
+    applyAnalyze(track, sampleRate, timingOffset, anlzData);
 
     // Assume that the key of the file the has been analyzed in Recordbox is correct
     // and prevent the AnalyzerKey from re-analyzing.
@@ -65,6 +65,10 @@ class RekordboxFeature : public BaseExternalLibraryFeature {
     QVariant title() override;
     QIcon getIcon() override;
     static bool isSupported();
+    // Parses the ANLZ files of a track and returns the serialized beat
+    // grid and cues for caching them. Malformed files are logged and
+    // result in empty data.
+    static QByteArray parseAnalyzeFilesForCache(const QString& anlzPath);
     void bindLibraryWidget(WLibrary* libraryWidget,
             KeyboardEventFilter* keyboard) override;
 
@@ -7,12 +7,30 @@
 
 #include "library/baseexternaltrackmodel.h"
 #include "library/baseexternalplaylistmodel.h"
+#include "library/externallibraryimport.h"
 #include "library/library.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/treeitem.h"
 #include "library/queryutil.h"
 
+namespace {
+
+const QString kImportStampKey = "mixxx.rhythmboxfeature.importstamp";
+
+QString findRhythmboxFile(const QString& fileName) {
+    QString filePath = QDir::homePath() + "/.gnome2/rhythmbox/" + fileName;
+    if (!QFile::exists(filePath)) {
+        filePath = QDir::homePath() + "/.local/share/rhythmbox/" + fileName;
+        if (!QFile::exists(filePath)) {
+            return QString();
+        }
+    }
+    return filePath;
+}
+
+} // anonymous namespace
+
 RhythmboxFeature::RhythmboxFeature(Library* pLibrary, UserSettingsPointer pConfig)
         : BaseExternalLibraryFeature(pLibrary, pConfig),
           m_cancelImport(false),
@@ -141,32 +159,52 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
     qDebug() << "importMusicCollection Thread Id: " << QThread::currentThread();
      // Try and open the Rhythmbox DB. An API call which tells us where
      // the file is would be nice.
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/rhythmdb.xml");
+    QFile db(findRhythmboxFile("rhythmdb.xml"));
     if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/rhythmdb.xml");
-        if (!db.exists()) {
-            return NULL;
-        }
+        return NULL;
+    }
+
+    // The tables still contain the result of the last import. Skip
+    // parsing if neither the music collection nor the playlists have
+    // been modified since then.
+    const ExternalLibraryFileStamp fileStamp({
+            QFileInfo(db),
+            QFileInfo(findRhythmboxFile("playlists.xml"))});
+    if (fileStamp.isStored(m_database, kImportStampKey)) {
+        qDebug() << "Rhythmbox music collection is unchanged since the last import";
+        return loadPlaylists();
     }
+    // Invalidate the stored stamp until the import has finished
+    ExternalLibraryFileStamp::clear(m_database, kImportStampKey);
 
     if (!db.open(QIODevice::ReadOnly | QIODevice::Text))
         return NULL;
 
-    //Delete all table entries of Traktor feature
+    // Tracks are updated in place, but playlists are always rebuilt
     ScopedTransaction transaction(m_database);
     clearTable("rhythmbox_playlist_tracks");
-    clearTable("rhythmbox_library");
     clearTable("rhythmbox_playlists");
-    transaction.commit();
-
-    transaction.transaction();
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO rhythmbox_library (artist, title, album, year, "
-                  "genre, comment, tracknumber, bpm, bitrate,"
-                  "duration, location, rating ) "
-                  "VALUES (:artist, :title, :album, :year, :genre, :comment, "
-                  ":tracknumber, :bpm, :bitrate, :duration, :location, :rating )");
 
+    ExternalTrackTableUpdater trackUpdater(
+            m_database,
+            &transaction,
+            "rhythmbox_library",
+            "location",
+            QStringList{
+                    "artist",
+                    "title",
+                    "album",
+                    "year",
+                    "genre",
+                    "comment",
+                    "tracknumber",
+                    "bpm",
+                    "bitrate",
+                    "duration",
+                    "rating"});
+    if (!trackUpdater.prepare()) {
+        return NULL;
+    }
 
     QXmlStreamReader xml(&db);
     while (!xml.atEnd() && !m_cancelImport) {
@@ -175,33 +213,54 @@ TreeItem* RhythmboxFeature::importMusicCollection() {
             QXmlStreamAttributes attr = xml.attributes();
             //Check if we really parse a track and not album art information
             if (attr.value("type").toString() == "song") {
-                importTrack(xml, query);
+                importTrack(xml, &trackUpdater);
             }
         }
     }
-    transaction.commit();
 
     if (xml.hasError()) {
         // do error handling
         qDebug() << "Cannot process Rhythmbox music collection";
         qDebug() << "XML ERROR: " << xml.errorString();
+        transaction.commit();
         return NULL;
     }
 
     db.close();
     if (m_cancelImport) {
+        transaction.commit();
         return NULL;
     }
-    return importPlaylists();
+    trackUpdater.removeUnvisited();
+
+    TreeItem* root = importPlaylists(trackUpdater);
+    transaction.commit();
+
+    if (root && !m_cancelImport) {
+        fileStamp.store(m_database, kImportStampKey);
+    }
+    return root;
+}
+
+TreeItem* RhythmboxFeature::loadPlaylists() {
+    std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT name FROM rhythmbox_playlists ORDER BY id")) {
+        LOG_FAILED_QUERY(query);
+        return NULL;
+    }
+    while (query.next()) {
+        rootItem->appendChild(query.value(0).toString());
+    }
+    return rootItem.release();
 }
 
-TreeItem* RhythmboxFeature::importPlaylists() {
-    QFile db(QDir::homePath() + "/.gnome2/rhythmbox/playlists.xml");
+TreeItem* RhythmboxFeature::importPlaylists(
+        const ExternalTrackTableUpdater& trackUpdater) {
+    QFile db(findRhythmboxFile("playlists.xml"));
     if (!db.exists()) {
-        db.setFileName(QDir::homePath() + "/.local/share/rhythmbox/playlists.xml");
-        if (!db.exists()) {
-            return NULL;
-        }
+        return NULL;
     }
     //Open file
      if (!db.open(QIODevice::ReadOnly | QIODevice::Text))
@@ -244,7 +303,7 @@ TreeItem* RhythmboxFeature::importPlaylists() {
                 int playlist_id = query_insert_to_playlists.lastInsertId().toInt();
 
                 //Process playlist entries
-                importPlaylist(xml, query_insert_to_playlist_tracks, playlist_id);
+                importPlaylist(xml, query_insert_to_playlist_tracks, playlist_id, trackUpdater);
             }
         }
     }
@@ -260,7 +319,8 @@ TreeItem* RhythmboxFeature::importPlaylists() {
     return rootItem.release();
 }
 
-void RhythmboxFeature::importTrack(QXmlStreamReader &xml, QSqlQuery &query) {
+void RhythmboxFeature::importTrack(QXmlStreamReader &xml,
+        ExternalTrackTableUpdater* pTrackUpdater) {
     QString title;
     QString artist;
     QString album;
@@ -336,32 +396,27 @@ void RhythmboxFeature::importTrack(QXmlStreamReader &xml, QSqlQuery &query) {
         return;
     }
 
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":genre", genre);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-
-    if (!success) {
-        qDebug() << "SQL Error in rhythmboxfeature.cpp: line" << __LINE__
-                 << " " << query.lastError();
-        return;
-    }
+    // Save parsed track to database unless it is unchanged
+    pTrackUpdater->upsert(location,
+            QVariantList{
+                    artist,
+                    title,
+                    album,
+                    year,
+                    genre,
+                    comment,
+                    tracknumber,
+                    bpm,
+                    bitrate,
+                    playtime,
+                    rating});
 }
 
 // reads all playlist entries and executes a SQL statement
 void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
                                       QSqlQuery &query_insert_to_playlist_tracks,
-                                      int playlist_id) {
+                                      int playlist_id,
+                                      const ExternalTrackTableUpdater& trackUpdater) {
     int playlist_position = 1;
     while (!xml.atEnd()) {
         //read next XML element
@@ -370,26 +425,12 @@ void RhythmboxFeature::importPlaylist(QXmlStreamReader &xml,
             const auto trackFile = TrackFile::fromUrl(xml.readElementText());
 
             //get the ID of the file in the rhythmbox_library table
-            int track_id = -1;
-            QSqlQuery finder_query(m_database);
-            finder_query.prepare("select id from rhythmbox_library where location=:path");
-            finder_query.bindValue(":path", trackFile.location());
-            bool success = finder_query.exec();
-
-            if (success) {
-                const int idColumn = finder_query.record().indexOf("id");
-                while (finder_query.next()) {
-                    track_id = finder_query.value(idColumn).toInt();
-                }
-             } else {
-                qDebug() << "SQL Error in RhythmboxFeature.cpp: line"
-                         << __LINE__ << " " << finder_query.lastError();
-            }
+            int track_id = trackUpdater.lookupId(trackFile.location());
 
             query_insert_to_playlist_tracks.bindValue(":playlist_id", playlist_id);
             query_insert_to_playlist_tracks.bindValue(":track_id", track_id);
             query_insert_to_playlist_tracks.bindValue(":position", playlist_position++);
-            success = query_insert_to_playlist_tracks.exec();
+            bool success = query_insert_to_playlist_tracks.exec();
 
             if (!success) {
                 qDebug() << "SQL Error in RhythmboxFeature.cpp: line" << __LINE__ << " "
@@ -17,6 +17,7 @@
 
 class BaseExternalTrackModel;
 class BaseExternalPlaylistModel;
+class ExternalTrackTableUpdater;
 
 class RhythmboxFeature : public BaseExternalLibraryFeature {
     Q_OBJECT
@@ -32,7 +33,9 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     // processes the music collection
     TreeItem* importMusicCollection();
     // processes the playlist entries
-    TreeItem* importPlaylists();
+    TreeItem* importPlaylists(const ExternalTrackTableUpdater& trackUpdater);
+    // constructs the childmodel from the playlists imported previously
+    TreeItem* loadPlaylists();
 
   public slots:
     void activate();
@@ -44,9 +47,10 @@ class RhythmboxFeature : public BaseExternalLibraryFeature {
     // Removes all rows from a given table
     void clearTable(QString table_name);
     // reads the properties of a track and executes a SQL statement
-    void importTrack(QXmlStreamReader &xml, QSqlQuery &query);
+    void importTrack(QXmlStreamReader &xml, ExternalTrackTableUpdater* pTrackUpdater);
     // reads all playlist entries and executes a SQL statement
-    void importPlaylist(QXmlStreamReader &xml, QSqlQuery &query, int playlist_id);
+    void importPlaylist(QXmlStreamReader &xml, QSqlQuery &query, int playlist_id,
+            const ExternalTrackTableUpdater& trackUpdater);
 
     BaseExternalTrackModel* m_pRhythmboxTrackModel;
     BaseExternalPlaylistModel* m_pRhythmboxPlaylistModel;
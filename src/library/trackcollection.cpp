@@ -81,6 +81,7 @@ void TrackCollection::connectDatabase(QSqlDatabase database) {
     m_cueDao.initialize(database);
     m_directoryDao.initialize(database);
     m_analysisDao.initialize(database);
+    m_analysisCacheDao.initialize(database);
     m_libraryHashDao.initialize(database);
     m_crates.connectDatabase(database);
 }
@@ -355,6 +356,7 @@ bool TrackCollection::purgeTracks(
     m_cueDao.deleteCuesForTracks(trackIds);
     m_playlistDao.removeTracksFromPlaylists(trackIds);
     m_analysisDao.deleteAnalyses(trackIds);
+    m_analysisCacheDao.deleteCachedResultsForTracks(trackIds);
 
     // Post-processing
     // TODO(XXX): Move signals from TrackDAO to TrackCollection
@@ -519,11 +521,28 @@ void TrackCollection::saveTrack(Track* pTrack) {
     m_trackDao.saveTrack(pTrack);
 }
 
+void TrackCollection::saveTracksPrepare() {
+    DEBUG_ASSERT(QApplication::instance()->thread() == QThread::currentThread());
+
+    m_trackDao.saveTracksPrepare();
+}
+
+void TrackCollection::saveTracksFinish() {
+    DEBUG_ASSERT(QApplication::instance()->thread() == QThread::currentThread());
+
+    m_trackDao.saveTracksFinish();
+}
+
 TrackPointer TrackCollection::getTrackById(
         TrackId trackId) const {
     return m_trackDao.getTrackById(trackId);
 }
 
+QList<TrackPointer> TrackCollection::getTracksByIds(
+        const QList<TrackId>& trackIds) const {
+    return m_trackDao.getTracksByIds(trackIds);
+}
+
 TrackPointer TrackCollection::getTrackByRef(
         const TrackRef& trackRef) const {
     return m_trackDao.getTrackByRef(trackRef);
@@ -10,6 +10,7 @@
 #include "library/dao/trackdao.h"
 #include "library/dao/cuedao.h"
 #include "library/dao/playlistdao.h"
+#include "library/dao/analysiscachedao.h"
 #include "library/dao/analysisdao.h"
 #include "library/dao/directorydao.h"
 #include "library/dao/libraryhashdao.h"
@@ -84,6 +85,8 @@ class TrackCollection : public QObject,
 
     TrackPointer getTrackById(
             TrackId trackId) const;
+    QList<TrackPointer> getTracksByIds(
+            const QList<TrackId>& trackIds) const;
 
     TrackPointer getTrackByRef(
             const TrackRef& trackRef) const;
@@ -142,6 +145,8 @@ class TrackCollection : public QObject,
     void relocateDirectory(QString oldDir, QString newDir);
 
     void saveTrack(Track* pTrack);
+    void saveTracksPrepare();
+    void saveTracksFinish();
 
     QSqlDatabase m_database;
 
@@ -150,6 +155,7 @@ class TrackCollection : public QObject,
     CueDAO m_cueDao;
     DirectoryDAO m_directoryDao;
     AnalysisDao m_analysisDao;
+    AnalysisCacheDao m_analysisCacheDao;
     LibraryHashDAO m_libraryHashDao;
     TrackDAO m_trackDao;
 
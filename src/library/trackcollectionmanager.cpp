@@ -21,10 +21,11 @@ inline
 parented_ptr<TrackCollection> createInternalTrackCollection(
         TrackCollectionManager* parent,
         const UserSettingsPointer& pConfig,
+        GlobalTrackCache::EvictedTrackSaving evictedTrackSaving,
         deleteTrackFn_t deleteTrackFn) {
     // Ensure that GlobalTrackCache is ready before creating
     // the internal TrackCollection.
-    GlobalTrackCache::createInstance(parent, deleteTrackFn);
+    GlobalTrackCache::createInstance(parent, evictedTrackSaving, deleteTrackFn);
     return make_parented<TrackCollection>(parent, pConfig);
 }
 
@@ -34,10 +35,19 @@ TrackCollectionManager::TrackCollectionManager(
         QObject* parent,
         UserSettingsPointer pConfig,
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        mixxx::DbConnectionPoolPtr pReadOnlyDbConnectionPool,
+        GlobalTrackCache::EvictedTrackSaving evictedTrackSaving,
         deleteTrackFn_t /*only-needed-for-testing*/ deleteTrackForTestingFn)
     : QObject(parent),
       m_pConfig(pConfig),
-      m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)) {
+      m_pReadOnlyDbConnectionPool(std::move(pReadOnlyDbConnectionPool)),
+      m_pInternalCollection(createInternalTrackCollection(
+              this, pConfig, evictedTrackSaving, deleteTrackForTestingFn)) {
+    // A single thread is sufficient, superseded queries are aborted
+    // early and only a single connection needs to be kept open
+    m_readOnlyDbThreadPool.setMaxThreadCount(1);
+    m_readOnlyDbThreadPool.setExpiryTimeout(-1);
+
     const QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
 
     // TODO(XXX): Add a checkbox in the library preferences for checking
@@ -174,12 +184,34 @@ bool TrackCollectionManager::saveTrack(const TrackPointer& pTrack) {
     return true;
 }
 
+int TrackCollectionManager::saveTracks(const QList<TrackPointer>& tracks) {
+    m_pInternalCollection->saveTracksPrepare();
+    int savedCount = 0;
+    for (const auto& pTrack : tracks) {
+        if (saveTrack(pTrack)) {
+            ++savedCount;
+        }
+    }
+    m_pInternalCollection->saveTracksFinish();
+    return savedCount;
+}
+
 // Export metadata and save the track in both the internal database
 // and external libraries.
 void TrackCollectionManager::saveEvictedTrack(Track* pTrack) noexcept {
     saveTrack(pTrack, TrackMetadataExportMode::Immediate);
 }
 
+void TrackCollectionManager::saveEvictedTracks(
+        const QList<Track*>& evictedTracks) noexcept {
+    // All tracks are updated within a single database transaction
+    m_pInternalCollection->saveTracksPrepare();
+    for (Track* pTrack : evictedTracks) {
+        saveTrack(pTrack, TrackMetadataExportMode::Immediate);
+    }
+    m_pInternalCollection->saveTracksFinish();
+}
+
 void TrackCollectionManager::saveTrack(
         Track* pTrack,
         TrackMetadataExportMode mode) {
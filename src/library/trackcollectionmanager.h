@@ -3,6 +3,7 @@
 #include <QDir>
 #include <QList>
 #include <QSet>
+#include <QThreadPool>
 
 #include <memory>
 
@@ -33,6 +34,9 @@ class TrackCollectionManager: public QObject,
             QObject* parent,
             UserSettingsPointer pConfig,
             mixxx::DbConnectionPoolPtr pDbConnectionPool,
+            mixxx::DbConnectionPoolPtr pReadOnlyDbConnectionPool,
+            GlobalTrackCache::EvictedTrackSaving evictedTrackSaving =
+                    GlobalTrackCache::EvictedTrackSaving::Deferred,
             deleteTrackFn_t deleteTrackForTestingFn = nullptr);
     ~TrackCollectionManager() override;
 
@@ -44,6 +48,18 @@ class TrackCollectionManager: public QObject,
         return m_externalCollections;
     }
 
+    // Read-only database connections for executing queries on
+    // worker threads. Might be null if not available.
+    const mixxx::DbConnectionPoolPtr& readOnlyDbConnectionPool() const {
+        return m_pReadOnlyDbConnectionPool;
+    }
+    // Worker threads for read-only queries. Their threads never expire
+    // and each thread keeps its read-only connection open until the
+    // pool is destroyed, instead of opening a new one per query.
+    QThreadPool* readOnlyDbThreadPool() {
+        return &m_readOnlyDbThreadPool;
+    }
+
     bool hideTracks(const QList<TrackId>& trackIds);
     bool unhideTracks(const QList<TrackId>& trackIds);
     void hideAllTracks(const QDir& rootDir);
@@ -66,6 +82,11 @@ class TrackCollectionManager: public QObject,
     // false.
     bool saveTrack(const TrackPointer& pTrack);
 
+    // Saves multiple tracks within a single database transaction, which
+    // is much faster than saving them one by one. Returns the number of
+    // tracks that were dirty and have been saved.
+    int saveTracks(const QList<TrackPointer>& tracks);
+
   signals:
     void libraryScanStarted();
     void libraryScanFinished();
@@ -79,8 +100,9 @@ class TrackCollectionManager: public QObject,
     void slotScanTracksRelocated(QList<RelocatedTrack> relocatedTracks);
 
   private:
-    // Callback for GlobalTrackCache
+    // Callbacks for GlobalTrackCache
     void saveEvictedTrack(Track* pTrack) noexcept override;
+    void saveEvictedTracks(const QList<Track*>& evictedTracks) noexcept override;
 
     // Might be called from any thread
     enum class TrackMetadataExportMode {
@@ -96,6 +118,11 @@ class TrackCollectionManager: public QObject,
 
     const UserSettingsPointer m_pConfig;
 
+    const mixxx::DbConnectionPoolPtr m_pReadOnlyDbConnectionPool;
+    // Must be destroyed before the connection pool, because the
+    // connections are closed when the threads terminate
+    QThreadPool m_readOnlyDbThreadPool;
+
     const parented_ptr<TrackCollection> m_pInternalCollection;
 
     QList<ExternalTrackCollection*> m_externalCollections;
@@ -91,6 +91,20 @@ class TrackModel {
     // or TrackRef in this result set.
     virtual TrackPointer getTrack(const QModelIndex& index) const = 0;
     virtual TrackPointer getTrackByRef(const TrackRef& trackRef) const = 0;
+    // Deserialize and return the tracks at the given indices, skipping
+    // unavailable tracks. Models can load them at once instead of one
+    // by one.
+    virtual TrackPointerList getTracks(const QModelIndexList& indices) const {
+        TrackPointerList tracks;
+        tracks.reserve(indices.size());
+        for (const auto& index : indices) {
+            auto pTrack = getTrack(index);
+            if (pTrack) {
+                tracks.append(std::move(pTrack));
+            }
+        }
+        return tracks;
+    }
 
     // Gets the on-disk location of the track at the given location
     // with Qt separator "/".
@@ -136,6 +150,13 @@ class TrackModel {
         Q_UNUSED(sourceIndex);
         Q_UNUSED(destIndex);
     }
+    // Moves multiple tracks at once in front of destIndex, keeping
+    // their order. An invalid destIndex moves them to the end.
+    virtual void moveTracks(const QModelIndexList& sourceIndices,
+                            const QModelIndex& destIndex) {
+        Q_UNUSED(sourceIndices);
+        Q_UNUSED(destIndex);
+    }
     virtual bool isLocked() {
         return false;
     }
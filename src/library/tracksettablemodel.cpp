@@ -23,3 +23,7 @@ bool TrackSetTableModel::isColumnInternal(int column) {
            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION) ||
            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH);;
 }
+
+TrackPointerList TrackSetTableModel::getTracks(const QModelIndexList& indices) const {
+    return getInternalTracks(indices);
+}
@@ -9,4 +9,5 @@ class TrackSetTableModel : public BaseSqlTableModel {
     TrackSetTableModel(QObject* parent, TrackCollectionManager* pTrackCollectionManager, const char* settingsNamespace);
 
     bool isColumnInternal(int column) override;
+    TrackPointerList getTracks(const QModelIndexList& indices) const override;
 };
@@ -10,6 +10,7 @@
 
 #include "library/traktor/traktorfeature.h"
 
+#include "library/externallibraryimport.h"
 #include "library/librarytablemodel.h"
 #include "library/missingtablemodel.h"
 #include "library/queryutil.h"
@@ -21,6 +22,11 @@
 
 namespace {
 
+const QString kImportStampKey = "mixxx.traktorfeature.importstamp";
+
+// Separates the folder and playlist names in the unique playlist path
+const QString kPlaylistPathDelimiter = "-->";
+
 QString fromTraktorSeparators(QString path) {
     // Traktor uses /: instead of just / as delimiting character for some reasons
     return path.replace("/:", "/");
@@ -186,22 +192,47 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
     //Give thread a low priority
     QThread* thisThread = QThread::currentThread();
     thisThread->setPriority(QThread::LowPriority);
+
+    // The tables still contain the result of the last import. Skip
+    // parsing if the file has not been modified since then.
+    const ExternalLibraryFileStamp fileStamp({QFileInfo(file)});
+    if (fileStamp.isStored(m_database, kImportStampKey)) {
+        qDebug() << "Traktor music collection is unchanged since the last import";
+        return loadPlaylists();
+    }
+    // Invalidate the stored stamp until the import has finished
+    ExternalLibraryFileStamp::clear(m_database, kImportStampKey);
+
     //Invisible root item of Traktor's child model
     TreeItem* root = NULL;
-    //Delete all table entries of Traktor feature
+    // Tracks are updated in place, but playlists are always rebuilt.
+    // All modifications are done in a single transaction without batch
+    // commits that is rolled back if the import is incomplete.
     ScopedTransaction transaction(m_database);
     clearTable("traktor_playlist_tracks");
-    clearTable("traktor_library");
     clearTable("traktor_playlists");
-    transaction.commit();
 
-    transaction.transaction();
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO traktor_library (artist, title, album, year,"
-                  "genre,comment,tracknumber,bpm, bitrate,duration, location,"
-                  "rating,key) VALUES (:artist, :title, :album, :year,:genre,"
-                  ":comment, :tracknumber,:bpm, :bitrate,:duration, :location,"
-                  ":rating,:key)");
+    ExternalTrackTableUpdater trackUpdater(
+            m_database,
+            nullptr,
+            "traktor_library",
+            "location",
+            QStringList{
+                    "artist",
+                    "title",
+                    "album",
+                    "year",
+                    "genre",
+                    "comment",
+                    "tracknumber",
+                    "bpm",
+                    "bitrate",
+                    "duration",
+                    "rating",
+                    "key"});
+    if (!trackUpdater.prepare()) {
+        return NULL;
+    }
 
     //Parse Trakor XML file using SAX (for performance)
     QFile traktor_file(file);
@@ -224,7 +255,7 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
             // Each "ENTRY" tag in <COLLECTION> represents a track
             if (inCollectionTag && xml.name() == "ENTRY") {
                 //parse track
-                parseTrack(xml, query);
+                parseTrack(xml, &trackUpdater);
                 ++nAudioFiles; //increment number of files in the music collection
             }
             if (xml.name() == "PLAYLISTS") {
@@ -236,7 +267,7 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
 
                 if (nodetype == "FOLDER" && name == "$ROOT") {
                     //process all playlists
-                    root = parsePlaylists(xml);
+                    root = parsePlaylists(xml, trackUpdater);
                     isRootFolderParsed = true;
                 }
             }
@@ -250,22 +281,75 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
             }
         }
     }
-    if (xml.hasError()) {
-         // do error handling
-         qDebug() << "Cannot process Traktor music collection";
-         if (root)
-             delete root;
-         return NULL;
+    // Tracks that have not been found in a completely parsed file
+    // have been removed from the Traktor collection.
+    const bool isComplete = isRootFolderParsed && !xml.hasError() && !m_cancelImport;
+    if (!isComplete) {
+        if (xml.hasError()) {
+            qDebug() << "Cannot process Traktor music collection"
+                     << "line:" << xml.lineNumber()
+                     << "column:" << xml.columnNumber()
+                     << "error:" << xml.errorString();
+        }
+        if (root) {
+            delete root;
+        }
+        // Keep the results of the last import
+        transaction.rollback();
+        if (m_cancelImport) {
+            return NULL;
+        }
+        return loadPlaylists();
     }
 
     qDebug() << "Found: " << nAudioFiles << " audio files in Traktor";
+    trackUpdater.removeUnvisited();
     //initialize TraktorTableModel
     transaction.commit();
 
+    fileStamp.store(m_database, kImportStampKey);
     return root;
 }
 
-void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
+TreeItem* TraktorFeature::loadPlaylists() {
+    std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
+
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT name FROM traktor_playlists ORDER BY id")) {
+        LOG_FAILED_QUERY(query);
+        return NULL;
+    }
+    // Only playlists are stored in the database. The folders are
+    // restored from the unique paths of the playlists in the order
+    // in which they have been inserted by parsePlaylists().
+    QMap<QString, TreeItem*> folders;
+    while (query.next()) {
+        const QString playlist_path = query.value(0).toString();
+        const QStringList names =
+                playlist_path.split(kPlaylistPathDelimiter, QString::SkipEmptyParts);
+        if (names.isEmpty()) {
+            continue;
+        }
+        TreeItem* parent = rootItem.get();
+        QString current_path;
+        for (int i = 0; i < names.size() - 1; ++i) {
+            current_path += kPlaylistPathDelimiter;
+            current_path += names.at(i);
+            TreeItem* folder = folders.value(current_path);
+            if (!folder) {
+                folder = parent->appendChild(names.at(i), current_path);
+                folders.insert(current_path, folder);
+            }
+            parent = folder;
+        }
+        parent->appendChild(names.last(), playlist_path);
+    }
+    return rootItem.release();
+}
+
+void TraktorFeature::parseTrack(QXmlStreamReader &xml,
+        ExternalTrackTableUpdater* pTrackUpdater) {
     QString title;
     QString artist;
     QString album;
@@ -353,27 +437,21 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
     }
 
     // If we reach the end of ENTRY within the COLLECTION tag
-    // Save parsed track to database
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":genre", genre);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":key", key);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-    if (!success) {
-        qDebug() << "SQL Error in TraktorTableModel.cpp: line"
-                 << __LINE__ << " " << query.lastError();
-        return;
-    }
+    // Save parsed track to database unless it is unchanged
+    pTrackUpdater->upsert(location,
+            QVariantList{
+                    artist,
+                    title,
+                    album,
+                    year,
+                    genre,
+                    comment,
+                    tracknumber,
+                    bpm,
+                    bitrate,
+                    playtime,
+                    rating,
+                    key});
 }
 
 // Purpose: Parsing all the folder and playlists of Traktor
@@ -381,14 +459,15 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
 // A folder can contain folders and playlists. A playlist contains entries but no folders.
 // In other words, Traktor uses a tree structure to organize music.
 // Inner nodes represent folders while leaves are playlists.
-TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
+TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml,
+        const ExternalTrackTableUpdater& trackUpdater) {
 
     qDebug() << "Process RootFolder";
     //Each playlist is unique and can be identified by a path in the tree structure.
     QString current_path = "";
     QMap<QString,QString> map;
 
-    QString delimiter = "-->";
+    const QString& delimiter = kPlaylistPathDelimiter;
 
     std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
     TreeItem* parent = rootItem.get();
@@ -429,7 +508,8 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
                     // process all the entries within the playlist 'name' having path 'current_path'
                     parsePlaylistEntries(xml, current_path,
                                          query_insert_to_playlists,
-                                         query_insert_to_playlist_tracks);
+                                         query_insert_to_playlist_tracks,
+                                         trackUpdater);
                 }
             }
         }
@@ -459,7 +539,8 @@ void TraktorFeature::parsePlaylistEntries(
         QXmlStreamReader &xml,
         QString playlist_path,
         QSqlQuery query_insert_into_playlist,
-        QSqlQuery query_insert_into_playlisttracks) {
+        QSqlQuery query_insert_into_playlisttracks,
+        const ExternalTrackTableUpdater& trackUpdater) {
     // In the database, the name of a playlist is specified by the unique path,
     // e.g., /someFolderA/someFolderB/playlistA"
     query_insert_into_playlist.bindValue(":name", playlist_path);
@@ -505,19 +586,7 @@ void TraktorFeature::parsePlaylistEntries(
                     #endif
 
                     //insert to database
-                    int track_id = -1;
-                    QSqlQuery finder_query(m_database);
-                    finder_query.prepare("select id from traktor_library where location=:path");
-                    finder_query.bindValue(":path", key);
-
-                    if (!finder_query.exec()) {
-                        LOG_FAILED_QUERY(finder_query) << "Could not get track id:" << key;
-                        continue;
-                    }
-
-                    if (finder_query.next()) {
-                        track_id = finder_query.value(finder_query.record().indexOf("id")).toInt();
-                    }
+                    int track_id = trackUpdater.lookupId(key);
 
                     query_insert_into_playlisttracks.bindValue(":playlist_id", playlist_id);
                     query_insert_into_playlisttracks.bindValue(":track_id", track_id);
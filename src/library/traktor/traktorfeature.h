@@ -16,6 +16,8 @@
 #include "library/baseexternalplaylistmodel.h"
 #include "library/treeitemmodel.h"
 
+class ExternalTrackTableUpdater;
+
 class TraktorTrackModel : public BaseExternalTrackModel {
   public:
     TraktorTrackModel(QObject* parent,
@@ -53,13 +55,16 @@ class TraktorFeature : public BaseExternalLibraryFeature {
   private:
     BaseSqlTableModel* getPlaylistModelForPlaylist(QString playlist) override;
     TreeItem* importLibrary(QString file);
+    // Constructs the childmodel from the playlists imported previously
+    TreeItem* loadPlaylists();
     // parses a track in the music collection
-    void parseTrack(QXmlStreamReader &xml, QSqlQuery &query);
+    void parseTrack(QXmlStreamReader &xml, ExternalTrackTableUpdater* pTrackUpdater);
     // Iterates over all playliost and folders and constructs the childmodel
-    TreeItem* parsePlaylists(QXmlStreamReader &xml);
+    TreeItem* parsePlaylists(QXmlStreamReader &xml, const ExternalTrackTableUpdater& trackUpdater);
     // processes a particular playlist
     void parsePlaylistEntries(QXmlStreamReader &xml, QString playlist_path,
-    QSqlQuery query_insert_into_playlist, QSqlQuery query_insert_into_playlisttracks);
+    QSqlQuery query_insert_into_playlist, QSqlQuery query_insert_into_playlisttracks,
+    const ExternalTrackTableUpdater& trackUpdater);
     void clearTable(QString table_name);
     static QString getTraktorMusicDatabase();
     // private fields
@@ -70,6 +70,7 @@
 #include "util/math.h"
 #include "util/sandbox.h"
 #include "util/screensaver.h"
+#include "util/startuptrace.h"
 #include "util/statsmanager.h"
 #include "util/time.h"
 #include "util/timer.h"
@@ -226,7 +227,23 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     QString resourcePath = pConfig->getResourcePath();
 
-    FontUtils::initializeFonts(resourcePath); // takes a long time
+    // Steps that do not depend on any other subsystem run on the thread
+    // pool while the main thread sets up the database and the engine. Each
+    // of them is waited for right before its result is needed.
+    mixxx::StartupTrace startupTrace;
+    const QFuture<void> fontsLoaded = startupTrace.run("fonts", [resourcePath] {
+        // QFontDatabase is thread-safe
+        FontUtils::initializeFonts(resourcePath); // takes a long time
+    });
+#ifdef __LILV__
+    LilvWorld* pLV2World = nullptr;
+    const QFuture<void> lv2WorldLoaded = startupTrace.run("LV2 bundles", [&pLV2World] {
+        pLV2World = LV2Backend::loadWorld();
+    });
+#endif
+    // Probing the sound devices is independent of the engine, only opening
+    // them has to wait until all channels have been registered.
+    SoundManager::initializePortAudioInBackground();
 
     launchProgress(2);
 
@@ -240,7 +257,9 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     m_pChannelHandleFactory = new ChannelHandleFactory();
 
-    m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
+    const MixxxDb mixxxDb(pConfig);
+    m_pDbConnectionPool = mixxxDb.connectionPool();
+    m_pReadOnlyDbConnectionPool = mixxxDb.readOnlyConnectionPool();
     if (!m_pDbConnectionPool) {
         // TODO(XXX) something a little more elegant
         exit(-1);
@@ -251,6 +270,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
         // TODO(XXX) something a little more elegant
         exit(-1);
     }
+    startupTrace.finishStep("database");
 
     // Create the Effects subsystem.
     m_pEffectsManager = new EffectsManager(this, pConfig, m_pChannelHandleFactory);
@@ -263,8 +283,10 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // effect backends to refer to controls that are produced by the engine.
     BuiltInBackend* pBuiltInBackend = new BuiltInBackend(m_pEffectsManager);
     m_pEffectsManager->addEffectsBackend(pBuiltInBackend);
+    startupTrace.finishStep("engine");
 #ifdef __LILV__
-    LV2Backend* pLV2Backend = new LV2Backend(m_pEffectsManager);
+    startupTrace.wait("LV2 bundles", lv2WorldLoaded);
+    LV2Backend* pLV2Backend = new LV2Backend(m_pEffectsManager, pLV2World);
     m_pEffectsManager->addEffectsBackend(pLV2Backend);
 #else
     LV2Backend* pLV2Backend = nullptr;
@@ -272,6 +294,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     // Sets up the EffectChains and EffectRacks (long)
     m_pEffectsManager->setup();
+    startupTrace.finishStep("effects");
 
     launchProgress(8);
 
@@ -279,6 +302,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
     m_pSoundManager = new SoundManager(pConfig, m_pEngine);
     m_pEngine->registerNonEngineChannelSoundIO(m_pSoundManager);
+    startupTrace.finishStep("sound device query");
 
     m_pRecordingManager = new RecordingManager(pConfig, m_pEngine);
 
@@ -334,6 +358,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     m_pPlayerManager->addSampler();
     m_pPlayerManager->addSampler();
     m_pPlayerManager->addPreviewDeck();
+    startupTrace.finishStep("players");
 
     launchProgress(30);
 
@@ -358,7 +383,8 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     m_pTrackCollectionManager = new TrackCollectionManager(
             this,
             pConfig,
-            m_pDbConnectionPool);
+            m_pDbConnectionPool,
+            m_pReadOnlyDbConnectionPool);
 
     launchProgress(35);
 
@@ -375,6 +401,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // been created. Otherwise Mixxx might hang when accessing
     // the uninitialized singleton instance!
     m_pPlayerManager->bindToLibrary(m_pLibrary);
+    startupTrace.finishStep("library");
 
     launchProgress(40);
 
@@ -443,6 +470,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     WaveformWidgetFactory::createInstance(); // takes a long time
     WaveformWidgetFactory::instance()->setConfig(pConfig);
     WaveformWidgetFactory::instance()->startVSync(m_pGuiTick, m_pVisualsManager);
+    startupTrace.finishStep("waveforms");
 
     launchProgress(52);
 
@@ -479,9 +507,13 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // Connect signals to the menubar. Should be done before we go fullscreen
     // and emit newSkinLoaded.
     connectMenuBar();
+    startupTrace.finishStep("preferences");
 
     launchProgress(63);
 
+    // Skins refer to the bundled fonts
+    startupTrace.wait("fonts", fontsLoaded);
+
     QWidget* oldWidget = m_pWidgetParent;
 
     // Load default styles that can be overridden by skins
@@ -510,6 +542,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
         m_pWidgetParent = oldWidget;
         //TODO (XXX) add dialog to warn user and launch skin choice page
     }
+    startupTrace.finishStep("skin");
 
     // Fake a 100 % progress here.
     // At a later place it will newer shown up, since it is
@@ -536,11 +569,6 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     }
     emit skinLoaded();
 
-
-    // Wait until all other ControlObjects are set up before initializing
-    // controllers
-    m_pControllerManager->setUpDevices();
-
     // Scan the library for new files and directories
     bool rescan = pConfig->getValue<bool>(
             ConfigKey("[Library]","RescanOnStartup"));
@@ -615,6 +643,12 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
         }
         if (continueClicked) break;
    }
+    startupTrace.finishStep("sound devices");
+
+    // Wait until all other ControlObjects are set up before initializing
+    // controllers. The controllers are enumerated and opened on their own
+    // thread, so this does not delay the decks.
+    m_pControllerManager->setUpDevices();
 
     // Load tracks in args.qlMusicFiles (command line arguments) into player
     // 1 and 2:
@@ -643,6 +677,8 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // The launch image widget is automatically disposed, but we still have a
     // pointer to it.
     m_pLaunchImage = nullptr;
+    startupTrace.finishStep("main window");
+    startupTrace.log();
 }
 
 void MixxxMainWindow::finalize() {
@@ -807,6 +843,7 @@ void MixxxMainWindow::finalize() {
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "closing database connection(s)";
     m_pDbConnectionPool->destroyThreadLocalConnection();
     m_pDbConnectionPool.reset(); // should drop the last reference
+    m_pReadOnlyDbConnectionPool.reset();
 
     // HACK: Save config again. We saved it once before doing some dangerous
     // stuff. We only really want to save it here, but the first one was just
@@ -177,6 +177,8 @@ class MixxxMainWindow : public QMainWindow {
 
     // The Mixxx database connection pool
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    // Read-only connections for library queries on worker threads
+    mixxx::DbConnectionPoolPtr m_pReadOnlyDbConnectionPool;
 
     TrackCollectionManager* m_pTrackCollectionManager;
 
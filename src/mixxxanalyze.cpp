@@ -0,0 +1,255 @@
+// mixxx-analyze: Analyzes all tracks of the library without the GUI,
+// e.g. for pre-analyzing a library on a build server or for reproducible
+// benchmarks of analyzer changes.
+
+#include <QDir>
+#include <QThread>
+#include <QtDebug>
+
+#include <cstdio>
+
+#include "analyzer/trackanalysisscheduler.h"
+#include "database/mixxxdb.h"
+#include "database/schemamanager.h"
+#include "library/dao/trackdao.h"
+#include "library/trackcollection.h"
+#include "library/trackcollectionmanager.h"
+#include "mixxxapplication.h"
+#include "preferences/settingsmanager.h"
+#include "sources/soundsourceproxy.h"
+#include "util/cmdlineargs.h"
+#include "util/console.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/logging.h"
+#include "util/performancetimer.h"
+#include "util/sandbox.h"
+#include "util/version.h"
+
+namespace {
+
+// The number of analyzed tracks that are saved within a single
+// database transaction
+constexpr int kDefaultBatchSize = 100;
+
+void printUsage() {
+    fputs("mixxx-analyze - Analyzes all tracks in the Mixxx library\n\n\
+--settingsPath PATH     Top-level directory of the settings and the\n\
+                        library database. Default is:\n", stdout);
+    fprintf(stdout, "\
+                        %s\n", CmdlineArgs::Instance().getSettingsPath().toLocal8Bit().constData());
+    fputs("\
+\n\
+--threads N             The number of analyzer threads. Default is the\n\
+                        number of CPU cores.\n\
+\n\
+--batchSize N           The number of tracks that are saved in a single\n\
+                        database transaction.\n\
+\n\
+--logLevel LEVEL        Sets the verbosity of command line logging, see\n\
+                        mixxx --help\n\
+\n\
+-h, --help              Display this help message and exit\n", stdout);
+}
+
+// Options that are only known by this tool, the common options are
+// parsed by CmdlineArgs
+bool parseIntOption(int argc, char** argv, const char* name, int* pValue) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (QString(argv[i]) == QString(name)) {
+            bool ok = false;
+            const int value = QString(argv[i + 1]).toInt(&ok);
+            if (!ok || value <= 0) {
+                fprintf(stderr, "Invalid value for %s: %s\n", name, argv[i + 1]);
+                return false;
+            }
+            *pValue = value;
+        }
+    }
+    return true;
+}
+
+bool checkDatabaseSchema(const QSqlDatabase& database) {
+    if (!database.isOpen()) {
+        fputs("Failed to open the library database\n", stderr);
+        return false;
+    }
+    // Upgrading the schema might require user interaction
+    const SchemaManager schemaManager(database);
+    if (schemaManager.getCurrentVersion() < MixxxDb::kRequiredSchemaVersion) {
+        fputs("The library database is outdated, start Mixxx once to upgrade it\n", stderr);
+        return false;
+    }
+    if (!schemaManager.isBackwardsCompatibleWithVersion(MixxxDb::kRequiredSchemaVersion)) {
+        fputs("The library database has been created by a newer version of Mixxx\n", stderr);
+        return false;
+    }
+    return true;
+}
+
+void printTiming(const QString& name, const AnalyzerStatistics::Timing& timing) {
+    fprintf(stdout, "  %-12s %10.1f s audio %10.1f s cpu %8.1fx real-time\n",
+            name.toLocal8Bit().constData(),
+            timing.audioSeconds,
+            timing.processingDuration.toDoubleSeconds(),
+            timing.realTimeFactor());
+}
+
+void printStatistics(
+        const AnalyzerStatistics& statistics,
+        mixxx::Duration elapsed,
+        int numThreads) {
+    const int finishedTrackCount =
+            statistics.analyzedTrackCount +
+            statistics.skippedTrackCount +
+            statistics.failedTrackCount;
+    const double elapsedMinutes = elapsed.toDoubleSeconds() / 60;
+    fprintf(stdout, "\nFinished %d tracks in %s with %d threads\n",
+            finishedTrackCount,
+            mixxx::Duration::formatTime(elapsed.toDoubleSeconds())
+                    .toLocal8Bit()
+                    .constData(),
+            numThreads);
+    fprintf(stdout, "  analyzed %d, skipped %d, failed %d\n",
+            statistics.analyzedTrackCount,
+            statistics.skippedTrackCount,
+            statistics.failedTrackCount);
+    if (elapsedMinutes > 0) {
+        fprintf(stdout, "  %.1f tracks/min, %.1f analyzed tracks/min, %.1fx real-time\n",
+                finishedTrackCount / elapsedMinutes,
+                statistics.analyzedTrackCount / elapsedMinutes,
+                statistics.decoding.audioSeconds / elapsed.toDoubleSeconds());
+    }
+    // The real-time factors are measured per thread, i.e. per core
+    fputs("\nPer thread:\n", stdout);
+    printTiming("Decoding", statistics.decoding);
+    for (auto i = statistics.analyzers.constBegin(); i != statistics.analyzers.constEnd(); ++i) {
+        printTiming(i.key(), i.value());
+    }
+}
+
+int runAnalysis(
+        const UserSettingsPointer& pConfig,
+        int numThreads,
+        int batchSize) {
+    const MixxxDb mixxxDb(pConfig);
+    const mixxx::DbConnectionPoolPtr pDbConnectionPool = mixxxDb.connectionPool();
+    if (!pDbConnectionPool) {
+        fputs("Failed to open the library database\n", stderr);
+        return 1;
+    }
+    // The connection for the main thread
+    const mixxx::DbConnectionPooler dbConnectionPooler(pDbConnectionPool);
+    if (!checkDatabaseSchema(mixxx::DbConnectionPooled(pDbConnectionPool))) {
+        return 1;
+    }
+
+    TrackCollectionManager trackCollectionManager(
+            nullptr,
+            pConfig,
+            pDbConnectionPool,
+            mixxxDb.readOnlyConnectionPool());
+    TrackCollection* pTrackCollection = trackCollectionManager.internalCollection();
+
+    // The analyzers decide which tracks are unanalyzed or outdated
+    const QList<TrackId> trackIds = pTrackCollection->getTrackDAO().getAllTrackIds();
+    if (trackIds.isEmpty()) {
+        fputs("The library is empty\n", stdout);
+        return 0;
+    }
+    fprintf(stdout, "Analyzing %d tracks with %d threads\n", trackIds.size(), numThreads);
+
+    auto pScheduler = TrackAnalysisScheduler::createInstance(
+            pTrackCollection,
+            pDbConnectionPool,
+            numThreads,
+            pConfig,
+            AnalyzerModeFlags::All);
+
+    // Finished tracks are kept until they are saved in a batch, otherwise
+    // each track would be saved separately when released
+    QList<TrackPointer> finishedTracks;
+    finishedTracks.reserve(batchSize);
+    const auto saveFinishedTracks = [&trackCollectionManager, &finishedTracks] {
+        trackCollectionManager.saveTracks(finishedTracks);
+        finishedTracks.clear();
+    };
+    QObject::connect(pScheduler.get(),
+            &TrackAnalysisScheduler::trackFinished,
+            [&finishedTracks, &saveFinishedTracks, batchSize](TrackPointer track) {
+                finishedTracks.append(std::move(track));
+                if (finishedTracks.size() >= batchSize) {
+                    saveFinishedTracks();
+                }
+            });
+    QObject::connect(pScheduler.get(),
+            &TrackAnalysisScheduler::progress,
+            [](AnalyzerProgress, int currentTrackNumber, int totalTracksCount) {
+                fprintf(stderr, "\rTrack %d of %d", currentTrackNumber, totalTracksCount);
+                fflush(stderr);
+            });
+    QObject::connect(pScheduler.get(),
+            &TrackAnalysisScheduler::finished,
+            QCoreApplication::instance(),
+            &QCoreApplication::quit);
+
+    PerformanceTimer timer;
+    timer.start();
+    pScheduler->scheduleTracksById(trackIds);
+    pScheduler->resume();
+    QCoreApplication::exec();
+    const mixxx::Duration elapsed = timer.elapsed();
+    saveFinishedTracks();
+
+    printStatistics(pScheduler->statistics(), elapsed, numThreads);
+    return 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Console console;
+
+    // The analysis doesn't need a display
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QCoreApplication::setOrganizationDomain("mixxx.org");
+    QCoreApplication::setApplicationName(Version::applicationName());
+    QCoreApplication::setApplicationVersion(Version::version());
+
+    CmdlineArgs& args = CmdlineArgs::Instance();
+    if (!args.Parse(argc, argv)) {
+        printUsage();
+        return 0;
+    }
+    int numThreads = QThread::idealThreadCount();
+    int batchSize = kDefaultBatchSize;
+    if (!parseIntOption(argc, argv, "--threads", &numThreads) ||
+            !parseIntOption(argc, argv, "--batchSize", &batchSize)) {
+        printUsage();
+        return 1;
+    }
+
+    QThread::currentThread()->setObjectName("Main");
+
+    // Only log to the console, the log file belongs to Mixxx
+    mixxx::Logging::setLogLevel(args.getLogLevel());
+
+    MixxxApplication app(argc, argv);
+
+    SoundSourceProxy::registerSoundSourceProviders();
+
+    int result;
+    {
+        SettingsManager settingsManager(nullptr, args.getSettingsPath());
+        const UserSettingsPointer pConfig = settingsManager.settings();
+        Sandbox::initialize(QDir(pConfig->getSettingsPath()).filePath("sandbox.cfg"));
+
+        result = runAnalysis(pConfig, numThreads, batchSize);
+
+        Sandbox::shutdown();
+    }
+    return result;
+}
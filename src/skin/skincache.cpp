@@ -0,0 +1,232 @@
+#include "skin/skincache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+
+#include "util/cmdlineargs.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SkinCache");
+
+// "MXSK", followed by the version of the binary form
+const quint32 kMagic = 0x4d58534b;
+const quint32 kVersion = 1;
+
+// Each node is written as its type followed by its contents. The children
+// of a node are terminated by kEndOfChildren.
+const quint8 kEndOfChildren = 0;
+const quint8 kElement = 1;
+const quint8 kText = 2;
+const quint8 kCDATASection = 3;
+
+QString s_cacheDirPath;
+
+// Parsed documents by the hash of the file contents. Only accessed from
+// the main thread like everything else in the skin parser.
+QHash<QByteArray, QDomDocument> s_documents;
+
+void writeChildren(QDataStream& stream, const QDomNode& parent) {
+    for (QDomNode child = parent.firstChild(); !child.isNull();
+            child = child.nextSibling()) {
+        if (child.isElement()) {
+            const QDomElement element = child.toElement();
+            stream << kElement << element.tagName();
+            const QDomNamedNodeMap attributes = element.attributes();
+            stream << static_cast<quint32>(attributes.count());
+            for (int i = 0; i < attributes.count(); ++i) {
+                const QDomAttr attribute = attributes.item(i).toAttr();
+                stream << attribute.name() << attribute.value();
+            }
+            writeChildren(stream, element);
+        } else if (child.isCDATASection()) {
+            stream << kCDATASection << child.nodeValue();
+        } else if (child.isText()) {
+            stream << kText << child.nodeValue();
+        }
+        // Comments and processing instructions are ignored by the parsers
+    }
+    stream << kEndOfChildren;
+}
+
+bool readChildren(QDataStream& stream, QDomDocument& document, QDomNode parent) {
+    while (stream.status() == QDataStream::Ok) {
+        quint8 type = kEndOfChildren;
+        stream >> type;
+        switch (type) {
+        case kEndOfChildren:
+            return stream.status() == QDataStream::Ok;
+        case kElement: {
+            QString tagName;
+            quint32 attributeCount;
+            stream >> tagName >> attributeCount;
+            QDomElement element = document.createElement(tagName);
+            for (quint32 i = 0; i < attributeCount; ++i) {
+                QString name;
+                QString value;
+                stream >> name >> value;
+                element.setAttribute(name, value);
+            }
+            parent.appendChild(element);
+            if (!readChildren(stream, document, element)) {
+                return false;
+            }
+            break;
+        }
+        case kText: {
+            QString value;
+            stream >> value;
+            parent.appendChild(document.createTextNode(value));
+            break;
+        }
+        case kCDATASection: {
+            QString value;
+            stream >> value;
+            parent.appendChild(document.createCDATASection(value));
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+QDomDocument parseXml(const QByteArray& contents, const QString& filePath) {
+    QDomDocument document;
+    QString errorMessage;
+    int errorLine;
+    int errorColumn;
+    if (!document.setContent(contents, &errorMessage, &errorLine, &errorColumn)) {
+        kLogger.warning()
+                << "Failed to parse" << filePath
+                << "line:" << errorLine
+                << "column:" << errorColumn
+                << "message:" << errorMessage;
+        return QDomDocument();
+    }
+    return document;
+}
+
+} // anonymous namespace
+
+// static
+void SkinCache::setCacheDirectory(const QString& dirPath) {
+    s_cacheDirPath = dirPath;
+    if (!s_cacheDirPath.isEmpty() && !QDir().mkpath(s_cacheDirPath)) {
+        kLogger.warning() << "Failed to create" << s_cacheDirPath;
+        s_cacheDirPath.clear();
+    }
+}
+
+// static
+QDomElement SkinCache::loadDocument(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        kLogger.warning() << "Failed to open" << filePath;
+        return QDomElement();
+    }
+    const QByteArray contents = file.readAll();
+    file.close();
+
+    const QByteArray hash = QCryptographicHash::hash(
+            contents, QCryptographicHash::Sha1).toHex();
+    auto it = s_documents.constFind(hash);
+    if (it != s_documents.constEnd()) {
+        return it.value().documentElement();
+    }
+
+    const bool useBinaryCache = !s_cacheDirPath.isEmpty() &&
+            !CmdlineArgs::Instance().getDeveloper();
+    const QString cacheFilePath = useBinaryCache
+            ? QDir(s_cacheDirPath).filePath(QString::fromLatin1(hash) + ".bin")
+            : QString();
+
+    QDomDocument document;
+    if (useBinaryCache) {
+        QFile cacheFile(cacheFilePath);
+        if (cacheFile.open(QIODevice::ReadOnly)) {
+            document = deserialize(cacheFile.readAll());
+        }
+    }
+    if (document.isNull()) {
+        document = parseXml(contents, filePath);
+        if (document.isNull()) {
+            return QDomElement();
+        }
+        if (useBinaryCache) {
+            QSaveFile cacheFile(cacheFilePath);
+            if (!cacheFile.open(QIODevice::WriteOnly) ||
+                    cacheFile.write(serialize(document)) < 0 ||
+                    !cacheFile.commit()) {
+                kLogger.warning() << "Failed to write" << cacheFilePath;
+            }
+        }
+    }
+
+    s_documents.insert(hash, document);
+    return document.documentElement();
+}
+
+// static
+void SkinCache::clear() {
+    s_documents.clear();
+}
+
+// static
+void SkinCache::pruneCacheDirectory() {
+    // The documents loaded in developer mode bypass the binary cache
+    if (s_cacheDirPath.isEmpty() || CmdlineArgs::Instance().getDeveloper()) {
+        return;
+    }
+    const QDir cacheDir(s_cacheDirPath);
+    const QStringList fileNames = cacheDir.entryList(
+            QStringList{QStringLiteral("*.bin")}, QDir::Files);
+    for (const auto& fileName : fileNames) {
+        const QByteArray hash = QFileInfo(fileName).completeBaseName().toLatin1();
+        if (s_documents.contains(hash)) {
+            continue;
+        }
+        if (!QFile::remove(cacheDir.filePath(fileName))) {
+            kLogger.warning() << "Failed to remove" << cacheDir.filePath(fileName);
+        }
+    }
+}
+
+// static
+QByteArray SkinCache::serialize(const QDomDocument& document) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << kMagic << kVersion;
+    writeChildren(stream, document);
+    return data;
+}
+
+// static
+QDomDocument SkinCache::deserialize(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic;
+    quint32 version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok ||
+            magic != kMagic ||
+            version != kVersion) {
+        return QDomDocument();
+    }
+    // Unlike a default constructed document this one is not null, so
+    // nodes can be appended to it
+    QDomDocument document{QDomDocumentType()};
+    if (!readChildren(stream, document, document) ||
+            document.documentElement().isNull()) {
+        return QDomDocument();
+    }
+    return document;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDomDocument>
+#include <QDomElement>
+#include <QString>
+
+// Parsed skin XML documents.
+//
+// The same skin.xml is opened for the launch image, the manifest and the
+// skin itself, and all files are opened again when switching skins. Each
+// file is only parsed once per process, keyed by the hash of its contents,
+// so edited files are picked up.
+//
+// If a cache directory is set, the parsed tree is also stored there in a
+// compact binary form. The next start reads it without tokenizing the XML
+// again. The binary form does not contain line numbers, so it is bypassed
+// in developer mode where skin warnings need them.
+class SkinCache {
+  public:
+    // Sets the directory for the binary cache. An empty path disables it.
+    static void setCacheDirectory(const QString& dirPath);
+
+    // Returns the document element of the XML file or a null element if
+    // the file could not be read or parsed.
+    static QDomElement loadDocument(const QString& filePath);
+
+    // Drops all documents that have been loaded in this process
+    static void clear();
+
+    // Removes the binary form of all documents that have not been loaded
+    // in this process from the cache directory, e.g. of other skins or of
+    // files that have been edited since.
+    static void pruneCacheDirectory();
+
+    // The binary form of a parsed document
+    static QByteArray serialize(const QDomDocument& document);
+    static QDomDocument deserialize(const QByteArray& data);
+
+  private:
+    SkinCache() = delete;
+};
@@ -17,11 +17,14 @@
 #include "mixer/playermanager.h"
 #include "util/debug.h"
 #include "skin/launchimage.h"
+#include "skin/skincache.h"
 #include "util/timer.h"
 #include "recording/recordingmanager.h"
 
 SkinLoader::SkinLoader(UserSettingsPointer pConfig) :
         m_pConfig(pConfig) {
+    SkinCache::setCacheDirectory(
+            QDir(m_pConfig->getSettingsPath()).filePath("skincache"));
 }
 
 SkinLoader::~SkinLoader() {
@@ -124,7 +127,12 @@ QWidget* SkinLoader::loadConfiguredSkin(QWidget* pParent,
     LegacySkinParser legacy(m_pConfig, pKeyboard, pPlayerManager,
                             pControllerManager, pLibrary, pVCMan,
                             pEffectsManager, pRecordingManager);
-    return legacy.parseSkin(skinPath, pParent);
+    QWidget* pSkinWidget = legacy.parseSkin(skinPath, pParent);
+    if (pSkinWidget) {
+        // Only keep the cached files of the skins used since the start
+        SkinCache::pruneCacheDirectory();
+    }
+    return pSkinWidget;
 }
 
 LaunchImage* SkinLoader::loadLaunchImage(QWidget* pParent) {
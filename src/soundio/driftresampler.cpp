@@ -0,0 +1,220 @@
+#include "soundio/driftresampler.h"
+
+#include <cstring>
+
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+// Length of the interpolation kernel. The output frame at the fractional
+// position p is interpolated from the input frames
+// [floor(p) - kHalfTaps + 1, floor(p) + kHalfTaps].
+const int kTaps = 8;
+const int kHalfTaps = kTaps / 2;
+
+// Number of precomputed kernel phases. The coefficients for positions in
+// between are interpolated linearly.
+const int kPhases = 128;
+
+// Bandwidth of the DLL. The drift between two crystals changes only
+// slowly with temperature, so a low bandwidth is sufficient and filters
+// the jitter of the callbacks.
+const double kBandwidthHz = 0.05;
+
+// Limits the ratio to +/-0.5% (less than 9 cents). This is far more than
+// the tolerance of any crystal, but allows to recover quickly from an
+// under- or overflow.
+const double kMaxRatioDeviation = 0.005;
+
+// Blackman windowed sinc, sampled at kPhases + 1 positions in [0, 1].
+// There is no need for an anti-aliasing cut off, because the ratio
+// is always close to 1.
+class InterpolationKernel {
+  public:
+    InterpolationKernel() {
+        for (int phase = 0; phase <= kPhases; ++phase) {
+            const double fraction = static_cast<double>(phase) / kPhases;
+            double coefficients[kTaps];
+            double sum = 0;
+            for (int tap = 0; tap < kTaps; ++tap) {
+                const double x = tap - (kHalfTaps - 1) - fraction;
+                const double sinc = x == 0 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+                const double window = 0.42
+                        + 0.5 * cos(M_PI * x / kHalfTaps)
+                        + 0.08 * cos(2 * M_PI * x / kHalfTaps);
+                coefficients[tap] = sinc * window;
+                sum += coefficients[tap];
+            }
+            // Normalize to unity gain at DC
+            for (int tap = 0; tap < kTaps; ++tap) {
+                m_coefficients[phase][tap] =
+                        static_cast<CSAMPLE>(coefficients[tap] / sum);
+            }
+        }
+    }
+
+    const CSAMPLE* coefficients(int phase) const {
+        return m_coefficients[phase];
+    }
+
+  private:
+    CSAMPLE m_coefficients[kPhases + 1][kTaps];
+};
+
+const InterpolationKernel& interpolationKernel() {
+    static const InterpolationKernel kernel;
+    return kernel;
+}
+
+} // anonymous namespace
+
+DriftResampler::DriftResampler(
+        int channelCount,
+        SINT framesPerBuffer,
+        double sampleRate,
+        double targetFillFrames)
+        : m_channelCount(channelCount),
+          m_framesPerBuffer(framesPerBuffer),
+          m_targetFillFrames(targetFillFrames),
+          m_fillFrames(targetFillFrames),
+          m_filteredError(0),
+          m_integratedError(0),
+          m_ratio(1),
+          // The frames for one buffer at the maximum ratio plus the kernel
+          m_buffer((2 * framesPerBuffer + kTaps) * channelCount),
+          m_bufferCapacityFrames(2 * framesPerBuffer + kTaps),
+          m_bufferedFrames(kHalfTaps - 1),
+          m_position(kHalfTaps - 1),
+          m_outputBuffer(2 * framesPerBuffer * channelCount) {
+    // Compute the kernel now and not in the audio callback
+    interpolationKernel();
+
+    // Critically damped second order loop, updated once per buffer
+    const double omega = 2 * M_PI * kBandwidthHz * framesPerBuffer / sampleRate;
+    m_proportionalGain = 1.6 * omega;
+    m_integralGain = omega * omega;
+    m_jitterFilterGain = math_min(1.0, 8 * omega);
+
+    // The history of the first output frame
+    SampleUtil::clear(m_buffer.data(), m_bufferedFrames * m_channelCount);
+}
+
+void DriftResampler::updateFillLevel(double fifoFrames) {
+    m_fillFrames = fifoFrames + (m_bufferedFrames - m_position);
+
+    // The fill level jitters with the scheduling of the callbacks, so it
+    // is low pass filtered before it is fed into the loop.
+    const double error = (m_fillFrames - m_targetFillFrames) / m_framesPerBuffer;
+    m_filteredError += m_jitterFilterGain * (error - m_filteredError);
+
+    // The integrated error converges to the actual clock drift, the
+    // proportional part corrects the fill level.
+    m_integratedError = math_clamp(
+            m_integratedError + m_integralGain * m_filteredError,
+            -kMaxRatioDeviation,
+            kMaxRatioDeviation);
+    m_ratio = 1.0 + math_clamp(
+            m_proportionalGain * m_filteredError + m_integratedError,
+            -kMaxRatioDeviation,
+            kMaxRatioDeviation);
+}
+
+bool DriftResampler::readFrom(
+        FIFO<CSAMPLE>* pFifo, CSAMPLE* pOutput, SINT outputFrames) {
+    const SINT framesToRead = math_min(
+            math_min(framesRequired(outputFrames),
+                    m_bufferCapacityFrames - m_bufferedFrames),
+            static_cast<SINT>(pFifo->readAvailable() / m_channelCount));
+    if (framesToRead > 0) {
+        pFifo->read(m_buffer.data(m_bufferedFrames * m_channelCount),
+                framesToRead * m_channelCount);
+        m_bufferedFrames += framesToRead;
+    }
+
+    const SINT framesProduced = process(pOutput, outputFrames);
+    if (framesProduced < outputFrames) {
+        SampleUtil::clear(&pOutput[framesProduced * m_channelCount],
+                (outputFrames - framesProduced) * m_channelCount);
+        return false;
+    }
+    return true;
+}
+
+bool DriftResampler::writeTo(
+        FIFO<CSAMPLE>* pFifo, const CSAMPLE* pInput, SINT inputFrames) {
+    const SINT framesToWrite = math_min(inputFrames,
+            m_bufferCapacityFrames - m_bufferedFrames);
+    SampleUtil::copy(m_buffer.data(m_bufferedFrames * m_channelCount),
+            pInput, framesToWrite * m_channelCount);
+    m_bufferedFrames += framesToWrite;
+
+    const SINT framesProduced = process(m_outputBuffer.data(),
+            m_outputBuffer.size() / m_channelCount);
+    const int samplesProduced = framesProduced * m_channelCount;
+    const int samplesWritten = pFifo->write(m_outputBuffer.data(), samplesProduced);
+    return framesToWrite == inputFrames && samplesWritten == samplesProduced;
+}
+
+SINT DriftResampler::framesRequired(SINT outputFrames) const {
+    if (outputFrames <= 0) {
+        return 0;
+    }
+    // Uses the same arithmetic as process() to get the identical position
+    const double lastPosition = m_position + (outputFrames - 1) * m_ratio;
+    const SINT requiredFrames = static_cast<SINT>(lastPosition) + kHalfTaps + 1;
+    return math_max(static_cast<SINT>(0), requiredFrames - m_bufferedFrames);
+}
+
+SINT DriftResampler::process(CSAMPLE* pOutput, SINT maxOutputFrames) {
+    SINT framesProduced = 0;
+    for (; framesProduced < maxOutputFrames; ++framesProduced) {
+        const double position = m_position + framesProduced * m_ratio;
+        const SINT frame = static_cast<SINT>(position);
+        if (frame + kHalfTaps >= m_bufferedFrames) {
+            break;
+        }
+        interpolate(&pOutput[framesProduced * m_channelCount],
+                frame - kHalfTaps + 1,
+                position - frame);
+    }
+    m_position += framesProduced * m_ratio;
+
+    // Move the history for the next output frame to the front
+    const SINT framesConsumed = static_cast<SINT>(m_position) - kHalfTaps + 1;
+    if (framesConsumed > 0) {
+        m_bufferedFrames -= framesConsumed;
+        m_position -= framesConsumed;
+        std::memmove(m_buffer.data(),
+                m_buffer.data(framesConsumed * m_channelCount),
+                m_bufferedFrames * m_channelCount * sizeof(CSAMPLE));
+    }
+    return framesProduced;
+}
+
+void DriftResampler::interpolate(
+        CSAMPLE* pOutput, SINT firstFrame, double fraction) const {
+    const InterpolationKernel& kernel = interpolationKernel();
+    const double phase = fraction * kPhases;
+    const int lowerPhase = static_cast<int>(phase);
+    const CSAMPLE weight = static_cast<CSAMPLE>(phase - lowerPhase);
+    const CSAMPLE* pLower = kernel.coefficients(lowerPhase);
+    const CSAMPLE* pUpper = kernel.coefficients(math_min(lowerPhase + 1, kPhases));
+
+    CSAMPLE coefficients[kTaps];
+    for (int tap = 0; tap < kTaps; ++tap) {
+        coefficients[tap] = pLower[tap] + weight * (pUpper[tap] - pLower[tap]);
+    }
+
+    // The channels of a frame are adjacent, so the inner loop
+    // is vectorized for any channel count.
+    const CSAMPLE* pInput = m_buffer.data(firstFrame * m_channelCount);
+    SampleUtil::clear(pOutput, m_channelCount);
+    for (int tap = 0; tap < kTaps; ++tap) {
+        const CSAMPLE coefficient = coefficients[tap];
+        const CSAMPLE* pFrame = &pInput[tap * m_channelCount];
+        for (int channel = 0; channel < m_channelCount; ++channel) {
+            pOutput[channel] += pFrame[channel] * coefficient;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "util/fifo.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+// Compensates the clock drift between a sound device and the clock
+// reference device by resampling the stream that is exchanged with the
+// engine through a FIFO.
+//
+// The resampling ratio is controlled by a delay-locked loop (DLL) that
+// keeps the fill level of the FIFO at a target value. The ratio only
+// deviates from 1 by the drift between the two crystals, i.e. a few
+// hundred ppm. Compared to skipping or duplicating whole frames the
+// stream stays continuous and does not click.
+//
+// All buffers are allocated on construction, so readFrom() and writeTo()
+// are safe to be called from the audio callback.
+class DriftResampler {
+  public:
+    DriftResampler(
+            int channelCount,
+            SINT framesPerBuffer,
+            double sampleRate,
+            double targetFillFrames);
+
+    // The number of input frames that are consumed per output frame.
+    double ratio() const {
+        return m_ratio;
+    }
+
+    // The fill level at the last update including the frames that are
+    // held inside the resampler. Divided by the sample rate this is the
+    // additional latency caused by the drift compensation.
+    double fillFrames() const {
+        return m_fillFrames;
+    }
+
+    // Adjusts the ratio for keeping the fill level at the target. Needs to
+    // be called once per buffer with the number of frames in the FIFO.
+    void updateFillLevel(double fifoFrames);
+
+    // Reads the required number of frames from pFifo and writes
+    // outputFrames resampled frames to pOutput. Returns false if the FIFO
+    // ran empty, the missing frames are cleared.
+    bool readFrom(FIFO<CSAMPLE>* pFifo, CSAMPLE* pOutput, SINT outputFrames);
+
+    // Resamples inputFrames frames from pInput and writes the result to
+    // pFifo. Returns false if the FIFO overflowed and frames were dropped.
+    bool writeTo(FIFO<CSAMPLE>* pFifo, const CSAMPLE* pInput, SINT inputFrames);
+
+  private:
+    // The number of frames that need to be buffered for producing
+    // outputFrames frames with the current ratio.
+    SINT framesRequired(SINT outputFrames) const;
+    // Produces up to maxOutputFrames frames from the buffered input
+    // and drops the input frames that are no longer needed.
+    SINT process(CSAMPLE* pOutput, SINT maxOutputFrames);
+    void interpolate(CSAMPLE* pOutput, SINT firstFrame, double fraction) const;
+
+    const int m_channelCount;
+    const SINT m_framesPerBuffer;
+    const double m_targetFillFrames;
+
+    // DLL coefficients
+    double m_jitterFilterGain;
+    double m_proportionalGain;
+    double m_integralGain;
+
+    // DLL state
+    double m_fillFrames;
+    double m_filteredError;
+    double m_integratedError;
+    double m_ratio;
+
+    // Interleaved input frames, m_position is the fractional position
+    // of the next output frame within it.
+    mixxx::SampleBuffer m_buffer;
+    const SINT m_bufferCapacityFrames;
+    SINT m_bufferedFrames;
+    double m_position;
+    mixxx::SampleBuffer m_outputBuffer;
+};
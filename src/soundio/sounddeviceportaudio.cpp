@@ -38,6 +38,7 @@
 #include "util/timer.h"
 #include "util/trace.h"
 #include "util/math.h"
+#include "util/time.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 #include "waveform/visualplayposition.h"
 
@@ -50,6 +51,20 @@ const int kDriftReserve = 1;
 // Buffer for drift correction 1 full, 1 for r/w, 1 empty
 const int kFifoSize = 2 * kDriftReserve + 1;
 
+// Fill levels in chunks the drift correction aims for, estimated in between
+// the callbacks of both devices. This leaves half a chunk for jitter at
+// either end of the FIFO.
+const double kOutputFifoTarget = kDriftReserve + 1.5;
+const double kInputFifoTarget = kDriftReserve + 0.5;
+
+// The number of frames the clock reference device has processed since it
+// has accessed the FIFOs, assuming it runs at the nominal sample rate.
+double framesSince(qint64 accessNanos, qint64 nowNanos,
+        double sampleRate, SINT framesPerBuffer) {
+    return math_clamp((nowNanos - accessNanos) * sampleRate / 1e9,
+            0.0, static_cast<double>(framesPerBuffer));
+}
+
 // We warn only at invalid timing 3, since the first two
 // callbacks can be always wrong due to a setup/open jitter
 const int m_invalidTimeInfoWarningCount = 3;
@@ -102,6 +117,8 @@ SoundDevicePortAudio::SoundDevicePortAudio(UserSettingsPointer config,
           m_inputFifo(NULL),
           m_outputDrift(false),
           m_inputDrift(false),
+          m_outputFifoWriteNanos(0),
+          m_inputFifoReadNanos(0),
           m_bSetThreadPriority(false),
           m_framesSinceAudioLatencyUsageUpdate(0),
           m_syncBuffers(2),
@@ -291,6 +308,14 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_outputFifo->releaseWriteRegions(writeCount);
+            m_pOutputResampler = std::make_unique<DriftResampler>(
+                    m_outputParams.channelCount,
+                    m_framesPerBuffer,
+                    m_dSampleRate,
+                    m_framesPerBuffer * kOutputFifoTarget);
+            m_outputDriftLatencyStat = QString(
+                    "SoundDevicePortAudio %1 output drift latency")
+                    .arg(m_deviceId.debugName());
         }
         if (m_inputParams.channelCount) {
             m_inputFifo = new FIFO<CSAMPLE>(
@@ -307,6 +332,14 @@ SoundDeviceError SoundDevicePortAudio::open(bool isClkRefDevice, int syncBuffers
             SampleUtil::clear(dataPtr1, size1);
             SampleUtil::clear(dataPtr2, size2);
             m_inputFifo->releaseWriteRegions(writeCount);
+            m_pInputResampler = std::make_unique<DriftResampler>(
+                    m_inputParams.channelCount,
+                    m_framesPerBuffer,
+                    m_dSampleRate,
+                    m_framesPerBuffer * kInputFifoTarget);
+            m_inputDriftLatencyStat = QString(
+                    "SoundDevicePortAudio %1 input drift latency")
+                    .arg(m_deviceId.debugName());
         }
     } else if (m_syncBuffers == 1) { // "Disabled (short delay)"
         // this can be used on a second device when it is driven by the Clock
@@ -460,6 +493,8 @@ SoundDeviceError SoundDevicePortAudio::close() {
 
     m_outputFifo = NULL;
     m_inputFifo = NULL;
+    m_pOutputResampler.reset();
+    m_pInputResampler.reset();
     m_bSetThreadPriority = false;
 
     return SOUNDDEVICE_ERROR_OK;
@@ -591,6 +626,7 @@ void SoundDevicePortAudio::readProcess() {
             }
             m_inputFifo->releaseReadRegions(readCount);
         }
+        m_inputFifoReadNanos = mixxx::Time::elapsed().toIntegerNanos();
         if (readCount < inChunkSize) {
             // Fill remaining buffers with zeros
             clearInputBuffer(inChunkSize - readCount, readCount);
@@ -631,6 +667,7 @@ void SoundDevicePortAudio::writeProcess() {
             }
             m_outputFifo->releaseWriteRegions(writeCount);
         }
+        m_outputFifoWriteNanos = mixxx::Time::elapsed().toIntegerNanos();
 
         if (m_syncBuffers == 0) { // "Experimental (no delay)"
             // Polling
@@ -740,101 +777,51 @@ int SoundDevicePortAudio::callbackProcessDrift(
     //
     // I the tests it turns out that it only happens in the opposite direction, so
     // 3 chunks are just fine.
+    //
+    // The drift itself is compensated by resampling the stream with a ratio
+    // that keeps the fill level of the FIFO at a target. Skipping or duplicating
+    // whole frames would click. The Clock Reference callback accesses the FIFO
+    // one chunk at a time, so its fill level is estimated in between from the
+    // time since that access. Otherwise it jumps by a chunk whenever one
+    // callback overtakes the other.
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
 
     if (m_inputParams.channelCount) {
-        int inChunkSize = framesPerBuffer * m_inputParams.channelCount;
-        int readAvailable = m_inputFifo->readAvailable();
-        int writeAvailable = m_inputFifo->writeAvailable();
-        if (readAvailable < inChunkSize * kDriftReserve) {
-            // risk of an underflow, duplicate one frame
-            m_inputFifo->write(in, inChunkSize);
-            if (m_inputDrift) {
-                // Do not compensate the first delay, because it is likely a jitter
-                // corrected in the next cycle
-                // Duplicate one frame
-                m_inputFifo->write(
-                        &in[inChunkSize - m_inputParams.channelCount],
-                        m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == inChunkSize * kDriftReserve) {
-            // Everything Ok
-            m_inputFifo->write(in, inChunkSize);
-            m_inputDrift = false;
-            //qDebug() << "callbackProcess write:" << (float) readAvailable / inChunkSize << "Normal";
-        } else if (writeAvailable >= inChunkSize) {
-            // Risk of overflow, skip one frame
-            if (m_inputDrift) {
-                m_inputFifo->write(in, inChunkSize - m_inputParams.channelCount);
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Skip";
-            } else {
-                m_inputFifo->write(in, inChunkSize);
-                m_inputDrift = true;
-                //qDebug() << "callbackProcessDrift write:" << (float)readAvailable / inChunkSize << "Jitter Skip";
-            }
-        } else if (writeAvailable) {
+        // The chunk read by the Clock Reference is drained gradually
+        const double fifoFrames =
+                m_inputFifo->readAvailable() / m_inputParams.channelCount
+                + framesPerBuffer
+                - framesSince(m_inputFifoReadNanos, nowNanos,
+                        m_dSampleRate, framesPerBuffer);
+        m_pInputResampler->updateFillLevel(fifoFrames);
+        if (!m_pInputResampler->writeTo(m_inputFifo, in, framesPerBuffer)) {
             // Fifo Overflow
-            m_inputFifo->write(in, writeAvailable);
             m_pSoundManager->underflowHappened(8);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Overflow";
-        } else {
-            // Buffer full
-            m_pSoundManager->underflowHappened(9);
-            //qDebug() << "callbackProcessDrift write:" << (float) readAvailable / inChunkSize << "Buffer full";
+            //qDebug() << "callbackProcessDrift write:" << fifoFrames / framesPerBuffer << "Overflow";
         }
+        Stat::track(m_inputDriftLatencyStat,
+                Stat::DURATION_NANOSEC,
+                Stat::experimentFlags(kDefaultComputeFlags),
+                m_pInputResampler->fillFrames() / m_dSampleRate * 1e9);
     }
 
     if (m_outputParams.channelCount) {
-        int outChunkSize = framesPerBuffer * m_outputParams.channelCount;
-        int readAvailable = m_outputFifo->readAvailable();
-
-        if (readAvailable > outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            if (m_outputDrift) {
-                // Risk of overflow, skip one frame
-                m_outputFifo->releaseReadRegions(m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Skip";
-            } else {
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Skip";
-            }
-        } else if (readAvailable == outChunkSize * (kDriftReserve + 1)) {
-            m_outputFifo->read(out, outChunkSize);
-            m_outputDrift = false;
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Normal";
-        } else if (readAvailable >= outChunkSize) {
-            if (m_outputDrift) {
-                // Risk of underflow, duplicate one frame
-                m_outputFifo->read(out,
-                        outChunkSize - m_outputParams.channelCount);
-                SampleUtil::copy(
-                        &out[outChunkSize - m_outputParams.channelCount],
-                        &out[outChunkSize - (2 * m_outputParams.channelCount)],
-                        m_outputParams.channelCount);
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Save";
-            } else {
-                m_outputFifo->read(out, outChunkSize);
-                m_outputDrift = true;
-                //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Jitter Save";
-            }
-        } else if (readAvailable) {
-            m_outputFifo->read(out,
-                    readAvailable);
+        // The chunk written by the Clock Reference is filled up gradually
+        const double fifoFrames =
+                m_outputFifo->readAvailable() / m_outputParams.channelCount
+                + framesSince(m_outputFifoWriteNanos, nowNanos,
+                        m_dSampleRate, framesPerBuffer);
+        m_pOutputResampler->updateFillLevel(fifoFrames);
+        if (!m_pOutputResampler->readFrom(m_outputFifo, out, framesPerBuffer)) {
             // underflow
-            SampleUtil::clear(&out[readAvailable],
-                    outChunkSize - readAvailable);
             m_pSoundManager->underflowHappened(10);
-            //qDebug() << "callbackProcessDrift read:" << (float)readAvailable / outChunkSize << "Underflow";
-        } else {
-            // underflow
-            SampleUtil::clear(out, outChunkSize);
-            m_pSoundManager->underflowHappened(11);
-            //qDebug() << "callbackProcess read:" << (float)readAvailable / outChunkSize << "Buffer empty";
+            //qDebug() << "callbackProcessDrift read:" << fifoFrames / framesPerBuffer << "Underflow";
         }
-     }
+        Stat::track(m_outputDriftLatencyStat,
+                Stat::DURATION_NANOSEC,
+                Stat::experimentFlags(kDefaultComputeFlags),
+                m_pOutputResampler->fillFrames() / m_dSampleRate * 1e9);
+    }
     return paContinue;
 }
 
@@ -20,12 +20,16 @@
 
 #include <portaudio.h>
 
+#include <atomic>
+
 #include <QString>
 #include "util/performancetimer.h"
 
+#include "soundio/driftresampler.h"
 #include "soundio/sounddevice.h"
 #include "util/duration.h"
 #include "util/fifo.h"
+#include "util/memory.h"
 
 #define CPU_USAGE_UPDATE_RATE 30 // in 1/s, fits to display frame rate
 
@@ -90,6 +94,15 @@ class SoundDevicePortAudio : public SoundDevice {
     FIFO<CSAMPLE>* m_inputFifo;
     bool m_outputDrift;
     bool m_inputDrift;
+    // Drift compensation if this is not the clock reference device
+    std::unique_ptr<DriftResampler> m_pOutputResampler;
+    std::unique_ptr<DriftResampler> m_pInputResampler;
+    // Time when the clock reference device has last accessed the FIFOs,
+    // used to estimate their fill level in between
+    std::atomic<qint64> m_outputFifoWriteNanos;
+    std::atomic<qint64> m_inputFifoReadNanos;
+    QString m_outputDriftLatencyStat;
+    QString m_inputDriftLatencyStat;
 
     // A string describing the last PortAudio error to occur.
     QString m_lastError;
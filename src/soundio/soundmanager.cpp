@@ -19,7 +19,9 @@
 #include <QtDebug>
 #include <cstring> // for memcpy and strcmp
 
+#include <QFuture>
 #include <QLibrary>
+#include <QtConcurrentRun>
 #include <portaudio.h>
 
 #include "control/controlobject.h"
@@ -33,6 +35,7 @@
 #include "soundio/sounddevicenotfound.h"
 #include "soundio/sounddeviceportaudio.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/assert.h"
 #include "util/compatibility.h"
 #include "util/cmdlineargs.h"
 #include "util/defs.h"
@@ -56,6 +59,11 @@ struct DeviceMode {
 #ifdef __LINUX__
 const unsigned int kSleepSecondsAfterClosingDevice = 5;
 #endif
+
+// Set by SoundManager::initializePortAudioInBackground()
+bool s_portAudioInitializationStarted = false;
+QFuture<PaError> s_portAudioInitialization;
+
 } // anonymous namespace
 
 SoundManager::SoundManager(UserSettingsPointer pConfig,
@@ -100,6 +108,27 @@ SoundManager::SoundManager(UserSettingsPointer pConfig,
     m_config.writeToDisk(); // in case anything changed by applying defaults
 }
 
+// static
+void SoundManager::initializePortAudioInBackground() {
+#ifdef __WINDOWS__
+    // The ASIO, WASAPI and WDM-KS host APIs initialize COM on the thread
+    // that calls Pa_Initialize() and keep using COM objects that are bound
+    // to it. PortAudio is initialized on the main thread by the
+    // SoundManager instead.
+#else
+    VERIFY_OR_DEBUG_ASSERT(!s_portAudioInitializationStarted) {
+        return;
+    }
+    s_portAudioInitializationStarted = true;
+    s_portAudioInitialization = QtConcurrent::run([] {
+#ifdef Q_OS_LINUX
+        setJACKName();
+#endif
+        return Pa_Initialize();
+    });
+#endif
+}
+
 SoundManager::~SoundManager() {
     // Clean up devices.
     const bool sleepAfterClosing = false;
@@ -266,10 +295,16 @@ void SoundManager::clearAndQueryDevices() {
 void SoundManager::queryDevicesPortaudio() {
     PaError err = paNoError;
     if (!m_paInitialized) {
+        if (s_portAudioInitializationStarted) {
+            s_portAudioInitializationStarted = false;
+            err = s_portAudioInitialization.result();
+            s_portAudioInitialization = QFuture<PaError>();
+        } else {
 #ifdef Q_OS_LINUX
-        setJACKName();
+            setJACKName();
 #endif
-        err = Pa_Initialize();
+            err = Pa_Initialize();
+        }
         m_paInitialized = true;
     }
     if (err != paNoError) {
@@ -658,7 +693,8 @@ QList<AudioInput> SoundManager::registeredInputs() const {
     return m_registeredDestinations.keys();
 }
 
-void SoundManager::setJACKName() const {
+// static
+void SoundManager::setJACKName() {
 #ifdef Q_OS_LINUX
     typedef PaError (*SetJackClientName)(const char *name);
     QLibrary portaudio("libportaudio.so.2");
@@ -60,6 +60,13 @@ class SoundManager : public QObject {
     SoundManager(UserSettingsPointer pConfig, EngineMaster *_master);
     virtual ~SoundManager();
 
+    // Initializes PortAudio on a worker thread. PortAudio probes all host
+    // APIs and their devices, which may take seconds. The next SoundManager
+    // that is created waits for the result instead of initializing
+    // PortAudio itself. Does nothing on Windows, where PortAudio must be
+    // initialized on the main thread.
+    static void initializePortAudioInBackground();
+
     // Returns a list of all devices we've enumerated that match the provided
     // filterApi, and have at least one output or input channel if the
     // bOutputDevices or bInputDevices are set, respectively.
@@ -143,7 +150,7 @@ class SoundManager : public QObject {
     // isn't open is safe.
     void closeDevices(bool sleepAfterClosing);
 
-    void setJACKName() const;
+    static void setJACKName();
 
     EngineMaster *m_pMaster;
     UserSettingsPointer m_pConfig;
@@ -2,9 +2,14 @@
 #include <QDir>
 #include <QtDebug>
 
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
 #include "test/mixxxtest.h"
 
 #include "analyzer/analyzerwaveform.h"
+#include "engine/filters/enginefilterbessel4.h"
 #include "library/dao/analysisdao.h"
 #include "track/track.h"
 
@@ -15,6 +20,64 @@
 
 namespace {
 
+// The waveform of the separate EngineFilterBessel4 filters, as computed by
+// AnalyzerWaveform before it used the WaveformFilterBank
+void analyzeWithSeparateFilters(const CSAMPLE* buffer, int bufferLength,
+        int sampleRate, Waveform* pWaveform, Waveform* pWaveformSummary) {
+    EngineFilterBessel4Low low(sampleRate, 600);
+    EngineFilterBessel4Band mid(sampleRate, 600, 4000);
+    EngineFilterBessel4High high(sampleRate, 4000);
+    low.assumeSettled();
+    mid.assumeSettled();
+    high.assumeSettled();
+
+    std::vector<CSAMPLE> filtered[FilterCount];
+    for (auto& samples : filtered) {
+        samples.resize(bufferLength);
+    }
+    low.process(buffer, &filtered[Low][0], bufferLength);
+    mid.process(buffer, &filtered[Mid][0], bufferLength);
+    high.process(buffer, &filtered[High][0], bufferLength);
+
+    WaveformStride stride(pWaveform->getAudioVisualRatio(),
+            pWaveformSummary->getAudioVisualRatio());
+    int currentStride = 0;
+    int currentSummaryStride = 0;
+    for (int i = 0; i < bufferLength; i += 2) {
+        for (int channel = 0; channel < ChannelCount; ++channel) {
+            stride.m_overallData[channel] = math_max(
+                    stride.m_overallData[channel], std::fabs(buffer[i + channel]));
+            for (int f = 0; f < FilterCount; ++f) {
+                stride.m_filteredData[channel][f] = math_max(
+                        stride.m_filteredData[channel][f],
+                        std::fabs(filtered[f][i + channel]));
+            }
+        }
+        stride.m_position++;
+        if (fmod(stride.m_position, stride.m_length) < 1 &&
+                currentStride + ChannelCount <= pWaveform->getDataSize()) {
+            stride.store(pWaveform->data() + currentStride);
+            currentStride += ChannelCount;
+        }
+        if (fmod(stride.m_position, stride.m_averageLength) < 1 &&
+                currentSummaryStride + ChannelCount <= pWaveformSummary->getDataSize()) {
+            stride.averageStore(pWaveformSummary->data() + currentSummaryStride);
+            currentSummaryStride += ChannelCount;
+        }
+    }
+}
+
+void expectWaveformNear(const Waveform& expected, const Waveform& actual) {
+    ASSERT_EQ(expected.getDataSize(), actual.getDataSize());
+    // The 8 bit values may only differ by rounding
+    for (int i = 0; i < expected.getDataSize(); ++i) {
+        EXPECT_NEAR(expected.getAll(i), actual.getAll(i), 1) << "at " << i;
+        EXPECT_NEAR(expected.getLow(i), actual.getLow(i), 1) << "at " << i;
+        EXPECT_NEAR(expected.getMid(i), actual.getMid(i), 1) << "at " << i;
+        EXPECT_NEAR(expected.getHigh(i), actual.getHigh(i), 1) << "at " << i;
+    }
+}
+
 class AnalyzerWaveformTest : public MixxxTest {
   protected:
     AnalyzerWaveformTest()
@@ -109,4 +172,41 @@ TEST_F(AnalyzerWaveformTest, wrongTotalSamples) {
         EXPECT_FLOAT_EQ(canaryBigBuf[i], CANARY_FLOAT);
     }
 }
+
+// The fused filters must produce the waveforms of the separate filters
+TEST_F(AnalyzerWaveformTest, sameAsSeparateFilters) {
+    const int sampleRate = tio->getSampleRate();
+    // Bass, mids, highs and noise with different levels on both channels
+    std::srand(1);
+    for (int i = 0; i < BIGBUF_SIZE; i += 2) {
+        const double t = static_cast<double>(i / 2) / sampleRate;
+        const double noise = static_cast<double>(std::rand()) / RAND_MAX - 0.5;
+        bigbuf[i] = static_cast<CSAMPLE>(
+                0.5 * sin(2 * M_PI * 80 * t) +
+                0.2 * sin(2 * M_PI * 1200 * t) * sin(2 * M_PI * 0.5 * t) +
+                0.1 * noise);
+        bigbuf[i + 1] = static_cast<CSAMPLE>(
+                0.1 * sin(2 * M_PI * 150 * t) +
+                0.3 * sin(2 * M_PI * 7000 * t) +
+                0.2 * noise);
+    }
+
+    Waveform expectedWaveform(sampleRate, BIGBUF_SIZE, 441, -1);
+    Waveform expectedWaveformSummary(sampleRate, BIGBUF_SIZE, 441, 2 * 1920);
+    analyzeWithSeparateFilters(bigbuf, BIGBUF_SIZE, sampleRate,
+            &expectedWaveform, &expectedWaveformSummary);
+
+    // Chunks that don't line up with the strides
+    aw.initialize(tio, sampleRate, BIGBUF_SIZE);
+    const int chunkLength = 2 * 4097;
+    for (int i = 0; i < BIGBUF_SIZE; i += chunkLength) {
+        aw.processSamples(&bigbuf[i], math_min(chunkLength, BIGBUF_SIZE - i));
+    }
+    aw.storeResults(tio);
+    aw.cleanup();
+
+    expectWaveformNear(expectedWaveform, *tio->getWaveform());
+    expectWaveformNear(expectedWaveformSummary, *tio->getWaveformSummary());
+}
+
 } // namespace
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "library/dao/analysiscachedao.h"
+#include "test/librarytest.h"
+
+namespace {
+
+class AnalysisCacheDaoTest : public LibraryTest {
+  protected:
+    AnalysisCacheDaoTest() {
+        m_dao.initialize(dbConnection());
+    }
+
+    AnalysisCacheDao m_dao;
+};
+
+TEST_F(AnalysisCacheDaoTest, SaveAndGetCachedResults) {
+    AnalysisCacheDao::CachedResults results;
+    results.trackId = TrackId(42);
+    results.beatsVersion = "BeatGrid-2.0";
+    results.beatsSubVersion = "min_bpm=70|max_bpm=140";
+    results.beats = QByteArray("beats");
+    results.replayGain = mixxx::ReplayGain(0.5, 0.75f);
+    results.audibleSoundStart = 1000.0;
+    results.audibleSoundEnd = 2000.0;
+    ASSERT_TRUE(m_dao.saveCachedResults("1:abc", results));
+
+    AnalysisCacheDao::CachedResults cached;
+    ASSERT_TRUE(m_dao.getCachedResults("1:abc", &cached));
+    EXPECT_EQ(results.trackId, cached.trackId);
+    EXPECT_EQ(results.beatsVersion, cached.beatsVersion);
+    EXPECT_EQ(results.beatsSubVersion, cached.beatsSubVersion);
+    EXPECT_EQ(results.beats, cached.beats);
+    // Missing results stay missing
+    EXPECT_TRUE(cached.keysVersion.isEmpty());
+    EXPECT_TRUE(cached.keys.isEmpty());
+    EXPECT_EQ(results.replayGain, cached.replayGain);
+    EXPECT_EQ(results.audibleSoundStart, cached.audibleSoundStart);
+    EXPECT_EQ(results.audibleSoundEnd, cached.audibleSoundEnd);
+
+    EXPECT_FALSE(m_dao.getCachedResults("1:def", &cached));
+}
+
+TEST_F(AnalysisCacheDaoTest, ReplaceCachedResults) {
+    AnalysisCacheDao::CachedResults results;
+    results.trackId = TrackId(1);
+    results.replayGain = mixxx::ReplayGain(0.5, 0.75f);
+    ASSERT_TRUE(m_dao.saveCachedResults("1:abc", results));
+
+    results.trackId = TrackId(2);
+    results.keysVersion = "KeyMap-1.0";
+    results.keys = QByteArray("keys");
+    ASSERT_TRUE(m_dao.saveCachedResults("1:abc", results));
+
+    AnalysisCacheDao::CachedResults cached;
+    ASSERT_TRUE(m_dao.getCachedResults("1:abc", &cached));
+    EXPECT_EQ(TrackId(2), cached.trackId);
+    EXPECT_EQ(results.keys, cached.keys);
+    EXPECT_GT(0.0, cached.audibleSoundStart);
+
+}
+
+TEST_F(AnalysisCacheDaoTest, DeleteCachedResultsForTracks) {
+    AnalysisCacheDao::CachedResults results;
+    results.replayGain = mixxx::ReplayGain(0.5, 0.75f);
+    results.trackId = TrackId(1);
+    ASSERT_TRUE(m_dao.saveCachedResults("1:abc", results));
+    results.trackId = TrackId(2);
+    ASSERT_TRUE(m_dao.saveCachedResults("1:def", results));
+
+    ASSERT_TRUE(m_dao.deleteCachedResultsForTracks({TrackId(1)}));
+    AnalysisCacheDao::CachedResults cached;
+    EXPECT_FALSE(m_dao.getCachedResults("1:abc", &cached));
+    EXPECT_TRUE(m_dao.getCachedResults("1:def", &cached));
+}
+
+} // anonymous namespace
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QtDebug>
+
+#include "analyzer/analysisfingerprint.h"
+#include "analyzer/analyzerthread.h"
+#include "library/dao/analysiscachedao.h"
+#include "sources/soundsourceproxy.h"
+#include "test/librarytest.h"
+#include "track/beatfactory.h"
+#include "track/keyfactory.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+class AnalysisFingerprintTest : public LibraryTest {
+  protected:
+    AnalysisFingerprintTest() {
+        m_dao.initialize(dbConnection());
+    }
+
+    static bool isSupported(const QString& fileName) {
+        if (SoundSourceProxy::isFileNameSupported(fileName)) {
+            return true;
+        }
+        qInfo() << "Ignoring unsupported file type" << fileName;
+        return false;
+    }
+
+    // A copy of the test file with the same audio content
+    QString copyTestFile(const QString& fileName) const {
+        const QString filePath = getTestDataDir().filePath("duplicate-" + fileName);
+        EXPECT_TRUE(QFile::copy(kTestDir.absoluteFilePath(fileName), filePath));
+        return filePath;
+    }
+
+    static TrackPointer newTrack(const QString& filePath) {
+        auto pTrack = Track::newTemporary(filePath);
+        SoundSourceProxy(pTrack).updateTrackFromSource();
+        return pTrack;
+    }
+
+    static QString computeFingerprint(const TrackPointer& pTrack) {
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::audio::ChannelCount(2));
+        const auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(openParams);
+        EXPECT_TRUE(pAudioSource);
+        if (!pAudioSource) {
+            return QString();
+        }
+        return AnalysisFingerprint::compute(pAudioSource);
+    }
+
+    // Stores the results of an analyzed track with the given fingerprint
+    void storeAnalyzedTrack(const TrackPointer& pTrack, const QString& fingerprint) {
+        pTrack->setBeats(BeatFactory::makeBeatGrid(*pTrack, 120.0, 0.0));
+        pTrack->setKeys(KeyFactory::makeBasicKeys(
+                mixxx::track::io::key::A_MINOR,
+                mixxx::track::io::key::USER));
+        pTrack->setReplayGain(mixxx::ReplayGain(0.5, 0.75f));
+        ASSERT_TRUE(m_dao.saveCachedResults(
+                fingerprint,
+                AnalyzerThread::cachedResultsOfTrack(pTrack)));
+    }
+
+    AnalysisCacheDao m_dao;
+};
+
+TEST_F(AnalysisFingerprintTest, SameAudioContent) {
+    const QString fileName = "cover-test.wav";
+    if (!isSupported(fileName)) {
+        return;
+    }
+    const QString fingerprint = computeFingerprint(
+            newTrack(kTestDir.absoluteFilePath(fileName)));
+    EXPECT_FALSE(fingerprint.isEmpty());
+    // Deterministic
+    EXPECT_EQ(fingerprint, computeFingerprint(
+            newTrack(kTestDir.absoluteFilePath(fileName))));
+    // Independent of the file location
+    EXPECT_EQ(fingerprint, computeFingerprint(
+            newTrack(copyTestFile(fileName))));
+}
+
+TEST_F(AnalysisFingerprintTest, DifferentAudioContent) {
+    const QString fileName = "cover-test.wav";
+    const QString otherFileName = "artist.mp3";
+    if (!isSupported(fileName) || !isSupported(otherFileName)) {
+        return;
+    }
+    EXPECT_NE(computeFingerprint(newTrack(kTestDir.absoluteFilePath(fileName))),
+            computeFingerprint(newTrack(kTestDir.absoluteFilePath(otherFileName))));
+}
+
+TEST_F(AnalysisFingerprintTest, DifferentEncodingOfSameAudio) {
+    // Only identical decoded audio matches, a lossy encoding of the
+    // same recording decodes to different samples
+    const QString fileName = "cover-test.wav";
+    const QString encodedFileName = "cover-test.ogg";
+    if (!isSupported(fileName) || !isSupported(encodedFileName)) {
+        return;
+    }
+    EXPECT_NE(computeFingerprint(newTrack(kTestDir.absoluteFilePath(fileName))),
+            computeFingerprint(newTrack(kTestDir.absoluteFilePath(encodedFileName))));
+}
+
+TEST_F(AnalysisFingerprintTest, RestoreResultsOfDuplicateFile) {
+    const QString fileName = "cover-test.wav";
+    if (!isSupported(fileName)) {
+        return;
+    }
+    const auto pAnalyzedTrack = newTrack(kTestDir.absoluteFilePath(fileName));
+    storeAnalyzedTrack(pAnalyzedTrack, computeFingerprint(pAnalyzedTrack));
+
+    const auto pDuplicateTrack = newTrack(copyTestFile(fileName));
+    AnalysisCacheDao::CachedResults results;
+    ASSERT_TRUE(m_dao.getCachedResults(computeFingerprint(pDuplicateTrack), &results));
+    AnalyzerThread::applyCachedResults(pDuplicateTrack, results, config());
+
+    ASSERT_TRUE(pDuplicateTrack->getBeats());
+    EXPECT_DOUBLE_EQ(120.0, pDuplicateTrack->getBpm());
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, pDuplicateTrack->getKey());
+    EXPECT_EQ(pAnalyzedTrack->getReplayGain(), pDuplicateTrack->getReplayGain());
+}
+
+TEST_F(AnalysisFingerprintTest, RestoreRespectsBpmLock) {
+    const QString fileName = "cover-test.wav";
+    if (!isSupported(fileName)) {
+        return;
+    }
+    const auto pAnalyzedTrack = newTrack(kTestDir.absoluteFilePath(fileName));
+    storeAnalyzedTrack(pAnalyzedTrack, computeFingerprint(pAnalyzedTrack));
+
+    const auto pDuplicateTrack = newTrack(copyTestFile(fileName));
+    pDuplicateTrack->setBpmLocked(true);
+    AnalysisCacheDao::CachedResults results;
+    ASSERT_TRUE(m_dao.getCachedResults(computeFingerprint(pDuplicateTrack), &results));
+    AnalyzerThread::applyCachedResults(pDuplicateTrack, results, config());
+
+    // Only the beats are not applied
+    EXPECT_FALSE(pDuplicateTrack->getBeats());
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, pDuplicateTrack->getKey());
+}
+
+} // anonymous namespace
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerfrontend.h"
+#include "analyzer/plugins/analyzerqueenmarybeats.h"
+#include "analyzer/plugins/analyzerqueenmarykey.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr SINT kTrackLengthFrames = 10 * kSampleRate;
+
+// Clicks at 120 BPM on the left channel and a constant offset on
+// the right channel
+std::vector<CSAMPLE> makeClickTrack() {
+    std::vector<CSAMPLE> samples(kTrackLengthFrames * mixxx::kAnalysisChannels);
+    for (SINT frame = 0; frame < kTrackLengthFrames; ++frame) {
+        const bool click = (frame % (kSampleRate / 2)) < 100;
+        samples[frame * 2] = click ? 1.0f : 0.0f;
+        samples[frame * 2 + 1] = 0.25f;
+    }
+    return samples;
+}
+
+// Passes the samples chunk by chunk like the AnalyzerThread
+bool analyzeTrack(
+        const std::vector<CSAMPLE>& samples,
+        mixxx::AnalyzerFrontEnd* pFrontEnd,
+        const std::vector<mixxx::AnalyzerPlugin*>& plugins) {
+    if (pFrontEnd) {
+        pFrontEnd->initialize(kSampleRate);
+    }
+    bool result = true;
+    for (auto* pPlugin : plugins) {
+        result &= pPlugin->initialize(kSampleRate);
+    }
+    for (SINT frame = 0; frame < kTrackLengthFrames;
+            frame += mixxx::kAnalysisFramesPerChunk) {
+        const SINT frames = std::min(
+                mixxx::kAnalysisFramesPerChunk, kTrackLengthFrames - frame);
+        const CSAMPLE* pChunk = &samples[frame * mixxx::kAnalysisChannels];
+        const int chunkLength = static_cast<int>(
+                frames * mixxx::kAnalysisChannels);
+        if (pFrontEnd) {
+            pFrontEnd->setStereoSamples(pChunk, chunkLength);
+        }
+        for (auto* pPlugin : plugins) {
+            result &= pPlugin->processSamples(pChunk, chunkLength);
+        }
+    }
+    for (auto* pPlugin : plugins) {
+        result &= pPlugin->finalize();
+    }
+    return result;
+}
+
+class AnalyzerFrontEndTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        m_samples = makeClickTrack();
+    }
+
+    void analyze(
+            mixxx::AnalyzerFrontEnd* pFrontEnd,
+            const std::vector<mixxx::AnalyzerPlugin*>& plugins) {
+        EXPECT_TRUE(analyzeTrack(m_samples, pFrontEnd, plugins));
+    }
+
+    std::vector<CSAMPLE> m_samples;
+};
+
+TEST_F(AnalyzerFrontEndTest, MonoDownmix) {
+    mixxx::AnalyzerFrontEnd frontEnd;
+    frontEnd.initialize(kSampleRate);
+    frontEnd.setStereoSamples(&m_samples[0], 200 * mixxx::kAnalysisChannels);
+    ASSERT_EQ(200, frontEnd.monoFrameCount());
+    const double* pMono = frontEnd.monoSamples();
+    EXPECT_DOUBLE_EQ(0.625, pMono[0]);
+    EXPECT_DOUBLE_EQ(0.125, pMono[199]);
+    EXPECT_TRUE(frontEnd.isCurrentChunk(&m_samples[0], 400));
+    EXPECT_FALSE(frontEnd.isCurrentChunk(&m_samples[2], 400));
+}
+
+TEST_F(AnalyzerFrontEndTest, SameBeatsAsStereoInput) {
+    mixxx::AnalyzerQueenMaryBeats stereo;
+    analyze(nullptr, {&stereo});
+    ASSERT_FALSE(stereo.getBeats().isEmpty());
+
+    mixxx::AnalyzerFrontEnd frontEnd;
+    mixxx::AnalyzerQueenMaryBeats mono(&frontEnd);
+    analyze(&frontEnd, {&mono});
+    EXPECT_EQ(stereo.getBeats(), mono.getBeats());
+}
+
+TEST_F(AnalyzerFrontEndTest, ShareBetweenBeatsAndKey) {
+    mixxx::AnalyzerQueenMaryBeats beatsOnly;
+    analyze(nullptr, {&beatsOnly});
+
+    mixxx::AnalyzerQueenMaryKey keyOnly;
+    analyze(nullptr, {&keyOnly});
+
+    // The plugins that are created by AnalyzerBeats and AnalyzerKey
+    mixxx::AnalyzerFrontEnd frontEnd;
+    mixxx::AnalyzerQueenMaryBeats beats(&frontEnd);
+    mixxx::AnalyzerQueenMaryKey key(&frontEnd);
+    analyze(&frontEnd, {&beats, &key});
+    EXPECT_EQ(beatsOnly.getBeats(), beats.getBeats());
+    EXPECT_EQ(keyOnly.getKeyChanges(), key.getKeyChanges());
+
+    // Each chunk is downmixed once for both plugins
+    const SINT chunkCount = (kTrackLengthFrames + mixxx::kAnalysisFramesPerChunk - 1) /
+            mixxx::kAnalysisFramesPerChunk;
+    EXPECT_EQ(chunkCount, frontEnd.getComputedDownmixCount());
+}
+
+TEST_F(AnalyzerFrontEndTest, SameKeyAsStereoInput) {
+    mixxx::AnalyzerQueenMaryKey stereo;
+    analyze(nullptr, {&stereo});
+
+    mixxx::AnalyzerFrontEnd frontEnd;
+    mixxx::AnalyzerQueenMaryKey mono(&frontEnd);
+    analyze(&frontEnd, {&mono});
+    EXPECT_EQ(stereo.getKeyChanges(), mono.getKeyChanges());
+}
+
+// Analyzes a track with and without the shared front-end. Argument 0
+// analyzes beats, 1 the key, and 2 both like the AnalyzerThread. The
+// second argument enables the front-end.
+static void BM_AnalyzerFrontEnd(benchmark::State& state) {
+    const std::vector<CSAMPLE> samples = makeClickTrack();
+    const bool withBeats = state.range(0) != 1;
+    const bool withKey = state.range(0) != 0;
+    const bool withFrontEnd = state.range(1) != 0;
+    int downmixCount = 0;
+    for (auto _ : state) {
+        mixxx::AnalyzerFrontEnd frontEnd;
+        mixxx::AnalyzerFrontEnd* pFrontEnd = withFrontEnd ? &frontEnd : nullptr;
+        mixxx::AnalyzerQueenMaryBeats beats(pFrontEnd);
+        mixxx::AnalyzerQueenMaryKey key(pFrontEnd);
+        std::vector<mixxx::AnalyzerPlugin*> plugins;
+        if (withBeats) {
+            plugins.push_back(&beats);
+        }
+        if (withKey) {
+            plugins.push_back(&key);
+        }
+        benchmark::DoNotOptimize(analyzeTrack(samples, pFrontEnd, plugins));
+        downmixCount = frontEnd.getComputedDownmixCount();
+    }
+    state.counters["downmixes"] = downmixCount;
+}
+BENCHMARK(BM_AnalyzerFrontEnd)
+        ->Args({0, 0})
+        ->Args({0, 1})
+        ->Args({1, 0})
+        ->Args({1, 1})
+        ->Args({2, 0})
+        ->Args({2, 1})
+        ->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "test/mixxxtest.h"
+
+#include "analyzer/analyzerbeats.h"
+#include "analyzer/analyzerkey.h"
+#include "analyzer/constants.h"
+#include "track/beatfactory.h"
+#include "util/math.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+// Longer than the provisional analysis
+constexpr int kTrackLengthSeconds = 2 * mixxx::kProvisionalAnalysisSecondsToAnalyze;
+constexpr int kTrackLengthFrames = kTrackLengthSeconds * kSampleRate;
+constexpr int kTrackLengthSamples = kTrackLengthFrames * mixxx::kAnalysisChannels;
+
+class AnalyzerProvisionalTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pTrack = Track::newTemporary();
+        m_pTrack->setAudioProperties(
+                mixxx::audio::ChannelCount(mixxx::kAnalysisChannels),
+                mixxx::audio::SampleRate(kSampleRate),
+                mixxx::audio::Bitrate(),
+                mixxx::Duration::fromSeconds(kTrackLengthSeconds));
+
+        // An A major chord with clicks at 120 BPM
+        m_samples.resize(kTrackLengthSamples);
+        for (int frame = 0; frame < kTrackLengthFrames; ++frame) {
+            const double t = static_cast<double>(frame) / kSampleRate;
+            double value = 0.1 * (std::sin(2 * M_PI * 440.0 * t) +
+                                         std::sin(2 * M_PI * 554.37 * t) +
+                                         std::sin(2 * M_PI * 659.26 * t));
+            if ((frame % (kSampleRate / 2)) < 100) {
+                value += 0.5;
+            }
+            m_samples[frame * 2] = static_cast<CSAMPLE>(value);
+            m_samples[frame * 2 + 1] = static_cast<CSAMPLE>(value);
+        }
+    }
+
+    // Passes the samples chunk by chunk like the AnalyzerThread until
+    // endSample has been reached
+    void process(Analyzer* pAnalyzer, int startSample, int endSample) {
+        for (int sample = startSample; sample < endSample;
+                sample += mixxx::kAnalysisSamplesPerChunk) {
+            const int length = math_min(
+                    static_cast<int>(mixxx::kAnalysisSamplesPerChunk),
+                    endSample - sample);
+            EXPECT_TRUE(pAnalyzer->processSamples(&m_samples[sample], length));
+        }
+    }
+
+    // Processes the samples that are needed for publishing the
+    // provisional results and returns the number of processed samples
+    int processProvisional(Analyzer* pAnalyzer) {
+        EXPECT_TRUE(pAnalyzer->initialize(m_pTrack, kSampleRate, kTrackLengthSamples));
+        const int provisionalSamples = mixxx::kProvisionalAnalysisSecondsToAnalyze *
+                kSampleRate * mixxx::kAnalysisChannels;
+        // Complete chunks, like the AnalyzerThread
+        const int endSample = std::min(kTrackLengthSamples,
+                (provisionalSamples / static_cast<int>(mixxx::kAnalysisSamplesPerChunk) + 1) *
+                        static_cast<int>(mixxx::kAnalysisSamplesPerChunk));
+        process(pAnalyzer, 0, endSample);
+        return endSample;
+    }
+
+    void finish(Analyzer* pAnalyzer, int startSample) {
+        process(pAnalyzer, startSample, kTrackLengthSamples);
+        pAnalyzer->storeResults(m_pTrack);
+        pAnalyzer->cleanup();
+    }
+
+    static bool isProvisional(const Keys& keys) {
+        return keys.getSubVersion().contains("provisional");
+    }
+
+    TrackPointer m_pTrack;
+    std::vector<CSAMPLE> m_samples;
+};
+
+TEST_F(AnalyzerProvisionalTest, FinalBeatsReplaceProvisionalBeats) {
+    AnalyzerBeats analyzer(config(), true, true);
+    const int processedSamples = processProvisional(&analyzer);
+
+    const mixxx::BeatsPointer pProvisionalBeats = m_pTrack->getBeats();
+    ASSERT_TRUE(pProvisionalBeats);
+    EXPECT_TRUE(BeatFactory::isProvisional(*pProvisionalBeats));
+
+    finish(&analyzer, processedSamples);
+    const mixxx::BeatsPointer pBeats = m_pTrack->getBeats();
+    ASSERT_TRUE(pBeats);
+    EXPECT_NE(pProvisionalBeats, pBeats);
+    EXPECT_FALSE(BeatFactory::isProvisional(*pBeats));
+}
+
+TEST_F(AnalyzerProvisionalTest, EditedProvisionalBeatsAreKept) {
+    AnalyzerBeats analyzer(config(), true, true);
+    const int processedSamples = processProvisional(&analyzer);
+
+    const mixxx::BeatsPointer pProvisionalBeats = m_pTrack->getBeats();
+    ASSERT_TRUE(pProvisionalBeats);
+    ASSERT_TRUE(BeatFactory::isProvisional(*pProvisionalBeats));
+
+    // Like nudging the beat grid
+    const double firstBeat = pProvisionalBeats->findNextBeat(0);
+    pProvisionalBeats->translate(100);
+    EXPECT_FALSE(BeatFactory::isProvisional(*pProvisionalBeats));
+
+    finish(&analyzer, processedSamples);
+    EXPECT_EQ(pProvisionalBeats, m_pTrack->getBeats());
+    EXPECT_DOUBLE_EQ(firstBeat + 100, m_pTrack->getBeats()->findNextBeat(0));
+}
+
+TEST_F(AnalyzerProvisionalTest, FinalKeysReplaceProvisionalKeys) {
+    AnalyzerKey analyzer(config(), true);
+    const int processedSamples = processProvisional(&analyzer);
+
+    const Keys provisionalKeys = m_pTrack->getKeys();
+    ASSERT_TRUE(provisionalKeys.isValid());
+    EXPECT_TRUE(isProvisional(provisionalKeys));
+
+    finish(&analyzer, processedSamples);
+    const Keys keys = m_pTrack->getKeys();
+    EXPECT_TRUE(keys.isValid());
+    EXPECT_FALSE(isProvisional(keys));
+}
+
+TEST_F(AnalyzerProvisionalTest, EditedProvisionalKeysAreKept) {
+    AnalyzerKey analyzer(config(), true);
+    const int processedSamples = processProvisional(&analyzer);
+
+    const Keys provisionalKeys = m_pTrack->getKeys();
+    ASSERT_TRUE(provisionalKeys.isValid());
+    ASSERT_TRUE(isProvisional(provisionalKeys));
+
+    // The user picks a different key
+    const auto userKey =
+            provisionalKeys.getGlobalKey() == mixxx::track::io::key::C_MAJOR
+            ? mixxx::track::io::key::D_MAJOR
+            : mixxx::track::io::key::C_MAJOR;
+    m_pTrack->setKey(userKey, mixxx::track::io::key::USER);
+    EXPECT_FALSE(isProvisional(m_pTrack->getKeys()));
+
+    finish(&analyzer, processedSamples);
+    EXPECT_EQ(userKey, m_pTrack->getKey());
+}
+
+} // anonymous namespace
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QWaitCondition>
+#include <functional>
+
+#include "library/browse/browsetablemodel.h"
+#include "library/browse/browsethread.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+const unsigned long kTimeoutMillis = 10000;
+
+QString fileNameOf(const QList<QStandardItem*>& row) {
+    return QFileInfo(row.at(COLUMN_NATIVELOCATION)->data(Qt::UserRole).toString())
+            .fileName();
+}
+
+} // anonymous namespace
+
+// Records the rows that are sent by the BrowseThread. The signals
+// are received on the BrowseThread itself and the test thread waits
+// until the expected rows have arrived.
+class BrowseThreadTest : public MixxxTest {
+  protected:
+    BrowseThreadTest()
+            : m_numCleared(0),
+              m_pBrowseThread(BrowseThread::getInstanceRef()) {
+        // A single metadata task reads the pending tracks in order
+        m_pBrowseThread->m_metadataThreadPool.setMaxThreadCount(1);
+        QObject::connect(m_pBrowseThread.data(),
+                &BrowseThread::clearModel,
+                m_pBrowseThread.data(),
+                [this](BrowseTableModel*) {
+                    if (m_onClearModel) {
+                        m_onClearModel();
+                    }
+                    QMutexLocker locker(&m_mutex);
+                    ++m_numCleared;
+                    m_changed.wakeAll();
+                },
+                Qt::DirectConnection);
+        QObject::connect(m_pBrowseThread.data(),
+                &BrowseThread::rowsAppended,
+                m_pBrowseThread.data(),
+                [this](const QList<QList<QStandardItem*>>& rows, BrowseTableModel*) {
+                    QList<QString> pendingLocations;
+                    QMutexLocker locker(&m_mutex);
+                    for (const auto& row : rows) {
+                        m_appended.append(fileNameOf(row));
+                        if (row.at(COLUMN_PREVIEW)->data(
+                                    BrowseTableModel::kPendingMetadataRole)
+                                        .toBool()) {
+                            m_pending.append(fileNameOf(row));
+                            pendingLocations.append(
+                                    row.at(COLUMN_NATIVELOCATION)
+                                            ->data(Qt::UserRole)
+                                            .toString());
+                        }
+                        qDeleteAll(row);
+                    }
+                    locker.unlock();
+                    if (m_onRowsAppended) {
+                        m_onRowsAppended(pendingLocations);
+                    }
+                    locker.relock();
+                    m_changed.wakeAll();
+                },
+                Qt::DirectConnection);
+        QObject::connect(m_pBrowseThread.data(),
+                &BrowseThread::rowsUpdated,
+                m_pBrowseThread.data(),
+                [this](const QList<QList<QStandardItem*>>& rows, BrowseTableModel*) {
+                    QMutexLocker locker(&m_mutex);
+                    for (const auto& row : rows) {
+                        m_updated.append(fileNameOf(row));
+                        qDeleteAll(row);
+                    }
+                    m_changed.wakeAll();
+                },
+                Qt::DirectConnection);
+    }
+
+    QString createTrackFile(const QString& dirName, const QString& fileName) const {
+        const QDir dir(getTestDataDir().filePath(dirName));
+        EXPECT_TRUE(dir.mkpath("."));
+        const QString filePath = dir.filePath(fileName);
+        EXPECT_TRUE(QFile::copy(kTestDir.absoluteFilePath("cover-test.wav"), filePath));
+        return filePath;
+    }
+
+    void clearRecordedRows() {
+        QMutexLocker locker(&m_mutex);
+        m_numCleared = 0;
+        m_appended.clear();
+        m_pending.clear();
+        m_updated.clear();
+    }
+
+    // Waits until all files have been sent and the metadata of all
+    // pending rows has been read
+    bool waitUntilPopulated(int numFiles) {
+        QMutexLocker locker(&m_mutex);
+        while (m_appended.size() < numFiles || m_updated.size() < m_pending.size()) {
+            if (!m_changed.wait(&m_mutex, kTimeoutMillis)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool populate(const QString& dirName, int numFiles) {
+        clearRecordedRows();
+        m_pBrowseThread->executePopulation(
+                MDir(getTestDataDir().filePath(dirName)), nullptr);
+        return waitUntilPopulated(numFiles);
+    }
+
+    // Invoked on the BrowseThread
+    std::function<void()> m_onClearModel;
+    std::function<void(const QList<QString>&)> m_onRowsAppended;
+
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+    int m_numCleared;
+    QStringList m_appended;
+    QStringList m_pending;
+    QStringList m_updated;
+
+    // Destroyed first to stop the thread before the recorded rows
+    BrowseThreadPointer m_pBrowseThread;
+};
+
+namespace {
+
+TEST_F(BrowseThreadTest, CachedRowsAreReusedUntilModified) {
+    const QStringList fileNames = {"a.wav", "b.wav", "c.wav"};
+    for (const auto& fileName : fileNames) {
+        createTrackFile("dir", fileName);
+    }
+
+    ASSERT_TRUE(populate("dir", fileNames.size()));
+    m_pending.sort();
+    m_updated.sort();
+    EXPECT_EQ(fileNames, m_pending);
+    EXPECT_EQ(fileNames, m_updated);
+
+    // All rows are complete when populating the directory again
+    ASSERT_TRUE(populate("dir", fileNames.size()));
+    EXPECT_TRUE(m_pending.isEmpty());
+    EXPECT_TRUE(m_updated.isEmpty());
+
+    // Different file size
+    {
+        QFile file(getTestDataDir().filePath("dir/b.wav"));
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        file.write(QByteArray(16, '\0'));
+    }
+    ASSERT_TRUE(populate("dir", fileNames.size()));
+    EXPECT_EQ(QStringList{"b.wav"}, m_pending);
+    EXPECT_EQ(QStringList{"b.wav"}, m_updated);
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    // Different modification time
+    {
+        QFile file(getTestDataDir().filePath("dir/c.wav"));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(
+                QDateTime::currentDateTime().addSecs(-3600),
+                QFileDevice::FileModificationTime));
+    }
+    ASSERT_TRUE(populate("dir", fileNames.size()));
+    EXPECT_EQ(QStringList{"c.wav"}, m_pending);
+    EXPECT_EQ(QStringList{"c.wav"}, m_updated);
+#endif
+}
+
+TEST_F(BrowseThreadTest, PrioritizedMetadataIsReadFirst) {
+    const int numFiles = 10;
+    for (int i = 0; i < numFiles; ++i) {
+        createTrackFile("dir", QString("%1.wav").arg(i));
+    }
+
+    // The rows are prioritized while they are received, before
+    // reading their metadata has started
+    QString prioritizedLocation;
+    m_onRowsAppended = [this, &prioritizedLocation](
+                               const QList<QString>& pendingLocations) {
+        if (!pendingLocations.isEmpty()) {
+            prioritizedLocation = pendingLocations.last();
+            m_pBrowseThread->prioritizeMetadata(prioritizedLocation);
+        }
+    };
+
+    ASSERT_TRUE(populate("dir", numFiles));
+    ASSERT_EQ(numFiles, m_pending.size());
+    ASSERT_EQ(numFiles, m_updated.size());
+    EXPECT_EQ(QFileInfo(prioritizedLocation).fileName(), m_updated.first());
+    EXPECT_EQ(m_pending.last(), m_updated.first());
+}
+
+TEST_F(BrowseThreadTest, ChangingDirectoryCancelsPopulation) {
+    const QStringList firstFileNames = {"first-1.wav", "first-2.wav", "first-3.wav"};
+    for (const auto& fileName : firstFileNames) {
+        createTrackFile("first", fileName);
+    }
+    const QStringList secondFileNames = {"second-1.wav", "second-2.wav"};
+    for (const auto& fileName : secondFileNames) {
+        createTrackFile("second", fileName);
+    }
+
+    // Select the second directory while the first one is populated
+    bool secondRequested = false;
+    m_onClearModel = [this, &secondRequested]() {
+        if (!secondRequested) {
+            secondRequested = true;
+            m_pBrowseThread->executePopulation(
+                    MDir(getTestDataDir().filePath("second")), nullptr);
+        }
+    };
+
+    ASSERT_TRUE(populate("first", secondFileNames.size()));
+    EXPECT_EQ(2, m_numCleared);
+    m_appended.sort();
+    m_updated.sort();
+    EXPECT_EQ(secondFileNames, m_appended);
+    EXPECT_EQ(secondFileNames, m_updated);
+}
+
+} // anonymous namespace
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <QUrl>
+#include <atomic>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "engine/cachingreader/cachingreaderchunkstore.h"
+#include "sources/audiosource.h"
+
+namespace {
+
+const SINT kFrameCount = 10 * CachingReaderChunk::kFrames;
+
+// Generates a ramp and counts how often it has been read from
+class RampAudioSource : public mixxx::AudioSource {
+  public:
+    explicit RampAudioSource(std::atomic<int>* pReadCount)
+            : mixxx::AudioSource(QUrl::fromLocalFile("ramp.wav")),
+              m_pReadCount(pReadCount) {
+    }
+
+    void close() override {
+    }
+
+  protected:
+    OpenResult tryOpen(
+            OpenMode mode,
+            const OpenParams& params) override {
+        Q_UNUSED(mode);
+        Q_UNUSED(params);
+        initChannelCountOnce(CachingReaderChunk::kChannels);
+        initSampleRateOnce(44100);
+        initFrameIndexRangeOnce(mixxx::IndexRange::forward(0, kFrameCount));
+        return OpenResult::Succeeded;
+    }
+
+    mixxx::ReadableSampleFrames readSampleFramesClamped(
+            mixxx::WritableSampleFrames sampleFrames) override {
+        m_pReadCount->fetch_add(1);
+        const mixxx::IndexRange frameIndexRange = sampleFrames.frameIndexRange();
+        CSAMPLE* pSample = sampleFrames.writableData();
+        for (SINT frameIndex = frameIndexRange.start();
+                frameIndex < frameIndexRange.end();
+                ++frameIndex) {
+            for (SINT channel = 0; channel < CachingReaderChunk::kChannels; ++channel) {
+                *pSample++ = static_cast<CSAMPLE>(frameIndex);
+            }
+        }
+        return mixxx::ReadableSampleFrames(
+                frameIndexRange,
+                mixxx::SampleBuffer::ReadableSlice(
+                        sampleFrames.writableData(),
+                        CachingReaderChunk::frames2samples(frameIndexRange.length())));
+    }
+
+  private:
+    std::atomic<int>* const m_pReadCount;
+};
+
+class CachingReaderChunkStoreTest : public testing::Test {
+  protected:
+    CachingReaderChunkStoreTest()
+            : m_openCount(0),
+              m_readCount(0) {
+    }
+
+    CachingReaderChunkStore::SourcePointer openSource(
+            CachingReaderChunkStore* pStore,
+            const QString& location) {
+        return pStore->openSource(location, [this]() {
+            ++m_openCount;
+            auto pAudioSource = std::make_shared<RampAudioSource>(&m_readCount);
+            pAudioSource->open(mixxx::AudioSource::OpenMode::Strict);
+            return pAudioSource;
+        });
+    }
+
+    static mixxx::IndexRange chunkRange(SINT chunkIndex) {
+        return mixxx::IndexRange::forward(
+                chunkIndex * CachingReaderChunk::kFrames,
+                CachingReaderChunk::kFrames);
+    }
+
+    int m_openCount;
+    std::atomic<int> m_readCount;
+};
+
+TEST_F(CachingReaderChunkStoreTest, ShareSourceAndChunks) {
+    CachingReaderChunkStore store(4);
+    // Like a track that is loaded into two decks
+    auto pSource1 = openSource(&store, "track.mp3");
+    auto pSource2 = openSource(&store, "track.mp3");
+    ASSERT_TRUE(pSource1);
+    EXPECT_EQ(pSource1, pSource2);
+    EXPECT_EQ(1, m_openCount);
+
+    auto pSlot1 = store.acquireChunk(pSource1, 1, chunkRange(1));
+    ASSERT_TRUE(pSlot1);
+    auto pSlot2 = store.acquireChunk(pSource2, 1, chunkRange(1));
+    EXPECT_EQ(pSlot1, pSlot2);
+    EXPECT_EQ(1, m_readCount);
+    EXPECT_EQ(1, store.getDecodedChunkCount());
+    EXPECT_EQ(chunkRange(1), pSlot2->sampleFrames().frameIndexRange());
+    EXPECT_EQ(static_cast<CSAMPLE>(chunkRange(1).start()),
+            *pSlot2->sampleFrames().readableData());
+
+    CachingReaderChunkStore::releaseChunk(pSlot1);
+    CachingReaderChunkStore::releaseChunk(pSlot2);
+
+    // Another file is opened separately
+    auto pOtherSource = openSource(&store, "other.mp3");
+    EXPECT_NE(pSource1, pOtherSource);
+    EXPECT_EQ(2, m_openCount);
+}
+
+TEST_F(CachingReaderChunkStoreTest, KeepUnreferencedChunks) {
+    CachingReaderChunkStore store(2);
+    auto pSource = openSource(&store, "track.mp3");
+
+    // Released chunks stay available until their slot is needed
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 0, chunkRange(0)));
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 1, chunkRange(1)));
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 0, chunkRange(0)));
+    EXPECT_EQ(2, m_readCount);
+
+    // Replaces the least recently used chunk 1
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 2, chunkRange(2)));
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 0, chunkRange(0)));
+    EXPECT_EQ(3, m_readCount);
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 1, chunkRange(1)));
+    EXPECT_EQ(4, m_readCount);
+}
+
+TEST_F(CachingReaderChunkStoreTest, ExhaustedWhenAllChunksReferenced) {
+    CachingReaderChunkStore store(2);
+    auto pSource = openSource(&store, "track.mp3");
+
+    auto pSlot0 = store.acquireChunk(pSource, 0, chunkRange(0));
+    auto pSlot1 = store.acquireChunk(pSource, 1, chunkRange(1));
+    ASSERT_TRUE(pSlot0);
+    ASSERT_TRUE(pSlot1);
+    EXPECT_EQ(nullptr, store.acquireChunk(pSource, 2, chunkRange(2)));
+
+    CachingReaderChunkStore::releaseChunk(pSlot0);
+    auto pSlot2 = store.acquireChunk(pSource, 2, chunkRange(2));
+    EXPECT_EQ(pSlot0, pSlot2);
+    CachingReaderChunkStore::releaseChunk(pSlot1);
+    CachingReaderChunkStore::releaseChunk(pSlot2);
+}
+
+TEST_F(CachingReaderChunkStoreTest, DropChunksOfClosedSource) {
+    CachingReaderChunkStore store(2);
+    auto pSource = openSource(&store, "track.mp3");
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 0, chunkRange(0)));
+    pSource.reset();
+
+    // The file is opened and decoded again
+    pSource = openSource(&store, "track.mp3");
+    CachingReaderChunkStore::releaseChunk(store.acquireChunk(pSource, 0, chunkRange(0)));
+    EXPECT_EQ(2, m_openCount);
+    EXPECT_EQ(2, m_readCount);
+}
+
+} // anonymous namespace
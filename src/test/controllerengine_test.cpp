@@ -1,3 +1,7 @@
+#include <benchmark/benchmark.h>
+
+#include <QTemporaryDir>
+#include <QTemporaryFile>
 #include <QThread>
 #include <QtDebug>
 
@@ -5,6 +9,8 @@
 #include "control/controlpotmeter.h"
 #include "controllers/controllerdebug.h"
 #include "controllers/controllerengine.h"
+#include "controllers/controllerinputreader.h"
+#include "controllers/midi/midiinputmappingtable.h"
 #include "controllers/softtakeover.h"
 #include "preferences/usersettings.h"
 #include "test/mixxxtest.h"
@@ -36,8 +42,20 @@ class ControllerEngineTest : public MixxxTest {
                                         QScriptValueList());
     }
 
+    // Like reloading the scripts
+    void clearHandlerCache() {
+        cEngine->clearHandlerCache();
+    }
+
     ControllerEngine *cEngine;
     QScriptEngine *pScriptEngine;
+
+  public:
+    // Normally set by initializeScripts(), which needs a controller
+    static void setScriptFunctionPrefixes(
+            ControllerEngine* pEngine, const QList<QString>& prefixes) {
+        pEngine->m_scriptFunctionPrefixes = prefixes;
+    }
 };
 
 TEST_F(ControllerEngineTest, commonScriptHasNoErrors) {
@@ -618,3 +636,288 @@ TEST_F(ControllerEngineTest, connectionExecutesWithCorrectThisObject) {
     // The counter should have been incremented exactly once.
     EXPECT_DOUBLE_EQ(1.0, pass->get());
 }
+
+TEST_F(ControllerEngineTest, resolveHandler) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+
+    ScopedTemporaryFile script(makeTemporaryFile(
+        "var TestController = { value: 1 };"
+        "TestController.deck = { value: 2 };"
+        "TestController.deck.handler = function () {"
+        "  engine.setValue('[Test]', 'co', this.value);"
+        "};"));
+    cEngine->evaluate(script->fileName());
+    EXPECT_FALSE(cEngine->hasErrors(script->fileName()));
+
+    const ControllerScriptHandler handler =
+            cEngine->resolveHandler("TestController.deck.handler", 5);
+    EXPECT_TRUE(handler.function().isFunction());
+    EXPECT_TRUE(cEngine->execute(handler, 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(2.0, co->get());
+
+    // The function may be replaced after resolving the handler
+    EXPECT_TRUE(execute("function() {"
+            "  TestController.deck.handler = function () {"
+            "    engine.setValue('[Test]', 'co', 3);"
+            "  };"
+            "}"));
+    EXPECT_TRUE(cEngine->execute(handler, 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(3.0, co->get());
+
+    // Any object on the path may be replaced, too
+    EXPECT_TRUE(execute("function() {"
+            "  TestController.deck = {"
+            "    value: 5,"
+            "    handler: function () {"
+            "      engine.setValue('[Test]', 'co', this.value);"
+            "    }"
+            "  };"
+            "}"));
+    EXPECT_TRUE(cEngine->execute(handler, 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(5.0, co->get());
+
+    // Handlers may be resolved before the objects are defined
+    const ControllerScriptHandler later =
+            cEngine->resolveHandler("LaterController.handler", 5);
+    EXPECT_FALSE(later.function().isFunction());
+    EXPECT_TRUE(execute("function() {"
+            "  LaterController = { value: 6 };"
+            "  LaterController.handler = function () {"
+            "    engine.setValue('[Test]', 'co', this.value);"
+            "  };"
+            "}"));
+    EXPECT_TRUE(cEngine->execute(later, 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(6.0, co->get());
+
+    // Any other code is wrapped in a function
+    const ControllerScriptHandler wrapped = cEngine->resolveHandler(
+            "function () { engine.setValue('[Test]', 'co', 4); }", 5);
+    EXPECT_TRUE(cEngine->execute(wrapped, 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(4.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, scriptHandlerOfMappingTableEntry) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    EXPECT_TRUE(execute("function() {"
+            "  MappingController = { value: 7 };"
+            "  MappingController.handler = function () {"
+            "    engine.setValue('[Test]', 'co', this.value);"
+            "  };"
+            "}"));
+
+    MidiOptions options;
+    options.script = true;
+    MidiInputMappingTable::Entry entry(MidiInputMapping(
+            MidiKey(MIDI_NOTE_ON, 0x10),
+            options,
+            ConfigKey("[Test]", "MappingController.handler")));
+    const int generation = cEngine->getHandlerGeneration();
+    EXPECT_TRUE(cEngine->execute(entry.scriptHandler(cEngine), 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(7.0, co->get());
+    EXPECT_EQ(generation, cEngine->getHandlerGeneration());
+
+    // Resolved again after the scripts have been reloaded
+    clearHandlerCache();
+    EXPECT_NE(generation, cEngine->getHandlerGeneration());
+    EXPECT_TRUE(execute("function() { MappingController.value = 8; }"));
+    EXPECT_TRUE(cEngine->execute(entry.scriptHandler(cEngine), 0, 0, 0, 0, "[Test]",
+            mixxx::Duration::fromMillis(0)));
+    EXPECT_DOUBLE_EQ(8.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, setValueCoalesced) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    auto seen = std::make_unique<ControlObject>(ConfigKey("[Test]", "seen"));
+    EXPECT_TRUE(execute("function() {"
+            "  engine.setValueCoalesced('[Test]', 'co', 1.0);"
+            "  engine.setValueCoalesced('[Test]', 'co', 2.0);"
+            "  engine.setValue('[Test]', 'seen', engine.getValue('[Test]', 'co'));"
+            "}"));
+    // Only applied after the function has returned
+    EXPECT_DOUBLE_EQ(0.0, seen->get());
+    EXPECT_DOUBLE_EQ(2.0, co->get());
+}
+
+TEST_F(ControllerEngineTest, incomingDataBatch) {
+    auto count = std::make_unique<ControlObject>(ConfigKey("[Test]", "count"));
+    auto sum = std::make_unique<ControlObject>(ConfigKey("[Test]", "sum"));
+
+    ScopedTemporaryFile script(makeTemporaryFile(
+        "var Single = {};"
+        "Single.incomingData = function (data, length) {"
+        "  engine.setValue('[Test]', 'count', engine.getValue('[Test]', 'count') + 1);"
+        "};"
+        "var Batch = {};"
+        "Batch.incomingData = function (data, length) {"
+        "  throw 'not expected';"
+        "};"
+        "Batch.incomingDataBatch = function (reports) {"
+        "  var total = 0;"
+        "  for (var i = 0; i < reports.length; ++i) {"
+        "    total += reports[i].data[0] * reports[i].length;"
+        "  }"
+        "  engine.setValueCoalesced('[Test]', 'sum', total);"
+        "};"));
+    cEngine->evaluate(script->fileName());
+    EXPECT_FALSE(cEngine->hasErrors(script->fileName()));
+    setScriptFunctionPrefixes(cEngine, {"Single", "Batch"});
+
+    QVector<ControllerInputReport> reports;
+    reports.append({QByteArray(1, 2), mixxx::Duration::fromMillis(1)});
+    reports.append({QByteArray(2, 3), mixxx::Duration::fromMillis(2)});
+    reports.append({QByteArray(3, 4), mixxx::Duration::fromMillis(3)});
+    cEngine->receiveIncomingData(reports);
+
+    EXPECT_DOUBLE_EQ(3.0, count->get());
+    EXPECT_DOUBLE_EQ(2 * 1 + 3 * 2 + 4 * 3, sum->get());
+}
+
+namespace {
+
+// Emulates a recording of a high resolution jog wheel that sends 1000
+// messages per second with the occasional fader move in between.
+QVector<QByteArray> jogWheelRecording(int messageCount) {
+    QVector<QByteArray> recording;
+    recording.reserve(messageCount);
+    for (int i = 0; i < messageCount; ++i) {
+        QByteArray message(3, 0);
+        if (i % 50 == 49) {
+            // Fader
+            message[0] = static_cast<char>(0xB0);
+            message[1] = 0x13;
+            message[2] = static_cast<char>(i % 128);
+        } else {
+            // Jog wheel, mostly forward with a few ticks backward
+            message[0] = static_cast<char>(0xB0);
+            message[1] = 0x22;
+            message[2] = (i % 7 == 0) ? 0x3F : 0x41;
+        }
+        recording.append(message);
+    }
+    return recording;
+}
+
+const char* const kBenchmarkScript =
+        "var Bench = { position: 0, fader: 0 };"
+        "Bench.handleMessage = function (control, value) {"
+        "  if (control === 0x22) {"
+        "    this.position += value - 64;"
+        "  } else {"
+        "    this.fader = value / 127;"
+        "  }"
+        "};"
+        "Bench.jog = function (channel, control, value, status, group) {"
+        "  this.handleMessage(control, value);"
+        "  engine.setValue('[Bench]', 'jog', this.position);"
+        "};"
+        "Bench.incomingData = function (data, length) {"
+        "  this.handleMessage(data[1], data[2]);"
+        "  engine.setValue('[Bench]', 'jog', this.position);"
+        "  engine.setValue('[Bench]', 'fader', this.fader);"
+        "};"
+        "var BenchBatch = Object.create(Bench);"
+        "BenchBatch.incomingDataBatch = function (reports) {"
+        "  for (var i = 0; i < reports.length; ++i) {"
+        "    this.handleMessage(reports[i].data[1], reports[i].data[2]);"
+        "    engine.setValueCoalesced('[Bench]', 'jog', this.position);"
+        "    engine.setValueCoalesced('[Bench]', 'fader', this.fader);"
+        "  }"
+        "};";
+
+class BenchmarkEngine {
+  public:
+    BenchmarkEngine()
+            : m_pConfig(new UserSettings(m_tempDir.filePath("test.cfg"))),
+              m_jog(ConfigKey("[Bench]", "jog")),
+              m_fader(ConfigKey("[Bench]", "fader")),
+              m_engine(nullptr, m_pConfig) {
+        m_engine.setPopups(false);
+        m_script.open();
+        m_script.write(kBenchmarkScript);
+        m_script.close();
+        m_engine.evaluate(m_script.fileName());
+    }
+    ~BenchmarkEngine() {
+        m_engine.gracefulShutdown();
+    }
+
+    ControllerEngine* engine() {
+        return &m_engine;
+    }
+
+  private:
+    QTemporaryDir m_tempDir;
+    UserSettingsPointer m_pConfig;
+    ControlObject m_jog;
+    ControlObject m_fader;
+    QTemporaryFile m_script;
+    ControllerEngine m_engine;
+};
+
+} // anonymous namespace
+
+// Replays the recording through a MIDI script binding, either by
+// evaluating the wrapped reference for each message (0) or with the
+// resolved handler (1).
+static void BM_ControllerEngineReplayMidi(benchmark::State& state) {
+    BenchmarkEngine bench;
+    ControllerEngine* pEngine = bench.engine();
+    const QVector<QByteArray> recording = jogWheelRecording(1000);
+    const QString group = "[Channel1]";
+    const QString item = "Bench.jog";
+    for (auto _ : state) {
+        for (const auto& message : recording) {
+            const unsigned char status = message[0];
+            const unsigned char control = message[1];
+            const unsigned char value = message[2];
+            if (state.range(0) == 0) {
+                pEngine->execute(pEngine->wrapFunctionCode(item, 5),
+                        status & 0x0F, control, value, status, group,
+                        mixxx::Duration::fromMillis(0));
+            } else {
+                pEngine->execute(pEngine->resolveHandler(item, 5),
+                        status & 0x0F, control, value, status, group,
+                        mixxx::Duration::fromMillis(0));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * recording.size());
+}
+BENCHMARK(BM_ControllerEngineReplayMidi)->Arg(0)->Arg(1);
+
+// Replays the recording as raw packets in bursts of the given size,
+// handled by incomingData (0) or incomingDataBatch with coalesced
+// setValue (1).
+static void BM_ControllerEngineReplayPackets(benchmark::State& state) {
+    BenchmarkEngine bench;
+    ControllerEngine* pEngine = bench.engine();
+    ControllerEngineTest::setScriptFunctionPrefixes(pEngine,
+            {state.range(0) == 0 ? "Bench" : "BenchBatch"});
+    const QVector<QByteArray> recording = jogWheelRecording(1000);
+    const int burstSize = state.range(1);
+    QVector<QVector<ControllerInputReport>> bursts;
+    for (int i = 0; i < recording.size(); i += burstSize) {
+        QVector<ControllerInputReport> burst;
+        for (int j = i; j < std::min(i + burstSize, recording.size()); ++j) {
+            burst.append({recording[j], mixxx::Duration::fromMillis(j)});
+        }
+        bursts.append(burst);
+    }
+    for (auto _ : state) {
+        for (const auto& burst : bursts) {
+            pEngine->receiveIncomingData(burst);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * recording.size());
+}
+BENCHMARK(BM_ControllerEngineReplayPackets)
+        ->Args({0, 1})
+        ->Args({0, 8})
+        ->Args({1, 1})
+        ->Args({1, 8});
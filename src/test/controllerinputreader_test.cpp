@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QMutex>
+#include <QQueue>
+#include <QSemaphore>
+#include <QWaitCondition>
+#include <atomic>
+#include <ctime>
+#include <thread>
+
+#include "controllers/controllerinputreader.h"
+#include "test/mixxxtest.h"
+#include "util/time.h"
+
+namespace {
+
+// Emulates a device that blocks in read() until a report is pushed
+class MockInputReader : public ControllerInputReader {
+  public:
+    MockInputReader()
+            : ControllerInputReader("MockInputReader") {
+    }
+
+    void push(const QByteArray& report) {
+        QMutexLocker locker(&m_mutex);
+        m_pending.enqueue(report);
+        m_available.wakeOne();
+    }
+
+  protected:
+    int readReport(unsigned char* pData, int maxLength, int timeoutMillis) override {
+        QMutexLocker locker(&m_mutex);
+        if (m_pending.isEmpty() &&
+                !m_available.wait(&m_mutex, timeoutMillis)) {
+            return 0;
+        }
+        if (m_pending.isEmpty()) {
+            return 0;
+        }
+        const QByteArray report = m_pending.dequeue();
+        const int length = std::min(report.size(), maxLength);
+        std::copy(report.constBegin(), report.constBegin() + length, pData);
+        return length;
+    }
+
+  private:
+    QMutex m_mutex;
+    QWaitCondition m_available;
+    QQueue<QByteArray> m_pending;
+};
+
+class ControllerInputReaderTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        QObject::connect(&m_reader,
+                &ControllerInputReader::reportsAvailable,
+                [this] {
+                    const auto reports = m_reader.takeReports();
+                    m_received += reports;
+                    m_receivedCount.release(reports.size());
+                });
+        m_reader.start();
+    }
+
+    void TearDown() override {
+        m_reader.stop();
+    }
+
+    MockInputReader m_reader;
+    QVector<ControllerInputReport> m_received;
+    QSemaphore m_receivedCount;
+};
+
+TEST_F(ControllerInputReaderTest, ReportsArriveInOrder) {
+    const int kReportCount = 100;
+    for (int i = 0; i < kReportCount; ++i) {
+        m_reader.push(QByteArray(1 + i % 8, static_cast<char>(i)));
+    }
+    ASSERT_TRUE(m_receivedCount.tryAcquire(kReportCount, 5000));
+
+    ASSERT_EQ(kReportCount, m_received.size());
+    for (int i = 0; i < kReportCount; ++i) {
+        EXPECT_EQ(QByteArray(1 + i % 8, static_cast<char>(i)),
+                m_received.at(i).data);
+        if (i > 0) {
+            EXPECT_LE(m_received.at(i - 1).timestamp,
+                    m_received.at(i).timestamp);
+        }
+    }
+}
+
+TEST_F(ControllerInputReaderTest, StopWhileIdle) {
+    m_reader.stop();
+    EXPECT_TRUE(m_reader.isFinished());
+}
+
+TEST_F(ControllerInputReaderTest, RestartAfterStop) {
+    m_reader.stop();
+    // Stopping before the thread is running must not be lost
+    m_reader.start();
+    m_reader.stop();
+    EXPECT_TRUE(m_reader.isFinished());
+
+    m_reader.start();
+    m_reader.push(QByteArray(4, '\x01'));
+    ASSERT_TRUE(m_receivedCount.tryAcquire(1, 5000));
+    EXPECT_EQ(QByteArray(4, '\x01'), m_received.last().data);
+}
+
+// Time from the device delivering a report until the controller
+// side has received it.
+static void BM_ControllerInputLatency(benchmark::State& state) {
+    MockInputReader reader;
+    QSemaphore received;
+    QObject::connect(&reader,
+            &ControllerInputReader::reportsAvailable,
+            [&reader, &received] {
+                received.release(reader.takeReports().size());
+            });
+    reader.start(QThread::HighPriority);
+
+    const QByteArray report(16, '\x7F');
+    double latencyNanos = 0;
+    for (auto _ : state) {
+        const mixxx::Duration start = mixxx::Time::elapsed();
+        reader.push(report);
+        received.acquire();
+        latencyNanos += (mixxx::Time::elapsed() - start).toDoubleNanos();
+    }
+    reader.stop();
+    state.counters["latency_us"] =
+            latencyNanos / 1000 / std::max<int64_t>(state.iterations(), 1);
+}
+BENCHMARK(BM_ControllerInputLatency);
+
+const int kIdleMillis = 200;
+
+// CPU time consumed while the device is idle with the blocking reader
+static void BM_ControllerInputIdleCpu(benchmark::State& state) {
+    for (auto _ : state) {
+        MockInputReader reader;
+        reader.start(QThread::HighPriority);
+        const std::clock_t start = std::clock();
+        QThread::msleep(kIdleMillis);
+        state.counters["cpu_ms"] =
+                1000.0 * (std::clock() - start) / CLOCKS_PER_SEC;
+        reader.stop();
+    }
+}
+BENCHMARK(BM_ControllerInputIdleCpu)->Iterations(1)->UseRealTime();
+
+// The same for the previous approach of polling the idle device from
+// a timer thread every millisecond.
+static void BM_ControllerInputIdleCpuPolling(benchmark::State& state) {
+    for (auto _ : state) {
+        std::atomic<bool> stop(false);
+        std::thread poller([&stop] {
+            unsigned char data[255];
+            while (!stop.load()) {
+                benchmark::DoNotOptimize(data);
+                QThread::msleep(1);
+            }
+        });
+        const std::clock_t start = std::clock();
+        QThread::msleep(kIdleMillis);
+        state.counters["cpu_ms"] =
+                1000.0 * (std::clock() - start) / CLOCKS_PER_SEC;
+        stop = true;
+        poller.join();
+    }
+}
+BENCHMARK(BM_ControllerInputIdleCpuPolling)->Iterations(1)->UseRealTime();
+
+} // anonymous namespace
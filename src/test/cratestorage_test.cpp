@@ -1,3 +1,6 @@
+#include <QDir>
+#include <QSqlQuery>
+
 #include "test/librarytest.h"
 
 #include "library/crate/cratestorage.h"
@@ -65,3 +68,59 @@ TEST_F(CrateStorageTest, persistentLifecycle) {
     EXPECT_FALSE(m_crateStorage.readCrateByName(kNewCrateName));
     EXPECT_EQ(kNumCrates - 1, m_crateStorage.countCrates());
 }
+
+TEST_F(CrateStorageTest, summaryFollowsTrackChanges) {
+    TrackPointer pTrack1 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-jpg.mp3"));
+    TrackPointer pTrack2 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-png.mp3"));
+    ASSERT_TRUE(pTrack1 && pTrack2);
+    const TrackId trackId1 = pTrack1->getId();
+    const TrackId trackId2 = pTrack2->getId();
+
+    const auto setDuration = [this](TrackId trackId, double duration) {
+        QSqlQuery query(dbConnection());
+        query.prepare("UPDATE library SET duration=:duration WHERE id=:id");
+        query.bindValue(":duration", duration);
+        query.bindValue(":id", trackId.toVariant());
+        ASSERT_TRUE(query.exec());
+    };
+    setDuration(trackId1, 120.5);
+    setDuration(trackId2, 60.25);
+
+    Crate crate;
+    crate.setName("Crate");
+    CrateId crateId;
+    ASSERT_TRUE(m_crateStorage.onInsertingCrate(crate, &crateId));
+
+    CrateSummary summary;
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(0u, summary.getTrackCount());
+    EXPECT_EQ(0.0, summary.getTrackDuration());
+
+    ASSERT_TRUE(m_crateStorage.onAddingCrateTracks(
+            crateId, QList<TrackId>{trackId1, trackId2}));
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(2u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(180.75, summary.getTrackDuration());
+
+    // Hidden tracks don't count
+    ASSERT_TRUE(internalCollection()->getTrackDAO().hideTracks(
+            QList<TrackId>{trackId2}));
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(1u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(120.5, summary.getTrackDuration());
+
+    ASSERT_TRUE(internalCollection()->getTrackDAO().unhideTracks(
+            QList<TrackId>{trackId2}));
+    setDuration(trackId1, 100.0);
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(2u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(160.25, summary.getTrackDuration());
+
+    ASSERT_TRUE(m_crateStorage.onRemovingCrateTracks(
+            crateId, QList<TrackId>{trackId1}));
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(1u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(60.25, summary.getTrackDuration());
+}
@@ -1,10 +1,15 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
 #include "test/mixxxtest.h"
 
 #include "database/mixxxdb.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/dbconnectionpooled.h"
+#include "util/db/sqltransaction.h"
 
 #include "library/dao/settingsdao.h"
 
@@ -35,3 +40,109 @@ TEST_F(DbConnectionPoolTest, MoveSemantics) {
     EXPECT_TRUE(p1.isPooling());
     EXPECT_FALSE(p2.isPooling());
 }
+
+TEST_F(DbConnectionPoolTest, WriteAheadLog) {
+    const mixxx::DbConnectionPooler pooler(m_mixxxDb.connectionPool());
+    QSqlQuery query(mixxx::DbConnectionPooled(m_mixxxDb.connectionPool()));
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode"));
+    ASSERT_TRUE(query.next());
+    EXPECT_QSTRING_EQ("wal", query.value(0).toString());
+}
+
+TEST_F(DbConnectionPoolTest, ReadOnlyConnection) {
+    const mixxx::DbConnectionPooler pooler(m_mixxxDb.connectionPool());
+    ASSERT_TRUE(MixxxDb::initDatabaseSchema(
+            mixxx::DbConnectionPooled(m_mixxxDb.connectionPool())));
+
+    const mixxx::DbConnectionPooler readOnlyPooler(
+            m_mixxxDb.readOnlyConnectionPool());
+    QSqlQuery query(mixxx::DbConnectionPooled(
+            m_mixxxDb.readOnlyConnectionPool()));
+    EXPECT_TRUE(query.exec("SELECT COUNT(*) FROM library"));
+    EXPECT_FALSE(query.exec(
+            "INSERT INTO settings (name, value) VALUES ('test', 'test')"));
+}
+
+namespace {
+
+const int kBenchmarkTracksPerAlbum = 12;
+
+// Populates the library table of the main database with the given
+// number of tracks. The trailing dots in the strings ensure that
+// sorting is not trivial.
+void populateLibrary(
+        const QSqlDatabase& database,
+        int numTracks) {
+    SqlTransaction transaction(database);
+    QSqlQuery query(database);
+    query.prepare(
+            "INSERT INTO library "
+            "(artist, title, album, duration, bpm, mixxx_deleted) "
+            "VALUES (:artist, :title, :album, :duration, :bpm, 0)");
+    for (int i = 0; i < numTracks; ++i) {
+        const int album = i / kBenchmarkTracksPerAlbum;
+        query.bindValue(":artist", QString("Artist %1").arg(album % 97));
+        query.bindValue(":title", QString("Title %1.").arg(numTracks - i));
+        query.bindValue(":album", QString("Album %1").arg(album));
+        query.bindValue(":duration", 180.0 + (i % 240));
+        query.bindValue(":bpm", 80.0 + (i % 100));
+        query.exec();
+    }
+    transaction.commit();
+}
+
+} // anonymous namespace
+
+// Opening the database and checking the schema is on the
+// critical path during startup.
+static void BM_MixxxDbOpen(benchmark::State& state) {
+    QTemporaryDir tempDir;
+    auto pConfig = UserSettingsPointer(new UserSettings(
+            tempDir.filePath("test.cfg")));
+    {
+        const MixxxDb mixxxDb(pConfig);
+        const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+        MixxxDb::initDatabaseSchema(
+                mixxx::DbConnectionPooled(mixxxDb.connectionPool()));
+    }
+    while (state.KeepRunning()) {
+        const MixxxDb mixxxDb(pConfig);
+        const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+        MixxxDb::initDatabaseSchema(
+                mixxx::DbConnectionPooled(mixxxDb.connectionPool()));
+    }
+}
+BENCHMARK(BM_MixxxDbOpen);
+
+// The typical query for populating the library view, executed
+// on a read-only connection.
+static void BM_LibraryViewQuery(benchmark::State& state) {
+    QTemporaryDir tempDir;
+    auto pConfig = UserSettingsPointer(new UserSettings(
+            tempDir.filePath("test.cfg")));
+    const MixxxDb mixxxDb(pConfig);
+    const mixxx::DbConnectionPooler pooler(mixxxDb.connectionPool());
+    const QSqlDatabase database =
+            mixxx::DbConnectionPooled(mixxxDb.connectionPool());
+    MixxxDb::initDatabaseSchema(database);
+    populateLibrary(database, state.range(0));
+
+    const mixxx::DbConnectionPooler readOnlyPooler(
+            mixxxDb.readOnlyConnectionPool());
+    const QSqlDatabase readOnlyDatabase =
+            mixxx::DbConnectionPooled(mixxxDb.readOnlyConnectionPool());
+    while (state.KeepRunning()) {
+        QSqlQuery query(readOnlyDatabase);
+        query.setForwardOnly(true);
+        query.exec(
+                "SELECT id FROM library WHERE mixxx_deleted=0 "
+                "ORDER BY artist, album, title");
+        int rows = 0;
+        while (query.next()) {
+            ++rows;
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LibraryViewQuery)->Arg(1000)->Arg(10000)->Arg(100000);
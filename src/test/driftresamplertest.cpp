@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "soundio/driftresampler.h"
+#include "util/math.h"
+
+namespace {
+
+const int kChannels = 2;
+const SINT kFramesPerBuffer = 256;
+const double kSampleRate = 44100;
+const double kSineStep = 2 * M_PI * 440 / kSampleRate;
+const CSAMPLE kSineAmplitude = 0.5f;
+
+// Runs the callbacks of the clock reference device and of a device with
+// a drifting clock in the order they would fire and exchanges a sine
+// through the FIFO. Time is measured in periods of the clock reference.
+class DriftSimulation {
+  public:
+    explicit DriftSimulation(double drift)
+            : m_drift(drift),
+              m_fifo(kChannels * kFramesPerBuffer * 3),
+              m_buffer(kChannels * kFramesPerBuffer),
+              m_sineFrame(0),
+              m_lastSample(0),
+              m_maxStep(0),
+              m_receivedFrames(0),
+              m_failures(0) {
+        // Prefilled like in SoundDevicePortAudio::open()
+        std::vector<CSAMPLE> silence(kChannels * kFramesPerBuffer * 3 / 2, 0);
+        m_fifo.write(silence.data(), silence.size());
+    }
+
+    // Output: the clock reference writes, the drifting device resamples
+    void runOutput(int seconds) {
+        DriftResampler resampler(kChannels, kFramesPerBuffer, kSampleRate,
+                2.5 * kFramesPerBuffer);
+        double clkRefTime = 0;
+        double deviceTime = 0;
+        double lastWrite = 0;
+        while (clkRefTime < periods(seconds)) {
+            if (clkRefTime <= deviceTime) {
+                generateSine();
+                m_fifo.write(m_buffer.data(), m_buffer.size());
+                lastWrite = clkRefTime;
+                clkRefTime += 1;
+            } else {
+                resampler.updateFillLevel(
+                        m_fifo.readAvailable() / kChannels +
+                        math_min(deviceTime - lastWrite, 1.0) * kFramesPerBuffer);
+                if (!resampler.readFrom(&m_fifo, m_buffer.data(), kFramesPerBuffer)) {
+                    ++m_failures;
+                }
+                receive();
+                deviceTime += 1 / (1 + m_drift);
+            }
+        }
+        m_ratio = resampler.ratio();
+    }
+
+    // Input: the drifting device resamples, the clock reference reads
+    void runInput(int seconds) {
+        DriftResampler resampler(kChannels, kFramesPerBuffer, kSampleRate,
+                1.5 * kFramesPerBuffer);
+        double clkRefTime = 0;
+        double deviceTime = 0;
+        double lastRead = 0;
+        while (clkRefTime < periods(seconds)) {
+            if (deviceTime <= clkRefTime) {
+                resampler.updateFillLevel(
+                        m_fifo.readAvailable() / kChannels + kFramesPerBuffer -
+                        math_min(deviceTime - lastRead, 1.0) * kFramesPerBuffer);
+                generateSine();
+                if (!resampler.writeTo(&m_fifo, m_buffer.data(), kFramesPerBuffer)) {
+                    ++m_failures;
+                }
+                deviceTime += 1 / (1 + m_drift);
+            } else {
+                if (m_fifo.read(m_buffer.data(), m_buffer.size()) <
+                        static_cast<int>(m_buffer.size())) {
+                    ++m_failures;
+                }
+                receive();
+                lastRead = clkRefTime;
+                clkRefTime += 1;
+            }
+        }
+        m_ratio = resampler.ratio();
+    }
+
+    double ratio() const {
+        return m_ratio;
+    }
+
+    // The largest difference between two adjacent samples. A skipped or
+    // duplicated frame would exceed the largest step of the sine itself.
+    double maxStep() const {
+        return m_maxStep;
+    }
+
+    int failures() const {
+        return m_failures;
+    }
+
+  private:
+    static double periods(int seconds) {
+        return seconds * kSampleRate / kFramesPerBuffer;
+    }
+
+    void generateSine() {
+        for (SINT i = 0; i < kFramesPerBuffer; ++i) {
+            const CSAMPLE sample = kSineAmplitude * sin(kSineStep * m_sineFrame++);
+            for (int channel = 0; channel < kChannels; ++channel) {
+                m_buffer[i * kChannels + channel] = sample;
+            }
+        }
+    }
+
+    void receive() {
+        for (SINT i = 0; i < kFramesPerBuffer; ++i) {
+            const CSAMPLE sample = m_buffer[i * kChannels];
+            // Skip the prefilled silence and the fade in of the sine
+            if (m_receivedFrames++ > 4 * kFramesPerBuffer) {
+                m_maxStep = math_max(m_maxStep,
+                        static_cast<double>(fabs(sample - m_lastSample)));
+            }
+            m_lastSample = sample;
+        }
+    }
+
+    const double m_drift;
+    FIFO<CSAMPLE> m_fifo;
+    std::vector<CSAMPLE> m_buffer;
+    SINT m_sineFrame;
+    CSAMPLE m_lastSample;
+    double m_maxStep;
+    SINT m_receivedFrames;
+    int m_failures;
+    double m_ratio;
+};
+
+TEST(DriftResamplerTest, PassThroughAtUnityRatio) {
+    DriftResampler resampler(kChannels, kFramesPerBuffer, kSampleRate,
+            kFramesPerBuffer);
+    FIFO<CSAMPLE> fifo(kChannels * kFramesPerBuffer * 4);
+
+    std::vector<CSAMPLE> input(kChannels * kFramesPerBuffer);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<CSAMPLE>(i % 13) / 13;
+    }
+    ASSERT_TRUE(resampler.writeTo(&fifo, input.data(), kFramesPerBuffer));
+    ASSERT_TRUE(resampler.writeTo(&fifo, input.data(), kFramesPerBuffer));
+    EXPECT_EQ(1.0, resampler.ratio());
+
+    // The first frame is output without delay, only the look ahead
+    // of the kernel stays inside the resampler.
+    std::vector<CSAMPLE> output(input.size());
+    ASSERT_EQ(static_cast<int>(output.size()),
+            fifo.read(output.data(), output.size()));
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_NEAR(input[i], output[i], 1e-6);
+    }
+}
+
+TEST(DriftResamplerTest, OutputFollowsFasterDevice) {
+    DriftSimulation simulation(1e-3);
+    simulation.runOutput(60);
+    EXPECT_NEAR(1 / (1 + 1e-3), simulation.ratio(), 1e-6);
+    EXPECT_EQ(0, simulation.failures());
+    EXPECT_LE(simulation.maxStep(), kSineAmplitude * kSineStep * 1.01);
+}
+
+TEST(DriftResamplerTest, OutputFollowsSlowerDevice) {
+    DriftSimulation simulation(-2e-4);
+    simulation.runOutput(60);
+    EXPECT_NEAR(1 / (1 - 2e-4), simulation.ratio(), 1e-6);
+    EXPECT_EQ(0, simulation.failures());
+    EXPECT_LE(simulation.maxStep(), kSineAmplitude * kSineStep * 1.01);
+}
+
+TEST(DriftResamplerTest, InputFollowsFasterDevice) {
+    DriftSimulation simulation(1e-3);
+    simulation.runInput(60);
+    EXPECT_NEAR(1 + 1e-3, simulation.ratio(), 1e-6);
+    EXPECT_EQ(0, simulation.failures());
+    EXPECT_LE(simulation.maxStep(), kSineAmplitude * kSineStep * 1.01);
+}
+
+TEST(DriftResamplerTest, InputFollowsSlowerDevice) {
+    DriftSimulation simulation(-2e-4);
+    simulation.runInput(60);
+    EXPECT_NEAR(1 - 2e-4, simulation.ratio(), 1e-6);
+    EXPECT_EQ(0, simulation.failures());
+    EXPECT_LE(simulation.maxStep(), kSineAmplitude * kSineStep * 1.01);
+}
+
+static void BM_DriftResamplerReadFrom(benchmark::State& state) {
+    const SINT framesPerBuffer = state.range(0);
+    DriftResampler resampler(kChannels, framesPerBuffer, kSampleRate,
+            2 * framesPerBuffer);
+    FIFO<CSAMPLE> fifo(kChannels * framesPerBuffer * 4);
+    std::vector<CSAMPLE> buffer(kChannels * framesPerBuffer, 0.5f);
+    fifo.write(buffer.data(), buffer.size());
+    for (auto _ : state) {
+        // Includes the copy the clock reference device does anyway
+        fifo.write(buffer.data(), buffer.size());
+        resampler.updateFillLevel(fifo.readAvailable() / kChannels);
+        resampler.readFrom(&fifo, buffer.data(), framesPerBuffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * framesPerBuffer);
+}
+BENCHMARK(BM_DriftResamplerReadFrom)->Range(64, 4096);
+
+} // anonymous namespace
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <QVector>
+#include <cmath>
+
+#include "engine/filters/enginefilterbessel4.h"
+#include "engine/filters/enginefilterbessel8.h"
+#include "engine/filters/enginefilterbiquad1.h"
+#include "engine/filters/enginefilterbutterworth8.h"
+#include "engine/filters/enginefilterlinkwitzriley2.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kBufferSize = 1024; // interleaved stereo samples
+constexpr int kBufferCount = 8;
+// The output is converted to float, the channels must only differ by
+// rounding errors
+constexpr CSAMPLE kMaxDeviation = 1e-5f;
+
+// Runs the filter cascade of EngineFilterIIR with a separate double for
+// each channel, as the scalar reference for the SIMD lanes of process().
+template<typename Filter>
+class ScalarReferenceFilter : public Filter {
+  public:
+    template<typename... Args>
+    explicit ScalarReferenceFilter(Args... args)
+            : Filter(args...),
+              m_leftBuf(),
+              m_rightBuf() {
+        // Skip the ramping of the first buffer
+        this->assumeSettled();
+    }
+
+    void processScalar(const CSAMPLE* pIn, CSAMPLE* pOutput, const int iBufferSize) {
+        for (int i = 0; i < iBufferSize; i += 2) {
+            pOutput[i] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, m_leftBuf, static_cast<double>(pIn[i])));
+            pOutput[i + 1] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, m_rightBuf, static_cast<double>(pIn[i + 1])));
+        }
+    }
+
+    // For filter types that no filter in Mixxx designs with fidlib
+    void setCoefficients(double gain, double feedback) {
+        this->m_coef[0] = gain;
+        for (size_t i = 1; i < sizeof(this->m_coef) / sizeof(double); ++i) {
+            this->m_coef[i] = feedback;
+        }
+    }
+
+  private:
+    double m_leftBuf[sizeof(ScalarReferenceFilter::m_buf) / sizeof(StereoDouble)];
+    double m_rightBuf[sizeof(ScalarReferenceFilter::m_buf) / sizeof(StereoDouble)];
+};
+
+class EngineFilterIIRTest : public testing::Test {
+  protected:
+    EngineFilterIIRTest()
+            : m_input(kBufferSize) {
+        // Different signals on both channels, so that swapped lanes fail
+        for (int i = 0; i < kBufferSize; i += 2) {
+            const int frame = i / 2;
+            m_input[i] = static_cast<CSAMPLE>(
+                    0.5 * std::sin(frame * 0.05) + 0.3 * std::sin(frame * 1.3));
+            m_input[i + 1] = static_cast<CSAMPLE>(
+                    0.7 * std::sin(frame * 0.11) - 0.2 * std::sin(frame * 2.1));
+        }
+    }
+
+    // Compares process() of one filter to the scalar processing of another
+    // filter with the same coefficients
+    template<typename Filter>
+    void expectSameOutput(Filter* pFilter, Filter* pReference) {
+        QVector<CSAMPLE> output(kBufferSize);
+        QVector<CSAMPLE> expected(kBufferSize);
+        // Multiple buffers to verify the state that is kept in between
+        for (int buffer = 0; buffer < kBufferCount; ++buffer) {
+            pFilter->process(m_input.constData(), output.data(), kBufferSize);
+            pReference->processScalar(m_input.constData(), expected.data(), kBufferSize);
+            for (int i = 0; i < kBufferSize; ++i) {
+                ASSERT_TRUE(std::isfinite(expected[i]));
+                ASSERT_NEAR(expected[i], output[i], kMaxDeviation)
+                        << "buffer " << buffer << " sample " << i;
+            }
+        }
+    }
+
+    template<typename Filter, typename... Args>
+    void expectSameOutputAsScalar(Args... args) {
+        ScalarReferenceFilter<Filter> filter(args...);
+        ScalarReferenceFilter<Filter> reference(args...);
+        expectSameOutput(&filter, &reference);
+    }
+
+    QVector<CSAMPLE> m_input;
+};
+
+TEST_F(EngineFilterIIRTest, Bessel4) {
+    // <4, IIR_LP>, <8, IIR_BP>, <4, IIR_HP>
+    expectSameOutputAsScalar<EngineFilterBessel4Low>(kSampleRate, 1000.0);
+    expectSameOutputAsScalar<EngineFilterBessel4Band>(kSampleRate, 200.0, 2000.0);
+    expectSameOutputAsScalar<EngineFilterBessel4High>(kSampleRate, 1000.0);
+}
+
+TEST_F(EngineFilterIIRTest, Bessel8) {
+    // <8, IIR_LP>, <16, IIR_BP>, <8, IIR_HP>
+    expectSameOutputAsScalar<EngineFilterBessel8Low>(kSampleRate, 1000.0);
+    expectSameOutputAsScalar<EngineFilterBessel8Band>(kSampleRate, 200.0, 2000.0);
+    expectSameOutputAsScalar<EngineFilterBessel8High>(kSampleRate, 1000.0);
+}
+
+TEST_F(EngineFilterIIRTest, Butterworth8) {
+    expectSameOutputAsScalar<EngineFilterButterworth8Low>(kSampleRate, 1000.0);
+    expectSameOutputAsScalar<EngineFilterButterworth8Band>(kSampleRate, 200.0, 2000.0);
+    expectSameOutputAsScalar<EngineFilterButterworth8High>(kSampleRate, 1000.0);
+}
+
+TEST_F(EngineFilterIIRTest, Biquad1) {
+    // <5, IIR_BP>
+    expectSameOutputAsScalar<EngineFilterBiquad1LowShelving>(kSampleRate, 500.0, 0.7);
+    expectSameOutputAsScalar<EngineFilterBiquad1Peaking>(kSampleRate, 1000.0, 1.75);
+    expectSameOutputAsScalar<EngineFilterBiquad1HighShelving>(kSampleRate, 2000.0, 0.7);
+    // <2, IIR_LP>, <2, IIR_BP>, <2, IIR_HP>
+    expectSameOutputAsScalar<EngineFilterBiquad1Low>(kSampleRate, 1000.0, 0.7, false);
+    expectSameOutputAsScalar<EngineFilterBiquad1Band>(kSampleRate, 1000.0, 0.7);
+    expectSameOutputAsScalar<EngineFilterBiquad1High>(kSampleRate, 1000.0, 0.7, false);
+}
+
+TEST_F(EngineFilterIIRTest, LinkwitzRiley2) {
+    // <2, IIR_LP2>, <2, IIR_HP2>
+    expectSameOutputAsScalar<EngineFilterLinkwitzRiley2Low>(kSampleRate, 1000.0);
+    expectSameOutputAsScalar<EngineFilterLinkwitzRiley2High>(kSampleRate, 1000.0);
+}
+
+TEST_F(EngineFilterIIRTest, OnePoleCascade) {
+    // <4, IIR_LPMO>, <4, IIR_HPMO> with four stable one pole sections
+    ScalarReferenceFilter<EngineFilterIIR<4, IIR_LPMO>> lowFilter;
+    ScalarReferenceFilter<EngineFilterIIR<4, IIR_LPMO>> lowReference;
+    lowFilter.setCoefficients(0.05, -0.9);
+    lowReference.setCoefficients(0.05, -0.9);
+    expectSameOutput(&lowFilter, &lowReference);
+
+    ScalarReferenceFilter<EngineFilterIIR<4, IIR_HPMO>> highFilter;
+    ScalarReferenceFilter<EngineFilterIIR<4, IIR_HPMO>> highReference;
+    highFilter.setCoefficients(0.9, -0.9);
+    highReference.setCoefficients(0.9, -0.9);
+    expectSameOutput(&highFilter, &highReference);
+}
+
+} // anonymous namespace
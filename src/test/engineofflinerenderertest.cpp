@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <sndfile.h>
+
+#include <QTemporaryDir>
+#include <QVector>
+
+#include "effects/builtin/builtinbackend.h"
+#include "effects/effect.h"
+#include "effects/effectchain.h"
+#include "effects/effectchainslot.h"
+#include "effects/effectrack.h"
+#include "engine/engineofflinerenderer.h"
+#include "test/signalpathtest.h"
+
+namespace {
+
+const SINT kFramesPerBuffer = 512;
+const double kSampleRate = 44100;
+
+const QStringList kBenchmarkEffectIds = {
+        "org.mixxx.effects.echo",
+        "org.mixxx.effects.filter"};
+
+class EngineOfflineRendererTest : public SignalPathTest {
+  protected:
+    EngineOfflineRendererTest()
+            : m_renderer(m_pEngineMaster, kFramesPerBuffer, kSampleRate) {
+    }
+
+    EngineOfflineRenderer m_renderer;
+};
+
+TEST_F(EngineOfflineRendererTest, ControlChangesAreSampleAccurate) {
+    const SINT kPlayPosition = 1000;
+    m_renderer.scheduleControlChange(
+            kPlayPosition, ConfigKey(m_sGroup1, "play"), 1.0);
+
+    QVector<SINT> bufferPositions;
+    QVector<CSAMPLE> output;
+    m_renderer.render(4 * kFramesPerBuffer,
+            [&](const CSAMPLE* pBuffer, SINT frameCount) {
+                bufferPositions.append(output.size() / 2);
+                for (SINT i = 0; i < frameCount * 2; ++i) {
+                    output.append(pBuffer[i]);
+                }
+            });
+    EXPECT_EQ(4 * kFramesPerBuffer, m_renderer.framePosition());
+    ASSERT_EQ(4 * kFramesPerBuffer * 2, output.size());
+
+    // The buffer is split at the scheduled position
+    EXPECT_EQ(QVector<SINT>({0, 512, kPlayPosition, kPlayPosition + kFramesPerBuffer}), bufferPositions);
+
+    // Silence before the deck starts playing, the sine afterwards
+    for (SINT i = 0; i < kPlayPosition * 2; ++i) {
+        ASSERT_EQ(0.0f, output[i]) << "at sample " << i;
+    }
+    CSAMPLE peak = 0;
+    for (SINT i = kPlayPosition * 2; i < output.size(); ++i) {
+        peak = math_max(peak, std::abs(output[i]));
+    }
+    EXPECT_LT(0.1f, peak);
+}
+
+TEST_F(EngineOfflineRendererTest, RenderToFile) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QString fileName = tempDir.filePath("mix.wav");
+
+    m_renderer.scheduleControlChange(0, ConfigKey(m_sGroup1, "play"), 1.0);
+    ASSERT_TRUE(m_renderer.renderToFile(fileName, 3 * kFramesPerBuffer + 7));
+
+    SF_INFO sfInfo;
+    memset(&sfInfo, 0, sizeof(sfInfo));
+    SNDFILE* pSndFile = sf_open(QFile::encodeName(fileName), SFM_READ, &sfInfo);
+    ASSERT_NE(nullptr, pSndFile);
+    EXPECT_EQ(3 * kFramesPerBuffer + 7, sfInfo.frames);
+    EXPECT_EQ(2, sfInfo.channels);
+    EXPECT_EQ(44100, sfInfo.samplerate);
+    sf_close(pSndFile);
+}
+
+// The signal path fixture as a benchmark
+class EngineOfflineRendererBenchmark : public SignalPathTest {
+  public:
+    void TestBody() override {
+    }
+
+    Deck* deck(int index) {
+        switch (index) {
+        case 0:
+            return m_pMixerDeck1;
+        case 1:
+            return m_pMixerDeck2;
+        default:
+            return m_pMixerDeck3;
+        }
+    }
+
+    TestEngineMaster* engineMaster() {
+        return m_pEngineMaster;
+    }
+
+    // Loads an enabled chain with an echo and a filter into its own effect
+    // unit for each of the given decks.
+    void addEffectChains(int deckCount) {
+        m_pEffectsManager->addEffectsBackend(new BuiltInBackend(m_pEffectsManager));
+        StandardEffectRackPointer pRack = m_pEffectsManager->addStandardEffectRack();
+        for (int i = 0; i < deckCount; ++i) {
+            EffectChainPointer pChain(new EffectChain(m_pEffectsManager,
+                    QString("org.mixxx.test.benchmarkchain%1").arg(i)));
+            pRack->getEffectChainSlot(i)->loadEffectChainToSlot(pChain);
+            for (const auto& effectId : kBenchmarkEffectIds) {
+                EffectPointer pEffect = m_pEffectsManager->instantiateEffect(effectId);
+                pEffect->setEnabled(true);
+                pChain->addEffect(pEffect);
+            }
+            pChain->setEnabled(true);
+            pChain->setMix(1.0);
+            const EngineChannel* pChannel = deck(i)->getEngineDeck();
+            pChain->enableForInputChannel(ChannelHandleAndGroup(
+                    pChannel->getHandle(), pChannel->getGroup()));
+        }
+    }
+};
+
+// Renders the full engine with the given number of playing decks, each
+// with its own effect chain. The audio_s counter reports the seconds of
+// audio per second of CPU.
+static void BM_EngineOfflineRender(benchmark::State& state) {
+    const int deckCount = state.range(0);
+    EngineOfflineRendererBenchmark fixture;
+    fixture.addEffectChains(deckCount);
+    EngineOfflineRenderer renderer(
+            fixture.engineMaster(), kFramesPerBuffer, kSampleRate);
+    for (int i = 0; i < deckCount; ++i) {
+        const QString group = fixture.deck(i)->getGroup();
+        renderer.scheduleControlChange(0, ConfigKey(group, "play"), 1.0);
+        renderer.scheduleControlChange(0, ConfigKey(group, "repeat"), 1.0);
+    }
+
+    const SINT kFramesPerIteration = 16 * kFramesPerBuffer;
+    for (auto _ : state) {
+        renderer.render(kFramesPerIteration);
+    }
+    state.counters["audio_s"] = benchmark::Counter(
+            state.iterations() * kFramesPerIteration / kSampleRate,
+            benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EngineOfflineRender)->DenseRange(1, 3);
+
+} // anonymous namespace
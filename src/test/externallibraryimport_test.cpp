@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtSql>
+
+#include "library/externallibraryimport.h"
+#include "library/queryutil.h"
+#include "test/librarytest.h"
+
+namespace {
+
+const QString kStampKey = "mixxx.test.externallibraryimport.stamp";
+
+class ExternalLibraryImportTest : public LibraryTest {
+  protected:
+    void TearDown() override {
+        QSqlQuery query(dbConnection());
+        query.exec("DELETE FROM traktor_library");
+    }
+
+    int upsertTracks(const QStringList& titles) {
+        ScopedTransaction transaction(dbConnection());
+        ExternalTrackTableUpdater updater(
+                dbConnection(),
+                &transaction,
+                "traktor_library",
+                "location",
+                QStringList{"title", "bpm"});
+        EXPECT_TRUE(updater.prepare());
+        for (const auto& title : titles) {
+            EXPECT_LE(0, updater.upsert(
+                    "/music/" + title + ".mp3",
+                    QVariantList{title, 120.5f}));
+        }
+        EXPECT_TRUE(updater.removeUnvisited());
+        transaction.commit();
+        m_insertedCount = updater.insertedCount();
+        m_removedCount = updater.removedCount();
+        return updater.updatedCount();
+    }
+
+    int countTracks() {
+        QSqlQuery query(dbConnection());
+        EXPECT_TRUE(query.exec("SELECT COUNT(*) FROM traktor_library"));
+        EXPECT_TRUE(query.next());
+        return query.value(0).toInt();
+    }
+
+    int m_insertedCount = 0;
+    int m_removedCount = 0;
+};
+
+TEST_F(ExternalLibraryImportTest, UpsertOnlyChangedRows) {
+    EXPECT_EQ(0, upsertTracks({"a", "b", "c"}));
+    EXPECT_EQ(3, m_insertedCount);
+    EXPECT_EQ(3, countTracks());
+
+    // Nothing changed
+    EXPECT_EQ(0, upsertTracks({"a", "b", "c"}));
+    EXPECT_EQ(0, m_insertedCount);
+    EXPECT_EQ(0, m_removedCount);
+
+    // One track added and one removed
+    EXPECT_EQ(0, upsertTracks({"a", "c", "d"}));
+    EXPECT_EQ(1, m_insertedCount);
+    EXPECT_EQ(1, m_removedCount);
+    EXPECT_EQ(3, countTracks());
+}
+
+TEST_F(ExternalLibraryImportTest, RollbackIncompleteImport) {
+    EXPECT_EQ(0, upsertTracks({"a", "b"}));
+    EXPECT_EQ(2, countTracks());
+
+    {
+        // Without a transaction nothing is committed in batches
+        ScopedTransaction transaction(dbConnection());
+        ExternalTrackTableUpdater updater(
+                dbConnection(),
+                nullptr,
+                "traktor_library",
+                "location",
+                QStringList{"title", "bpm"});
+        EXPECT_TRUE(updater.prepare());
+        for (int i = 0; i < 2000; ++i) {
+            EXPECT_LE(0, updater.upsert(
+                    QString("/music/new%1.mp3").arg(i),
+                    QVariantList{QString::number(i), 120.5f}));
+        }
+        EXPECT_TRUE(transaction.rollback());
+    }
+    EXPECT_EQ(2, countTracks());
+}
+
+TEST_F(ExternalLibraryImportTest, FileStamp) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    QFile file(tempDir.filePath("collection.xml"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("<collection/>");
+    file.close();
+
+    const ExternalLibraryFileStamp stamp({QFileInfo(file)});
+    ASSERT_TRUE(stamp.isValid());
+    EXPECT_FALSE(stamp.isStored(dbConnection(), kStampKey));
+    EXPECT_TRUE(stamp.store(dbConnection(), kStampKey));
+    EXPECT_TRUE(stamp.isStored(dbConnection(), kStampKey));
+
+    // The size of the file has changed
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write("\n");
+    file.close();
+    EXPECT_FALSE(ExternalLibraryFileStamp({QFileInfo(file)}).isStored(
+            dbConnection(), kStampKey));
+
+    ExternalLibraryFileStamp::clear(dbConnection(), kStampKey);
+    EXPECT_FALSE(stamp.isStored(dbConnection(), kStampKey));
+
+    EXPECT_FALSE(ExternalLibraryFileStamp(
+            {QFileInfo(tempDir.filePath("missing.xml"))}).isValid());
+}
+
+} // anonymous namespace
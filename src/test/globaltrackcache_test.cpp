@@ -82,7 +82,10 @@ class GlobalTrackCacheTest: public MixxxTest, public virtual GlobalTrackCacheSav
 
   protected:
     GlobalTrackCacheTest() {
-        GlobalTrackCache::createInstance(this, deleteTrack);
+        GlobalTrackCache::createInstance(
+                this,
+                GlobalTrackCache::EvictedTrackSaving::Immediate,
+                deleteTrack);
     }
     ~GlobalTrackCacheTest() {
         GlobalTrackCache::destroyInstance();
@@ -216,3 +219,67 @@ TEST_F(GlobalTrackCacheTest, evictWhileMoving) {
 
     EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
 }
+
+class GlobalTrackCacheWriteBehindTest: public MixxxTest, public virtual GlobalTrackCacheSaver {
+  public:
+    void saveEvictedTrack(Track* pTrack) noexcept override {
+        ASSERT_FALSE(pTrack == nullptr);
+        m_savedTitles.append(pTrack->getTitle());
+    }
+    void saveEvictedTracks(const QList<Track*>& evictedTracks) noexcept override {
+        m_batchSizes.append(evictedTracks.size());
+        GlobalTrackCacheSaver::saveEvictedTracks(evictedTracks);
+    }
+
+  protected:
+    GlobalTrackCacheWriteBehindTest() {
+        GlobalTrackCache::createInstance(
+                this,
+                GlobalTrackCache::EvictedTrackSaving::Deferred);
+    }
+    ~GlobalTrackCacheWriteBehindTest() {
+        GlobalTrackCacheLocker().deactivateCache();
+        GlobalTrackCache::destroyInstance();
+        // Tracks are deleted later
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    TrackPointer newDirtyTrack(const TrackFile& fileInfo, TrackId trackId) {
+        GlobalTrackCacheResolver resolver(fileInfo);
+        TrackPointer track = resolver.getTrack();
+        resolver.initTrackIdAndUnlockCache(trackId);
+        track->setTitle(QString("Title %1").arg(trackId.toString()));
+        return track;
+    }
+
+    QStringList m_savedTitles;
+    QList<int> m_batchSizes;
+};
+
+TEST_F(GlobalTrackCacheWriteBehindTest, saveEvictedTracksTogether) {
+    const TrackId trackId1(1);
+    const TrackId trackId2(2);
+    TrackPointer track1 = newDirtyTrack(kTestFile, trackId1);
+    TrackPointer track2 = newDirtyTrack(kTestFile2, trackId2);
+
+    track1.reset();
+    // Still cached with the unsaved modifications
+    EXPECT_TRUE(m_savedTitles.isEmpty());
+    track1 = GlobalTrackCacheLocker().lookupTrackById(trackId1);
+    ASSERT_TRUE(static_cast<bool>(track1));
+    EXPECT_EQ(QStringLiteral("Title 1"), track1->getTitle());
+    EXPECT_TRUE(track1->isDirty());
+
+    track1.reset();
+    track2.reset();
+    EXPECT_TRUE(m_savedTitles.isEmpty());
+
+    GlobalTrackCacheLocker().savePendingTracks();
+
+    // Both tracks are saved once, at the same time
+    EXPECT_EQ(QList<int>{2}, m_batchSizes);
+    EXPECT_EQ(2, m_savedTitles.size());
+    EXPECT_TRUE(m_savedTitles.contains(QStringLiteral("Title 1")));
+    EXPECT_TRUE(m_savedTitles.contains(QStringLiteral("Title 2")));
+    EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
+}
@@ -21,6 +21,10 @@ std::unique_ptr<TrackCollectionManager> newTrackCollectionManager(
             nullptr,
             std::move(userSettings),
             std::move(dbConnectionPool),
+            // Tests rely on synchronous queries in the main thread
+            mixxx::DbConnectionPoolPtr(),
+            // Tests expect modified tracks to be saved when evicted
+            GlobalTrackCache::EvictedTrackSaving::Immediate,
             deleteTrack);
 }
 
@@ -525,3 +525,27 @@ TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_14BitPitchBend) {
     receive(MIDI_PITCH_BEND | channel, 0x01, 0x40);
     EXPECT_LT(kMiddleValue, potmeter.get());
 }
+
+TEST_F(MidiControllerTest, ReceiveMessage_ControlCreatedAfterLoadingPreset) {
+    ConfigKey key("[Channel1]", "rate");
+    unsigned char channel = 0x01;
+    unsigned char control = 0x10;
+
+    addMapping(MidiInputMapping(MidiKey(MIDI_CC | channel, control),
+                                MidiOptions(), key));
+    loadPreset(m_preset);
+
+    // Messages for missing controls are ignored
+    receive(MIDI_CC | channel, control, 0x7F);
+
+    {
+        ControlPotmeter potmeter(key, -1.0, 1.0);
+        receive(MIDI_CC | channel, control, 0x7F);
+        EXPECT_DOUBLE_EQ(1.0, potmeter.get());
+    }
+
+    // The mapping must not refer to the deleted control anymore
+    ControlPotmeter potmeter(key, -1.0, 1.0);
+    receive(MIDI_CC | channel, control, 0x00);
+    EXPECT_DOUBLE_EQ(-1.0, potmeter.get());
+}
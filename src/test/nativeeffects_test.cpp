@@ -94,3 +94,84 @@ DECLARE_EFFECT_BENCHMARK(ReverbEffect)
 
 }  // namespace
 #endif
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "engine/filters/enginefilterbessel8.h"
+#include "engine/filters/enginefilterbiquad1.h"
+#include "engine/filters/enginefilterlinkwitzriley8.h"
+#include "util/samplebuffer.h"
+
+// Benchmarks of the IIR filters of one deck EQ or QuickEffect filter,
+// processing a stereo buffer of the given number of samples
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+
+void benchmarkFilters(benchmark::State& state,
+        const std::vector<std::unique_ptr<EngineFilterIIRBase>>& filters) {
+    const SINT numSamples = state.range(0);
+    mixxx::SampleBuffer input(numSamples);
+    mixxx::SampleBuffer output(numSamples);
+    for (SINT i = 0; i < numSamples; ++i) {
+        input.data()[i] = static_cast<CSAMPLE>((i * 7919) % 2000) / 1000 - 1;
+    }
+    for (const auto& pFilter : filters) {
+        pFilter->assumeSettled();
+    }
+    for (auto _ : state) {
+        for (const auto& pFilter : filters) {
+            pFilter->process(input.data(), output.data(), numSamples);
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numSamples);
+}
+
+} // anonymous namespace
+
+// The two crossovers of LinkwitzRiley8EQEffect
+static void BM_DeckEqFilters_LinkwitzRiley8(benchmark::State& state) {
+    std::vector<std::unique_ptr<EngineFilterIIRBase>> filters;
+    filters.push_back(std::make_unique<EngineFilterLinkwitzRiley8Low>(kSampleRate, 250));
+    filters.push_back(std::make_unique<EngineFilterLinkwitzRiley8High>(kSampleRate, 250));
+    filters.push_back(std::make_unique<EngineFilterLinkwitzRiley8Low>(kSampleRate, 2500));
+    filters.push_back(std::make_unique<EngineFilterLinkwitzRiley8High>(kSampleRate, 2500));
+    benchmarkFilters(state, filters);
+}
+BENCHMARK(BM_DeckEqFilters_LinkwitzRiley8)->Arg(128)->Arg(512)->Arg(2048);
+
+// The low and band pass of Bessel8LVMixEQEffect
+static void BM_DeckEqFilters_Bessel8LVMix(benchmark::State& state) {
+    std::vector<std::unique_ptr<EngineFilterIIRBase>> filters;
+    filters.push_back(std::make_unique<EngineFilterBessel8Low>(kSampleRate, 250));
+    filters.push_back(std::make_unique<EngineFilterBessel8Band>(kSampleRate, 250, 2500));
+    benchmarkFilters(state, filters);
+}
+BENCHMARK(BM_DeckEqFilters_Bessel8LVMix)->Arg(128)->Arg(512)->Arg(2048);
+
+// The boost and kill filters of BiquadFullKillEQEffect
+static void BM_DeckEqFilters_BiquadFullKill(benchmark::State& state) {
+    std::vector<std::unique_ptr<EngineFilterIIRBase>> filters;
+    filters.push_back(std::make_unique<EngineFilterBiquad1Peaking>(kSampleRate, 100, 0.7));
+    filters.push_back(std::make_unique<EngineFilterBiquad1Peaking>(kSampleRate, 1000, 0.7));
+    filters.push_back(std::make_unique<EngineFilterBiquad1Peaking>(kSampleRate, 8000, 0.7));
+    filters.push_back(std::make_unique<EngineFilterBiquad1LowShelving>(kSampleRate, 250, 0.7));
+    filters.push_back(std::make_unique<EngineFilterBiquad1Peaking>(kSampleRate, 1000, 0.7));
+    filters.push_back(std::make_unique<EngineFilterBiquad1HighShelving>(kSampleRate, 2500, 0.7));
+    benchmarkFilters(state, filters);
+}
+BENCHMARK(BM_DeckEqFilters_BiquadFullKill)->Arg(128)->Arg(512)->Arg(2048);
+
+// The filters of the QuickEffect FilterEffect
+static void BM_DeckEqFilters_QuickEffectFilter(benchmark::State& state) {
+    std::vector<std::unique_ptr<EngineFilterIIRBase>> filters;
+    filters.push_back(std::make_unique<EngineFilterBiquad1Low>(kSampleRate, 2000, 0.7, true));
+    filters.push_back(std::make_unique<EngineFilterBiquad1High>(kSampleRate, 200, 0.7, true));
+    benchmarkFilters(state, filters);
+}
+BENCHMARK(BM_DeckEqFilters_QuickEffectFilter)->Arg(128)->Arg(512)->Arg(2048);
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+
+#include "library/dao/playlistdao.h"
+#include "test/librarytest.h"
+
+class PlaylistDAOTest : public LibraryTest {
+  protected:
+    PlaylistDAOTest()
+            : m_playlistDao(internalCollection()->getPlaylistDAO()) {
+        m_playlistId = m_playlistDao.createPlaylist("Playlist");
+        // The tracks don't need to exist in the library
+        for (int i = 1; i <= 6; ++i) {
+            m_playlistDao.appendTrackToPlaylist(TrackId(i), m_playlistId);
+        }
+    }
+
+    // The track ids ordered by position, the positions must be unique
+    QList<int> trackIdsInOrder() const {
+        QSqlQuery query(dbConnection());
+        query.prepare("SELECT track_id, position FROM PlaylistTracks "
+                      "WHERE playlist_id=:id ORDER BY position");
+        query.bindValue(":id", m_playlistId);
+        EXPECT_TRUE(query.exec());
+        QList<int> trackIds;
+        int prevPosition = 0;
+        while (query.next()) {
+            trackIds.append(query.value(0).toInt());
+            EXPECT_LT(prevPosition, query.value(1).toInt());
+            prevPosition = query.value(1).toInt();
+        }
+        return trackIds;
+    }
+
+    // The positions of the given tracks
+    QList<int> positionsOf(const QList<int>& trackIds) const {
+        QSqlQuery query(dbConnection());
+        query.prepare("SELECT position FROM PlaylistTracks "
+                      "WHERE playlist_id=:id AND track_id=:track_id");
+        query.bindValue(":id", m_playlistId);
+        QList<int> positions;
+        for (const auto trackId : trackIds) {
+            query.bindValue(":track_id", trackId);
+            EXPECT_TRUE(query.exec());
+            EXPECT_TRUE(query.next());
+            positions.append(query.value(0).toInt());
+        }
+        return positions;
+    }
+
+    int positionOf(int trackId) const {
+        return positionsOf(QList<int>{trackId}).first();
+    }
+
+    PlaylistDAO& m_playlistDao;
+    int m_playlistId;
+};
+
+TEST_F(PlaylistDAOTest, insertTracks) {
+    EXPECT_EQ(2,
+            m_playlistDao.insertTracksIntoPlaylist(
+                    QList<TrackId>{TrackId(7), TrackId(), TrackId(8)},
+                    m_playlistId,
+                    positionOf(3)));
+    EXPECT_EQ((QList<int>{1, 2, 7, 8, 3, 4, 5, 6}), trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, insertTracksKeepsFollowingPositions) {
+    const QList<int> positions = positionsOf(QList<int>{3, 4, 5, 6});
+    ASSERT_TRUE(m_playlistDao.insertTrackIntoPlaylist(
+            TrackId(7), m_playlistId, positionOf(3)));
+    EXPECT_EQ(positions, positionsOf(QList<int>{3, 4, 5, 6}));
+}
+
+TEST_F(PlaylistDAOTest, insertTracksRepeatedly) {
+    // Use up all unused positions in front of the third track
+    QList<int> expectedTrackIds{1, 2, 3, 4, 5, 6};
+    for (int trackId = 7; trackId < 57; ++trackId) {
+        ASSERT_TRUE(m_playlistDao.insertTrackIntoPlaylist(
+                TrackId(trackId), m_playlistId, positionOf(3)));
+        expectedTrackIds.insert(expectedTrackIds.indexOf(3), trackId);
+    }
+    EXPECT_EQ(expectedTrackIds, trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, insertTracksWithoutUnusedPositions) {
+    // Consecutive positions as stored by previous versions
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            QString("UPDATE PlaylistTracks SET position=track_id "
+                    "WHERE playlist_id=%1")
+                    .arg(m_playlistId)));
+    EXPECT_EQ(2,
+            m_playlistDao.insertTracksIntoPlaylist(
+                    QList<TrackId>{TrackId(7), TrackId(8)},
+                    m_playlistId,
+                    3));
+    EXPECT_EQ((QList<int>{1, 2, 7, 8, 3, 4, 5, 6}), trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, appendTracks) {
+    ASSERT_TRUE(m_playlistDao.appendTracksToPlaylist(
+            QList<TrackId>{TrackId(7), TrackId(8)}, m_playlistId));
+    EXPECT_EQ((QList<int>{1, 2, 3, 4, 5, 6, 7, 8}), trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, removeTracks) {
+    m_playlistDao.removeTracksFromPlaylist(m_playlistId, positionsOf(QList<int>{5, 2, 3}));
+    EXPECT_EQ((QList<int>{1, 4, 6}), trackIdsInOrder());
+    EXPECT_FALSE(m_playlistDao.isTrackInPlaylist(TrackId(2), m_playlistId));
+    EXPECT_TRUE(m_playlistDao.isTrackInPlaylist(TrackId(4), m_playlistId));
+}
+
+TEST_F(PlaylistDAOTest, moveTracksUp) {
+    m_playlistDao.moveTracks(m_playlistId, positionsOf(QList<int>{6, 4}), positionOf(2));
+    EXPECT_EQ((QList<int>{1, 4, 6, 2, 3, 5}), trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, moveTracksDown) {
+    m_playlistDao.moveTracks(m_playlistId, positionsOf(QList<int>{1, 3}), positionOf(5));
+    EXPECT_EQ((QList<int>{2, 4, 1, 3, 5, 6}), trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, moveTracksToEnd) {
+    m_playlistDao.moveTracks(m_playlistId, positionsOf(QList<int>{2, 3}), 0);
+    EXPECT_EQ((QList<int>{1, 4, 5, 6, 2, 3}), trackIdsInOrder());
+}
+
+TEST_F(PlaylistDAOTest, moveTracksOntoMovedTrack) {
+    m_playlistDao.moveTracks(m_playlistId, positionsOf(QList<int>{2, 4}), positionOf(4));
+    EXPECT_EQ((QList<int>{1, 3, 2, 4, 5, 6}), trackIdsInOrder());
+}
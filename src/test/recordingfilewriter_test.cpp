@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#ifdef __LINUX__
+#include <sys/stat.h>
+#endif
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "engine/sidechain/recordingfilewriter.h"
+
+namespace {
+
+class RecordingFileWriterTest : public testing::Test {
+  protected:
+    RecordingFileWriterTest()
+            : m_fileName(m_tempDir.filePath("recording.wav")) {
+    }
+
+    static QByteArray pattern(int length, int seed) {
+        QByteArray data(length, '\0');
+        for (int i = 0; i < length; ++i) {
+            data[i] = static_cast<char>((i * 31 + seed) & 0xff);
+        }
+        return data;
+    }
+
+    QByteArray readFile() const {
+        QFile file(m_fileName);
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+
+    QTemporaryDir m_tempDir;
+    const QString m_fileName;
+};
+
+TEST_F(RecordingFileWriterTest, WriteAndUpdateHeader) {
+    RecordingFileWriter writer;
+    ASSERT_TRUE(writer.open(m_fileName));
+
+    // Like an encoder that updates its header while writing
+    QByteArray expected = pattern(44, 1);
+    writer.write(expected.constData(), expected.size());
+    for (int i = 0; i < 100; ++i) {
+        // Odd sizes that do not fit the blocks
+        const QByteArray data = pattern(4096 * i + 7, i);
+        writer.write(data.constData(), data.size());
+        expected.append(data);
+    }
+    EXPECT_EQ(expected.size(), writer.pos());
+    EXPECT_EQ(expected.size(), writer.size());
+
+    const QByteArray header = pattern(44, 2);
+    writer.seek(0);
+    writer.write(header.constData(), header.size());
+    expected.replace(0, header.size(), header);
+    EXPECT_EQ(header.size(), writer.pos());
+    EXPECT_EQ(expected.size(), writer.size());
+
+    EXPECT_TRUE(writer.close());
+    EXPECT_FALSE(writer.isOpen());
+    EXPECT_EQ(expected, readFile());
+}
+
+TEST_F(RecordingFileWriterTest, BlocksWhenBufferIsFull) {
+    // Much less than what is written
+    RecordingFileWriter writer(64 * 1024);
+    ASSERT_TRUE(writer.open(m_fileName));
+
+    QByteArray expected;
+    for (int i = 0; i < 64; ++i) {
+        const QByteArray data = pattern(100 * 1000, i);
+        writer.write(data.constData(), data.size());
+        expected.append(data);
+    }
+
+    EXPECT_TRUE(writer.close());
+    EXPECT_EQ(expected, readFile());
+}
+
+TEST_F(RecordingFileWriterTest, Reopen) {
+    RecordingFileWriter writer;
+    const QByteArray first = pattern(1000, 1);
+    ASSERT_TRUE(writer.open(m_fileName));
+    writer.write(first.constData(), first.size());
+    EXPECT_TRUE(writer.close());
+
+    // The file is truncated
+    const QByteArray second = pattern(10, 2);
+    ASSERT_TRUE(writer.open(m_fileName));
+    EXPECT_EQ(0, writer.size());
+    writer.write(second.constData(), second.size());
+    EXPECT_TRUE(writer.close());
+    EXPECT_EQ(second, readFile());
+}
+
+#ifdef __LINUX__
+TEST_F(RecordingFileWriterTest, ReleasePreallocatedSpace) {
+    RecordingFileWriter writer;
+    ASSERT_TRUE(writer.open(m_fileName));
+    const QByteArray data = pattern(1000 * 1000, 1);
+    writer.write(data.constData(), data.size());
+    EXPECT_TRUE(writer.close());
+
+    struct stat fileStat;
+    ASSERT_EQ(0, stat(m_fileName.toLocal8Bit().constData(), &fileStat));
+    EXPECT_EQ(data.size(), fileStat.st_size);
+    // st_blocks is in units of 512 bytes. Far less than the 64 MiB that
+    // have been preallocated while writing.
+    EXPECT_GT(4 * 1000 * 1000, fileStat.st_blocks * 512);
+}
+#endif
+
+TEST_F(RecordingFileWriterTest, OpenFails) {
+    RecordingFileWriter writer;
+    EXPECT_FALSE(writer.open(m_tempDir.filePath("missing/recording.wav")));
+    EXPECT_FALSE(writer.isOpen());
+}
+
+} // anonymous namespace
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+
+#include "library/rekordbox/rekordboxfeature.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+class RekordboxFeatureTest : public MixxxTest {
+  protected:
+    QString writeAnalyzeFile(const QString& fileName, const QByteArray& contents) const {
+        const QString filePath = getTestDataDir().filePath(fileName);
+        QFile file(filePath);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(contents);
+        file.close();
+        return filePath;
+    }
+};
+
+TEST_F(RekordboxFeatureTest, MalformedAnalyzeFiles) {
+    // Missing files result in empty data
+    const QByteArray emptyData = RekordboxFeature::parseAnalyzeFilesForCache(
+            getTestDataDir().filePath("MISSING.DAT"));
+    EXPECT_FALSE(emptyData.isEmpty());
+
+    // Wrong magic bytes
+    QByteArray data;
+    EXPECT_NO_THROW(data = RekordboxFeature::parseAnalyzeFilesForCache(
+                            writeAnalyzeFile("WRONG.DAT", "NOT AN ANLZ FILE")));
+    EXPECT_EQ(emptyData, data);
+
+    // Truncated header
+    EXPECT_NO_THROW(data = RekordboxFeature::parseAnalyzeFilesForCache(
+                            writeAnalyzeFile("TRUNCATED.DAT", QByteArray("PMAI\x00\x00", 6))));
+    EXPECT_EQ(emptyData, data);
+}
+
+} // anonymous namespace
@@ -0,0 +1,227 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDirIterator>
+#include <QDomDocument>
+#include <QFile>
+#include <QStringList>
+
+#include "skin/skincache.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QString kSkinXml = QStringLiteral(
+        "<skin>"
+        "<!-- ignored -->"
+        "<WidgetGroup>"
+        "<ObjectName>DeckContainer</ObjectName>"
+        "<Template src=\"skin:deck.xml\">"
+        "<SetVariable name=\"group\">[Channel1]</SetVariable>"
+        "<SetVariable name=\"i\" expression=\"1 + 1\"/>"
+        "</Template>"
+        "<Style><![CDATA[WWidget { color: #fff; }]]></Style>"
+        "</WidgetGroup>"
+        "</skin>");
+
+void expectEqualTrees(const QDomNode& expected, const QDomNode& actual) {
+    ASSERT_EQ(expected.nodeType(), actual.nodeType());
+    EXPECT_QSTRING_EQ(expected.nodeName(), actual.nodeName());
+    EXPECT_QSTRING_EQ(expected.nodeValue(), actual.nodeValue());
+    if (expected.isElement()) {
+        const QDomNamedNodeMap attributes = expected.attributes();
+        ASSERT_EQ(attributes.count(), actual.attributes().count());
+        for (int i = 0; i < attributes.count(); ++i) {
+            const QDomAttr attribute = attributes.item(i).toAttr();
+            EXPECT_QSTRING_EQ(attribute.value(),
+                    actual.toElement().attribute(attribute.name()));
+        }
+    }
+    QDomNode expectedChild = expected.firstChild();
+    QDomNode actualChild = actual.firstChild();
+    while (!expectedChild.isNull()) {
+        if (expectedChild.isComment()) {
+            // Not stored in the binary form
+            expectedChild = expectedChild.nextSibling();
+            continue;
+        }
+        ASSERT_FALSE(actualChild.isNull());
+        expectEqualTrees(expectedChild, actualChild);
+        expectedChild = expectedChild.nextSibling();
+        actualChild = actualChild.nextSibling();
+    }
+    EXPECT_TRUE(actualChild.isNull());
+}
+
+class SkinCacheTest : public MixxxTest {
+  protected:
+    SkinCacheTest()
+            : m_cacheDir(getTestDataDir().filePath("skincache")),
+              m_skinXmlPath(getTestDataDir().filePath("skin.xml")) {
+        SkinCache::clear();
+        SkinCache::setCacheDirectory(m_cacheDir);
+    }
+
+    ~SkinCacheTest() override {
+        SkinCache::setCacheDirectory(QString());
+        SkinCache::clear();
+    }
+
+    void writeSkinXml(const QString& contents) {
+        QFile file(m_skinXmlPath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(contents.toUtf8());
+    }
+
+    QStringList cacheFiles() const {
+        return QDir(m_cacheDir).entryList(QDir::Files);
+    }
+
+    const QString m_cacheDir;
+    const QString m_skinXmlPath;
+};
+
+TEST_F(SkinCacheTest, SerializeRoundTrip) {
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+
+    const QDomDocument restored = SkinCache::deserialize(
+            SkinCache::serialize(document));
+    ASSERT_FALSE(restored.isNull());
+    expectEqualTrees(document.documentElement(), restored.documentElement());
+}
+
+TEST_F(SkinCacheTest, DeserializeRejectsInvalidData) {
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+    QByteArray data = SkinCache::serialize(document);
+
+    EXPECT_TRUE(SkinCache::deserialize(QByteArray()).isNull());
+    EXPECT_TRUE(SkinCache::deserialize(data.left(data.size() / 2)).isNull());
+    data[0] = 'X';
+    EXPECT_TRUE(SkinCache::deserialize(data).isNull());
+}
+
+TEST_F(SkinCacheTest, LoadFromBinaryCache) {
+    writeSkinXml(kSkinXml);
+    const QDomElement parsed = SkinCache::loadDocument(m_skinXmlPath);
+    ASSERT_FALSE(parsed.isNull());
+    ASSERT_EQ(1, cacheFiles().size());
+
+    // Like the next start of Mixxx
+    SkinCache::clear();
+    const QDomElement loaded = SkinCache::loadDocument(m_skinXmlPath);
+    ASSERT_FALSE(loaded.isNull());
+    // Documents from the binary cache have no line numbers
+    EXPECT_EQ(-1, loaded.lineNumber());
+    expectEqualTrees(parsed, loaded);
+    EXPECT_EQ(1, cacheFiles().size());
+}
+
+TEST_F(SkinCacheTest, ChangedFileIsParsedAgain) {
+    writeSkinXml(kSkinXml);
+    ASSERT_FALSE(SkinCache::loadDocument(m_skinXmlPath).isNull());
+
+    writeSkinXml(QStringLiteral("<skin><Layout>vertical</Layout></skin>"));
+    const QDomElement changed = SkinCache::loadDocument(m_skinXmlPath);
+    ASSERT_FALSE(changed.isNull());
+    EXPECT_QSTRING_EQ("vertical", changed.firstChildElement("Layout").text());
+    EXPECT_EQ(2, cacheFiles().size());
+}
+
+TEST_F(SkinCacheTest, PruneFilesNotLoaded) {
+    writeSkinXml(QStringLiteral("<skin><Layout>vertical</Layout></skin>"));
+    ASSERT_FALSE(SkinCache::loadDocument(m_skinXmlPath).isNull());
+    writeSkinXml(kSkinXml);
+    ASSERT_FALSE(SkinCache::loadDocument(m_skinXmlPath).isNull());
+    SkinCache::pruneCacheDirectory();
+    ASSERT_EQ(2, cacheFiles().size());
+
+    // Only the current file is loaded after the next start
+    SkinCache::clear();
+    const QDomElement loaded = SkinCache::loadDocument(m_skinXmlPath);
+    ASSERT_FALSE(loaded.isNull());
+    SkinCache::pruneCacheDirectory();
+    ASSERT_EQ(1, cacheFiles().size());
+
+    // The remaining file is the one of the current contents
+    SkinCache::clear();
+    const QDomElement reloaded = SkinCache::loadDocument(m_skinXmlPath);
+    ASSERT_FALSE(reloaded.isNull());
+    EXPECT_EQ(-1, reloaded.lineNumber());
+    expectEqualTrees(loaded, reloaded);
+}
+
+TEST_F(SkinCacheTest, InvalidXml) {
+    writeSkinXml(QStringLiteral("<skin><Layout></skin>"));
+    EXPECT_TRUE(SkinCache::loadDocument(m_skinXmlPath).isNull());
+    EXPECT_TRUE(SkinCache::loadDocument(
+            getTestDataDir().filePath("missing.xml")).isNull());
+    EXPECT_TRUE(cacheFiles().isEmpty());
+}
+
+QStringList skinFiles(const QString& skinName) {
+    QStringList files;
+    QDirIterator it(QDir::currentPath() + "/res/skins/" + skinName,
+            QStringList("*.xml"),
+            QDir::Files,
+            QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.append(it.next());
+    }
+    return files;
+}
+
+// Parsing all files of a skin, like every skin load did before
+static void BM_SkinDocumentsParseXml(benchmark::State& state) {
+    const QStringList files = skinFiles("LateNight");
+    for (auto _ : state) {
+        for (const auto& filePath : files) {
+            QFile file(filePath);
+            file.open(QIODevice::ReadOnly);
+            QDomDocument document;
+            document.setContent(&file);
+            benchmark::DoNotOptimize(document);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * files.size());
+}
+BENCHMARK(BM_SkinDocumentsParseXml);
+
+// Loading all files of a skin from the binary cache on startup
+static void BM_SkinDocumentsBinaryCache(benchmark::State& state) {
+    const QStringList files = skinFiles("LateNight");
+    QTemporaryDir cacheDir;
+    SkinCache::setCacheDirectory(cacheDir.path());
+    for (const auto& filePath : files) {
+        SkinCache::loadDocument(filePath);
+    }
+    for (auto _ : state) {
+        SkinCache::clear();
+        for (const auto& filePath : files) {
+            benchmark::DoNotOptimize(SkinCache::loadDocument(filePath));
+        }
+    }
+    SkinCache::setCacheDirectory(QString());
+    SkinCache::clear();
+    state.SetItemsProcessed(state.iterations() * files.size());
+}
+BENCHMARK(BM_SkinDocumentsBinaryCache);
+
+// Switching back and forth between two skins that have been loaded before
+static void BM_SkinDocumentsSwitchSkin(benchmark::State& state) {
+    const QStringList files = skinFiles("LateNight") + skinFiles("Deere");
+    for (const auto& filePath : files) {
+        SkinCache::loadDocument(filePath);
+    }
+    for (auto _ : state) {
+        for (const auto& filePath : files) {
+            benchmark::DoNotOptimize(SkinCache::loadDocument(filePath));
+        }
+    }
+    SkinCache::clear();
+    state.SetItemsProcessed(state.iterations() * files.size());
+}
+BENCHMARK(BM_SkinDocumentsSwitchSkin);
+
+} // anonymous namespace
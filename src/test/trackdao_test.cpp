@@ -6,6 +6,44 @@
 using ::testing::UnorderedElementsAre;
 
 class TrackDAOTest : public LibraryTest {
+  protected:
+    static void addTracksPrepare(TrackDAO& trackDAO) {
+        trackDAO.addTracksPrepare();
+    }
+    static TrackId addTracksAddTrack(TrackDAO& trackDAO, const QString& fileName) {
+        return trackDAO.addTracksAddTrack(
+                Track::newTemporary(TrackFile(QDir::tempPath(), fileName)),
+                false);
+    }
+    static void addTracksFinish(TrackDAO& trackDAO, bool rollback) {
+        trackDAO.addTracksFinish(rollback);
+    }
+    static void saveTracksPrepare(TrackDAO& trackDAO) {
+        trackDAO.saveTracksPrepare();
+    }
+    static void saveTracksFinish(TrackDAO& trackDAO, bool rollback) {
+        trackDAO.saveTracksFinish(rollback);
+    }
+
+    QString queryTitle(TrackId trackId) const {
+        QSqlQuery query(dbConnection());
+        query.prepare("SELECT title FROM library WHERE id=:id");
+        query.bindValue(":id", trackId.toVariant());
+        EXPECT_TRUE(query.exec());
+        if (!query.next()) {
+            return QString();
+        }
+        return query.value(0).toString();
+    }
+
+    bool isTrackInLibrary(TrackId trackId) const {
+        QSqlQuery query(dbConnection());
+        query.prepare("SELECT COUNT(*) FROM library WHERE id=:id");
+        query.bindValue(":id", trackId.toVariant());
+        EXPECT_TRUE(query.exec());
+        EXPECT_TRUE(query.next());
+        return query.value(0).toInt() > 0;
+    }
 };
 
 
@@ -55,3 +93,149 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, getAllTrackIds) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    TrackFile file1(QDir::tempPath(), QStringLiteral("file1.mp3"));
+    TrackFile file2(QDir::tempPath(), QStringLiteral("file2.mp3"));
+    TrackFile file3(QDir::tempPath(), QStringLiteral("file3.mp3"));
+
+    TrackId id1 = internalCollection()->addTrack(Track::newTemporary(file1), false);
+    TrackId id2 = internalCollection()->addTrack(Track::newTemporary(file2), false);
+    TrackId id3 = internalCollection()->addTrack(Track::newTemporary(file3), false);
+
+    // Mark as missing
+    QSqlQuery query(dbConnection());
+    query.prepare("UPDATE track_locations SET fs_deleted=1 WHERE location=:location");
+    query.bindValue(":location", file2.location());
+    query.exec();
+    // Hide
+    ASSERT_TRUE(trackCollections()->hideTracks(QList<TrackId>{id3}));
+
+    EXPECT_THAT(trackDAO.getAllTrackIds(), UnorderedElementsAre(id1));
+}
+
+TEST_F(TrackDAOTest, saveTracks) {
+    TrackPointer pTrack1 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-jpg.mp3"));
+    TrackPointer pTrack2 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-png.mp3"));
+    ASSERT_TRUE(pTrack1 && pTrack2);
+    trackCollections()->saveTracks(QList<TrackPointer>{pTrack1, pTrack2});
+
+    pTrack1->setTitle(QStringLiteral("Title 1"));
+    pTrack2->setTitle(QStringLiteral("Title 2"));
+    EXPECT_EQ(2, trackCollections()->saveTracks(QList<TrackPointer>{pTrack1, pTrack2}));
+    EXPECT_FALSE(pTrack1->isDirty());
+    EXPECT_FALSE(pTrack2->isDirty());
+    // Nothing to save
+    EXPECT_EQ(0, trackCollections()->saveTracks(QList<TrackPointer>{pTrack1, pTrack2}));
+
+    QSqlQuery query(dbConnection());
+    query.prepare("SELECT title FROM library WHERE id=:id");
+    query.bindValue(":id", pTrack2->getId().toVariant());
+    ASSERT_TRUE(query.exec());
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("Title 2"), query.value(0).toString());
+}
+
+TEST_F(TrackDAOTest, getTracksByIds) {
+    TrackPointer pTrack1 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-jpg.mp3"));
+    TrackPointer pTrack2 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-png.mp3"));
+    TrackPointer pTrack3 = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-vbr.mp3"));
+    ASSERT_TRUE(pTrack1 && pTrack2 && pTrack3);
+    pTrack1->setTitle(QStringLiteral("Title 1"));
+    pTrack1->createAndAddCue()->setStartPosition(1000.0);
+    pTrack2->setTitle(QStringLiteral("Title 2"));
+    const TrackId id1 = pTrack1->getId();
+    const TrackId id2 = pTrack2->getId();
+    const TrackId id3 = pTrack3->getId();
+
+    // Evict and save the first two tracks, the third one stays cached
+    pTrack1.reset();
+    pTrack2.reset();
+
+    const QList<TrackPointer> tracks = internalCollection()->getTracksByIds(
+            QList<TrackId>{id2, TrackId(), id3, TrackId(12345), id1});
+    ASSERT_EQ(3, tracks.size());
+    EXPECT_EQ(id2, tracks[0]->getId());
+    EXPECT_EQ(QStringLiteral("Title 2"), tracks[0]->getTitle());
+    EXPECT_TRUE(tracks[0]->getCuePoints().isEmpty());
+    EXPECT_EQ(pTrack3, tracks[1]);
+    EXPECT_EQ(id1, tracks[2]->getId());
+    EXPECT_EQ(QStringLiteral("Title 1"), tracks[2]->getTitle());
+    ASSERT_EQ(1, tracks[2]->getCuePoints().size());
+    EXPECT_EQ(1000.0, tracks[2]->getCuePoints().first()->getPosition());
+
+    // Loaded tracks are cached
+    EXPECT_EQ(tracks[2], internalCollection()->getTrackById(id1));
+}
+
+TEST_F(TrackDAOTest, saveTracksWhileAddingTracks) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+    TrackPointer pTrack = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-jpg.mp3"));
+    ASSERT_TRUE(pTrack);
+
+    addTracksPrepare(trackDAO);
+    const TrackId addedId = addTracksAddTrack(trackDAO, QStringLiteral("added.mp3"));
+    ASSERT_TRUE(addedId.isValid());
+
+    // Nested save batch, e.g. when saving evicted tracks
+    saveTracksPrepare(trackDAO);
+    pTrack->setTitle(QStringLiteral("Saved"));
+    trackDAO.saveTrack(pTrack.get());
+    EXPECT_FALSE(pTrack->isDirty());
+    saveTracksFinish(trackDAO, false);
+
+    // Rolling back the enclosing batch must not discard the
+    // modifications of clean tracks
+    addTracksFinish(trackDAO, true);
+    EXPECT_TRUE(isTrackInLibrary(addedId));
+    EXPECT_EQ(QStringLiteral("Saved"), queryTitle(pTrack->getId()));
+}
+
+TEST_F(TrackDAOTest, rollbackNestedSaveBatch) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+    TrackPointer pTrack = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-jpg.mp3"));
+    ASSERT_TRUE(pTrack);
+    const QString title = queryTitle(pTrack->getId());
+
+    addTracksPrepare(trackDAO);
+    const TrackId addedId = addTracksAddTrack(trackDAO, QStringLiteral("added.mp3"));
+    ASSERT_TRUE(addedId.isValid());
+
+    saveTracksPrepare(trackDAO);
+    pTrack->setTitle(title + QStringLiteral(" (discarded)"));
+    trackDAO.saveTrack(pTrack.get());
+    saveTracksFinish(trackDAO, true);
+
+    // Only the nested batch has been rolled back
+    addTracksFinish(trackDAO, false);
+    EXPECT_TRUE(isTrackInLibrary(addedId));
+    EXPECT_EQ(title, queryTitle(pTrack->getId()));
+}
+
+TEST_F(TrackDAOTest, rollbackAddBatch) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    addTracksPrepare(trackDAO);
+    const TrackId addedId = addTracksAddTrack(trackDAO, QStringLiteral("added.mp3"));
+    ASSERT_TRUE(addedId.isValid());
+    addTracksFinish(trackDAO, true);
+
+    EXPECT_FALSE(isTrackInLibrary(addedId));
+
+    // A subsequent save batch is not affected
+    TrackPointer pTrack = getOrAddTrackByLocation(QDir::currentPath() +
+            QStringLiteral("/src/test/id3-test-data/cover-test-jpg.mp3"));
+    ASSERT_TRUE(pTrack);
+    pTrack->setTitle(QStringLiteral("Saved"));
+    EXPECT_EQ(1, trackCollections()->saveTracks(QList<TrackPointer>{pTrack}));
+    EXPECT_EQ(QStringLiteral("Saved"), queryTitle(pTrack->getId()));
+}
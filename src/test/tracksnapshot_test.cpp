@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+
+#include "test/mixxxtest.h"
+#include "track/track.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+TrackPointer newTestTrack() {
+    auto pTrack = Track::newDummy(
+            TrackFile(kTestDir, "cover-test-jpg.mp3"),
+            TrackId());
+    pTrack->setAudioProperties(
+            mixxx::audio::ChannelCount(2),
+            mixxx::audio::SampleRate(44100),
+            mixxx::audio::Bitrate(320),
+            mixxx::Duration::fromSeconds(180));
+    pTrack->setBpm(120);
+    pTrack->createAndAddCue();
+    return pTrack;
+}
+
+} // anonymous namespace
+
+// The getters of the frequently read properties don't lock the track
+// and must reflect all modifications immediately.
+class TrackSnapshotTest : public MixxxTest {
+};
+
+TEST_F(TrackSnapshotTest, gettersReflectModifications) {
+    auto pTrack = newTestTrack();
+    EXPECT_EQ(2, pTrack->getChannels());
+    EXPECT_EQ(44100, pTrack->getSampleRate());
+    EXPECT_EQ(180.0, pTrack->getDuration());
+    ASSERT_TRUE(pTrack->getBeats());
+    EXPECT_EQ(120.0, pTrack->getBpm());
+    ASSERT_EQ(1, pTrack->getCuePoints().size());
+
+    pTrack->setBpm(128);
+    EXPECT_EQ(128.0, pTrack->getBpm());
+
+    // Beats edited in place without an event loop
+    pTrack->getBeats()->setBpm(140);
+    EXPECT_EQ(140.0, pTrack->getBpm());
+
+    pTrack->removeCue(pTrack->getCuePoints().first());
+    EXPECT_TRUE(pTrack->getCuePoints().isEmpty());
+
+    pTrack->setBeats(mixxx::BeatsPointer());
+    EXPECT_FALSE(pTrack->getBeats());
+    EXPECT_EQ(mixxx::Bpm::kValueUndefined, pTrack->getBpm());
+
+    pTrack->setDuration(120.5);
+    EXPECT_EQ(120.5, pTrack->getDuration());
+}
+
+TEST_F(TrackSnapshotTest, removedObjectsAreReleased) {
+    auto pTrack = newTestTrack();
+    const std::weak_ptr<Cue> pWeakCue = pTrack->getCuePoints().first();
+    const QWeakPointer<mixxx::Beats> pWeakBeats = pTrack->getBeats();
+    ASSERT_FALSE(pWeakCue.expired());
+    ASSERT_FALSE(pWeakBeats.isNull());
+
+    // The published copies must not keep removed objects alive
+    pTrack->removeCue(pTrack->getCuePoints().first());
+    pTrack->setBeats(mixxx::BeatsPointer());
+    pTrack->setTitle(QStringLiteral("Title"));
+    EXPECT_TRUE(pWeakCue.expired());
+    EXPECT_TRUE(pWeakBeats.isNull());
+}
+
+// Reads the frequently used properties of a single track from multiple
+// threads. With a non-zero argument the first thread edits the metadata
+// of the track instead, which must not slow down the other threads.
+static void BM_TrackGetters(benchmark::State& state) {
+    static TrackPointer s_pTrack;
+    if (state.thread_index == 0) {
+        s_pTrack = newTestTrack();
+    }
+    const bool editing = state.range(0) != 0 && state.thread_index == 0;
+    int i = 0;
+    for (auto _ : state) {
+        if (editing) {
+            s_pTrack->setTitle((++i % 2) ? QStringLiteral("A") : QStringLiteral("B"));
+            continue;
+        }
+        benchmark::DoNotOptimize(s_pTrack->getBpm());
+        benchmark::DoNotOptimize(s_pTrack->getDuration());
+        benchmark::DoNotOptimize(s_pTrack->getSampleRate());
+        benchmark::DoNotOptimize(s_pTrack->getBeats());
+        benchmark::DoNotOptimize(s_pTrack->getCuePoints());
+    }
+    if (!editing) {
+        state.SetItemsProcessed(state.iterations());
+    }
+    if (state.thread_index == 0) {
+        s_pTrack.reset();
+    }
+}
+BENCHMARK(BM_TrackGetters)->Arg(0)->Arg(1)->ThreadRange(2, 8)->UseRealTime();
@@ -1,5 +1,6 @@
 #include <QtDebug>
 #include <QStringList>
+#include <algorithm>
 
 #include "track/beatgrid.h"
 #include "track/beatmap.h"
@@ -42,14 +43,23 @@ QString BeatFactory::getPreferredVersion(
     return BEAT_MAP_VERSION;
 }
 
+namespace {
+
+const char* kSubVersionKeyValueSeparator = "=";
+const char* kSubVersionFragmentSeparator = "|";
+
+// Marks the sub-version of beats that have been detected by analyzing
+// only the first seconds of a track
+const QString kProvisionalVersionInfoKey = QStringLiteral("provisional");
+
+} // anonymous namespace
+
 QString BeatFactory::getPreferredSubVersion(
         const bool bEnableFixedTempoCorrection,
         const bool bEnableOffsetCorrection,
         const int iMinBpm,
         const int iMaxBpm,
         const QHash<QString, QString> extraVersionInfo) {
-    const char* kSubVersionKeyValueSeparator = "=";
-    const char* kSubVersionFragmentSeparator = "|";
     QStringList fragments;
 
     // min/max BPM limits only apply to fixed-tempo assumption
@@ -128,6 +138,41 @@ mixxx::BeatsPointer BeatFactory::makePreferredBeats(const Track& track,
     }
 }
 
+// static
+void BeatFactory::markProvisional(QHash<QString, QString>* pExtraVersionInfo) {
+    pExtraVersionInfo->insert(kProvisionalVersionInfoKey, QStringLiteral("1"));
+}
+
+// static
+bool BeatFactory::isProvisional(const mixxx::Beats& beats) {
+    const QString fragment = kProvisionalVersionInfoKey + kSubVersionKeyValueSeparator;
+    const QStringList fragments = beats.getSubVersion().split(kSubVersionFragmentSeparator);
+    for (const auto& each : fragments) {
+        if (each.startsWith(fragment)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// static
+bool BeatFactory::clearProvisional(mixxx::Beats* pBeats) {
+    const QString fragment = kProvisionalVersionInfoKey + kSubVersionKeyValueSeparator;
+    QStringList fragments = pBeats->getSubVersion().split(kSubVersionFragmentSeparator);
+    const int size = fragments.size();
+    fragments.erase(std::remove_if(fragments.begin(),
+                            fragments.end(),
+                            [&fragment](const QString& each) {
+                                return each.startsWith(fragment);
+                            }),
+            fragments.end());
+    if (fragments.size() == size) {
+        return false;
+    }
+    pBeats->setSubVersion(fragments.join(kSubVersionFragmentSeparator));
+    return true;
+}
+
 void BeatFactory::deleteBeats(mixxx::Beats* pBeats) {
     // BeatGrid/BeatMap objects have no parent and live in the same thread as
     // their associated TIO. QObject::deleteLater does not have the desired
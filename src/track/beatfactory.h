@@ -34,6 +34,14 @@ class BeatFactory {
             const int iMinBpm,
             const int iMaxBpm);
 
+    // Beats that have been detected by analyzing only the first seconds
+    // of a track are marked as provisional in their sub-version until
+    // they are edited or replaced by the results of the whole track.
+    static void markProvisional(QHash<QString, QString>* pExtraVersionInfo);
+    static bool isProvisional(const mixxx::Beats& beats);
+    // Returns true if the marker has been removed
+    static bool clearProvisional(mixxx::Beats* pBeats);
+
   private:
     static void deleteBeats(mixxx::Beats* pBeats);
 };
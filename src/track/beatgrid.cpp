@@ -127,6 +127,7 @@ QString BeatGrid::getSubVersion() const {
 }
 
 void BeatGrid::setSubVersion(QString subVersion) {
+    QMutexLocker locker(&m_mutex);
     m_subVersion = subVersion;
 }
 
@@ -43,7 +43,7 @@ class BeatGrid final : public Beats {
     BeatsPointer clone() const override;
     QString getVersion() const override;
     QString getSubVersion() const override;
-    virtual void setSubVersion(QString subVersion);
+    void setSubVersion(QString subVersion) override;
 
     ////////////////////////////////////////////////////////////////////////////
     // Beat calculations
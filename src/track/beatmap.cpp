@@ -164,6 +164,7 @@ QString BeatMap::getSubVersion() const {
 }
 
 void BeatMap::setSubVersion(QString subVersion) {
+    QMutexLocker locker(&m_mutex);
     m_subVersion = subVersion;
 }
 
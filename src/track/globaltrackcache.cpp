@@ -29,6 +29,13 @@ inline bool traceLogEnabled() {
 
 constexpr bool kLogStats = false;
 
+// Modified tracks are saved at most this long after they have been
+// evicted, together with all other tracks evicted in the meantime
+constexpr int kSaveDelayMillis = 1000;
+
+// Save immediately when this many tracks are waiting
+constexpr std::size_t kMaxPendingSaves = 100;
+
 inline
 TrackRef createTrackRef(const Track& track) {
     return TrackRef::fromFileInfo(track.getFileInfo(), track.getId());
@@ -128,6 +135,11 @@ void GlobalTrackCacheLocker::deactivateCache() const {
     m_pInstance->deactivate();
 }
 
+void GlobalTrackCacheLocker::savePendingTracks() const {
+    DEBUG_ASSERT(m_pInstance);
+    m_pInstance->savePendingTracks();
+}
+
 bool GlobalTrackCacheLocker::isEmpty() const {
     DEBUG_ASSERT(m_pInstance);
     return m_pInstance->isEmpty();
@@ -201,10 +213,11 @@ void GlobalTrackCacheResolver::initTrackIdAndUnlockCache(TrackId trackId) {
 //static
 void GlobalTrackCache::createInstance(
         GlobalTrackCacheSaver* pSaver,
+        EvictedTrackSaving evictedTrackSaving,
         deleteTrackFn_t deleteTrackFn) {
     DEBUG_ASSERT(!s_pInstance);
     kLogger.info() << "Creating instance";
-    s_pInstance = new GlobalTrackCache(pSaver, deleteTrackFn);
+    s_pInstance = new GlobalTrackCache(pSaver, evictedTrackSaving, deleteTrackFn);
 }
 
 //static
@@ -289,13 +302,21 @@ void GlobalTrackCache::evictAndSaveCachedTrack(GlobalTrackCacheEntryPointer cach
 
 GlobalTrackCache::GlobalTrackCache(
         GlobalTrackCacheSaver* pSaver,
+        EvictedTrackSaving evictedTrackSaving,
         deleteTrackFn_t deleteTrackFn)
     : m_mutex(QMutex::Recursive),
       m_pSaver(pSaver),
       m_deleteTrackFn(deleteTrackFn),
+      m_evictedTrackSaving(evictedTrackSaving),
       m_tracksById(kUnorderedCollectionMinCapacity, DbId::hash_fun) {
     DEBUG_ASSERT(m_pSaver);
     qRegisterMetaType<GlobalTrackCacheEntryPointer>("GlobalTrackCacheEntryPointer");
+
+    m_saveTimer.setSingleShot(true);
+    connect(&m_saveTimer,
+            &QTimer::timeout,
+            this,
+            &GlobalTrackCache::slotSavePendingTracks);
 }
 
 GlobalTrackCache::~GlobalTrackCache() {
@@ -370,9 +391,23 @@ void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
     m_pSaver->saveEvictedTrack(pEvictedTrack);
 }
 
+void GlobalTrackCache::saveEvictedTracks(const QList<Track*>& evictedTracks) const {
+    for (Track* pEvictedTrack : evictedTracks) {
+        DEBUG_ASSERT(pEvictedTrack);
+        // See saveEvictedTrack()
+        pEvictedTrack->disconnect();
+        pEvictedTrack->blockSignals(true);
+    }
+    m_pSaver->saveEvictedTracks(evictedTracks);
+}
+
 void GlobalTrackCache::deactivate() {
     DEBUG_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
 
+    // Pending tracks are still cached and saved below
+    m_saveTimer.stop();
+    m_pendingSaves.clear();
+
     if (isEmpty()) {
         return;
     }
@@ -390,20 +425,27 @@ void GlobalTrackCache::deactivate() {
             << m_tracksByCanonicalLocation.size()
             << "tracks from cache";
 
-    while (!m_tracksById.empty()) {
-        auto i = m_tracksById.begin();
-        Track* plainPtr= i->second->getPlainPtr();
-        saveEvictedTrack(plainPtr);
-        m_tracksByCanonicalLocation.erase(plainPtr->getCanonicalLocation());
-        m_tracksById.erase(i);
-    }
-
-    while (!m_tracksByCanonicalLocation.empty()) {
-        auto i = m_tracksByCanonicalLocation.begin();
-        Track* plainPtr= i->second->getPlainPtr();
-        saveEvictedTrack(plainPtr);
-        m_tracksByCanonicalLocation.erase(i);
+    // The entries keep the tracks alive until all of them have been saved
+    std::vector<GlobalTrackCacheEntryPointer> evictedEntries;
+    evictedEntries.reserve(m_tracksById.size() + m_tracksByCanonicalLocation.size());
+    for (const auto& entry : m_tracksById) {
+        evictedEntries.push_back(entry.second);
+    }
+    for (const auto& entry : m_tracksByCanonicalLocation) {
+        evictedEntries.push_back(entry.second);
+    }
+    QSet<Track*> evictedTrackSet;
+    QList<Track*> evictedTracks;
+    for (const auto& cacheEntryPtr : evictedEntries) {
+        Track* plainPtr = cacheEntryPtr->getPlainPtr();
+        if (!evictedTrackSet.contains(plainPtr)) {
+            evictedTrackSet.insert(plainPtr);
+            evictedTracks.append(plainPtr);
+        }
     }
+    m_tracksById.clear();
+    m_tracksByCanonicalLocation.clear();
+    saveEvictedTracks(evictedTracks);
 
     // Verify that all cached tracks have been evicted
     DEBUG_ASSERT(m_tracksById.empty());
@@ -693,6 +735,17 @@ void GlobalTrackCache::evictAndSave(
         return;
     }
 
+    if (m_evictedTrackSaving == EvictedTrackSaving::Deferred &&
+            m_pSaver &&
+            cacheEntryPtr->getPlainPtr()->isDirty()) {
+        // The track stays cached until it is saved together with other
+        // modified tracks. Lookups revive it in the meantime, so the
+        // unsaved modifications are never lost by reloading the track
+        // from the database.
+        deferSaving(std::move(cacheEntryPtr));
+        return;
+    }
+
     if (!tryEvict(cacheEntryPtr->getPlainPtr())) {
         // A second deleter has already evicted the track from cache after our
         // reference count drops to zero and before acquiring the lock at the
@@ -712,6 +765,59 @@ void GlobalTrackCache::evictAndSave(
     // deleted including the owned track
 }
 
+void GlobalTrackCache::deferSaving(
+        GlobalTrackCacheEntryPointer cacheEntryPtr) {
+    if (debugLogEnabled()) {
+        kLogger.debug()
+                << "Deferring to save evicted track"
+                << cacheEntryPtr->getPlainPtr();
+    }
+    m_pendingSaves.push_back(std::move(cacheEntryPtr));
+    if (m_pendingSaves.size() >= kMaxPendingSaves) {
+        m_saveTimer.start(0);
+    } else if (!m_saveTimer.isActive()) {
+        // Not restarted by subsequent evictions to bound the delay
+        m_saveTimer.start(kSaveDelayMillis);
+    }
+}
+
+void GlobalTrackCache::slotSavePendingTracks() {
+    GlobalTrackCacheLocker cacheLocker;
+    savePendingTracks();
+}
+
+void GlobalTrackCache::savePendingTracks() {
+    DEBUG_ASSERT(QApplication::instance()->thread() == QThread::currentThread());
+    m_saveTimer.stop();
+
+    // The entries keep the tracks alive until all of them have been saved
+    std::vector<GlobalTrackCacheEntryPointer> pendingSaves;
+    pendingSaves.swap(m_pendingSaves);
+    QList<Track*> evictedTracks;
+    for (const auto& cacheEntryPtr : pendingSaves) {
+        if (!cacheEntryPtr->expired()) {
+            // Revived in the meantime, it will be deferred again when
+            // the last reference is dropped
+            continue;
+        }
+        if (!tryEvict(cacheEntryPtr->getPlainPtr())) {
+            // Pending more than once or evicted otherwise
+            continue;
+        }
+        evictedTracks.append(cacheEntryPtr->getPlainPtr());
+    }
+    if (evictedTracks.isEmpty() || !m_pSaver) {
+        return;
+    }
+    if (debugLogEnabled()) {
+        kLogger.debug()
+                << "Saving"
+                << evictedTracks.size()
+                << "evicted tracks";
+    }
+    saveEvictedTracks(evictedTracks);
+}
+
 bool GlobalTrackCache::tryEvict(Track* plainPtr) {
     DEBUG_ASSERT(plainPtr);
     // Make the cached track object invisible to avoid reusing
@@ -1,8 +1,11 @@
 #pragma once
 
 
+#include <QTimer>
+
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "track/track.h"
 #include "track/trackref.h"
@@ -105,6 +108,10 @@ public:
     // of the callback and disables the cache permanently.
     void deactivateCache() const;
 
+    // Saves all evicted tracks with unsaved modifications immediately
+    // instead of waiting for the deferred save.
+    void savePendingTracks() const;
+
     bool isEmpty() const;
 
     // Lookup an existing Track object in the cache
@@ -178,6 +185,13 @@ class /*interface*/ GlobalTrackCacheSaver {
 private:
     friend class GlobalTrackCache;
     virtual void saveEvictedTrack(Track* pEvictedTrack) noexcept = 0;
+    // Saves multiple evicted tracks at once, e.g. within a single
+    // database transaction
+    virtual void saveEvictedTracks(const QList<Track*>& evictedTracks) noexcept {
+        for (Track* pEvictedTrack : evictedTracks) {
+            saveEvictedTrack(pEvictedTrack);
+        }
+    }
 
 protected:
     virtual ~GlobalTrackCacheSaver() {}
@@ -187,8 +201,17 @@ class GlobalTrackCache : public QObject {
     Q_OBJECT
 
 public:
+    // Modified tracks are either saved immediately when evicted or
+    // collected and saved together after a short delay. Deferred
+    // saving requires an event loop.
+    enum class EvictedTrackSaving {
+        Immediate,
+        Deferred,
+    };
+
     static void createInstance(
             GlobalTrackCacheSaver* pSaver,
+            EvictedTrackSaving evictedTrackSaving,
             // A custom deleter is only needed for tests without an event loop!
             deleteTrackFn_t deleteTrackFn = nullptr);
     // NOTE(uklotzde, 2018-02-20): We decided not to destroy the singular
@@ -204,6 +227,7 @@ public:
 
 private slots:
     void evictAndSave(GlobalTrackCacheEntryPointer cacheEntryPtr);
+    void slotSavePendingTracks();
 
 private:
     friend class GlobalTrackCacheLocker;
@@ -211,6 +235,7 @@ private:
 
     GlobalTrackCache(
             GlobalTrackCacheSaver* pSaver,
+            EvictedTrackSaving evictedTrackSaving,
             deleteTrackFn_t deleteTrackFn);
     ~GlobalTrackCache();
 
@@ -246,6 +271,10 @@ private:
     void deactivate();
 
     void saveEvictedTrack(Track* pEvictedTrack) const;
+    void saveEvictedTracks(const QList<Track*>& evictedTracks) const;
+
+    void deferSaving(GlobalTrackCacheEntryPointer cacheEntryPtr);
+    void savePendingTracks();
 
     // Managed by GlobalTrackCacheLocker
     mutable QMutex m_mutex;
@@ -254,6 +283,13 @@ private:
 
     deleteTrackFn_t m_deleteTrackFn;
 
+    const EvictedTrackSaving m_evictedTrackSaving;
+
+    // Evicted tracks with unsaved modifications. They stay cached and
+    // are revived if needed again until they are saved.
+    std::vector<GlobalTrackCacheEntryPointer> m_pendingSaves;
+    QTimer m_saveTimer;
+
     // This caches the unsaved Tracks by ID
     typedef std::unordered_map<TrackId, GlobalTrackCacheEntryPointer, TrackId::hash_fun_t> TracksById;
     TracksById m_tracksById;
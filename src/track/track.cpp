@@ -42,6 +42,16 @@ bool compareAndSet(T* pField, const T& value) {
     }
 }
 
+// Overwrites all slots of the ring that are not read concurrently.
+// Otherwise replaced objects would be kept alive by the remaining
+// slots until these are overwritten eventually.
+template<typename T>
+void publishValue(ControlValueAtomic<T>* pPublished, const T& value) {
+    for (int i = 0; i < kDefaultRingSize; ++i) {
+        pPublished->setValue(value);
+    }
+}
+
 inline mixxx::Bpm getActualBpm(
         mixxx::Bpm bpm,
         mixxx::BeatsPointer pBeats = mixxx::BeatsPointer()) {
@@ -74,6 +84,8 @@ Track::Track(
           m_record(trackId),
           m_bDirty(false),
           m_bMarkedForMetadataExport(false) {
+    publishProperties();
+    publishBeats();
     if (kLogStats && kLogger.debugEnabled()) {
         long numberOfInstancesBefore = s_numberOfInstances.fetch_add(1);
         kLogger.debug()
@@ -252,18 +264,10 @@ void Track::setReplayGain(const mixxx::ReplayGain& replayGain) {
 }
 
 double Track::getBpm() const {
-    double bpm = mixxx::Bpm::kValueUndefined;
-    QMutexLocker lock(&m_qMutex);
-    if (m_pBeats) {
-        // BPM from beat grid overrides BPM from metadata
-        // Reason: The BPM value in the metadata might be imprecise,
-        // e.g. ID3v2 only supports integer values!
-        double beatsBpm = m_pBeats->getBpm();
-        if (mixxx::Bpm::isValidValue(beatsBpm)) {
-            bpm = beatsBpm;
-        }
-    }
-    return bpm;
+    // BPM from beat grid overrides BPM from metadata
+    // Reason: The BPM value in the metadata might be imprecise,
+    // e.g. ID3v2 only supports integer values!
+    return m_publishedBpm.load();
 }
 
 double Track::setBpm(double bpmValue) {
@@ -318,7 +322,7 @@ void Track::setBeatsAndUnlock(QMutexLocker* pLock, mixxx::BeatsPointer pBeats) {
     }
 
     if (m_pBeats) {
-        disconnect(m_pBeats.data(), &mixxx::Beats::updated, this, &Track::slotBeatsUpdated);
+        disconnect(m_pBeats.data(), 0, this, 0);
     }
 
     m_pBeats = std::move(pBeats);
@@ -327,8 +331,17 @@ void Track::setBeatsAndUnlock(QMutexLocker* pLock, mixxx::BeatsPointer pBeats) {
     if (m_pBeats) {
         bpmValue = m_pBeats->getBpm();
         connect(m_pBeats.data(), &mixxx::Beats::updated, this, &Track::slotBeatsUpdated);
+        // Beats might be edited in place from any thread. The BPM
+        // is published immediately and not only after the queued
+        // slot has been invoked.
+        connect(m_pBeats.data(),
+                &mixxx::Beats::updated,
+                this,
+                &Track::publishBpm,
+                Qt::DirectConnection);
     }
     m_record.refMetadata().refTrackInfo().setBpm(mixxx::Bpm(bpmValue));
+    publishBeats();
 
     markDirtyAndUnlock(pLock);
     emit bpmUpdated(bpmValue);
@@ -336,8 +349,7 @@ void Track::setBeatsAndUnlock(QMutexLocker* pLock, mixxx::BeatsPointer pBeats) {
 }
 
 mixxx::BeatsPointer Track::getBeats() const {
-    QMutexLocker lock(&m_qMutex);
-    return m_pBeats;
+    return m_publishedBeats.getValue();
 }
 
 void Track::slotBeatsUpdated() {
@@ -346,8 +358,12 @@ void Track::slotBeatsUpdated() {
     auto bpmValue = mixxx::Bpm::kValueUndefined;
     if (m_pBeats) {
         bpmValue = m_pBeats->getBpm();
+        // Beats that have been edited, e.g. by nudging the grid, must
+        // not be replaced by the final results of the analysis
+        BeatFactory::clearProvisional(m_pBeats.data());
     }
     m_record.refMetadata().refTrackInfo().setBpm(mixxx::Bpm(bpmValue));
+    publishBpm();
 
     markDirtyAndUnlock(&lock);
     emit bpmUpdated(bpmValue);
@@ -425,12 +441,12 @@ void Track::setDuration(double duration) {
 }
 
 double Track::getDuration(DurationRounding rounding) const {
-    QMutexLocker lock(&m_qMutex);
+    const double duration = m_publishedDuration.load();
     switch (rounding) {
     case DurationRounding::SECONDS:
-        return std::round(m_record.getMetadata().getDuration().toDoubleSeconds());
+        return std::round(duration);
     default:
-        return m_record.getMetadata().getDuration().toDoubleSeconds();
+        return duration;
     }
 }
 
@@ -636,13 +652,11 @@ void Track::setType(const QString& sType) {
 }
 
 int Track::getSampleRate() const {
-    QMutexLocker lock(&m_qMutex);
-    return m_record.getMetadata().getSampleRate();
+    return m_publishedSampleRate.load();
 }
 
 int Track::getChannels() const {
-    QMutexLocker lock(&m_qMutex);
-    return m_record.getMetadata().getChannelCount();
+    return m_publishedChannels.load();
 }
 
 int Track::getBitrate() const {
@@ -756,10 +770,12 @@ void Track::setCuePoint(CuePosition cue) {
                     this,
                     &Track::slotCueUpdated);
             m_cuePoints.push_back(pLoadCue);
+            publishCuePoints();
         }
     } else if (pLoadCue) {
         disconnect(pLoadCue.get(), 0, this, 0);
         m_cuePoints.removeOne(pLoadCue);
+        publishCuePoints();
     }
 
     markDirtyAndUnlock(&lock);
@@ -807,6 +823,7 @@ CuePointer Track::createAndAddCue() {
             this,
             &Track::slotCueUpdated);
     m_cuePoints.push_back(pCue);
+    publishCuePoints();
     markDirtyAndUnlock(&lock);
     emit cuesUpdated();
     return pCue;
@@ -845,6 +862,7 @@ void Track::removeCue(const CuePointer& pCue) {
     QMutexLocker lock(&m_qMutex);
     disconnect(pCue.get(), 0, this, 0);
     m_cuePoints.removeOne(pCue);
+    publishCuePoints();
     if (pCue->getType() == mixxx::CueType::MainCue) {
         m_record.setCuePoint(CuePosition());
     }
@@ -865,6 +883,9 @@ void Track::removeCuesOfType(mixxx::CueType type) {
             dirty = true;
         }
     }
+    if (dirty) {
+        publishCuePoints();
+    }
     if (compareAndSet(m_record.ptrCuePoint(), CuePosition())) {
         dirty = true;
     }
@@ -875,8 +896,7 @@ void Track::removeCuesOfType(mixxx::CueType type) {
 }
 
 QList<CuePointer> Track::getCuePoints() const {
-    QMutexLocker lock(&m_qMutex);
-    return m_cuePoints;
+    return m_publishedCuePoints.getValue();
 }
 
 void Track::setCuePoints(const QList<CuePointer>& cuePoints) {
@@ -953,6 +973,7 @@ void Track::setCuePointsMarkDirtyAndUnlock(
         disconnect(pCue.get(), 0, this, 0);
     }
     m_cuePoints = cuePoints;
+    publishCuePoints();
     // connect new cue points
     for (const auto& pCue: m_cuePoints) {
         DEBUG_ASSERT(pCue->thread() == thread());
@@ -1030,10 +1051,51 @@ void Track::markDirtyAndUnlock(QMutexLocker* pLock, bool bDirty) {
     setDirtyAndUnlock(pLock, result);
 }
 
+void Track::publishProperties() {
+    m_publishedDuration.store(m_record.getMetadata().getDuration().toDoubleSeconds());
+    m_publishedSampleRate.store(m_record.getMetadata().getSampleRate());
+    m_publishedChannels.store(m_record.getMetadata().getChannelCount());
+}
+
+void Track::publishBeats() {
+    publishValue(&m_publishedBeats, m_pBeats);
+    publishBpm();
+}
+
+void Track::publishCuePoints() {
+    publishValue(&m_publishedCuePoints, m_cuePoints);
+}
+
+void Track::publishBpm() {
+    // The beats might be replaced while the BPM of the previous beats
+    // is published. Repeat until the BPM matches the published beats.
+    auto pBeats = m_publishedBeats.getValue();
+    while (true) {
+        auto bpm = mixxx::Bpm::kValueUndefined;
+        if (pBeats) {
+            const double beatsBpm = pBeats->getBpm();
+            if (mixxx::Bpm::isValidValue(beatsBpm)) {
+                bpm = beatsBpm;
+            }
+        }
+        m_publishedBpm.store(bpm);
+        auto pPublishedBeats = m_publishedBeats.getValue();
+        if (pPublishedBeats == pBeats) {
+            return;
+        }
+        pBeats = std::move(pPublishedBeats);
+    }
+}
+
 void Track::setDirtyAndUnlock(QMutexLocker* pLock, bool bDirty) {
     const bool dirtyChanged = m_bDirty != bDirty;
     m_bDirty = bDirty;
 
+    // All modifications end up here, publish them
+    // for the getters that don't lock m_qMutex. The
+    // beats and cue points are published when replaced.
+    publishProperties();
+
     const auto trackId = m_record.getId();
 
     // Unlock before emitting any signals!
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
+
 #include <QList>
 #include <QMutex>
 #include <QObject>
 #include <QUrl>
 
 #include "audio/streaminfo.h"
+#include "control/controlvalue.h"
 #include "sources/metadatasource.h"
 #include "track/beats.h"
 #include "track/cue.h"
@@ -414,9 +417,29 @@ class Track : public QObject {
     void updateAudioPropertiesFromStream(
             mixxx::audio::StreamInfo&& streamInfo);
 
+    // Publish the properties that are read most frequently from
+    // different threads, e.g. by the engine, the waveform widgets and
+    // the library. Must be called while m_qMutex is locked.
+    void publishProperties();
+    void publishBeats();
+    void publishCuePoints();
+    // Publishes the BPM of the published beats. Invoked directly from
+    // the thread that edits the beats in place without locking m_qMutex.
+    void publishBpm();
+
     // Mutex protecting access to object
     mutable QMutex m_qMutex;
 
+    // Published copies for the getters that must not lock m_qMutex.
+    // The scalar properties are plain atomics and the shared objects
+    // are handed over through the wait-free ring of ControlValueAtomic.
+    std::atomic<double> m_publishedBpm;
+    std::atomic<double> m_publishedDuration;
+    std::atomic<int> m_publishedSampleRate;
+    std::atomic<int> m_publishedChannels;
+    ControlValueAtomic<mixxx::BeatsPointer> m_publishedBeats;
+    ControlValueAtomic<QList<CuePointer>> m_publishedCuePoints;
+
     // The file
     mutable TrackFile m_fileInfo;
 
@@ -1,5 +1,6 @@
 #include <QSqlDriver>
 #include <QSqlError>
+#include <QSqlQuery>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -22,6 +23,8 @@ namespace {
 
 const mixxx::Logger kLogger("DbConnection");
 
+const QString kSqliteDriverType = QStringLiteral("QSQLITE");
+
 QSqlDatabase createDatabase(
         const DbConnection::Params& params,
         const QString connectionName) {
@@ -310,18 +313,68 @@ bool initDatabase(QSqlDatabase database, StringCollator* pCollator) {
     return true;
 }
 
+bool execPragma(
+        QSqlDatabase database,
+        const QString& pragma) {
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("PRAGMA ") + pragma)) {
+        kLogger.warning()
+                << "Failed to execute"
+                << pragma
+                << query.lastError();
+        return false;
+    }
+    return true;
+}
+
+void tuneDatabase(
+        QSqlDatabase database,
+        const DbConnection::Tuning& tuning,
+        bool readOnly) {
+    DEBUG_ASSERT(database.isOpen());
+    if (database.driverName() != kSqliteDriverType) {
+        return;
+    }
+    if (readOnly) {
+        // Opening the connection with SQLITE_OPEN_READONLY is not
+        // possible for shared in-memory databases and would prevent
+        // readers from creating the shared-memory index of a WAL
+        // journal. Reject all modifications on the SQL level instead.
+        execPragma(database, QStringLiteral("query_only=ON"));
+    } else if (tuning.writeAheadLog) {
+        // The journal mode is stored persistently in the database file
+        // and cannot be changed by read-only connections. In-memory
+        // databases silently stay in journal mode MEMORY.
+        execPragma(database, QStringLiteral("journal_mode=WAL"));
+    }
+    execPragma(database,
+            QStringLiteral("synchronous=%1").arg(tuning.synchronous));
+    // Negative values denote the cache size in KiB instead of pages
+    execPragma(database,
+            QStringLiteral("cache_size=%1").arg(-tuning.cacheSizeKiB));
+    execPragma(database,
+            QStringLiteral("mmap_size=%1").arg(tuning.mmapSizeBytes));
+    if (tuning.tempStoreInMemory) {
+        execPragma(database, QStringLiteral("temp_store=MEMORY"));
+    }
+}
+
 } // anonymous namespace
 
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_sqlDatabase(createDatabase(params, connectionName)),
+      m_readOnly(params.readOnly),
+      m_tuning(params.tuning) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
         const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)),
+      m_readOnly(prototype.m_readOnly),
+      m_tuning(prototype.m_tuning) {
 }
 
 DbConnection::~DbConnection() {
@@ -349,6 +402,7 @@ bool DbConnection::open() {
         m_sqlDatabase.close();
         return false; // abort
     }
+    tuneDatabase(m_sqlDatabase, m_tuning, m_readOnly);
     return true;
 }
 
@@ -399,9 +453,13 @@ void DbConnection::makeStringLatinLow(QString* string) {
 }
 
 QDebug operator<<(QDebug debug, const DbConnection& connection) {
-    return debug
+    debug
             << connection.name()
             << connection.m_sqlDatabase;
+    if (connection.m_readOnly) {
+        debug << "(read-only)";
+    }
+    return debug;
 }
 
 } // namespace mixxx
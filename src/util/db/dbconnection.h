@@ -24,6 +24,28 @@ class DbConnection final {
 
     static void makeStringLatinLow(QString* string);
 
+    // Performance tuning for SQLite3 connections that is applied
+    // through PRAGMA statements right after a connection has been
+    // opened. The defaults are tuned for the Mixxx library database
+    // with a single writer and multiple concurrent readers.
+    struct Tuning {
+        // Write-ahead logging allows readers to proceed concurrently
+        // with a single writer. The journal mode is persistent and
+        // only modified by connections with write access.
+        bool writeAheadLog = true;
+        // Synchronization level: 0 = OFF, 1 = NORMAL, 2 = FULL. NORMAL
+        // is safe in WAL mode, i.e. the database cannot get corrupted
+        // although the most recent transactions might be lost after
+        // a power failure.
+        int synchronous = 1;
+        // Size of the page cache per connection in KiB
+        int cacheSizeKiB = 8 * 1024;
+        // Maximum number of bytes that are accessed by memory-mapped I/O
+        qint64 mmapSizeBytes = 128 * 1024 * 1024;
+        // Store temporary tables and indices in memory
+        bool tempStoreInMemory = true;
+    };
+
     struct Params {
         QString type;
         QString connectOptions;
@@ -31,6 +53,10 @@ class DbConnection final {
         QString filePath;
         QString userName;
         QString password;
+        // Read-only connections reject all modifications and never
+        // block a concurrent writer when using a WAL journal.
+        bool readOnly = false;
+        Tuning tuning;
     };
 
     // All constructors are reserved for DbConnectionPool!!
@@ -53,6 +79,10 @@ class DbConnection final {
         return m_sqlDatabase.isOpen();
     }
 
+    bool isReadOnly() const {
+        return m_readOnly;
+    }
+
     operator QSqlDatabase() const {
         return m_sqlDatabase;
     }
@@ -65,6 +95,8 @@ class DbConnection final {
 
     QSqlDatabase m_sqlDatabase;
     StringCollator m_collator;
+    bool m_readOnly;
+    Tuning m_tuning;
 };
 
 } // namespace mixxx
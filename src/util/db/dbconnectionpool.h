@@ -38,6 +38,9 @@ class DbConnectionPool final {
     // scoping possible then use these functions directly.
     bool createThreadLocalConnection();
     void destroyThreadLocalConnection();
+    bool hasThreadLocalConnection() const {
+        return m_threadLocalConnections.hasLocalData();
+    }
 
   private:
     DbConnectionPool(const DbConnectionPool&) = delete;
@@ -48,9 +51,9 @@ class DbConnectionPool final {
     // returned connection is only valid within the current thread! It
     // will be closed and removed from the pool upon the destruction of
     // the owning DbConnectionPooler or as a very last resort implicitly
-    // when the current thread terminates. Since all connections need
-    // to be created through DbConnectionPooler the latter case should
-    // never happen.
+    // when the current thread terminates. The latter case should only
+    // happen for connections of long-living worker threads that have
+    // been created explicitly.
     friend class DbConnectionPooled;
     const DbConnection* threadLocalConnection() const {
         return m_threadLocalConnections.localData();
@@ -0,0 +1,70 @@
+#include "util/db/sqlsavepoint.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SqlSavepoint");
+
+} // anonymous namespace
+
+SqlSavepoint::SqlSavepoint(
+        const QSqlDatabase& database,
+        const QString& name)
+        : m_database(database), // implicitly shared (not copied)
+          m_name(name),
+          m_active(false) {
+    m_active = exec(QStringLiteral("SAVEPOINT ") + m_name);
+}
+
+SqlSavepoint::~SqlSavepoint() {
+    if (m_active && m_database.isOpen()) {
+        rollback();
+    }
+}
+
+bool SqlSavepoint::exec(const QString& statement) {
+    if (!m_database.isOpen()) {
+        kLogger.warning()
+                << "Failed to execute" << statement
+                << ": No open SQL database connection";
+        return false;
+    }
+    QSqlQuery query(m_database);
+    if (!query.exec(statement)) {
+        kLogger.warning()
+                << "Failed to execute" << statement
+                << "on" << m_database.connectionName()
+                << ":" << query.lastError();
+        return false;
+    }
+    if (kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Executed" << statement
+                << "on" << m_database.connectionName();
+    }
+    return true;
+}
+
+bool SqlSavepoint::release() {
+    DEBUG_ASSERT(m_active);
+    if (!exec(QStringLiteral("RELEASE SAVEPOINT ") + m_name)) {
+        return false;
+    }
+    m_active = false; // release/rollback only once
+    return true;
+}
+
+bool SqlSavepoint::rollback() {
+    DEBUG_ASSERT(m_active);
+    // Rolling back to a savepoint doesn't remove it from the
+    // transaction stack, it needs to be released afterwards
+    if (!exec(QStringLiteral("ROLLBACK TO SAVEPOINT ") + m_name)) {
+        return false;
+    }
+    return release();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+
+// A nested transaction within an enclosing SqlTransaction. Modifications
+// since the savepoint has been created are rolled back independently of
+// the enclosing transaction. Savepoints must be released or rolled back
+// in the reverse order of their creation.
+class SqlSavepoint final {
+  public:
+    // The name must be a valid SQL identifier
+    SqlSavepoint(
+            const QSqlDatabase& database,
+            const QString& name);
+    ~SqlSavepoint();
+
+    operator bool() const {
+        return m_active;
+    }
+
+    // Keeps all modifications within the enclosing transaction
+    bool release();
+    // Discards all modifications since the savepoint has been created
+    bool rollback();
+
+    // Disable copy/move construction and assignment
+    SqlSavepoint(const SqlSavepoint&) = delete;
+    SqlSavepoint(SqlSavepoint&&) = delete;
+    SqlSavepoint& operator=(const SqlSavepoint&) = delete;
+    SqlSavepoint& operator=(SqlSavepoint&&) = delete;
+
+  private:
+    bool exec(const QString& statement);
+
+    QSqlDatabase m_database;
+    const QString m_name;
+    bool m_active;
+};
@@ -0,0 +1,80 @@
+#include "util/startuptrace.h"
+
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+#include <algorithm>
+
+#include "util/logger.h"
+#include "util/time.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("StartupTrace");
+
+} // anonymous namespace
+
+StartupTrace::StartupTrace()
+        : m_start(Time::elapsed()),
+          m_stepStart(m_start) {
+}
+
+void StartupTrace::finishStep(const QString& name) {
+    const Duration start = m_stepStart;
+    m_stepStart = Time::elapsed();
+    record(name, start, true);
+}
+
+QFuture<void> StartupTrace::run(const QString& name, std::function<void()> task) {
+    return QtConcurrent::run([this, name, task] {
+        const Duration start = Time::elapsed();
+        task();
+        record(name, start, false);
+    });
+}
+
+void StartupTrace::wait(const QString& name, QFuture<void> future) {
+    future.waitForFinished();
+    finishStep(QStringLiteral("waiting for ") + name);
+}
+
+void StartupTrace::record(const QString& name, Duration start, bool onMainThread) {
+    const Duration duration = Time::elapsed() - start;
+    QMutexLocker locker(&m_mutex);
+    m_records.append(Record{name, start, duration, onMainThread});
+}
+
+void StartupTrace::log() const {
+    QMutexLocker locker(&m_mutex);
+    QVector<Record> records = m_records;
+    locker.unlock();
+
+    std::stable_sort(records.begin(), records.end(),
+            [](const Record& lhs, const Record& rhs) {
+                return lhs.start < rhs.start;
+            });
+
+    Duration criticalPath;
+    Duration background;
+    for (const auto& record : records) {
+        kLogger.info()
+                << (record.onMainThread ? "main  " : "worker")
+                << "start" << (record.start - m_start).formatMillisWithUnit()
+                << "duration" << record.duration.formatMillisWithUnit()
+                << record.name;
+        if (record.onMainThread) {
+            criticalPath += record.duration;
+        } else {
+            background += record.duration;
+        }
+    }
+    kLogger.info()
+            << "Critical path"
+            << criticalPath.formatMillisWithUnit()
+            << "with"
+            << background.formatMillisWithUnit()
+            << "in the background";
+}
+
+} // namespace mixxx
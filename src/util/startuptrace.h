@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+
+#include <QFuture>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include "util/duration.h"
+
+namespace mixxx {
+
+// Records the steps of the application startup on a simple task graph.
+// Steps either run on the main thread one after another or on the global
+// thread pool. When the main thread needs the result of a background step
+// it has to wait for it, and that time is recorded as a step as well.
+//
+// The log shows when each step started and how long it took. The steps
+// of the main thread, including the waits, form the critical path: only
+// shortening them reduces the time until a deck is playable.
+class StartupTrace {
+  public:
+    StartupTrace();
+
+    // Records the time since the previous step of the main thread as the
+    // step name. Must only be called from the main thread.
+    void finishStep(const QString& name);
+
+    // Runs task on the global thread pool and records it as a background
+    // step. The main thread must call wait() before using any result.
+    QFuture<void> run(const QString& name, std::function<void()> task);
+
+    // Waits for a step started with run() and records the time the main
+    // thread was blocked as a step. Call finishStep() before, otherwise
+    // the current step is attributed to the wait.
+    void wait(const QString& name, QFuture<void> future);
+
+    // Logs all steps ordered by their start time and the critical path
+    void log() const;
+
+  private:
+    struct Record {
+        QString name;
+        Duration start;
+        Duration duration;
+        bool onMainThread;
+    };
+
+    void record(const QString& name, Duration start, bool onMainThread);
+
+    const Duration m_start;
+    Duration m_stepStart;
+
+    mutable QMutex m_mutex;
+    QVector<Record> m_records;
+};
+
+} // namespace mixxx
@@ -1,4 +1,8 @@
 #include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
 
 #include "vinylcontrol/vinylcontrolprocessor.h"
 
@@ -6,6 +10,7 @@
 #include "util/defs.h"
 #include "util/event.h"
 #include "util/sample.h"
+#include "util/time.h"
 #include "util/timer.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 #include "vinylcontrol/vinylcontrol.h"
@@ -14,142 +19,255 @@
 #define SIGNAL_QUALITY_FIFO_SIZE 256
 #define SAMPLE_PIPE_FIFO_SIZE 65536
 
-VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPointer pConfig)
-        : QThread(pParent),
-          m_pConfig(pConfig),
-          m_pToggle(new ControlPushButton(ConfigKey(VINYL_PREF_KEY, "Toggle"))),
-          m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
-          m_processorsLock(QMutex::Recursive),
-          m_processors(kMaximumVinylControlInputs, NULL),
-          m_signalQualityFifo(SIGNAL_QUALITY_FIFO_SIZE),
-          m_bReportSignalQuality(false),
-          m_bQuit(false),
-          m_bReloadConfig(false) {
-    connect(m_pToggle,
-            &ControlPushButton::valueChanged,
-            this,
-            &VinylControlProcessor::toggleDeck,
-            Qt::DirectConnection);
+// Decodes the timecode of a single vinyl control input on its own thread.
+class VinylControlDeckWorker : public QThread {
+  public:
+    VinylControlDeckWorker(VinylControlProcessor* pProcessor, int index)
+            : m_pProcessor(pProcessor),
+              m_index(index),
+              m_samplePipe(SAMPLE_PIPE_FIFO_SIZE),
+              m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
+              // Recursive, because toggling the VinylControls while holding
+              // the lock may call back into deckConfigured().
+              m_vinylControlMutex(QMutex::Recursive),
+              m_pVinylControl(NULL),
+              m_pendingSinceNanos(0),
+              m_pitchLatencyStat(QString("VinylControlProcessor %1 pitch latency")
+                                         .arg(kVCGroup.arg(index + 1))),
+              m_bQuit(false),
+              m_bReloadConfig(false) {
+    }
 
-    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-        m_samplePipes[i] = new FIFO<CSAMPLE>(SAMPLE_PIPE_FIFO_SIZE);
+    ~VinylControlDeckWorker() override {
+        stopProcessing();
+        delete m_pVinylControl;
+        SampleUtil::free(m_pWorkBuffer);
     }
 
-    start(QThread::HighPriority);
-}
+    // Called from the main thread when the input has been configured.
+    void startProcessing() {
+        if (isRunning()) {
+            return;
+        }
+        m_bQuit = false;
+        // The VinylControl has just been created from the current config
+        m_bReloadConfig = false;
+        // Decoding has to keep up with the audio callback.
+        start(QThread::TimeCriticalPriority);
+    }
 
-VinylControlProcessor::~VinylControlProcessor() {
-    m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
-    wait();
+    // Called from the main thread when the input has been unconfigured.
+    void stopProcessing() {
+        shutdown();
+        wait();
+    }
 
-    delete m_pToggle;
-    SampleUtil::free(m_pWorkBuffer);
+    // Called from the main thread. Returns the previous VinylControl, which
+    // is not used by the worker anymore and needs to be deleted by the caller.
+    VinylControl* replaceVinylControl(VinylControl* pVinylControl) {
+        QMutexLocker locker(&m_vinylControlMutex);
+        VinylControl* pPrevious = m_pVinylControl;
+        m_pVinylControl = pVinylControl;
+        return pPrevious;
+    }
+
+    // Called from the main thread.
+    bool hasVinylControl() {
+        QMutexLocker locker(&m_vinylControlMutex);
+        return m_pVinylControl != NULL;
+    }
+
+    // Called from the main thread. The VinylControl must only be used
+    // between lockVinylControl() and unlockVinylControl().
+    void lockVinylControl() {
+        m_vinylControlMutex.lock();
+    }
+    VinylControl* lockedVinylControl() const {
+        return m_pVinylControl;
+    }
+    void unlockVinylControl() {
+        m_vinylControlMutex.unlock();
+    }
+
+    void shutdown() {
+        QMutexLocker locker(&m_waitForSampleMutex);
+        m_bQuit = true;
+        m_samplesAvailableSignal.wakeAll();
+    }
 
-    {
-        QMutexLocker locker(&m_processorsLock);
-        for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-            VinylControl* pProcessor = m_processors.at(i);
-            m_processors[i] = NULL;
-            delete pProcessor;
+    void requestReloadConfig() {
+        QMutexLocker locker(&m_waitForSampleMutex);
+        m_bReloadConfig = true;
+        m_samplesAvailableSignal.wakeAll();
+    }
 
-            delete m_samplePipes[i];
-            m_samplePipes[i] = NULL;
+    // Called by the engine callback. Must only touch the sample pipe and the
+    // time the oldest pending samples have been received.
+    void receiveBuffer(const CSAMPLE* pBuffer, int nSamples) {
+        qint64 expected = 0;
+        m_pendingSinceNanos.compare_exchange_strong(
+                expected, mixxx::Time::elapsed().toIntegerNanos());
+
+        int samplesWritten = m_samplePipe.write(pBuffer, nSamples);
+        if (samplesWritten < nSamples) {
+            qWarning() << "ERROR: Buffer overflow in VinylControlProcessor. Dropping samples on the floor."
+                       << "VCIndex:" << m_index;
         }
+
+        m_samplesAvailableSignal.wakeAll();
     }
 
-    // xwax has a global LUT that we need to free after we've shut down our
-    // vinyl control threads because it's not thread-safe.
-    VinylControlXwax::freeLUTs();
-}
+  protected:
+    void run() override {
+        QThread::currentThread()->setObjectName(
+                QString("VinylControlDeckWorker %1").arg(m_index + 1));
 
-void VinylControlProcessor::setSignalQualityReporting(bool enable) {
-    m_bReportSignalQuality = enable;
-}
+        while (!m_bQuit) {
+            if (m_bReloadConfig) {
+                m_bReloadConfig = false;
+                reloadConfig();
+            }
 
-void VinylControlProcessor::shutdown() {
-    m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
-}
+            processSamples();
 
-void VinylControlProcessor::requestReloadConfig() {
-    m_bReloadConfig = true;
-    m_samplesAvailableSignal.wakeAll();
-}
+            if (m_bQuit) {
+                break;
+            }
 
-void VinylControlProcessor::run() {
-    unsigned static id = 0; //the id of this thread, for debugging purposes //XXX copypasta (should factor this out somehow), -kousu 2/2009
-    QThread::currentThread()->setObjectName(QString("VinylControlProcessor %1").arg(++id));
+            // Wait for a signal from the main thread or engine thread that we
+            // should wake up and process input.
+            m_waitForSampleMutex.lock();
+            if (m_samplePipe.readAvailable() == 0 && !m_bReloadConfig && !m_bQuit) {
+                m_samplesAvailableSignal.wait(&m_waitForSampleMutex);
+            }
+            m_waitForSampleMutex.unlock();
+        }
+    }
 
-    while (!m_bQuit) {
-        if (m_bReloadConfig) {
-            reloadConfig();
-            m_bReloadConfig = false;
+  private:
+    void reloadConfig() {
+        QMutexLocker locker(&m_vinylControlMutex);
+        if (m_pVinylControl == NULL) {
+            return;
         }
+        VinylControl* pCurrent = m_pVinylControl;
+        m_pVinylControl = new VinylControlXwax(
+                m_pProcessor->m_pConfig, kVCGroup.arg(m_index + 1));
+        locker.unlock();
+        delete pCurrent;
+    }
 
-        for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-            QMutexLocker locker(&m_processorsLock);
-            VinylControl* pProcessor = m_processors[i];
-            locker.unlock();
-            FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[i];
+    void processSamples() {
+        while (m_samplePipe.readAvailable() > 0) {
+            const qint64 pendingSinceNanos = m_pendingSinceNanos.exchange(0);
+            int samplesRead = m_samplePipe.read(m_pWorkBuffer, MAX_BUFFER_LEN);
 
-            if (pSamplePipe->readAvailable() > 0) {
-                int samplesRead = pSamplePipe->read(m_pWorkBuffer, MAX_BUFFER_LEN);
+            if (samplesRead % 2 != 0) {
+                qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
+                samplesRead--;
+            }
+            int framesRead = samplesRead / 2;
 
-                if (samplesRead % 2 != 0) {
-                    qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
-                    samplesRead--;
-                }
-                int framesRead = samplesRead / 2;
+            QMutexLocker locker(&m_vinylControlMutex);
+            if (m_pVinylControl == NULL) {
+                // Samples are being written to a non-existent processor. Warning?
+                qWarning() << "Samples written to non-existent VinylControl processor:" << m_index;
+                continue;
+            }
 
-                if (pProcessor) {
-                    pProcessor->analyzeSamples(m_pWorkBuffer, framesRead);
-                } else {
-                    // Samples are being written to a non-existent processor. Warning?
-                    qWarning() << "Samples written to non-existent VinylControl processor:" << i;
-                }
+            m_pVinylControl->analyzeSamples(m_pWorkBuffer, framesRead);
+
+            // The time from receiving the samples in the engine callback
+            // until the pitch of the deck has been updated.
+            if (pendingSinceNanos > 0) {
+                Stat::track(m_pitchLatencyStat,
+                        Stat::DURATION_NANOSEC,
+                        Stat::experimentFlags(kDefaultComputeFlags),
+                        mixxx::Time::elapsed().toIntegerNanos() - pendingSinceNanos);
             }
 
             // TODO(rryan) define a time-based update rate. This will update way
             // too quickly.
-            if (pProcessor && m_bReportSignalQuality) {
+            if (m_pProcessor->reportSignalQuality()) {
                 VinylSignalQualityReport report;
-                if (pProcessor->writeQualityReport(&report)) {
-                    report.processor = i;
-                    if (m_signalQualityFifo.write(&report, 1) != 1) {
-                        qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << i;
-                    }
+                if (m_pVinylControl->writeQualityReport(&report)) {
+                    report.processor = m_index;
+                    m_pProcessor->writeSignalQualityReport(report);
                 }
             }
         }
+    }
 
-        if (m_bQuit) {
-            break;
-        }
+    VinylControlProcessor* const m_pProcessor;
+    const int m_index;
+    // For writing samples from the engine callback to the worker thread.
+    FIFO<CSAMPLE> m_samplePipe;
+    CSAMPLE* m_pWorkBuffer;
+    // Held while the VinylControl is in use by the worker.
+    QMutex m_vinylControlMutex;
+    VinylControl* m_pVinylControl;
+    // Time when the oldest samples that have not been processed yet were
+    // received, 0 if none are pending.
+    std::atomic<qint64> m_pendingSinceNanos;
+    const QString m_pitchLatencyStat;
+    QWaitCondition m_samplesAvailableSignal;
+    QMutex m_waitForSampleMutex;
+    volatile bool m_bQuit;
+    volatile bool m_bReloadConfig;
+};
+
+VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPointer pConfig)
+        : QObject(pParent),
+          m_pConfig(pConfig),
+          m_pToggle(new ControlPushButton(ConfigKey(VINYL_PREF_KEY, "Toggle"))),
+          m_signalQualityFifo(SIGNAL_QUALITY_FIFO_SIZE),
+          m_bReportSignalQuality(false) {
+    connect(m_pToggle,
+            &ControlPushButton::valueChanged,
+            this,
+            &VinylControlProcessor::toggleDeck,
+            Qt::DirectConnection);
 
-        // Wait for a signal from the main thread or engine thread that we
-        // should wake up and process input.
-        m_waitForSampleMutex.lock();
-        m_samplesAvailableSignal.wait(&m_waitForSampleMutex);
-        m_waitForSampleMutex.unlock();
+    // The workers are started when their input is configured
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        m_workers[i] = new VinylControlDeckWorker(this, i);
     }
 }
 
-void VinylControlProcessor::reloadConfig() {
+VinylControlProcessor::~VinylControlProcessor() {
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-        QMutexLocker locker(&m_processorsLock);
-        VinylControl* pCurrent = m_processors[i];
+        delete m_workers[i];
+        m_workers[i] = NULL;
+    }
 
-        if (pCurrent == NULL) {
-            continue;
-        }
+    delete m_pToggle;
 
-        VinylControl *pNew = new VinylControlXwax(
-            m_pConfig, kVCGroup.arg(i + 1));
-        m_processors.replace(i, pNew);
-        locker.unlock();
-        // Delete outside of the critical section to avoid deadlocks.
-        delete pCurrent;
+    // xwax has a global LUT that we need to free after we've shut down our
+    // vinyl control threads because it's not thread-safe.
+    VinylControlXwax::freeLUTs();
+}
+
+void VinylControlProcessor::setSignalQualityReporting(bool enable) {
+    m_bReportSignalQuality = enable;
+}
+
+void VinylControlProcessor::shutdown() {
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        m_workers[i]->shutdown();
+    }
+}
+
+void VinylControlProcessor::requestReloadConfig() {
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        m_workers[i]->requestReloadConfig();
+    }
+}
+
+void VinylControlProcessor::writeSignalQualityReport(
+        const VinylSignalQualityReport& report) {
+    QMutexLocker locker(&m_signalQualityFifoMutex);
+    if (m_signalQualityFifo.write(&report, 1) != 1) {
+        qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << report.processor;
     }
 }
 
@@ -169,12 +287,9 @@ void VinylControlProcessor::onInputConfigured(AudioInput input) {
     VinylControl *pNew = new VinylControlXwax(
         m_pConfig, kVCGroup.arg(index + 1));
 
-    QMutexLocker locker(&m_processorsLock);
-    VinylControl* pCurrent = m_processors.at(index);
-    m_processors.replace(index, pNew);
-    locker.unlock();
     // Delete outside of the critical section to avoid deadlocks.
-    delete pCurrent;
+    delete m_workers[index]->replaceVinylControl(pNew);
+    m_workers[index]->startProcessing();
 }
 
 void VinylControlProcessor::onInputUnconfigured(AudioInput input) {
@@ -191,16 +306,13 @@ void VinylControlProcessor::onInputUnconfigured(AudioInput input) {
         return;
     }
 
-    QMutexLocker locker(&m_processorsLock);
-    VinylControl* pVC = m_processors.at(index);
-    m_processors.replace(index, NULL);
-    locker.unlock();
+    m_workers[index]->stopProcessing();
     // Delete outside of the critical section to avoid deadlocks.
-    delete pVC;
+    delete m_workers[index]->replaceVinylControl(NULL);
 }
 
 bool VinylControlProcessor::deckConfigured(int index) const {
-    return m_processors[index] != NULL;
+    return m_workers[index]->hasVinylControl();
 }
 
 void VinylControlProcessor::receiveBuffer(AudioInput input,
@@ -219,23 +331,9 @@ void VinylControlProcessor::receiveBuffer(AudioInput input,
         return;
     }
 
-    FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[vcIndex];
-
-    if (pSamplePipe == NULL) {
-        // Should not be possible.
-        return;
-    }
-
     const int kChannels = 2;
     const int nSamples = nFrames * kChannels;
-    int samplesWritten = pSamplePipe->write(pBuffer, nSamples);
-
-    if (samplesWritten < nSamples) {
-        qWarning() << "ERROR: Buffer overflow in VinylControlProcessor. Dropping samples on the floor."
-                   << "VCIndex:" << vcIndex;
-    }
-
-    m_samplesAvailableSignal.wakeAll();
+    m_workers[vcIndex]->receiveBuffer(pBuffer, nSamples);
 }
 
 void VinylControlProcessor::toggleDeck(double value) {
@@ -254,13 +352,29 @@ void VinylControlProcessor::toggleDeck(double value) {
      * will be ignored.
      */
 
+    // None of the VinylControls must be replaced or deleted while toggling
+    // them. The locks are always taken in the same order.
+    VinylControl* processors[kMaximumVinylControlInputs];
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        m_workers[i]->lockVinylControl();
+        processors[i] = m_workers[i]->lockedVinylControl();
+    }
+
+    toggleNextVinylControl(processors);
+
+    for (int i = kMaximumVinylControlInputs - 1; i >= 0; --i) {
+        m_workers[i]->unlockVinylControl();
+    }
+}
+
+// static
+void VinylControlProcessor::toggleNextVinylControl(
+        VinylControl* const (&processors)[kMaximumVinylControlInputs]) {
     // -1 means we haven't found a proxy that's enabled
     int enabled = -1;
 
-    QMutexLocker locker(&m_processorsLock);
-
-    for (int i = 0; i < m_processors.size(); ++i) {
-        VinylControl* pProcessor = m_processors.at(i);
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        VinylControl* pProcessor = processors[i];
         if (pProcessor && pProcessor->isEnabled()) {
             if (enabled > -1) {
                 return; // case 3
@@ -269,28 +383,24 @@ void VinylControlProcessor::toggleDeck(double value) {
         }
     }
 
-    if (enabled > -1 && m_processors.size() > 1) {
+    if (enabled > -1 && kMaximumVinylControlInputs > 1) {
         // handle case 2
 
-        int nextProxy = (enabled + 1) % m_processors.size();
-        while (!m_processors[nextProxy]) {
-            nextProxy = (nextProxy + 1) % m_processors.size();
+        int nextProxy = (enabled + 1) % kMaximumVinylControlInputs;
+        while (!processors[nextProxy]) {
+            nextProxy = (nextProxy + 1) % kMaximumVinylControlInputs;
         } // guaranteed to terminate as there's at least 1 non-null proxy
 
         if (nextProxy == enabled) {
             return;
         }
 
-        VinylControl* pEnabled = m_processors[enabled];
-        VinylControl* pNextProxy = m_processors[nextProxy];
-        locker.unlock();
-        pEnabled->toggleVinylControl(false);
-        pNextProxy->toggleVinylControl(true);
+        processors[enabled]->toggleVinylControl(false);
+        processors[nextProxy]->toggleVinylControl(true);
     } else if (enabled == -1) {
         // handle case 1, or we just don't have any processors
-        foreach (VinylControl* pProcessor, m_processors) {
+        for (VinylControl* pProcessor : processors) {
             if (pProcessor) {
-                locker.unlock();
                 pProcessor->toggleVinylControl(true);
                 return;
             }
@@ -2,10 +2,7 @@
 #define VINYLCONTROLPROCESSOR_H
 
 #include <QObject>
-#include <QThread>
-#include <QVector>
 #include <QMutex>
-#include <QWaitCondition>
 
 #include "preferences/usersettings.h"
 #include "util/fifo.h"
@@ -13,13 +10,16 @@
 #include "soundio/soundmanagerutil.h"
 
 class VinylControl;
+class VinylControlDeckWorker;
 class ControlPushButton;
 
-// VinylControlProcessor is a thread that is in charge of receiving samples from
-// the engine callback and feeding those samples to the VinylControl
-// classes. The most important thing is that the connection between the engine
-// callback and VinylControlProcessor (the receiveBuffer method) is lock-free.
-class VinylControlProcessor : public QThread, public AudioDestination {
+// VinylControlProcessor is in charge of receiving samples from the engine
+// callback and feeding those samples to the VinylControl classes. Each
+// configured input is decoded by its own worker thread, so decoding the
+// timecode of one deck never delays another one. The most important thing
+// is that the connection between the engine callback and the workers (the
+// receiveBuffer method) is lock-free.
+class VinylControlProcessor : public QObject, public AudioDestination {
     Q_OBJECT
   public:
     VinylControlProcessor(QObject* pParent, UserSettingsPointer pConfig);
@@ -28,10 +28,10 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     // Called from main thread. Must only touch m_bReportSignalQuality.
     void setSignalQualityReporting(bool enable);
 
-    // Called from the main thread. Must only touch m_bQuit;
+    // Called from the main thread. Stops all workers.
     void shutdown();
 
-    // Called from the main thread. Must only touch m_bReload;
+    // Called from the main thread. The workers re-create their VinylControl.
     void requestReloadConfig();
 
     bool deckConfigured(int index) const;
@@ -45,7 +45,7 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     virtual void onInputUnconfigured(AudioInput input);
 
     // Called by the engine callback. Must not touch any state in
-    // VinylControlProcessor except for m_samplePipes. NOTE:
+    // VinylControlProcessor except for the sample pipes of the workers. NOTE:
 
     // This is called by SoundManager whenever there are new samples from the
     // configured input to be processed. This is run in the callback thread of
@@ -56,30 +56,32 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     void receiveBuffer(AudioInput input, const CSAMPLE* pBuffer,
                        unsigned int iNumFrames);
 
-  protected:
-    void run();
-
   private slots:
     void toggleDeck(double value);
 
   private:
-    void reloadConfig();
+    // Called by toggleDeck() while holding the locks of all workers. The
+    // VinylControls of unconfigured inputs are NULL.
+    static void toggleNextVinylControl(
+            VinylControl* const (&processors)[kMaximumVinylControlInputs]);
+
+    // Called from the worker threads.
+    bool reportSignalQuality() const {
+        return m_bReportSignalQuality;
+    }
+    void writeSignalQualityReport(const VinylSignalQualityReport& report);
 
     UserSettingsPointer m_pConfig;
     ControlPushButton* m_pToggle;
-    // A pre-allocated array of FIFOs for writing samples from the engine
-    // callback to the processor thread. There is a maximum of
-    // kMaximumVinylControlInputs pipes.
-    FIFO<CSAMPLE>* m_samplePipes[kMaximumVinylControlInputs];
-    CSAMPLE* m_pWorkBuffer;
-    QWaitCondition m_samplesAvailableSignal;
-    QMutex m_waitForSampleMutex;
-    QMutex m_processorsLock;
-    QVector<VinylControl*> m_processors;
+    // A pre-allocated array of workers, one for each of the
+    // kMaximumVinylControlInputs inputs.
+    VinylControlDeckWorker* m_workers[kMaximumVinylControlInputs];
+    // The workers share the FIFO for signal quality reports
+    QMutex m_signalQualityFifoMutex;
     FIFO<VinylSignalQualityReport> m_signalQualityFifo;
     volatile bool m_bReportSignalQuality;
-    volatile bool m_bQuit;
-    volatile bool m_bReloadConfig;
+
+    friend class VinylControlDeckWorker;
 };
 
 
@@ -734,6 +734,10 @@ TrackPointerList WTrackMenu::getTrackPointers(
     if (!m_pTrackModel) {
         return m_trackPointerList;
     }
+    if (maxSize < 0) {
+        // Load all selected tracks at once instead of one by one
+        return m_pTrackModel->getTracks(m_trackIndexList);
+    }
     TrackPointerList trackPointers;
     trackPointers.reserve(m_trackIndexList.size());
     for (const auto& index : m_trackIndexList) {